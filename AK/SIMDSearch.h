@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Assertions.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/SIMD.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+
+// NOTE: The helpers that pass vectors around are static, so their calling convention doesn't matter (see SIMDExtras.h).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace AK {
+
+namespace Detail {
+
+template<typename CodeUnit>
+using CodeUnitVectorFor = Conditional<sizeof(CodeUnit) == 1, SIMD::u8x16, SIMD::u16x8>;
+
+template<typename CodeUnit>
+using UnsignedCodeUnit = Conditional<sizeof(CodeUnit) == 1, u8, u16>;
+
+template<typename CodeUnit>
+ALWAYS_INLINE static CodeUnitVectorFor<CodeUnit> load_code_units(CodeUnit const* code_units)
+{
+    CodeUnitVectorFor<CodeUnit> vector;
+    __builtin_memcpy(&vector, code_units, sizeof(vector));
+    return vector;
+}
+
+template<typename CodeUnit>
+ALWAYS_INLINE static CodeUnitVectorFor<CodeUnit> splat_code_unit(UnsignedCodeUnit<CodeUnit> code_unit)
+{
+    CodeUnitVectorFor<CodeUnit> vector;
+    for (size_t i = 0; i < sizeof(vector) / sizeof(CodeUnit); ++i)
+        vector[i] = code_unit;
+    return vector;
+}
+
+template<typename Vector>
+ALWAYS_INLINE static bool any_lane_set(Vector mask)
+{
+    u64 halves[2];
+    __builtin_memcpy(halves, &mask, sizeof(halves));
+    return (halves[0] | halves[1]) != 0;
+}
+
+// Code units are compared by their unsigned value, so that a char haystack can be searched for char16_t needles.
+template<typename CodeUnit, typename NeedleCodeUnit>
+ALWAYS_INLINE static Optional<UnsignedCodeUnit<CodeUnit>> code_unit_as(NeedleCodeUnit needle)
+{
+    auto value = static_cast<UnsignedCodeUnit<NeedleCodeUnit>>(needle);
+    if (value > NumericLimits<UnsignedCodeUnit<CodeUnit>>::max())
+        return {};
+    return static_cast<UnsignedCodeUnit<CodeUnit>>(value);
+}
+
+template<typename CodeUnit, typename NeedleCodeUnit>
+ALWAYS_INLINE static bool code_units_equal(CodeUnit const* haystack, NeedleCodeUnit const* needle, size_t length)
+{
+    for (size_t i = 0; i < length; ++i) {
+        if (static_cast<UnsignedCodeUnit<CodeUnit>>(haystack[i]) != static_cast<UnsignedCodeUnit<NeedleCodeUnit>>(needle[i]))
+            return false;
+    }
+    return true;
+}
+
+}
+
+// Returns the offset of the first code unit in haystack at or after start_offset that is one of needles. This is meant
+// for small sets of needles, as each of them costs a comparison per block of code units.
+template<typename CodeUnit, typename NeedleCodeUnit>
+Optional<size_t> find_any_of_code_units(ReadonlySpan<CodeUnit> haystack, ReadonlySpan<NeedleCodeUnit> needles, size_t start_offset = 0)
+{
+    using Vector = Detail::CodeUnitVectorFor<CodeUnit>;
+    static constexpr size_t lanes = sizeof(Vector) / sizeof(CodeUnit);
+
+    Array<Vector, 8> needle_vectors;
+    Array<Detail::UnsignedCodeUnit<CodeUnit>, 8> needle_values;
+    size_t needle_count = 0;
+    for (auto needle : needles) {
+        VERIFY(needle_count < needle_vectors.size());
+        auto value = Detail::code_unit_as<CodeUnit>(needle);
+        if (!value.has_value())
+            continue;
+        needle_values[needle_count] = *value;
+        needle_vectors[needle_count++] = Detail::splat_code_unit<CodeUnit>(*value);
+    }
+    if (needle_count == 0)
+        return {};
+
+    auto const* code_units = haystack.data();
+    auto index = start_offset;
+
+    for (; index + lanes <= haystack.size(); index += lanes) {
+        auto block = Detail::load_code_units(code_units + index);
+        auto mask = block == needle_vectors[0];
+        for (size_t i = 1; i < needle_count; ++i)
+            mask |= block == needle_vectors[i];
+        if (!Detail::any_lane_set(mask))
+            continue;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (mask[lane])
+                return index + lane;
+        }
+    }
+
+    for (; index < haystack.size(); ++index) {
+        auto code_unit = static_cast<Detail::UnsignedCodeUnit<CodeUnit>>(code_units[index]);
+        for (size_t i = 0; i < needle_count; ++i) {
+            if (code_unit == needle_values[i])
+                return index;
+        }
+    }
+
+    return {};
+}
+
+// Returns the offset of the first occurrence of needle in haystack at or after start_offset. Blocks of code units are
+// checked for the first and the last code unit of the needle at once, and only the candidates that have both are
+// compared in full, which skips over most of the haystack without looking at it twice.
+template<typename CodeUnit, typename NeedleCodeUnit>
+Optional<size_t> find_code_units(ReadonlySpan<CodeUnit> haystack, ReadonlySpan<NeedleCodeUnit> needle, size_t start_offset = 0)
+{
+    using Vector = Detail::CodeUnitVectorFor<CodeUnit>;
+    static constexpr size_t lanes = sizeof(Vector) / sizeof(CodeUnit);
+
+    if (start_offset > haystack.size() || needle.size() > haystack.size() - start_offset)
+        return {};
+    if (needle.is_empty())
+        return start_offset;
+    if (needle.size() == 1)
+        return find_any_of_code_units(haystack, needle, start_offset);
+
+    auto first = Detail::code_unit_as<CodeUnit>(needle.first());
+    auto last = Detail::code_unit_as<CodeUnit>(needle.last());
+    if (!first.has_value() || !last.has_value())
+        return {};
+
+    auto first_vector = Detail::splat_code_unit<CodeUnit>(*first);
+    auto last_vector = Detail::splat_code_unit<CodeUnit>(*last);
+
+    auto const* code_units = haystack.data();
+    auto last_offset = needle.size() - 1;
+    auto end = haystack.size() - last_offset;
+    auto index = start_offset;
+
+    for (; index + lanes <= end; index += lanes) {
+        auto mask = (Detail::load_code_units(code_units + index) == first_vector)
+            & (Detail::load_code_units(code_units + index + last_offset) == last_vector);
+        if (!Detail::any_lane_set(mask))
+            continue;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (mask[lane] && Detail::code_units_equal(code_units + index + lane + 1, needle.data() + 1, needle.size() - 2))
+                return index + lane;
+        }
+    }
+
+    for (; index < end; ++index) {
+        if (Detail::code_units_equal(code_units + index, needle.data(), needle.size()))
+            return index;
+    }
+
+    return {};
+}
+
+}
+
+#pragma GCC diagnostic pop
+
+#if USING_AK_GLOBALLY
+using AK::find_any_of_code_units;
+using AK::find_code_units;
+#endif
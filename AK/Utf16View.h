@@ -13,6 +13,7 @@
 #include <AK/IterationDecision.h>
 #include <AK/MemMem.h>
 #include <AK/Optional.h>
+#include <AK/SIMDSearch.h>
 #include <AK/Span.h>
 #include <AK/String.h>
 #include <AK/StringConversions.h>
@@ -488,6 +489,12 @@ public:
 
     constexpr Optional<size_t> find_code_unit_offset(Utf16View const& needle, size_t start_offset = 0) const
     {
+        if (!is_constant_evaluated()) {
+            if (has_ascii_storage())
+                return needle.has_ascii_storage() ? find_code_units(ascii_span(), needle.ascii_span(), start_offset) : find_code_units(ascii_span(), needle.utf16_span(), start_offset);
+            return needle.has_ascii_storage() ? find_code_units(utf16_span(), needle.ascii_span(), start_offset) : find_code_units(utf16_span(), needle.utf16_span(), start_offset);
+        }
+
         if (has_ascii_storage() && needle.has_ascii_storage())
             return ascii_span().index_of(needle.ascii_span(), start_offset);
         if (!has_ascii_storage() && !needle.has_ascii_storage())
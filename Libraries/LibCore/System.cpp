@@ -147,7 +147,7 @@ ErrorOr<int> anon_create([[maybe_unused]] size_t size, [[maybe_unused]] int opti
 #if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
     // FIXME: Support more options on Linux.
     auto linux_options = ((options & O_CLOEXEC) > 0) ? MFD_CLOEXEC : 0;
-    fd = memfd_create("", linux_options);
+    fd = memfd_create("", linux_options | MFD_ALLOW_SEALING);
     if (fd < 0)
         return Error::from_errno(errno);
     if (::ftruncate(fd, size) < 0) {
@@ -155,6 +155,12 @@ ErrorOr<int> anon_create([[maybe_unused]] size_t size, [[maybe_unused]] int opti
         TRY(close(fd));
         return Error::from_errno(saved_errno);
     }
+    // Anonymous files are shared with other processes that map them, so their size must not change underneath them.
+    if (::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) < 0) {
+        auto saved_errno = errno;
+        TRY(close(fd));
+        return Error::from_errno(saved_errno);
+    }
 #elif defined(SHM_ANON)
     fd = shm_open(SHM_ANON, O_RDWR | O_CREAT | options, 0600);
     if (fd < 0)
@@ -197,6 +203,38 @@ ErrorOr<int> anon_create([[maybe_unused]] size_t size, [[maybe_unused]] int opti
     return fd;
 }
 
+ErrorOr<void> verify_anon_fd_is_sealed([[maybe_unused]] int fd)
+{
+#if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
+    auto seals = TRY(fcntl(fd, F_GET_SEALS));
+    if ((seals & (F_SEAL_SHRINK | F_SEAL_GROW)) != (F_SEAL_SHRINK | F_SEAL_GROW))
+        return Error::from_string_literal("Anonymous file is not sealed against resizing");
+#endif
+    // FIXME: Shared memory objects elsewhere can't be sealed, so we have to trust the peer not to resize them.
+    return {};
+}
+
+ErrorOr<void> seal_anon_fd_against_writes([[maybe_unused]] int fd)
+{
+#if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
+    // This fails with EBUSY while any writable shared mapping of the file still exists.
+    if (::fcntl(fd, F_ADD_SEALS, F_SEAL_WRITE) < 0)
+        return Error::from_syscall("fcntl"sv, errno);
+#endif
+    return {};
+}
+
+ErrorOr<void> verify_anon_fd_is_sealed_against_writes([[maybe_unused]] int fd)
+{
+    TRY(verify_anon_fd_is_sealed(fd));
+#if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
+    auto seals = TRY(fcntl(fd, F_GET_SEALS));
+    if ((seals & F_SEAL_WRITE) == 0)
+        return Error::from_string_literal("Anonymous file is not sealed against writes");
+#endif
+    return {};
+}
+
 ErrorOr<int> open(StringView path, int options, mode_t mode)
 {
     return openat(AT_FDCWD, path, options, mode);
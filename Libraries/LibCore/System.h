@@ -76,6 +76,9 @@ ErrorOr<int> fcntl(int fd, int command, ...);
 ErrorOr<void*> mmap(void* address, size_t, int protection, int flags, int fd, off_t, size_t alignment = 0, StringView name = {});
 ErrorOr<void> munmap(void* address, size_t);
 ErrorOr<int> anon_create(size_t size, int options);
+ErrorOr<void> verify_anon_fd_is_sealed(int fd);
+ErrorOr<void> seal_anon_fd_against_writes(int fd);
+ErrorOr<void> verify_anon_fd_is_sealed_against_writes(int fd);
 ErrorOr<int> open(StringView path, int options, mode_t mode = 0);
 ErrorOr<int> openat(int fd, StringView path, int options, mode_t mode = 0);
 ErrorOr<void> close(int fd);
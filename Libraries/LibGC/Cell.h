@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
@@ -37,6 +38,13 @@ public:                                            \
     }                                              \
     friend class GC::Heap;
 
+// Cells of this exact class have visit_edges() called on helper marking threads (see Heap::set_collector_thread_count()).
+// Subclasses don't inherit this, and have to opt in themselves. Only opt in if visit_edges() is safe to run concurrently
+// with the tracing of other cells, i.e. it doesn't allocate, mutate state or read anything that another cell's
+// visit_edges() may be changing at the same time.
+#define GC_DECLARE_THREAD_SAFE_VISIT_EDGES(ClassName) \
+    using ClassWithThreadSafeVisitEdges = ClassName
+
 class GC_API Cell {
     AK_MAKE_NONCOPYABLE(Cell);
     AK_MAKE_NONMOVABLE(Cell);
@@ -44,11 +52,17 @@ class GC_API Cell {
 public:
     virtual ~Cell() = default;
 
-    bool is_marked() const { return m_mark; }
-    void set_marked(bool b) { m_mark = b; }
+    // Mark bits are atomic, since they're read and written by several threads during parallel marking.
+    bool is_marked() const { return AK::atomic_load(&m_mark, AK::memory_order_relaxed); }
+    void set_marked(bool b) { AK::atomic_store(&m_mark, b, AK::memory_order_relaxed); }
+
+    // Returns whether the cell was already marked. Safe to use from several marking threads at once.
+    bool test_and_set_marked() { return AK::atomic_exchange(&m_mark, true, AK::memory_order_relaxed); }
 
-    enum class State : bool {
+    enum class State : u8 {
         Live,
+        // The cell is unreachable and has been finalized, but its HeapBlock has not been swept yet.
+        Finalized,
         Dead,
     };
 
@@ -168,7 +182,15 @@ public:
 
     virtual void visit_edges(Visitor&) { }
 
+    // With more than one collector thread, only cells of classes that use GC_DECLARE_THREAD_SAFE_VISIT_EDGES have
+    // visit_edges() called on a helper thread. Everything else is traced on the main thread.
+    bool has_thread_safe_visit_edges() const { return m_has_thread_safe_visit_edges; }
+    void set_has_thread_safe_visit_edges(Badge<Heap>) { m_has_thread_safe_visit_edges = true; }
+
     // This will be called on unmarked objects by the garbage collector in a separate pass before destruction.
+    // NOTE: With lazy sweeping, destruction may happen long after this. Anything that would let other code reach this
+    //       cell in the meantime (AK::WeakPtrs, caches and registries that are iterated or looked up by value) must be
+    //       torn down here, after calling Base::finalize(). Everything else belongs in the destructor as usual.
     virtual void finalize() { }
 
     // This allows cells to survive GC by choice, even if nothing points to them.
@@ -190,6 +212,7 @@ protected:
 private:
     bool m_mark { false };
     bool m_overrides_must_survive_garbage_collection { false };
+    bool m_has_thread_safe_visit_edges { false };
     State m_state { State::Live };
 } SWIFT_UNSAFE_REFERENCE;
 
@@ -23,6 +23,10 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     if (!m_list_node.is_in_list())
         heap.register_cell_allocator({}, *this);
 
+    // Sweeping a block is cheaper than creating one, and usually frees up some cells.
+    while (m_usable_blocks.is_empty() && !m_unswept_blocks.is_empty())
+        sweep_block(*m_unswept_blocks.first());
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, *this, m_cell_size, m_class_name);
         auto block_ptr = reinterpret_cast<FlatPtr>(block.ptr());
@@ -42,6 +46,11 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
 }
 
 void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
+{
+    destroy_block(block);
+}
+
+void CellAllocator::destroy_block(HeapBlock& block)
 {
     block.m_list_node.remove();
     // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
@@ -55,4 +64,38 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::block_needs_sweeping(Badge<Heap>, HeapBlock& block)
+{
+    m_unswept_blocks.append(block);
+}
+
+void CellAllocator::sweep_block(HeapBlock& block)
+{
+    auto& heap = block.heap();
+    bool block_has_live_cells = false;
+    size_t swept_cell_count = 0;
+    block.for_each_cell([&](Cell* cell) {
+        switch (cell->state()) {
+        case Cell::State::Finalized:
+            block.deallocate(cell);
+            ++swept_cell_count;
+            break;
+        case Cell::State::Live:
+            cell->set_marked(false);
+            block_has_live_cells = true;
+            break;
+        case Cell::State::Dead:
+            break;
+        }
+    });
+    heap.did_sweep_block_lazily({}, swept_cell_count * m_cell_size);
+
+    if (!block_has_live_cells)
+        destroy_block(block);
+    else if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
+}
+
 }
@@ -41,12 +41,22 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_unswept_blocks) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
     void block_did_become_empty(Badge<Heap>, HeapBlock&);
     void block_did_become_usable(Badge<Heap>, HeapBlock&);
 
+    // Blocks that need sweeping are not allocated from until they have been swept, which happens on demand when
+    // this allocator runs out of usable blocks, or when the heap finishes sweeping before the next collection.
+    void block_needs_sweeping(Badge<Heap>, HeapBlock&);
+    bool has_unswept_blocks() const { return !m_unswept_blocks.is_empty(); }
+    void sweep_next_unswept_block(Badge<Heap>) { sweep_block(*m_unswept_blocks.first()); }
+
     IntrusiveListNode<CellAllocator> m_list_node;
     using List = IntrusiveList<&CellAllocator::m_list_node>;
 
@@ -55,6 +65,9 @@ public:
     FlatPtr max_block_address() const { return m_max_block_address; }
 
 private:
+    void sweep_block(HeapBlock&);
+    void destroy_block(HeapBlock&);
+
     char const* const m_class_name { nullptr };
     size_t const m_cell_size;
 
@@ -63,6 +76,7 @@ private:
     using BlockList = IntrusiveList<&HeapBlock::m_list_node>;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+    BlockList m_unswept_blocks;
     FlatPtr m_min_block_address { explode_byte(0xff) };
     FlatPtr m_max_block_address { 0 };
 };
@@ -12,6 +12,7 @@
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
@@ -20,31 +21,87 @@
 #include <LibGC/HeapBlock.h>
 #include <LibGC/NanBoxedValue.h>
 #include <LibGC/Root.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/WorkerThread.h>
 #include <setjmp.h>
 
+#ifdef AK_OS_WINDOWS
+#    include <AK/Windows.h>
+#else
+#    include <sched.h>
+#endif
+
 #ifdef HAS_ADDRESS_SANITIZER
 #    include <sanitizer/asan_interface.h>
 #endif
 
 namespace GC {
 
+Atomic<size_t> g_incrementally_marking_heap_count { 0 };
+
+// Only the heap's own thread may shade cells, since that adds them to the marking work queue. Pointers that other
+// threads store while marking is in progress (e.g. during parallel style computation) are collected here instead, and
+// shaded by the heap's thread before its next marking step.
+class StoresFromOtherThreads {
+public:
+    StoresFromOtherThreads()
+        : m_heap_thread(pthread_self())
+    {
+    }
+
+    bool is_on_heap_thread() const { return pthread_equal(pthread_self(), m_heap_thread); }
+
+    void did_start_marking()
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_is_marking = true;
+    }
+
+    Vector<void const*> did_stop_marking()
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_is_marking = false;
+        return move(m_pointers);
+    }
+
+    void append(void const* pointer)
+    {
+        Threading::MutexLocker locker(m_mutex);
+        if (m_is_marking)
+            m_pointers.append(pointer);
+    }
+
+    Vector<void const*> take()
+    {
+        Threading::MutexLocker locker(m_mutex);
+        return move(m_pointers);
+    }
+
+private:
+    pthread_t const m_heap_thread;
+    Threading::Mutex m_mutex;
+    bool m_is_marking { false };
+    Vector<void const*> m_pointers;
+};
+
+// Write barrier pointers may point anywhere inside a cell (e.g. at a base class other than the first).
+static Cell* live_cell_containing(void const* pointer)
+{
+    auto* block = static_cast<HeapBlock*>(HeapBlockBase::from_cell(reinterpret_cast<Cell const*>(pointer)));
+    auto* cell = block->cell_from_possible_pointer(reinterpret_cast<FlatPtr>(pointer));
+    if (!cell || cell->state() != Cell::State::Live)
+        return nullptr;
+    return cell;
+}
+
 Heap::Heap(void* private_data, AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> gather_embedder_roots)
     : HeapBase(private_data)
+    , m_stores_from_other_threads(make<StoresFromOtherThreads>())
     , m_gather_embedder_roots(move(gather_embedder_roots))
 {
     static_assert(HeapBlock::min_possible_cell_size <= 32, "Heap Cell tracking uses too much data!");
-    m_size_based_cell_allocators.append(make<CellAllocator>(64));
-    m_size_based_cell_allocators.append(make<CellAllocator>(96));
-    m_size_based_cell_allocators.append(make<CellAllocator>(128));
-    m_size_based_cell_allocators.append(make<CellAllocator>(256));
-    m_size_based_cell_allocators.append(make<CellAllocator>(512));
-    m_size_based_cell_allocators.append(make<CellAllocator>(1024));
-    m_size_based_cell_allocators.append(make<CellAllocator>(3072));
-}
-
-Heap::~Heap()
-{
-    collect_garbage(CollectionType::CollectEverything);
+    for (auto cell_size : GC_SIZE_CLASSES)
+        m_size_based_cell_allocators.append(make<CellAllocator>(cell_size));
 }
 
 void Heap::will_allocate(size_t size)
@@ -52,12 +109,25 @@ void Heap::will_allocate(size_t size)
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
         collect_garbage();
+    } else if (m_incremental_marking_in_progress) {
+        if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
+            // The mutator is outpacing the marker, so finish this cycle right away.
+            m_allocated_bytes_since_last_gc = 0;
+            collect_garbage();
+        } else if (m_allocated_bytes_since_last_marking_step + size > GC_INCREMENTAL_MARKING_STEP_BYTES) {
+            m_allocated_bytes_since_last_marking_step = 0;
+            perform_incremental_marking_step();
+        }
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        if (m_incremental_marking_time_budget.is_zero())
+            collect_garbage();
+        else
+            start_incremental_marking();
     }
 
     m_allocated_bytes_since_last_gc += size;
+    m_allocated_bytes_since_last_marking_step += size;
 }
 
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
@@ -237,35 +307,6 @@ AK::JsonObject Heap::dump_graph()
     return visitor.dump();
 }
 
-void Heap::collect_garbage(CollectionType collection_type, bool print_report)
-{
-    VERIFY(!m_collecting_garbage);
-
-    {
-        TemporaryChange change(m_collecting_garbage, true);
-
-        Core::ElapsedTimer collection_measurement_timer;
-        if (print_report)
-            collection_measurement_timer.start();
-
-        if (collection_type == CollectionType::CollectGarbage) {
-            if (m_gc_deferrals) {
-                m_should_gc_when_deferral_ends = true;
-                return;
-            }
-            HashMap<Cell*, HeapRoot> roots;
-            gather_roots(roots);
-            mark_live_cells(roots);
-        }
-        finalize_unmarked_cells();
-        sweep_dead_cells(print_report, collection_measurement_timer);
-    }
-
-    auto tasks = move(m_post_gc_tasks);
-    for (auto& task : tasks)
-        task();
-}
-
 void Heap::enqueue_post_gc_task(AK::Function<void()> task)
 {
     m_post_gc_tasks.append(move(task));
@@ -330,21 +371,41 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     FlatPtr min_block_address, max_block_address;
     find_min_and_max_block_addresses(min_block_address, max_block_address);
 
+    ConservativeScanStatistics statistics;
+
     for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
         add_possible_value(possible_pointers, raw_jmp_buf[i], HeapRoot { .type = HeapRoot::Type::RegisterPointer }, min_block_address, max_block_address);
+    statistics.scanned_words += sizeof(buf) / sizeof(FlatPtr);
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
 
+    Vector<PreciseStackRange> precise_ranges;
+    if (m_precise_stack_scanning_enabled && m_gather_precise_stack_ranges) {
+        m_gather_precise_stack_ranges(precise_ranges);
+        quick_sort(precise_ranges, [](auto const& a, auto const& b) { return a.base < b.base; });
+    }
+    size_t next_precise_range_index = 0;
+
     for (FlatPtr stack_address = stack_reference; stack_address < m_stack_info.top(); stack_address += sizeof(FlatPtr)) {
+        // Words inside a precisely reported range are already covered by the embedder's roots.
+        while (next_precise_range_index < precise_ranges.size() && precise_ranges[next_precise_range_index].end < stack_address + sizeof(FlatPtr))
+            ++next_precise_range_index;
+        if (next_precise_range_index < precise_ranges.size() && precise_ranges[next_precise_range_index].base <= stack_address) {
+            ++statistics.skipped_words;
+            continue;
+        }
+
         auto data = *reinterpret_cast<FlatPtr*>(stack_address);
         add_possible_value(possible_pointers, data, HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
         gather_asan_fake_stack_roots(possible_pointers, data, min_block_address, max_block_address);
+        ++statistics.scanned_words;
     }
 
     for (auto& vector : m_conservative_vectors) {
         for (auto possible_value : vector.possible_values()) {
             add_possible_value(possible_pointers, possible_value, HeapRoot { .type = HeapRoot::Type::ConservativeVector }, min_block_address, max_block_address);
         }
+        statistics.scanned_words += vector.possible_values().size();
     }
 
     HashTable<HeapBlock*> all_live_heap_blocks;
@@ -357,16 +418,252 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
             roots.set(cell, *possible_pointers.get(possible_pointer));
+            ++statistics.matched_cells;
         } else {
             dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
         }
     });
+
+    statistics.candidate_pointers = possible_pointers.size();
+    m_last_conservative_scan_statistics = statistics;
 }
 
+// Helper threads that mark and sweep alongside the main thread. They're kept around between collections, since starting
+// threads would take up a good part of a typical pause.
+class CollectorThreadPool {
+public:
+    explicit CollectorThreadPool(size_t helper_thread_count)
+    {
+        for (size_t i = 0; i < helper_thread_count; ++i) {
+            auto thread = Threading::WorkerThread<Error>::create("GC Worker"sv);
+            if (thread.is_error()) {
+                dbgln("Heap: Unable to create collector thread: {}", thread.error());
+                break;
+            }
+            m_helper_threads.append(thread.release_value());
+        }
+    }
+
+    size_t thread_count() const { return m_helper_threads.size() + 1; }
+
+    // Runs the task on every thread at once, and returns once all of them are done. The main thread has index 0.
+    template<typename Callback>
+    void run(Callback const& task)
+    {
+        for (size_t i = 0; i < m_helper_threads.size(); ++i) {
+            auto did_start_task = m_helper_threads[i]->start_task([&task, thread_index = i + 1]() -> ErrorOr<void> {
+                task(thread_index);
+                return {};
+            });
+            // Parallel marking waits for every thread to run out of work, so each of them has to take part.
+            VERIFY(did_start_task);
+        }
+        task(0);
+        for (auto& thread : m_helper_threads)
+            MUST(thread->wait_until_task_is_finished());
+    }
+
+private:
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> m_helper_threads;
+};
+
+// A Chase-Lev work-stealing deque, using the memory orderings from "Correct and Efficient Work-Stealing for Weak Memory
+// Models" (Lê et al., 2013). The owning thread pushes and pops at the bottom, while other threads steal from the top.
+class MarkStack {
+    AK_MAKE_NONCOPYABLE(MarkStack);
+    AK_MAKE_NONMOVABLE(MarkStack);
+
+public:
+    MarkStack()
+    {
+        m_buffers.append(make<Buffer>(initial_capacity));
+        m_buffer.store(m_buffers.last().ptr(), AK::memory_order_relaxed);
+    }
+
+    void push(Cell& cell)
+    {
+        auto bottom = m_bottom.load(AK::memory_order_relaxed);
+        auto top = m_top.load(AK::memory_order_acquire);
+        auto* buffer = m_buffer.load(AK::memory_order_relaxed);
+        if (bottom - top >= static_cast<i64>(buffer->capacity()))
+            buffer = grow(*buffer, top, bottom);
+        buffer->store(bottom, &cell);
+        AK::atomic_thread_fence(AK::memory_order_release);
+        m_bottom.store(bottom + 1, AK::memory_order_relaxed);
+    }
+
+    Cell* pop()
+    {
+        auto bottom = m_bottom.load(AK::memory_order_relaxed) - 1;
+        auto* buffer = m_buffer.load(AK::memory_order_relaxed);
+        m_bottom.store(bottom, AK::memory_order_relaxed);
+        AK::atomic_thread_fence(AK::memory_order_seq_cst);
+        auto top = m_top.load(AK::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, AK::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* cell = buffer->load(bottom);
+        if (top == bottom) {
+            // This is the last cell, so thieves may be racing us for it.
+            if (!m_top.compare_exchange_strong(top, top + 1, AK::memory_order_seq_cst))
+                cell = nullptr;
+            m_bottom.store(bottom + 1, AK::memory_order_relaxed);
+        }
+        return cell;
+    }
+
+    // Safe to call from any thread. Also returns null if another thread stole the cell first.
+    Cell* steal()
+    {
+        auto top = m_top.load(AK::memory_order_acquire);
+        AK::atomic_thread_fence(AK::memory_order_seq_cst);
+        auto bottom = m_bottom.load(AK::memory_order_acquire);
+        if (top >= bottom)
+            return nullptr;
+
+        auto* cell = m_buffer.load(AK::memory_order_acquire)->load(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, AK::memory_order_seq_cst))
+            return nullptr;
+        return cell;
+    }
+
+    bool is_empty() const
+    {
+        return m_bottom.load(AK::memory_order_acquire) <= m_top.load(AK::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t initial_capacity = 1024;
+
+    class Buffer {
+    public:
+        explicit Buffer(size_t capacity)
+        {
+            VERIFY(is_power_of_two(capacity));
+            m_cells.resize(capacity);
+        }
+
+        size_t capacity() const { return m_cells.size(); }
+
+        // Slots are accessed atomically, since a thief may read a slot while the owner reuses it.
+        Cell* load(i64 index) const { return AK::atomic_load(&m_cells[index & (capacity() - 1)], AK::memory_order_relaxed); }
+        void store(i64 index, Cell* cell) { AK::atomic_store(&m_cells[index & (capacity() - 1)], cell, AK::memory_order_relaxed); }
+
+    private:
+        Vector<Cell*> m_cells;
+    };
+
+    Buffer* grow(Buffer const& buffer, i64 top, i64 bottom)
+    {
+        auto new_buffer = make<Buffer>(buffer.capacity() * 2);
+        for (auto i = top; i < bottom; ++i)
+            new_buffer->store(i, buffer.load(i));
+
+        // Thieves may still be reading from the old buffer, so it stays alive until marking is done.
+        m_buffers.append(move(new_buffer));
+        m_buffer.store(m_buffers.last().ptr(), AK::memory_order_release);
+        return m_buffers.last().ptr();
+    }
+
+    Atomic<i64> m_top { 0 };
+    Atomic<i64> m_bottom { 0 };
+    Atomic<Buffer*> m_buffer { nullptr };
+    Vector<NonnullOwnPtr<Buffer>> m_buffers;
+};
+
+// Every marking thread has a stack of its own, which the other threads steal from once they run out of work. Cells that
+// can't be traced on a helper thread are handed to the main thread instead.
+class ParallelMarkingContext {
+public:
+    explicit ParallelMarkingContext(size_t thread_count)
+        : m_thread_count(thread_count)
+    {
+        for (size_t i = 0; i < thread_count; ++i)
+            m_mark_stacks.append(make<MarkStack>());
+    }
+
+    MarkStack& mark_stack(size_t thread_index) { return *m_mark_stacks[thread_index]; }
+
+    Cell* steal(size_t thief_index)
+    {
+        for (size_t i = 1; i < m_thread_count; ++i) {
+            if (auto* cell = m_mark_stacks[(thief_index + i) % m_thread_count]->steal())
+                return cell;
+        }
+        return nullptr;
+    }
+
+    void defer_to_main_thread(Vector<Cell*>& cells)
+    {
+        Threading::MutexLocker locker(m_main_thread_work_mutex);
+        m_main_thread_work.extend(move(cells));
+        m_has_main_thread_work.store(true, AK::memory_order_seq_cst);
+    }
+
+    bool has_main_thread_work() const { return m_has_main_thread_work.load(AK::memory_order_seq_cst); }
+
+    Vector<Cell*> take_main_thread_work()
+    {
+        Threading::MutexLocker locker(m_main_thread_work_mutex);
+        m_has_main_thread_work.store(false, AK::memory_order_seq_cst);
+        return move(m_main_thread_work);
+    }
+
+    // Called by a thread that has run out of work. Returns false once every thread has.
+    bool wait_for_work(bool is_main_thread)
+    {
+        static constexpr size_t spins_before_yielding = 64;
+
+        ++m_idle_thread_count;
+        for (size_t spins = 0;; ++spins) {
+            if (has_work_to_steal() || (is_main_thread && has_main_thread_work())) {
+                --m_idle_thread_count;
+                return true;
+            }
+            // Threads only go idle with an empty stack, so once all of them are, nothing can create new work.
+            if (m_idle_thread_count.load() == m_thread_count && !has_main_thread_work())
+                return false;
+
+            // The threads we're waiting for may need our core to get anything done.
+            if (spins < spins_before_yielding) {
+                AK::atomic_pause();
+            } else {
+#ifdef AK_OS_WINDOWS
+                Sleep(0);
+#else
+                sched_yield();
+#endif
+            }
+        }
+    }
+
+private:
+    bool has_work_to_steal() const
+    {
+        for (auto const& mark_stack : m_mark_stacks) {
+            if (!mark_stack->is_empty())
+                return true;
+        }
+        return false;
+    }
+
+    size_t const m_thread_count { 0 };
+    Vector<NonnullOwnPtr<MarkStack>> m_mark_stacks;
+    Atomic<size_t> m_idle_thread_count { 0 };
+
+    Threading::Mutex m_main_thread_work_mutex;
+    Vector<Cell*> m_main_thread_work;
+    Atomic<bool> m_has_main_thread_work { false };
+};
+
 class MarkingVisitor final : public Cell::Visitor {
 public:
     explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
         : m_heap(heap)
+        , m_live_heap_blocks(m_all_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
         m_heap.for_each_block([&](auto& block) {
@@ -379,14 +676,23 @@ public:
         }
     }
 
+    // Helper visitors for parallel marking start out without any work.
+    MarkingVisitor(Heap& heap, MarkingVisitor const& main_visitor)
+        : m_heap(heap)
+        , m_live_heap_blocks(main_visitor.m_live_heap_blocks)
+        , m_min_block_address(main_visitor.m_min_block_address)
+        , m_max_block_address(main_visitor.m_max_block_address)
+        , m_is_helper_visitor(true)
+    {
+    }
+
     virtual void visit_impl(Cell& cell) override
     {
         if (cell.is_marked())
             return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
-        cell.set_marked(true);
-        m_work_queue.append(cell);
+        mark(cell);
     }
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
@@ -397,13 +703,12 @@ public:
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
             add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        for_each_cell_among_possible_pointers(m_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
             if (cell->is_marked())
                 return;
             if (cell->state() != Cell::State::Live)
                 return;
-            cell->set_marked(true);
-            m_work_queue.append(*cell);
+            mark(*cell);
         });
     }
 
@@ -414,21 +719,173 @@ public:
         }
     }
 
+    // Returns true once there is no more marking work left.
+    bool mark_live_cells_until(MonotonicTime deadline)
+    {
+        static constexpr size_t cells_between_deadline_checks = 64;
+        while (!m_work_queue.is_empty()) {
+            for (size_t i = 0; i < cells_between_deadline_checks && !m_work_queue.is_empty(); ++i)
+                m_work_queue.take_last()->visit_edges(*this);
+            if (MonotonicTime::now() >= deadline)
+                break;
+        }
+        return m_work_queue.is_empty();
+    }
+
+    void mark_all_live_cells_in_parallel(ParallelMarkingContext& context, size_t thread_index)
+    {
+        m_parallel_marking_context = &context;
+        m_mark_stack = &context.mark_stack(thread_index);
+
+        // Whatever the main thread found before marking started becomes work that other threads can steal.
+        if (!m_is_helper_visitor) {
+            auto work_queue = move(m_work_queue);
+            for (auto& cell : work_queue)
+                push(cell);
+        }
+
+        do {
+            while (true) {
+                if (!m_work_queue.is_empty()) {
+                    m_work_queue.take_last()->visit_edges(*this);
+                } else if (auto* cell = m_mark_stack->pop()) {
+                    cell->visit_edges(*this);
+                } else if (!m_is_helper_visitor && context.has_main_thread_work()) {
+                    for (auto* deferred_cell : context.take_main_thread_work())
+                        deferred_cell->visit_edges(*this);
+                } else if (auto* stolen_cell = context.steal(thread_index)) {
+                    stolen_cell->visit_edges(*this);
+                } else {
+                    break;
+                }
+            }
+            if (!m_deferred_cells.is_empty())
+                context.defer_to_main_thread(m_deferred_cells);
+        } while (context.wait_for_work(!m_is_helper_visitor));
+
+        m_mark_stack = nullptr;
+        m_parallel_marking_context = nullptr;
+    }
+
+    size_t marked_cell_bytes() const { return m_marked_cell_bytes; }
+    void did_mark_cell_bytes_on_another_thread(size_t bytes) { m_marked_cell_bytes += bytes; }
+
 private:
+    void mark(Cell& cell)
+    {
+        if (m_parallel_marking_context) {
+            // Another marking thread may have gotten to this cell first.
+            if (cell.test_and_set_marked())
+                return;
+        } else {
+            cell.set_marked(true);
+        }
+        m_marked_cell_bytes += HeapBlock::from_cell(&cell)->cell_size();
+        if (m_mark_stack)
+            push(cell);
+        else
+            m_work_queue.append(cell);
+    }
+
+    // Only cells that can be traced on any thread go on the mark stack, where other threads can steal them. The rest are
+    // kept to ourselves on the main thread, or handed over to it in batches from helper threads.
+    void push(Cell& cell)
+    {
+        static constexpr size_t deferred_cells_per_batch = 64;
+
+        if (cell.has_thread_safe_visit_edges()) {
+            m_mark_stack->push(cell);
+        } else if (!m_is_helper_visitor) {
+            m_work_queue.append(cell);
+        } else {
+            m_deferred_cells.append(&cell);
+            if (m_deferred_cells.size() >= deferred_cells_per_batch)
+                m_parallel_marking_context->defer_to_main_thread(m_deferred_cells);
+        }
+    }
+
     Heap& m_heap;
     Vector<Ref<Cell>> m_work_queue;
+    size_t m_marked_cell_bytes { 0 };
     HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
+    ParallelMarkingContext* m_parallel_marking_context { nullptr };
+    MarkStack* m_mark_stack { nullptr };
+    Vector<Cell*> m_deferred_cells;
+    bool m_is_helper_visitor { false };
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 {
-    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
+    VERIFY(!m_collecting_garbage);
+
+    {
+        TemporaryChange change(m_collecting_garbage, true);
+
+        auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+        if (collection_type != CollectionType::CollectEverything) {
+            if (m_gc_deferrals) {
+                m_should_gc_when_deferral_ends = true;
+                return;
+            }
+        }
 
-    MarkingVisitor visitor(*this, roots);
+        // Blocks left over from the previous collection still have survivors marked, so we have to finish
+        // sweeping them before marking can start.
+        finish_lazy_sweeping();
 
-    visitor.mark_all_live_cells();
+        // Any collection during incremental marking finishes the current cycle, unless the heap is going away.
+        if (m_incremental_marking_in_progress && collection_type == CollectionType::CollectEverything)
+            cancel_incremental_marking();
+
+        if (m_incremental_marking_in_progress) {
+            // This is the final pause of incremental marking. The roots may have changed since marking started,
+            // so we have to visit them again before we can finish marking.
+            HashMap<Cell*, HeapRoot> roots;
+            gather_roots(roots);
+            auto visitor = m_incremental_marking_visitor.release_nonnull();
+            m_incremental_marking_in_progress = false;
+            --g_incrementally_marking_heap_count;
+            for (auto* root : roots.keys())
+                visitor->visit(root);
+            for (auto const* pointer : m_stores_from_other_threads->did_stop_marking()) {
+                if (auto* cell = live_cell_containing(pointer))
+                    visitor->visit(cell);
+            }
+            mark_live_cells(*visitor);
+        } else if (collection_type != CollectionType::CollectEverything) {
+            HashMap<Cell*, HeapRoot> roots;
+            gather_roots(roots);
+            MarkingVisitor visitor(*this, roots);
+            mark_live_cells(visitor);
+        }
+        // Lazy sweeping finalizes dead cells in the same pass that finds them.
+        if (!should_sweep_lazily(collection_type))
+            finalize_unmarked_cells();
+        sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
+    }
+
+    auto tasks = move(m_post_gc_tasks);
+    for (auto& task : tasks)
+        task();
+}
+
+Heap::~Heap()
+{
+    collect_garbage(CollectionType::CollectEverything);
+}
+
+void Heap::mark_live_cells(MarkingVisitor& visitor)
+{
+    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
+
+    if (m_collector_thread_count > 1)
+        mark_live_cells_in_parallel(visitor);
+    else
+        visitor.mark_all_live_cells();
 
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
@@ -444,6 +901,38 @@ void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
     m_uprooted_cells.clear();
 }
 
+void Heap::mark_live_cells_in_parallel(MarkingVisitor& main_visitor)
+{
+    ParallelMarkingContext context(m_collector_thread_count);
+
+    Vector<NonnullOwnPtr<MarkingVisitor>> helper_visitors;
+    for (size_t i = 1; i < m_collector_thread_count; ++i)
+        helper_visitors.append(make<MarkingVisitor>(*this, main_visitor));
+
+    m_collector_thread_pool->run([&](size_t thread_index) {
+        auto& visitor = thread_index == 0 ? main_visitor : *helper_visitors[thread_index - 1];
+        visitor.mark_all_live_cells_in_parallel(context, thread_index);
+    });
+
+    for (auto& helper_visitor : helper_visitors)
+        main_visitor.did_mark_cell_bytes_on_another_thread(helper_visitor->marked_cell_bytes());
+}
+
+void Heap::set_collector_thread_count(size_t count)
+{
+    VERIFY(!m_collecting_garbage);
+
+    m_collector_thread_pool = nullptr;
+    m_collector_thread_count = 1;
+    if (count <= 1)
+        return;
+
+    auto pool = make<CollectorThreadPool>(count - 1);
+    m_collector_thread_count = pool->thread_count();
+    if (m_collector_thread_count > 1)
+        m_collector_thread_pool = move(pool);
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -451,6 +940,16 @@ bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
     return cell.must_survive_garbage_collection();
 }
 
+void Heap::unmark_all_cells()
+{
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
 void Heap::finalize_unmarked_cells()
 {
     for_each_block([&](auto& block) {
@@ -462,7 +961,7 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
@@ -473,28 +972,101 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
 
-    for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked()) {
+    if (should_sweep_lazily(collection_type)) {
+        // Dead cells are finalized and flagged right away, so that weak containers and the conservative scan stop
+        // seeing them. Destroying them and rebuilding the freelists is left to CellAllocator::allocate_cell(), idle
+        // time, or the start of the next collection.
+        Vector<HeapBlock*, 32> blocks_to_sweep;
+        for_each_block([&](auto& block) {
+            size_t finalized_cells_in_block = 0;
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                if (cell->is_marked()) {
+                    ++live_cells;
+                    live_cell_bytes += block.cell_size();
+                    return;
+                }
+                cell->finalize();
+                cell->set_state(Cell::State::Finalized);
+                ++finalized_cells_in_block;
+            });
+            collected_cells += finalized_cells_in_block;
+            collected_cell_bytes += finalized_cells_in_block * block.cell_size();
+            // Survivors are unmarked by the sweep, so every block needs one.
+            blocks_to_sweep.append(&block);
+            return IterationDecision::Continue;
+        });
+        for (auto* block : blocks_to_sweep)
+            block->cell_allocator().block_needs_sweeping({}, *block);
+        m_unswept_block_count += blocks_to_sweep.size();
+    } else if (m_collector_thread_count > 1) {
+        // Finding the dead cells and unmarking the survivors happens in parallel. Destroying dead cells runs
+        // arbitrary destructors, so that part still happens on this thread.
+        struct BlockSweepResult {
+            HeapBlock* block { nullptr };
+            Vector<Cell*> dead_cells;
+            size_t live_cell_count { 0 };
+        };
+        Vector<BlockSweepResult> results;
+        for_each_block([&](auto& block) {
+            results.append({ .block = &block });
+            return IterationDecision::Continue;
+        });
+
+        auto thread_count = m_collector_thread_count;
+        m_collector_thread_pool->run([&results, thread_count](size_t thread_index) {
+            for (size_t i = thread_index; i < results.size(); i += thread_count) {
+                auto& result = results[i];
+                result.block->for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                    if (!cell->is_marked()) {
+                        result.dead_cells.append(cell);
+                        return;
+                    }
+                    cell->set_marked(false);
+                    ++result.live_cell_count;
+                });
+            }
+        });
+
+        for (auto& result : results) {
+            auto& block = *result.block;
+            bool block_was_full = block.is_full();
+            for (auto* cell : result.dead_cells) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
                 block.deallocate(cell);
-                ++collected_cells;
-                collected_cell_bytes += block.cell_size();
-            } else {
-                cell->set_marked(false);
-                block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
             }
+            collected_cells += result.dead_cells.size();
+            collected_cell_bytes += result.dead_cells.size() * block.cell_size();
+            live_cells += result.live_cell_count;
+            live_cell_bytes += result.live_cell_count * block.cell_size();
+            if (result.live_cell_count == 0)
+                empty_blocks.append(&block);
+            else if (block_was_full != block.is_full())
+                full_blocks_that_became_usable.append(&block);
+        }
+    } else {
+        for_each_block([&](auto& block) {
+            bool block_has_live_cells = false;
+            bool block_was_full = block.is_full();
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                if (!cell->is_marked()) {
+                    dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                    block.deallocate(cell);
+                    ++collected_cells;
+                    collected_cell_bytes += block.cell_size();
+                } else {
+                    cell->set_marked(false);
+                    block_has_live_cells = true;
+                    ++live_cells;
+                    live_cell_bytes += block.cell_size();
+                }
+            });
+            if (!block_has_live_cells)
+                empty_blocks.append(&block);
+            else if (block_was_full != block.is_full())
+                full_blocks_that_became_usable.append(&block);
+            return IterationDecision::Continue;
         });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
-        return IterationDecision::Continue;
-    });
+    }
 
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
@@ -518,8 +1090,10 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
     m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
 
+    AK::Duration const time_spent = measurement_timer.elapsed_time();
+    m_collection_statistics.record(time_spent);
+
     if (print_report) {
-        AK::Duration const time_spent = measurement_timer.elapsed_time();
         size_t live_block_count = 0;
         for_each_block([&](auto&) {
             ++live_block_count;
@@ -533,10 +1107,129 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln(" Unswept blocks: {} ({} bytes swept lazily since the last report)", m_unswept_block_count, exchange(m_lazily_swept_bytes, 0));
+        dbgln("    Collections: {} (total {} us, max {} us)", m_collection_statistics.pause_count, m_collection_statistics.total_time.to_microseconds(), m_collection_statistics.max_time.to_microseconds());
+        dbgln("  Marking steps: {} (total {} us, max {} us)", m_incremental_marking_step_statistics.pause_count, m_incremental_marking_step_statistics.total_time.to_microseconds(), m_incremental_marking_step_statistics.max_time.to_microseconds());
+        auto const& scan = m_last_conservative_scan_statistics;
+        dbgln("   Stack words: {} scanned, {} skipped as precise", scan.scanned_words, scan.skipped_words);
+        dbgln("    Candidates: {} in heap range, {} matched a live cell", scan.candidate_pointers, scan.matched_cells);
         dbgln("=============================================");
     }
 }
 
+bool Heap::should_sweep_lazily(CollectionType collection_type) const
+{
+    // The heap is going away, so everything has to be destroyed now.
+    if (collection_type == CollectionType::CollectEverything)
+        return false;
+    return m_lazy_sweeping_enabled;
+}
+
+void Heap::finish_lazy_sweeping()
+{
+    if (m_unswept_block_count == 0)
+        return;
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.has_unswept_blocks())
+            allocator.sweep_next_unswept_block({});
+    }
+    VERIFY(m_unswept_block_count == 0);
+}
+
+void Heap::perform_lazy_sweeping_step()
+{
+    if (m_unswept_block_count == 0 || m_collecting_garbage)
+        return;
+
+    auto deadline = MonotonicTime::now() + AK::Duration::from_milliseconds(GC_LAZY_SWEEPING_STEP_MILLISECONDS);
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.has_unswept_blocks()) {
+            allocator.sweep_next_unswept_block({});
+            if (MonotonicTime::now() >= deadline)
+                return;
+        }
+    }
+}
+
+void Heap::did_sweep_block_lazily(Badge<CellAllocator>, size_t swept_bytes)
+{
+    VERIFY(m_unswept_block_count > 0);
+    --m_unswept_block_count;
+    m_lazily_swept_bytes += swept_bytes;
+}
+
+void Heap::PauseStatistics::record(AK::Duration time_spent)
+{
+    ++pause_count;
+    total_time += time_spent;
+    max_time = max(max_time, time_spent);
+}
+
+void Heap::start_incremental_marking()
+{
+    VERIFY(!m_incremental_marking_in_progress);
+    VERIFY(!m_collecting_garbage);
+
+    if (m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    TemporaryChange change(m_collecting_garbage, true);
+    auto step_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+    finish_lazy_sweeping();
+
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    m_incremental_marking_visitor = make<MarkingVisitor>(*this, roots);
+    m_incremental_marking_in_progress = true;
+    m_allocated_bytes_since_last_marking_step = 0;
+
+    // From here on, every store of a pointer to an unmarked cell has to shade that cell.
+    ++g_incrementally_marking_heap_count;
+    m_stores_from_other_threads->did_start_marking();
+
+    m_incremental_marking_step_statistics.record(step_timer.elapsed_time());
+}
+
+void Heap::cancel_incremental_marking()
+{
+    VERIFY(m_incremental_marking_in_progress);
+    m_incremental_marking_visitor = nullptr;
+    m_incremental_marking_in_progress = false;
+    --g_incrementally_marking_heap_count;
+    (void)m_stores_from_other_threads->did_stop_marking();
+    unmark_all_cells();
+}
+
+void Heap::perform_incremental_marking_step()
+{
+    if (!m_incremental_marking_in_progress || m_collecting_garbage)
+        return;
+
+    bool marking_is_done = false;
+    {
+        TemporaryChange change(m_collecting_garbage, true);
+        auto step_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        for (auto const* pointer : m_stores_from_other_threads->take()) {
+            if (auto* cell = live_cell_containing(pointer))
+                m_incremental_marking_visitor->visit(cell);
+        }
+        marking_is_done = m_incremental_marking_visitor->mark_live_cells_until(MonotonicTime::now() + m_incremental_marking_time_budget);
+        m_incremental_marking_step_statistics.record(step_timer.elapsed_time());
+    }
+
+    if (marking_is_done)
+        collect_garbage();
+}
+
+void Heap::did_allocate_cell_during_incremental_marking(Cell& cell)
+{
+    // New cells are allocated gray, so they survive this cycle and have their edges traced.
+    m_incremental_marking_visitor->visit(cell);
+}
+
 void Heap::defer_gc()
 {
     ++m_gc_deferrals;
@@ -559,4 +1252,25 @@ void Heap::uproot_cell(Cell* cell)
     m_uprooted_cells.append(cell);
 }
 
+void Heap::did_store_pointer(void const* pointer)
+{
+    if (!m_stores_from_other_threads->is_on_heap_thread()) {
+        m_stores_from_other_threads->append(pointer);
+        return;
+    }
+
+    if (!m_incremental_marking_in_progress || m_collecting_garbage)
+        return;
+
+    // Shade the cell so that no marked cell ever points to an unmarked cell that is not queued for marking.
+    auto* cell = live_cell_containing(pointer);
+    if (cell && !cell->is_marked())
+        m_incremental_marking_visitor->visit(*cell);
+}
+
+void write_barrier_slow_path(void const* cell)
+{
+    HeapBlockBase::from_cell(reinterpret_cast<Cell const*>(cell))->heap().did_store_pointer(cell);
+}
+
 }
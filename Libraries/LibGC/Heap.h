@@ -6,13 +6,17 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/Function.h>
+#include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/Swift.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -29,6 +33,10 @@
 
 namespace GC {
 
+class CollectorThreadPool;
+class MarkingVisitor;
+class StoresFromOtherThreads;
+
 class GC_API Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -43,6 +51,12 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
+        if constexpr (requires { typename T::ClassWithThreadSafeVisitEdges; }) {
+            if constexpr (IsSame<T, typename T::ClassWithThreadSafeVisitEdges>)
+                memory->set_has_thread_safe_visit_edges({});
+        }
+        if (m_incremental_marking_in_progress) [[unlikely]]
+            did_allocate_cell_during_incremental_marking(*memory);
         undefer_gc();
         return *static_cast<T*>(memory);
     }
@@ -58,6 +72,56 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // With a non-zero time budget, collections start with incremental marking. Marking work is then done in steps
+    // of at most the given duration, from allocations and from perform_incremental_marking_step(). The final pause
+    // rescans the roots, finishes marking and sweeps. Cells stored while marking is in progress are shaded by the write
+    // barrier (see write_barrier()).
+    AK::Duration incremental_marking_time_budget() const { return m_incremental_marking_time_budget; }
+    void set_incremental_marking_time_budget(AK::Duration budget) { m_incremental_marking_time_budget = budget; }
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_in_progress; }
+    void perform_incremental_marking_step();
+
+    // With lazy sweeping, a collection only finalizes dead cells. Their blocks are swept (dead cells destroyed and
+    // put back on the freelist) when an allocator runs out of usable blocks, from perform_lazy_sweeping_step(), or
+    // at the start of the next collection.
+    bool is_lazy_sweeping_enabled() const { return m_lazy_sweeping_enabled; }
+    void set_lazy_sweeping_enabled(bool b) { m_lazy_sweeping_enabled = b; }
+    bool has_unswept_blocks() const { return m_unswept_block_count > 0; }
+    void perform_lazy_sweeping_step();
+
+    // A range of the native stack in which the embedder reports every cell pointer itself, through the roots it gathers.
+    struct PreciseStackRange {
+        FlatPtr base { 0 };
+        FlatPtr end { 0 };
+    };
+    // With precise stack scanning enabled, the conservative scan skips the stack ranges reported by the given callback.
+    bool is_precise_stack_scanning_enabled() const { return m_precise_stack_scanning_enabled; }
+    void set_precise_stack_scanning_enabled(bool b) { m_precise_stack_scanning_enabled = b; }
+    void set_gather_precise_stack_ranges(AK::Function<void(Vector<PreciseStackRange>&)> callback) { m_gather_precise_stack_ranges = move(callback); }
+
+    struct ConservativeScanStatistics {
+        size_t scanned_words { 0 };
+        size_t skipped_words { 0 };
+        size_t candidate_pointers { 0 };
+        size_t matched_cells { 0 };
+    };
+    ConservativeScanStatistics const& last_conservative_scan_statistics() const { return m_last_conservative_scan_statistics; }
+
+    // Number of threads that mark and sweep during a collection, including the main thread. Helper threads are kept
+    // around between collections, and only trace cells that opt in with GC_DECLARE_THREAD_SAFE_VISIT_EDGES.
+    size_t collector_thread_count() const { return m_collector_thread_count; }
+    void set_collector_thread_count(size_t);
+
+    struct PauseStatistics {
+        size_t pause_count { 0 };
+        AK::Duration total_time;
+        AK::Duration max_time;
+
+        void record(AK::Duration);
+    };
+    PauseStatistics const& collection_statistics() const { return m_collection_statistics; }
+    PauseStatistics const& incremental_marking_step_statistics() const { return m_incremental_marking_step_statistics; }
+
     void did_create_root(Badge<RootImpl>, RootImpl&);
     void did_destroy_root(Badge<RootImpl>, RootImpl&);
 
@@ -75,6 +139,8 @@ public:
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
 
+    void did_sweep_block_lazily(Badge<CellAllocator>, size_t swept_bytes);
+
     void uproot_cell(Cell* cell);
 
     bool is_gc_deferred() const { return m_gc_deferrals > 0; }
@@ -86,6 +152,7 @@ private:
     friend class GraphConstructorVisitor;
     friend class DeferGC;
     friend class ForeignCell;
+    friend void write_barrier_slow_path(void const*);
 
     void defer_gc();
     void undefer_gc();
@@ -97,32 +164,72 @@ private:
     {
         will_allocate(sizeof(T));
         if constexpr (requires { T::cell_allocator.allocator.get().allocate_cell(*this); }) {
-            if constexpr (IsSame<T, typename decltype(T::cell_allocator)::CellType>) {
+            if constexpr (IsSame<T, typename decltype(T::cell_allocator)::CellType>)
                 return T::cell_allocator.allocator.get().allocate_cell(*this);
-            }
+            else
+                return allocate_cell_from_size_class<T>();
+        } else {
+            return allocate_cell_from_size_class<T>();
         }
-        return allocator_for_size(sizeof(T)).allocate_cell(*this);
+    }
+
+    // Type-isolated cells (see GC_DECLARE_ALLOCATOR) have allocators of their own, so only the others are limited by the
+    // largest size class.
+    template<typename T>
+    Cell* allocate_cell_from_size_class()
+    {
+        static_assert(sizeof(T) <= GC_SIZE_CLASSES.last(), "Cell type is too large for the size-based cell allocators");
+        constexpr auto size_class = size_class_for_size(sizeof(T));
+        return m_size_based_cell_allocators[size_class]->allocate_cell(*this);
     }
 
     void will_allocate(size_t);
 
+    void did_store_pointer(void const*);
+
+    void start_incremental_marking();
+    void cancel_incremental_marking();
+    void did_allocate_cell_during_incremental_marking(Cell&);
+
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells(MarkingVisitor&);
+    void mark_live_cells_in_parallel(MarkingVisitor&);
+    void unmark_all_cells();
     void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&);
+    bool should_sweep_lazily(CollectionType) const;
+    void finish_lazy_sweeping();
+
+    // Every size class is a multiple of the granularity, so looking up the rounded up size in this table gives the
+    // smallest size class that fits.
+    static constexpr size_t GC_SIZE_CLASS_GRANULARITY { 16 };
+    static constexpr Array<size_t, 7> GC_SIZE_CLASSES { 64, 96, 128, 256, 512, 1024, 3072 };
+    static constexpr auto GC_SIZE_CLASS_TABLE = [] {
+        Array<u8, GC_SIZE_CLASSES.last() / GC_SIZE_CLASS_GRANULARITY + 1> table {};
+        size_t size_class = 0;
+        for (size_t i = 0; i < table.size(); ++i) {
+            while (GC_SIZE_CLASSES[size_class] < i * GC_SIZE_CLASS_GRANULARITY)
+                ++size_class;
+            table[i] = size_class;
+        }
+        return table;
+    }();
+
+    static constexpr size_t size_class_for_size(size_t cell_size)
+    {
+        return GC_SIZE_CLASS_TABLE[(cell_size + GC_SIZE_CLASS_GRANULARITY - 1) / GC_SIZE_CLASS_GRANULARITY];
+    }
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
-        // FIXME: Use binary search?
-        for (auto& allocator : m_size_based_cell_allocators) {
-            if (allocator->cell_size() >= cell_size)
-                return *allocator;
+        if (cell_size > GC_SIZE_CLASSES.last()) [[unlikely]] {
+            dbgln("Cannot get CellAllocator for cell size {}, largest available is {}!", cell_size, GC_SIZE_CLASSES.last());
+            VERIFY_NOT_REACHED();
         }
-        dbgln("Cannot get CellAllocator for cell size {}, largest available is {}!", cell_size, m_size_based_cell_allocators.last()->cell_size());
-        VERIFY_NOT_REACHED();
+        return *m_size_based_cell_allocators[size_class_for_size(cell_size)];
     }
 
     template<typename Callback>
@@ -135,11 +242,33 @@ private:
     }
 
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+    static constexpr size_t GC_INCREMENTAL_MARKING_STEP_BYTES { 256 * 1024 };
+    static constexpr i64 GC_LAZY_SWEEPING_STEP_MILLISECONDS { 1 };
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
+    size_t m_allocated_bytes_since_last_marking_step { 0 };
 
     bool m_should_collect_on_every_allocation { false };
 
+    size_t m_collector_thread_count { 1 };
+    OwnPtr<CollectorThreadPool> m_collector_thread_pool;
+
+    AK::Duration m_incremental_marking_time_budget;
+    bool m_incremental_marking_in_progress { false };
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
+    NonnullOwnPtr<StoresFromOtherThreads> m_stores_from_other_threads;
+
+    bool m_precise_stack_scanning_enabled { false };
+    AK::Function<void(Vector<PreciseStackRange>&)> m_gather_precise_stack_ranges;
+    ConservativeScanStatistics m_last_conservative_scan_statistics;
+
+    bool m_lazy_sweeping_enabled { false };
+    size_t m_unswept_block_count { 0 };
+    size_t m_lazily_swept_bytes { 0 };
+
+    PauseStatistics m_collection_statistics;
+    PauseStatistics m_incremental_marking_step_statistics;
+
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
 
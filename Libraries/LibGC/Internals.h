@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Types.h>
 #include <LibGC/Export.h>
 #include <LibGC/Forward.h>
@@ -43,6 +44,8 @@ public:
     Heap& heap() { return m_heap; }
 
 protected:
+    friend class Heap;
+
     HeapBlockBase(Heap& heap)
         : m_heap(heap)
     {
@@ -51,4 +54,20 @@ protected:
     Heap& m_heap;
 };
 
+// The number of heaps that are currently marking incrementally.
+extern GC_API Atomic<size_t> g_incrementally_marking_heap_count;
+
+GC_API void write_barrier_slow_path(void const* cell);
+
+// GC::Ptr, GC::Ref and NanBoxedValue call this whenever they're constructed or assigned with a pointer to a cell, so
+// that incremental marking can shade every cell that is stored while it is in progress. The pointer may point anywhere
+// inside the cell, since we don't need to know the cell's type to find it.
+ALWAYS_INLINE void write_barrier(void const* cell)
+{
+    if (g_incrementally_marking_heap_count.load(AK::memory_order_relaxed) == 0) [[likely]]
+        return;
+    if (cell)
+        write_barrier_slow_path(cell);
+}
+
 }
@@ -57,6 +57,21 @@ static constexpr u64 SHIFTED_IS_CELL_PATTERN = IS_CELL_PATTERN << TAG_SHIFT;
 
 class GC_API NanBoxedValue {
 public:
+    constexpr NanBoxedValue() = default;
+
+    constexpr NanBoxedValue(NanBoxedValue const& other)
+        : m_value(other.m_value)
+    {
+        did_store();
+    }
+
+    constexpr NanBoxedValue& operator=(NanBoxedValue const& other)
+    {
+        m_value = other.m_value;
+        did_store();
+        return *this;
+    }
+
     bool is_cell() const { return (m_value.tag & IS_CELL_PATTERN) == IS_CELL_PATTERN; }
 
     static constexpr FlatPtr extract_pointer_bits(u64 encoded)
@@ -105,6 +120,12 @@ public:
     }
 
 protected:
+    ALWAYS_INLINE constexpr void did_store() const
+    {
+        if (!is_constant_evaluated() && is_cell())
+            write_barrier(reinterpret_cast<void const*>(extract_pointer_bits(m_value.encoded)));
+    }
+
     union {
         double as_double;
         struct {
@@ -9,6 +9,7 @@
 #include <AK/Format.h>
 #include <AK/Traits.h>
 #include <AK/Types.h>
+#include <LibGC/Internals.h>
 
 namespace GC {
 
@@ -23,6 +24,7 @@ public:
     Ref(T& ptr)
         : m_ptr(&ptr)
     {
+        write_barrier(m_ptr);
     }
 
     template<typename U>
@@ -30,6 +32,13 @@ public:
     requires(IsConvertible<U*, T*>)
         : m_ptr(&static_cast<T&>(ptr))
     {
+        write_barrier(m_ptr);
+    }
+
+    Ref(Ref const& other)
+        : m_ptr(other.m_ptr)
+    {
+        write_barrier(m_ptr);
     }
 
     template<typename U>
@@ -37,6 +46,14 @@ public:
     requires(IsConvertible<U*, T*>)
         : m_ptr(other.ptr())
     {
+        write_barrier(m_ptr);
+    }
+
+    Ref& operator=(Ref const& other)
+    {
+        m_ptr = other.m_ptr;
+        write_barrier(m_ptr);
+        return *this;
     }
 
     template<typename U>
@@ -44,12 +61,14 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        write_barrier(m_ptr);
         return *this;
     }
 
     Ref& operator=(T& other)
     {
         m_ptr = &other;
+        write_barrier(m_ptr);
         return *this;
     }
 
@@ -58,6 +77,7 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = &static_cast<T&>(other);
+        write_barrier(m_ptr);
         return *this;
     }
 
@@ -83,11 +103,19 @@ public:
     Ptr(T& ptr)
         : m_ptr(&ptr)
     {
+        write_barrier(m_ptr);
     }
 
     Ptr(T* ptr)
         : m_ptr(ptr)
     {
+        write_barrier(m_ptr);
+    }
+
+    Ptr(Ptr const& other)
+        : m_ptr(other.m_ptr)
+    {
+        write_barrier(m_ptr);
     }
 
     template<typename U>
@@ -95,11 +123,13 @@ public:
     requires(IsConvertible<U*, T*>)
         : m_ptr(other.ptr())
     {
+        write_barrier(m_ptr);
     }
 
     Ptr(Ref<T> const& other)
         : m_ptr(other.ptr())
     {
+        write_barrier(m_ptr);
     }
 
     template<typename U>
@@ -107,6 +137,7 @@ public:
     requires(IsConvertible<U*, T*>)
         : m_ptr(other.ptr())
     {
+        write_barrier(m_ptr);
     }
 
     Ptr(nullptr_t)
@@ -114,17 +145,26 @@ public:
     {
     }
 
+    Ptr& operator=(Ptr const& other)
+    {
+        m_ptr = other.m_ptr;
+        write_barrier(m_ptr);
+        return *this;
+    }
+
     template<typename U>
     Ptr& operator=(Ptr<U> const& other)
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        write_barrier(m_ptr);
         return *this;
     }
 
     Ptr& operator=(Ref<T> const& other)
     {
         m_ptr = other.ptr();
+        write_barrier(m_ptr);
         return *this;
     }
 
@@ -133,12 +173,14 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        write_barrier(m_ptr);
         return *this;
     }
 
     Ptr& operator=(T& other)
     {
         m_ptr = &other;
+        write_barrier(m_ptr);
         return *this;
     }
 
@@ -147,12 +189,14 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = &static_cast<T&>(other);
+        write_barrier(m_ptr);
         return *this;
     }
 
     Ptr& operator=(T* other)
     {
         m_ptr = other;
+        write_barrier(m_ptr);
         return *this;
     }
 
@@ -161,6 +205,7 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other);
+        write_barrier(m_ptr);
         return *this;
     }
 
@@ -11,6 +11,7 @@
 #include <AK/Utf8View.h>
 #include <LibGfx/Point.h>
 #include <LibGfx/TextLayout.h>
+#include <LibGfx/TextShapingCache.h>
 #include <harfbuzz/hb.h>
 
 namespace Gfx {
@@ -98,18 +99,42 @@ static hb_buffer_t* setup_text_shaping(UnicodeView const& string, Font const& fo
     return buffer;
 }
 
+struct TextForShapingCache {
+    TextShapingCache::Encoding encoding;
+    ReadonlyBytes bytes;
+};
+
 template<typename UnicodeView>
-NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, UnicodeView const& string, Font const& font, GlyphRun::TextType text_type, ShapeFeatures const& features)
+static TextForShapingCache text_for_shaping_cache(UnicodeView const& string)
 {
+    if constexpr (IsSame<UnicodeView, Utf8View>) {
+        return { TextShapingCache::Encoding::Utf8, { string.bytes(), string.byte_length() } };
+    } else if constexpr (IsSame<UnicodeView, Utf16View>) {
+        // ASCII storage is shaped as UTF-8 (see setup_text_shaping), so it shares its cache entries with UTF-8 text.
+        if (string.has_ascii_storage())
+            return { TextShapingCache::Encoding::Utf8, string.bytes() };
+        return { TextShapingCache::Encoding::Utf16, to_readonly_bytes(string.utf16_span()) };
+    } else {
+        static_assert(DependentFalse<UnicodeView>);
+    }
+}
+
+template<typename UnicodeView>
+static NonnullRefPtr<ShapedText const> shape(UnicodeView const& string, Font const& font, ShapeFeatures const& features)
+{
+    auto& cache = TextShapingCache::the();
+    auto [encoding, text] = text_for_shaping_cache(string);
+    if (auto shaped_text = cache.find(font, features, encoding, text))
+        return shaped_text.release_nonnull();
+
     auto* buffer = setup_text_shaping(string, font, features);
 
     u32 glyph_count;
     auto const* glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
     auto const* positions = hb_buffer_get_glyph_positions(buffer, &glyph_count);
 
-    Vector<DrawGlyph> glyph_run;
-    glyph_run.ensure_capacity(glyph_count);
-    FloatPoint point = baseline_start;
+    Vector<ShapedGlyph> glyphs;
+    glyphs.ensure_capacity(glyph_count);
 
     // We track the code unit length rather than just the code unit offset because LibWeb may later collapse glyph runs.
     // Updating the offset of each glyph gets tricky when handling text direction (LTR/RTL). So rather than doing that,
@@ -129,18 +154,43 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
     };
 
     for (size_t i = 0; i < glyph_count; ++i) {
+        glyphs.unchecked_append({
+            .glyph_id = glyph_info[i].codepoint,
+            .length_in_code_units = static_cast<u32>(glyph_length_in_code_units(i)),
+            .x_offset = positions[i].x_offset,
+            .y_offset = positions[i].y_offset,
+            .x_advance = positions[i].x_advance,
+            .y_advance = positions[i].y_advance,
+        });
+    }
+
+    auto shaped_text = adopt_ref(*new ShapedText(move(glyphs)));
+    cache.insert(font, features, encoding, text, shaped_text);
+    return shaped_text;
+}
+
+template<typename UnicodeView>
+NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, UnicodeView const& string, Font const& font, GlyphRun::TextType text_type, ShapeFeatures const& features)
+{
+    auto shaped_text = shape(string, font, features);
+
+    Vector<DrawGlyph> glyph_run;
+    glyph_run.ensure_capacity(shaped_text->glyphs().size());
+    FloatPoint point = baseline_start;
+
+    for (auto const& glyph : shaped_text->glyphs()) {
         auto position = point
             - FloatPoint { 0, font.pixel_metrics().ascent }
-            + FloatPoint { positions[i].x_offset, positions[i].y_offset } / text_shaping_resolution;
+            + FloatPoint { glyph.x_offset, glyph.y_offset } / text_shaping_resolution;
 
         glyph_run.unchecked_append({
             .position = position,
-            .length_in_code_units = glyph_length_in_code_units(i),
-            .glyph_width = positions[i].x_advance / text_shaping_resolution,
-            .glyph_id = glyph_info[i].codepoint,
+            .length_in_code_units = glyph.length_in_code_units,
+            .glyph_width = glyph.x_advance / text_shaping_resolution,
+            .glyph_id = glyph.glyph_id,
         });
 
-        point += FloatPoint { positions[i].x_advance, positions[i].y_advance } / text_shaping_resolution;
+        point += FloatPoint { glyph.x_advance, glyph.y_advance } / text_shaping_resolution;
 
         // NOTE: The spec says that we "really should not" apply letter-spacing to the trailing edge of a line but
         //       other browsers do so we will as well. https://drafts.csswg.org/css-text/#example-7880704e
@@ -156,14 +206,11 @@ template NonnullRefPtr<GlyphRun> shape_text(FloatPoint, float, Utf16View const&,
 template<typename UnicodeView>
 float measure_text_width(UnicodeView const& string, Font const& font, ShapeFeatures const& features)
 {
-    auto* buffer = setup_text_shaping(string, font, features);
-
-    u32 glyph_count;
-    auto const* positions = hb_buffer_get_glyph_positions(buffer, &glyph_count);
+    auto shaped_text = shape(string, font, features);
 
     hb_position_t point_x = 0;
-    for (size_t i = 0; i < glyph_count; ++i)
-        point_x += positions[i].x_advance;
+    for (auto const& glyph : shaped_text->glyphs())
+        point_x += glyph.x_advance;
 
     return point_x / text_shaping_resolution;
 }
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/HashFunctions.h>
+#include <AK/StringHash.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/TextShapingCache.h>
+
+namespace Gfx {
+
+TextShapingCache& TextShapingCache::the()
+{
+    static thread_local TextShapingCache s_the;
+    return s_the;
+}
+
+unsigned TextShapingCache::hash(Font const& font, ShapeFeatures const& features, Encoding encoding, ReadonlyBytes text)
+{
+    auto hash = pair_int_hash(ptr_hash(&font.typeface()), bit_cast<u32>(font.point_size()));
+    for (auto const& feature : features) {
+        hash = pair_int_hash(hash, string_hash(feature.tag, sizeof(feature.tag)));
+        hash = pair_int_hash(hash, feature.value);
+    }
+    hash = pair_int_hash(hash, to_underlying(encoding));
+    return pair_int_hash(hash, string_hash(reinterpret_cast<char const*>(text.data()), text.size()));
+}
+
+TextShapingCache::Entry::Entry(Font const& font, ShapeFeatures const& features, Encoding encoding, ByteBuffer text, unsigned hash, NonnullRefPtr<ShapedText const> shaped_text)
+    : typeface(font.typeface())
+    , point_size(font.point_size())
+    , features(features)
+    , encoding(encoding)
+    , text(move(text))
+    , hash(hash)
+    , shaped_text(move(shaped_text))
+{
+}
+
+bool TextShapingCache::Entry::matches(Font const& font, ShapeFeatures const& other_features, Encoding other_encoding, ReadonlyBytes other_text) const
+{
+    if (typeface.ptr() != &font.typeface() || point_size != font.point_size() || encoding != other_encoding)
+        return false;
+    if (text.bytes() != other_text)
+        return false;
+
+    if (features.size() != other_features.size())
+        return false;
+    for (size_t i = 0; i < features.size(); ++i) {
+        if (__builtin_memcmp(features[i].tag, other_features[i].tag, sizeof(features[i].tag)) != 0 || features[i].value != other_features[i].value)
+            return false;
+    }
+
+    return true;
+}
+
+RefPtr<ShapedText const> TextShapingCache::find(Font const& font, ShapeFeatures const& features, Encoding encoding, ReadonlyBytes text)
+{
+    if (text.size() > MAX_TEXT_SIZE_IN_BYTES)
+        return {};
+
+    auto it = m_entries.find(hash(font, features, encoding, text), [&](auto const& entry) {
+        return entry->matches(font, features, encoding, text);
+    });
+    if (it == m_entries.end()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    ++m_statistics.hits;
+
+    auto& entry = **it;
+    m_recently_used.prepend(entry);
+    return entry.shaped_text;
+}
+
+void TextShapingCache::insert(Font const& font, ShapeFeatures const& features, Encoding encoding, ReadonlyBytes text, NonnullRefPtr<ShapedText const> shaped_text)
+{
+    if (text.size() > MAX_TEXT_SIZE_IN_BYTES)
+        return;
+
+    if (m_entries.size() >= CAPACITY)
+        evict_least_recently_used();
+
+    auto entry = make<Entry>(font, features, encoding, MUST(ByteBuffer::copy(text)), hash(font, features, encoding, text), move(shaped_text));
+
+    m_recently_used.prepend(*entry);
+    m_entries.set(move(entry));
+}
+
+void TextShapingCache::evict_least_recently_used()
+{
+    auto* entry = m_recently_used.last();
+    VERIFY(entry);
+
+    auto it = m_entries.find(entry->hash, [&](auto const& candidate) { return candidate.ptr() == entry; });
+    VERIFY(it != m_entries.end());
+
+    m_recently_used.remove(*entry);
+    m_entries.remove(it);
+    ++m_statistics.evictions;
+}
+
+void TextShapingCache::clear()
+{
+    m_recently_used.clear();
+    m_entries.clear();
+}
+
+}
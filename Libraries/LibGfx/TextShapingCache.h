@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashTable.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/Vector.h>
+#include <LibGfx/Font/Typeface.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/TextLayout.h>
+
+namespace Gfx {
+
+// A glyph as HarfBuzz shaped it, before it is placed on a baseline. Offsets and advances are in units of
+// 1/text_shaping_resolution pixels.
+struct ShapedGlyph {
+    u32 glyph_id { 0 };
+    u32 length_in_code_units { 0 };
+    i32 x_offset { 0 };
+    i32 y_offset { 0 };
+    i32 x_advance { 0 };
+    i32 y_advance { 0 };
+};
+
+class ShapedText : public RefCounted<ShapedText> {
+public:
+    explicit ShapedText(Vector<ShapedGlyph>&& glyphs)
+        : m_glyphs(move(glyphs))
+    {
+    }
+
+    [[nodiscard]] Vector<ShapedGlyph> const& glyphs() const { return m_glyphs; }
+
+private:
+    Vector<ShapedGlyph> m_glyphs;
+};
+
+// A bounded cache of shaped text that is shared by everything on a thread that lays out or measures text. Shaping only
+// depends on the typeface, its size, the font features and the text itself, so a word that appears many times is shaped
+// once, no matter where it is drawn or how much letter spacing is applied to it. The least recently used text is evicted
+// first.
+//
+// Text is measured off the main thread too (e.g. by style workers calling Font::width()), and every lookup reorders the
+// LRU list. ShapedText isn't atomically reference counted either, so each thread gets its own cache instead of sharing
+// one behind a lock.
+class TextShapingCache {
+public:
+    static constexpr size_t CAPACITY = 4096;
+
+    // Longer texts are unlikely to be shaped again, and would push many words out of the cache. Layout shapes one word at
+    // a time, so in practice this only skips long canvas text and scripts that don't separate their words with spaces.
+    static constexpr size_t MAX_TEXT_SIZE_IN_BYTES = 128;
+
+    // HarfBuzz reports clusters in UTF-8 bytes or in UTF-16 code units, so the same text shapes differently in each.
+    enum class Encoding : u8 {
+        Utf8,
+        Utf16,
+    };
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+    };
+
+    // Returns the cache for the calling thread.
+    static TextShapingCache& the();
+
+    RefPtr<ShapedText const> find(Font const&, ShapeFeatures const&, Encoding, ReadonlyBytes text);
+    void insert(Font const&, ShapeFeatures const&, Encoding, ReadonlyBytes text, NonnullRefPtr<ShapedText const>);
+    void clear();
+
+    [[nodiscard]] Statistics const& statistics() const { return m_statistics; }
+    [[nodiscard]] size_t size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        Entry(Font const&, ShapeFeatures const&, Encoding, ByteBuffer text, unsigned hash, NonnullRefPtr<ShapedText const>);
+
+        NonnullRefPtr<Typeface const> typeface;
+        float point_size { 0 };
+        ShapeFeatures features;
+        Encoding encoding { Encoding::Utf8 };
+        ByteBuffer text;
+        unsigned hash { 0 };
+
+        NonnullRefPtr<ShapedText const> shaped_text;
+        IntrusiveListNode<Entry> list_node;
+
+        bool matches(Font const&, ShapeFeatures const&, Encoding, ReadonlyBytes text) const;
+    };
+
+    struct EntryTraits : public DefaultTraits<NonnullOwnPtr<Entry>> {
+        static unsigned hash(NonnullOwnPtr<Entry> const& entry) { return entry->hash; }
+        static bool equals(NonnullOwnPtr<Entry> const& a, NonnullOwnPtr<Entry> const& b) { return a.ptr() == b.ptr(); }
+    };
+
+    static unsigned hash(Font const&, ShapeFeatures const&, Encoding, ReadonlyBytes text);
+
+    void evict_least_recently_used();
+
+    HashTable<NonnullOwnPtr<Entry>, EntryTraits> m_entries;
+
+    // Ordered from the most recently to the least recently used entry.
+    IntrusiveList<&Entry::list_node> m_recently_used;
+
+    Statistics m_statistics;
+};
+
+}
@@ -10,8 +10,10 @@
 #include <AK/Utf16String.h>
 #include <LibCore/AnonymousBuffer.h>
 #include <LibCore/DateTime.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/File.h>
 #include <LibURL/Parser.h>
@@ -24,11 +26,31 @@ ErrorOr<size_t> Decoder::decode_size()
     return static_cast<size_t>(TRY(decode<u32>()));
 }
 
+ErrorOr<NonnullOwnPtr<Stream>> Decoder::map_shared_memory(size_t size)
+{
+    auto file = TRY(decode<IPC::File>());
+
+#if !defined(AK_OS_WINDOWS)
+    // A peer that could still resize or write to the buffer could fault us or change the payload while we decode it.
+    TRY(Core::System::verify_anon_fd_is_sealed_against_writes(file.fd()));
+#endif
+    auto mapping = TRY(Core::MappedFile::map_from_fd_and_close(file.take_fd(), {}));
+
+    // The mapping ends where the peer's buffer ends, so a size that points past it must not be read.
+    if (mapping->bytes().size() < size)
+        return Error::from_string_literal("Shared memory buffer is too small");
+
+    return mapping;
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
     auto length = TRY(decoder.decode_size());
-    return String::from_stream(decoder.stream(), length);
+
+    return decoder.decode_bytes(length, [&](Stream& stream) {
+        return String::from_stream(stream, length);
+    });
 }
 
 template<>
@@ -36,20 +58,26 @@ ErrorOr<Utf16String> decode(Decoder& decoder)
 {
     auto is_ascii = TRY(decoder.decode<bool>());
     auto length_in_code_units = TRY(decoder.decode_size());
+    auto size = is_ascii ? length_in_code_units : length_in_code_units * sizeof(char16_t);
 
-    return Utf16String::from_ipc_stream(decoder.stream(), length_in_code_units, is_ascii);
+    return decoder.decode_bytes(size, [&](Stream& stream) {
+        return Utf16String::from_ipc_stream(stream, length_in_code_units, is_ascii);
+    });
 }
 
 template<>
 ErrorOr<ByteString> decode(Decoder& decoder)
 {
     auto length = TRY(decoder.decode_size());
-    if (length == 0)
-        return ByteString::empty();
 
-    return ByteString::create_and_overwrite(length, [&](Bytes bytes) -> ErrorOr<void> {
-        TRY(decoder.decode_into(bytes));
-        return {};
+    return decoder.decode_bytes(length, [&](Stream& stream) -> ErrorOr<ByteString> {
+        if (length == 0)
+            return ByteString::empty();
+
+        return ByteString::create_and_overwrite(length, [&](Bytes bytes) -> ErrorOr<void> {
+            TRY(stream.read_until_filled(bytes));
+            return {};
+        });
     });
 }
 
@@ -57,14 +85,15 @@ template<>
 ErrorOr<ByteBuffer> decode(Decoder& decoder)
 {
     auto length = TRY(decoder.decode_size());
-    if (length == 0)
-        return ByteBuffer {};
 
-    auto buffer = TRY(ByteBuffer::create_uninitialized(length));
-    auto bytes = buffer.bytes();
+    return decoder.decode_bytes(length, [&](Stream& stream) -> ErrorOr<ByteBuffer> {
+        if (length == 0)
+            return ByteBuffer {};
 
-    TRY(decoder.decode_into(bytes));
-    return buffer;
+        auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+        TRY(stream.read_until_filled(buffer.bytes()));
+        return buffer;
+    });
 }
 
 template<>
@@ -62,10 +62,29 @@ public:
 
     ErrorOr<size_t> decode_size();
 
+    // Calls the callback with a stream to read the given number of bytes from, as they were encoded by
+    // Encoder::encode_bytes(). Bytes that were sent through shared memory are mapped read-only for the callback.
+    template<typename Callback>
+    InvokeResult<Callback, Stream&> decode_bytes(size_t size, Callback callback)
+    {
+        switch (TRY(decode<PayloadStorage>())) {
+        case PayloadStorage::Inline:
+            return callback(m_stream);
+        case PayloadStorage::SharedMemory: {
+            auto stream = TRY(map_shared_memory(size));
+            return callback(*stream);
+        }
+        }
+
+        return Error::from_string_literal("Invalid payload storage");
+    }
+
     Stream& stream() { return m_stream; }
     Queue<File>& files() { return m_files; }
 
 private:
+    ErrorOr<NonnullOwnPtr<Stream>> map_shared_memory(size_t size);
+
     Stream& m_stream;
     Queue<File>& m_files;
 };
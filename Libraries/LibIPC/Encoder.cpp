@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/BitCast.h>
 #include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
@@ -27,6 +28,19 @@
 
 namespace IPC {
 
+static Atomic<u64> s_bytes_sent_inline;
+static Atomic<u64> s_bytes_sent_through_shared_memory;
+static Atomic<u64> s_shared_memory_buffers_sent;
+
+Encoder::Statistics Encoder::statistics()
+{
+    return {
+        .bytes_sent_inline = s_bytes_sent_inline.load(AK::MemoryOrder::memory_order_relaxed),
+        .bytes_sent_through_shared_memory = s_bytes_sent_through_shared_memory.load(AK::MemoryOrder::memory_order_relaxed),
+        .shared_memory_buffers_sent = s_shared_memory_buffers_sent.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
+
 ErrorOr<void> Encoder::encode_size(size_t size)
 {
     if (static_cast<u64>(size) > static_cast<u64>(NumericLimits<u32>::max()))
@@ -34,6 +48,42 @@ ErrorOr<void> Encoder::encode_size(size_t size)
     return encode(static_cast<u32>(size));
 }
 
+ErrorOr<void> Encoder::encode_bytes(ReadonlyBytes bytes)
+{
+    if (m_use_shared_memory == UseSharedMemory::No) {
+        TRY(encode(PayloadStorage::Inline));
+        return append(bytes.data(), bytes.size());
+    }
+
+    // FIXME: Anonymous buffers on Windows are not backed by file descriptors that the peer can map.
+#if !defined(AK_OS_WINDOWS)
+    if (bytes.size() >= SHARED_MEMORY_THRESHOLD) {
+        // The peer maps the buffer directly, so this is the only copy that is made before it is decoded.
+        auto buffer = TRY(Core::AnonymousBuffer::create_with_size(bytes.size()));
+        bytes.copy_to({ buffer.data<u8>(), buffer.size() });
+
+        // The peer validates the payload in place, so we must not be able to change it afterwards. The file can only
+        // be sealed against writes once our own writable mapping is gone.
+        auto file = TRY(IPC::File::clone_fd(buffer.fd()));
+        buffer = {};
+        TRY(Core::System::seal_anon_fd_against_writes(file.fd()));
+
+        TRY(encode(PayloadStorage::SharedMemory));
+        TRY(encode(file));
+
+        s_bytes_sent_through_shared_memory.fetch_add(bytes.size(), AK::MemoryOrder::memory_order_relaxed);
+        s_shared_memory_buffers_sent.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        return {};
+    }
+#endif
+
+    TRY(encode(PayloadStorage::Inline));
+    TRY(append(bytes.data(), bytes.size()));
+
+    s_bytes_sent_inline.fetch_add(bytes.size(), AK::MemoryOrder::memory_order_relaxed);
+    return {};
+}
+
 template<>
 ErrorOr<void> encode(Encoder& encoder, float const& value)
 {
@@ -56,7 +106,7 @@ template<>
 ErrorOr<void> encode(Encoder& encoder, StringView const& value)
 {
     TRY(encoder.encode_size(value.length()));
-    TRY(encoder.append(reinterpret_cast<u8 const*>(value.characters_without_null_termination()), value.length()));
+    TRY(encoder.encode_bytes(value.bytes()));
     return {};
 }
 
@@ -73,9 +123,9 @@ ErrorOr<void> encode(Encoder& encoder, Utf16View const& value)
     TRY(encoder.encode_size(value.length_in_code_units()));
 
     if (value.has_ascii_storage())
-        TRY(encoder.append(value.bytes().data(), value.length_in_code_units()));
+        TRY(encoder.encode_bytes(value.bytes()));
     else
-        TRY(encoder.append(reinterpret_cast<u8 const*>(value.utf16_span().data()), value.length_in_code_units() * sizeof(char16_t)));
+        TRY(encoder.encode_bytes(to_readonly_bytes(value.utf16_span())));
 
     return {};
 }
@@ -90,7 +140,7 @@ template<>
 ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
 {
     TRY(encoder.encode_size(value.size()));
-    TRY(encoder.append(value.data(), value.size()));
+    TRY(encoder.encode_bytes(value.bytes()));
     return {};
 }
 
@@ -30,8 +30,25 @@ ErrorOr<void> encode(Encoder&, T const&)
 
 class Encoder {
 public:
-    explicit Encoder(MessageBuffer& buffer)
+    // Messages that are sent over a transport may move large strings and buffers into shared memory, instead of copying
+    // them through the socket. Anything that only keeps the encoded bytes, and drops the file descriptors, must not.
+    enum class UseSharedMemory {
+        No,
+        Yes,
+    };
+
+    static constexpr size_t SHARED_MEMORY_THRESHOLD = 128 * KiB;
+
+    struct Statistics {
+        u64 bytes_sent_inline { 0 };
+        u64 bytes_sent_through_shared_memory { 0 };
+        u64 shared_memory_buffers_sent { 0 };
+    };
+    static Statistics statistics();
+
+    explicit Encoder(MessageBuffer& buffer, UseSharedMemory use_shared_memory = UseSharedMemory::No)
         : m_buffer(buffer)
+        , m_use_shared_memory(use_shared_memory)
     {
     }
 
@@ -58,8 +75,12 @@ public:
 
     ErrorOr<void> encode_size(size_t size);
 
+    // Encodes the storage of the given bytes, followed by the bytes themselves. Their size must be encoded beforehand.
+    ErrorOr<void> encode_bytes(ReadonlyBytes);
+
 private:
     MessageBuffer& m_buffer;
+    UseSharedMemory m_use_shared_memory { UseSharedMemory::No };
 };
 
 template<Arithmetic T>
@@ -48,6 +48,12 @@ private:
 #endif
 };
 
+// Where the bytes of a string or buffer are stored, in front of which they are encoded.
+enum class PayloadStorage : u8 {
+    Inline,
+    SharedMemory,
+};
+
 enum class ErrorCode : u32 {
     PeerDisconnected
 };
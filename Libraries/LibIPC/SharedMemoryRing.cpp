@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Platform.h>
+#include <LibCore/System.h>
+#include <LibIPC/SharedMemoryRing.h>
+
+#if defined(AK_OS_LINUX)
+#    include <sys/eventfd.h>
+#endif
+
+namespace IPC {
+
+static_assert(is_power_of_two(SharedMemoryRing::CAPACITY));
+
+struct SharedMemoryRing::SharedState {
+    // Invariant: head <= tail <= head + CAPACITY
+    // Invariant: head and tail are monotonically increasing byte positions, and only taken modulo CAPACITY to index into data.
+    AK_CACHE_ALIGNED Atomic<u64> tail { 0 };
+    AK_CACHE_ALIGNED Atomic<u64> head { 0 };
+    AK_CACHE_ALIGNED Atomic<bool> consumer_is_waiting { false };
+    AK_CACHE_ALIGNED u8 data[CAPACITY];
+};
+
+ErrorOr<NonnullRefPtr<SharedMemoryRing>> SharedMemoryRing::create()
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(sizeof(SharedState)));
+    new (buffer.data<void>()) SharedState;
+
+#if defined(AK_OS_LINUX)
+    auto doorbell = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (doorbell < 0)
+        return Error::from_errno(errno);
+    auto doorbell_fds = Array { doorbell, doorbell };
+#else
+    auto doorbell_fds = TRY(Core::System::pipe2(O_CLOEXEC | O_NONBLOCK));
+#endif
+
+    return adopt_nonnull_ref_or_enomem(new (nothrow) SharedMemoryRing(move(buffer), doorbell_fds[0], doorbell_fds[1]));
+}
+
+ErrorOr<NonnullRefPtr<SharedMemoryRing>> SharedMemoryRing::attach(File buffer_file, File doorbell)
+{
+    // Mapping a buffer that is smaller than we expect would turn every access past its end into a SIGBUS.
+    // The size check is only meaningful if the peer can't shrink the buffer after we've made it.
+    TRY(Core::System::verify_anon_fd_is_sealed(buffer_file.fd()));
+    auto buffer_stat = TRY(Core::System::fstat(buffer_file.fd()));
+    if (static_cast<size_t>(buffer_stat.st_size) < sizeof(SharedState))
+        return Error::from_string_literal("Shared memory ring is too small");
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(buffer_file.fd(), sizeof(SharedState)));
+    (void)buffer_file.take_fd();
+
+    // The consumer drains the doorbell until it would block, so make sure it can't.
+    auto doorbell_flags = TRY(Core::System::fcntl(doorbell.fd(), F_GETFL));
+    TRY(Core::System::fcntl(doorbell.fd(), F_SETFL, doorbell_flags | O_NONBLOCK));
+
+    auto ring = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) SharedMemoryRing(move(buffer), doorbell.fd(), -1)));
+    (void)doorbell.take_fd();
+
+    ring->m_position = ring->shared_state().head.load(AK::MemoryOrder::memory_order_acquire);
+    return ring;
+}
+
+SharedMemoryRing::SharedMemoryRing(Core::AnonymousBuffer buffer, int doorbell_read_fd, int doorbell_write_fd)
+    : m_buffer(move(buffer))
+    , m_doorbell_read_fd(doorbell_read_fd)
+    , m_doorbell_write_fd(doorbell_write_fd)
+{
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if (m_doorbell_read_fd != -1)
+        (void)Core::System::close(m_doorbell_read_fd);
+    if (m_doorbell_write_fd != -1 && m_doorbell_write_fd != m_doorbell_read_fd)
+        (void)Core::System::close(m_doorbell_write_fd);
+}
+
+SharedMemoryRing::SharedState& SharedMemoryRing::shared_state()
+{
+    return *static_cast<SharedState*>(m_buffer.data<void>());
+}
+
+ErrorOr<Vector<int, 2>> SharedMemoryRing::clone_fds_for_peer() const
+{
+    auto buffer_fd = TRY(Core::System::dup(m_buffer.fd()));
+    auto doorbell_fd = Core::System::dup(m_doorbell_read_fd);
+    if (doorbell_fd.is_error()) {
+        (void)Core::System::close(buffer_fd);
+        return doorbell_fd.release_error();
+    }
+    return Vector<int, 2> { buffer_fd, doorbell_fd.value() };
+}
+
+void SharedMemoryRing::copy_to_ring(u64 position, ReadonlyBytes bytes)
+{
+    auto offset = position % CAPACITY;
+    auto first_chunk_size = min(bytes.size(), CAPACITY - offset);
+    auto* data = shared_state().data;
+
+    memcpy(data + offset, bytes.data(), first_chunk_size);
+    memcpy(data, bytes.data() + first_chunk_size, bytes.size() - first_chunk_size);
+}
+
+void SharedMemoryRing::copy_from_ring(u64 position, Bytes bytes)
+{
+    auto offset = position % CAPACITY;
+    auto first_chunk_size = min(bytes.size(), CAPACITY - offset);
+    auto const* data = shared_state().data;
+
+    memcpy(bytes.data(), data + offset, first_chunk_size);
+    memcpy(bytes.data() + first_chunk_size, data, bytes.size() - first_chunk_size);
+}
+
+bool SharedMemoryRing::try_enqueue(u32 sequence_number, ReadonlyBytes payload)
+{
+    VERIFY(m_doorbell_write_fd != -1);
+    auto& state = shared_state();
+
+    // A consumer that misbehaves can only make us believe that the ring is full, which sends everything over the socket.
+    auto used = m_position - state.head.load(AK::MemoryOrder::memory_order_acquire);
+    if (used > CAPACITY || sizeof(RecordHeader) + payload.size() > CAPACITY - used)
+        return false;
+
+    RecordHeader header { .sequence_number = sequence_number, .payload_size = static_cast<u32>(payload.size()) };
+    copy_to_ring(m_position, { &header, sizeof(header) });
+    copy_to_ring(m_position + sizeof(header), payload);
+    m_position += sizeof(header) + payload.size();
+
+    // NOTE: Publishing the tail and checking for a waiting consumer must not be reordered, as the consumer does the
+    //       opposite in prepare_to_wait(). At least one of the two sides will see the other's store.
+    state.tail.store(m_position, AK::MemoryOrder::memory_order_seq_cst);
+    if (state.consumer_is_waiting.exchange(false, AK::MemoryOrder::memory_order_seq_cst))
+        ring_doorbell();
+
+    return true;
+}
+
+ErrorOr<Optional<SharedMemoryRing::RecordHeader>> SharedMemoryRing::peek()
+{
+    VERIFY(m_doorbell_write_fd == -1);
+
+    auto available = shared_state().tail.load(AK::MemoryOrder::memory_order_acquire) - m_position;
+    if (available == 0)
+        return OptionalNone {};
+    if (available > CAPACITY || available < sizeof(RecordHeader))
+        return Error::from_string_literal("Shared memory ring has an invalid tail");
+
+    RecordHeader header;
+    copy_from_ring(m_position, { &header, sizeof(header) });
+    if (header.payload_size > available - sizeof(RecordHeader))
+        return Error::from_string_literal("Shared memory ring has an invalid record");
+
+    return header;
+}
+
+Vector<u8> SharedMemoryRing::dequeue(RecordHeader const& header)
+{
+    Vector<u8> payload;
+    payload.resize(header.payload_size);
+    copy_from_ring(m_position + sizeof(RecordHeader), payload);
+
+    m_position += sizeof(RecordHeader) + header.payload_size;
+    shared_state().head.store(m_position, AK::MemoryOrder::memory_order_release);
+
+    return payload;
+}
+
+bool SharedMemoryRing::prepare_to_wait()
+{
+    auto& state = shared_state();
+    state.consumer_is_waiting.store(true, AK::MemoryOrder::memory_order_seq_cst);
+    return state.tail.load(AK::MemoryOrder::memory_order_seq_cst) == m_position;
+}
+
+void SharedMemoryRing::ring_doorbell()
+{
+    // An eventfd needs exactly 8 bytes, while a pipe doesn't care. If the pipe is full, the doorbell is already ringing.
+    u64 value = 1;
+    (void)Core::System::write(m_doorbell_write_fd, { &value, sizeof(value) });
+}
+
+void SharedMemoryRing::drain_doorbell()
+{
+    u64 values[8];
+    for (;;) {
+        auto result = Core::System::read(m_doorbell_read_fd, { values, sizeof(values) });
+        if (result.is_error() || result.value() == 0)
+            break;
+    }
+}
+
+}
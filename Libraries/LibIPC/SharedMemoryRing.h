@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <AK/Vector.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibIPC/File.h>
+
+namespace IPC {
+
+// A single-producer, single-consumer ring of variable-sized messages that lives in shared memory, so that a message
+// can be handed to another process with one copy in and one copy out, and without a system call when that process is
+// busy anyway. The producer only rings the doorbell (an eventfd on Linux, a pipe elsewhere) if the consumer announced
+// that it is about to wait for a message.
+//
+// The consumer must not trust anything it reads from the shared memory, as the producer is usually a less privileged
+// process than itself. Every record header is validated before use, and payloads are copied out before they are parsed.
+class SharedMemoryRing : public RefCounted<SharedMemoryRing> {
+public:
+    static constexpr size_t CAPACITY = 256 * KiB;
+
+    struct RecordHeader {
+        u32 sequence_number { 0 };
+        u32 payload_size { 0 };
+    };
+
+    // Creates a new ring for this process to produce messages into.
+    static ErrorOr<NonnullRefPtr<SharedMemoryRing>> create();
+
+    // Maps a ring that was created by the peer, for this process to consume messages from.
+    static ErrorOr<NonnullRefPtr<SharedMemoryRing>> attach(File buffer, File doorbell);
+
+    ~SharedMemoryRing();
+
+    // The file descriptors that the consumer needs to attach to this ring.
+    ErrorOr<Vector<int, 2>> clone_fds_for_peer() const;
+
+    // Producer: Returns false if the message does not fit into the free space of the ring.
+    bool try_enqueue(u32 sequence_number, ReadonlyBytes);
+
+    // Consumer: Returns the header of the next message, if there is one.
+    ErrorOr<Optional<RecordHeader>> peek();
+    Vector<u8> dequeue(RecordHeader const&);
+
+    // Consumer: Asks the producer to ring the doorbell for the next message. Returns false if a message arrived in the
+    // meantime, in which case the consumer should not go to sleep.
+    bool prepare_to_wait();
+    void drain_doorbell();
+    int doorbell_fd() const { return m_doorbell_read_fd; }
+
+private:
+    struct SharedState;
+
+    SharedMemoryRing(Core::AnonymousBuffer, int doorbell_read_fd, int doorbell_write_fd);
+
+    SharedState& shared_state();
+    void copy_to_ring(u64 position, ReadonlyBytes);
+    void copy_from_ring(u64 position, Bytes);
+    void ring_doorbell();
+
+    Core::AnonymousBuffer m_buffer;
+    int m_doorbell_read_fd { -1 };
+    int m_doorbell_write_fd { -1 };
+
+    // The producer is the only writer of the tail, and the consumer is the only writer of the head, so each side keeps
+    // its own copy instead of trusting the one in shared memory.
+    u64 m_position { 0 };
+};
+
+}
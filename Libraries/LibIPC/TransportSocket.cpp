@@ -6,6 +6,7 @@
  */
 
 #include <AK/NonnullOwnPtr.h>
+#include <LibCore/Notifier.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
 #include <LibIPC/TransportSocket.h>
@@ -113,6 +114,8 @@ void TransportSocket::close()
 {
     Threading::RWLockLocker<Threading::LockMode::Write> lock(m_socket_rw_lock);
     m_socket->close();
+    if (m_incoming_ring_notifier)
+        m_incoming_ring_notifier->close();
 }
 
 void TransportSocket::close_after_sending_all_pending_messages()
@@ -133,6 +136,29 @@ void TransportSocket::close_after_sending_all_pending_messages()
 void TransportSocket::wait_until_readable()
 {
     Threading::RWLockLocker<Threading::LockMode::Read> lock(m_socket_rw_lock);
+
+    if (m_incoming_ring) {
+        if (has_deliverable_message_in_shared_memory_ring())
+            return;
+
+        Array<struct pollfd, 2> pollfds {
+            pollfd { .fd = m_socket->fd().value(), .events = POLLIN, .revents = 0 },
+            pollfd { .fd = m_incoming_ring->doorbell_fd(), .events = POLLIN, .revents = 0 },
+        };
+
+        ErrorOr<int> result { 0 };
+        do {
+            result = Core::System::poll(pollfds, -1);
+        } while (result.is_error() && result.error().code() == EINTR);
+
+        if (result.is_error()) {
+            dbgln("TransportSocket::wait_until_readable: {}", result.error());
+            warnln("TransportSocket::wait_until_readable: {}", result.error());
+            VERIFY_NOT_REACHED();
+        }
+        return;
+    }
+
     auto maybe_did_become_readable = m_socket->can_read_without_blocking(-1);
     if (maybe_did_become_readable.is_error()) {
         dbgln("TransportSocket::wait_until_readable: {}", maybe_did_become_readable.error());
@@ -147,10 +173,13 @@ struct MessageHeader {
     enum class Type : u8 {
         Payload = 0,
         FileDescriptorAcknowledgement = 1,
+        SharedMemoryRingOffer = 2,
+        SharedMemoryRingAcceptance = 3,
     };
     Type type { Type::Payload };
     u32 payload_size { 0 };
     u32 fd_count { 0 };
+    u32 sequence_number { 0 };
 
     static Vector<u8> encode_with_payload(MessageHeader header, ReadonlyBytes payload)
     {
@@ -164,6 +193,13 @@ struct MessageHeader {
 
 void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const& fds)
 {
+    Threading::MutexLocker locker(m_send_mutex);
+    auto sequence_number = m_next_outgoing_sequence_number++;
+
+    // NOTE: File descriptors can only be passed through the socket.
+    if (fds.is_empty() && m_outgoing_ring_accepted && m_outgoing_ring->try_enqueue(sequence_number, bytes_to_write))
+        return;
+
     auto num_fds_to_transfer = fds.size();
 
     auto message_buffer = MessageHeader::encode_with_payload(
@@ -171,6 +207,7 @@ void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<Nonn
             .type = MessageHeader::Type::Payload,
             .payload_size = static_cast<u32>(bytes_to_write.size()),
             .fd_count = static_cast<u32>(num_fds_to_transfer),
+            .sequence_number = sequence_number,
         },
         bytes_to_write);
 
@@ -188,6 +225,100 @@ void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<Nonn
     m_send_queue->enqueue_message(move(message_buffer), move(raw_fds));
 }
 
+void TransportSocket::offer_shared_memory_ring()
+{
+    auto ring = SharedMemoryRing::create();
+    if (ring.is_error()) {
+        dbgln("TransportSocket::offer_shared_memory_ring: {}", ring.error());
+        return;
+    }
+
+    auto fds = ring.value()->clone_fds_for_peer();
+    if (fds.is_error()) {
+        dbgln("TransportSocket::offer_shared_memory_ring: {}", fds.error());
+        return;
+    }
+
+    Threading::MutexLocker locker(m_send_mutex);
+    VERIFY(!m_outgoing_ring);
+    m_outgoing_ring = ring.release_value();
+
+    for (auto fd : fds.value())
+        m_fds_retained_until_received_by_peer.enqueue(adopt_ref(*new AutoCloseFileDescriptor(fd)));
+
+    auto message_buffer = MessageHeader::encode_with_payload(
+        {
+            .type = MessageHeader::Type::SharedMemoryRingOffer,
+            .payload_size = 0,
+            .fd_count = static_cast<u32>(fds.value().size()),
+        },
+        {});
+    m_send_queue->enqueue_message(move(message_buffer), Vector<int> { fds.value() });
+}
+
+bool TransportSocket::is_sending_through_shared_memory_ring() const
+{
+    Threading::MutexLocker locker(m_send_mutex);
+    return m_outgoing_ring_accepted;
+}
+
+void TransportSocket::accept_shared_memory_ring(File buffer, File doorbell)
+{
+    if (m_incoming_ring) {
+        dbgln("TransportSocket::accept_shared_memory_ring: Peer offered a second shared memory ring");
+        return;
+    }
+
+    auto ring = SharedMemoryRing::attach(move(buffer), move(doorbell));
+    if (ring.is_error()) {
+        // The peer keeps sending everything through the socket until we accept its ring.
+        dbgln("TransportSocket::accept_shared_memory_ring: {}", ring.error());
+        return;
+    }
+
+    m_incoming_ring = ring.release_value();
+    m_incoming_ring_notifier = Core::Notifier::construct(m_incoming_ring->doorbell_fd(), Core::Notifier::Type::Read);
+    m_incoming_ring_notifier->on_activation = [this] {
+        if (m_socket->on_ready_to_read)
+            m_socket->on_ready_to_read();
+    };
+
+    MessageHeader header;
+    header.type = MessageHeader::Type::SharedMemoryRingAcceptance;
+    m_send_queue->enqueue_message(MessageHeader::encode_with_payload(header, {}), {});
+}
+
+ErrorOr<void> TransportSocket::read_messages_from_shared_memory_ring(Function<void(Message&&)> const& callback)
+{
+    for (;;) {
+        auto header = TRY(m_incoming_ring->peek());
+
+        // A message that is further ahead has to wait for the ones before it to arrive through the socket.
+        if (header.has_value() && header->sequence_number == m_next_incoming_sequence_number) {
+            Message message;
+            message.bytes = m_incoming_ring->dequeue(*header);
+            ++m_next_incoming_sequence_number;
+            callback(move(message));
+            continue;
+        }
+
+        // Ask for the doorbell before going back to sleep, but make sure that no message slipped in before it was armed.
+        if (m_incoming_ring->prepare_to_wait() || header.has_value())
+            return {};
+    }
+}
+
+bool TransportSocket::has_deliverable_message_in_shared_memory_ring()
+{
+    if (m_incoming_ring->prepare_to_wait())
+        return false;
+
+    auto header = m_incoming_ring->peek();
+    if (header.is_error())
+        return true;
+    return header.value().has_value() && header.value()->sequence_number == m_next_incoming_sequence_number;
+}
+
 ErrorOr<void> TransportSocket::send_message(Core::LocalSocket& socket, ReadonlyBytes& bytes_to_write, Vector<int>& unowned_fds)
 {
     auto num_fds_to_transfer = unowned_fds.size();
@@ -259,6 +390,10 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
 {
     Threading::RWLockLocker<Threading::LockMode::Read> lock(m_socket_rw_lock);
 
+    // NOTE: This must happen before the ring is read, otherwise we could swallow the doorbell for a message that we miss.
+    if (m_incoming_ring)
+        m_incoming_ring->drain_doorbell();
+
     bool should_shutdown = false;
     while (is_open()) {
         u8 buffer[4096];
@@ -303,6 +438,24 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
                 break;
             if (header.fd_count > m_unprocessed_fds.size())
                 break;
+
+            // Everything that was posted before this message and went through the ring is already visible to us. Until
+            // the peer has a ring, the socket is the only path, so we simply follow its numbering. This keeps sockets that
+            // have been passed on to another process working, as that process numbers its messages from zero again.
+            if (m_incoming_ring) {
+                if (auto result = read_messages_from_shared_memory_ring(callback); result.is_error()) {
+                    dbgln("TransportSocket::read_as_many_messages_as_possible_without_blocking: {}", result.error());
+                    should_shutdown = true;
+                    break;
+                }
+                if (header.sequence_number != m_next_incoming_sequence_number) {
+                    dbgln("TransportSocket::read_as_many_messages_as_possible_without_blocking: Expected message {}, got {}", m_next_incoming_sequence_number, header.sequence_number);
+                    should_shutdown = true;
+                    break;
+                }
+            }
+            m_next_incoming_sequence_number = header.sequence_number + 1;
+
             Message message;
             received_fd_count += header.fd_count;
             for (size_t i = 0; i < header.fd_count; ++i)
@@ -312,12 +465,40 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
         } else if (header.type == MessageHeader::Type::FileDescriptorAcknowledgement) {
             VERIFY(header.payload_size == 0);
             acknowledged_fd_count += header.fd_count;
+        } else if (header.type == MessageHeader::Type::SharedMemoryRingOffer) {
+            // The peer may be less privileged than us, so a malformed or repeated offer is a protocol error.
+            if (header.payload_size != 0 || header.fd_count != 2 || m_incoming_ring) {
+                dbgln("TransportSocket::read_as_many_messages_as_possible_without_blocking: Unexpected shared memory ring offer");
+                should_shutdown = true;
+                break;
+            }
+            if (header.fd_count > m_unprocessed_fds.size())
+                break;
+            received_fd_count += header.fd_count;
+            auto buffer = m_unprocessed_fds.dequeue();
+            auto doorbell = m_unprocessed_fds.dequeue();
+            accept_shared_memory_ring(move(buffer), move(doorbell));
+        } else if (header.type == MessageHeader::Type::SharedMemoryRingAcceptance) {
+            Threading::MutexLocker locker(m_send_mutex);
+            if (header.payload_size != 0 || header.fd_count != 0 || !m_outgoing_ring || m_outgoing_ring_accepted) {
+                dbgln("TransportSocket::read_as_many_messages_as_possible_without_blocking: Unexpected shared memory ring acceptance");
+                should_shutdown = true;
+                break;
+            }
+            m_outgoing_ring_accepted = true;
         } else {
             VERIFY_NOT_REACHED();
         }
         index += header.payload_size + sizeof(MessageHeader);
     }
 
+    if (m_incoming_ring) {
+        if (auto result = read_messages_from_shared_memory_ring(callback); result.is_error()) {
+            dbgln("TransportSocket::read_as_many_messages_as_possible_without_blocking: {}", result.error());
+            should_shutdown = true;
+        }
+    }
+
     if (should_shutdown)
         return ShouldShutdown::Yes;
 
@@ -352,12 +533,14 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
 ErrorOr<int> TransportSocket::release_underlying_transport_for_transfer()
 {
     Threading::RWLockLocker<Threading::LockMode::Write> lock(m_socket_rw_lock);
+    VERIFY(!m_outgoing_ring);
     return m_socket->release_fd();
 }
 
 ErrorOr<IPC::File> TransportSocket::clone_for_transfer()
 {
     Threading::RWLockLocker<Threading::LockMode::Write> lock(m_socket_rw_lock);
+    VERIFY(!m_outgoing_ring);
     return IPC::File::clone_fd(m_socket->fd().value());
 }
 
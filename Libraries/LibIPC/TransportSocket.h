@@ -9,9 +9,11 @@
 
 #include <AK/MemoryStream.h>
 #include <AK/Queue.h>
+#include <LibCore/Forward.h>
 #include <LibCore/Socket.h>
 #include <LibIPC/AutoCloseFileDescriptor.h>
 #include <LibIPC/File.h>
+#include <LibIPC/SharedMemoryRing.h>
 #include <LibThreading/ConditionVariable.h>
 #include <LibThreading/MutexProtected.h>
 #include <LibThreading/RWLock.h>
@@ -64,6 +66,13 @@ public:
 
     void post_message(Vector<u8> const&, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const&);
 
+    // Offers the peer a shared memory ring to receive our messages through instead of the socket. Once the peer accepts
+    // it, messages go through the ring unless they carry file descriptors or don't fit, in which case they still go
+    // through the socket. The peer puts the messages from both paths back into the order they were posted in.
+    // NOTE: Transports that are cloned or transferred to another process must not offer a ring.
+    void offer_shared_memory_ring();
+    bool is_sending_through_shared_memory_ring() const;
+
     enum class ShouldShutdown {
         No,
         Yes,
@@ -90,6 +99,10 @@ private:
 
     void stop_send_thread();
 
+    void accept_shared_memory_ring(File buffer, File doorbell);
+    ErrorOr<void> read_messages_from_shared_memory_ring(Function<void(Message&&)> const&);
+    bool has_deliverable_message_in_shared_memory_ring();
+
     NonnullOwnPtr<Core::LocalSocket> m_socket;
     mutable Threading::RWLock m_socket_rw_lock;
     ByteBuffer m_unprocessed_bytes;
@@ -102,6 +115,17 @@ private:
 
     RefPtr<Threading::Thread> m_send_thread;
     RefPtr<SendQueue> m_send_queue;
+
+    // Every payload is numbered, so that messages that went through the socket and the shared memory ring can be
+    // delivered in the order they were posted in.
+    mutable Threading::Mutex m_send_mutex;
+    u32 m_next_outgoing_sequence_number { 0 };
+    RefPtr<SharedMemoryRing> m_outgoing_ring;
+    bool m_outgoing_ring_accepted { false };
+
+    u32 m_next_incoming_sequence_number { 0 };
+    RefPtr<SharedMemoryRing> m_incoming_ring;
+    RefPtr<Core::Notifier> m_incoming_ring_notifier;
 };
 
 }
@@ -30,6 +30,10 @@ public:
 
     ErrorOr<void> transfer_message(ReadonlyBytes, Vector<size_t> const& handle_offsets);
 
+    // FIXME: Implement a shared memory ring transport on Windows.
+    void offer_shared_memory_ring() { }
+    bool is_sending_through_shared_memory_ring() const { return false; }
+
     enum class ShouldShutdown {
         No,
         Yes,
@@ -51,6 +51,7 @@ struct SourceRecord {
 class JS_API Executable final : public Cell {
     GC_CELL(Executable, Cell);
     GC_DECLARE_ALLOCATOR(Executable);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(Executable);
 
 public:
     Executable(
@@ -98,6 +99,11 @@ public:
 
     Optional<IdentifierTableIndex> length_identifier;
 
+    // Baseline JIT state. See JIT::Compiler.
+    OwnPtr<JIT::NativeExecutable> native_executable;
+    u32 execution_count { 0 };
+    bool did_try_to_compile_native_code { false };
+
     Utf16String const& get_string(StringTableIndex index) const { return string_table->get(index); }
     Utf16FlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
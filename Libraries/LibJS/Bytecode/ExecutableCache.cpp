@@ -0,0 +1,595 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <AK/MemoryStream.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/Runtime/BigInt.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/SourceCode.h>
+#include <LibRegex/Regex.h>
+
+namespace JS::Bytecode {
+
+static constexpr u32 executable_cache_magic = 0x4342534a; // "JSBC"
+
+// Bump this whenever the serialized layout below changes.
+static constexpr u32 executable_cache_format_version = 1;
+
+// Instructions are stored as raw bytes, so a build with different instruction layouts must not read our entries.
+static constexpr u32 bytecode_layout_fingerprint()
+{
+    u32 fingerprint = sizeof(Operand) * 31 + sizeof(Label);
+#define __BYTECODE_OP(op) \
+    fingerprint = fingerprint * 31 + sizeof(Op::op);
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    return fingerprint;
+}
+
+// Small functions compile faster than we could look them up on disk.
+static constexpr u32 minimum_cached_source_length = 512;
+
+Optional<String> executable_cache_key(ECMAScriptFunctionObject const& function)
+{
+    auto const& code = function.ecmascript_code();
+    if (code.end_offset() - code.start_offset() < minimum_cached_source_length)
+        return {};
+
+    // Eval code and dynamic functions are parsed in a context that isn't part of their source text, and that changes
+    // the bytecode we generate for them (e.g. whether globals can be accessed directly). Never share their bytecode.
+    if (!code.source_code().was_parsed_as_program())
+        return {};
+
+    // The bytecode depends on the scope analysis of the whole source text, which differs between scripts and modules.
+    auto is_module = function.script_or_module().has<GC::Ref<Module>>();
+
+    return MUST(String::formatted("{}-{}-{}-{}{}{}{}-{}-{:08x}",
+        code.source_code().content_hash(),
+        code.start_offset(),
+        code.end_offset(),
+        to_underlying(function.kind()),
+        static_cast<FunctionObject const&>(function).is_strict_mode() ? 's' : 'n',
+        is_module ? 'm' : 's',
+        g_optimize_bytecode ? 'o' : 'u',
+        executable_cache_format_version,
+        bytecode_layout_fingerprint()));
+}
+
+enum class ConstantKind : u8 {
+    Primitive,
+    String,
+    BigInt,
+};
+
+static ErrorOr<void> write_utf16_string(Stream& stream, Utf16View const& string)
+{
+    TRY(stream.write_value<u8>(string.has_ascii_storage()));
+    TRY(stream.write_value<u32>(string.length_in_code_units()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<u32>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<void> ensure_serializable(Value value)
+{
+    if (value.is_cell() && !value.is_string() && !value.is_bigint())
+        return AK::Error::from_string_literal("Executable holds a heap value that can't be serialized");
+    return {};
+}
+
+static ErrorOr<void> ensure_serializable_instructions(Executable const& executable)
+{
+    InstructionStreamIterator it(executable.bytecode, &executable);
+    while (!it.at_end()) {
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+        case Instruction::Type::BlockDeclarationInstantiation:
+        case Instruction::Type::Dump:
+        case Instruction::Type::NewClass:
+        case Instruction::Type::NewFunction:
+            return AK::Error::from_string_literal("Executable refers to memory outside of itself");
+        case Instruction::Type::NewPrimitiveArray:
+            // Elements are stored inline, so even strings would leave dangling pointers behind.
+            for (auto element : static_cast<Op::NewPrimitiveArray const&>(instruction).elements()) {
+                if (element.is_cell())
+                    return AK::Error::from_string_literal("Executable has an inline heap value");
+            }
+            break;
+        case Instruction::Type::IteratorClose:
+            if (auto const& value = static_cast<Op::IteratorClose const&>(instruction).completion_value(); value.has_value() && value->is_cell())
+                return AK::Error::from_string_literal("Executable has an inline heap value");
+            break;
+        case Instruction::Type::AsyncIteratorClose:
+            if (auto const& value = static_cast<Op::AsyncIteratorClose const&>(instruction).completion_value(); value.has_value() && value->is_cell())
+                return AK::Error::from_string_literal("Executable has an inline heap value");
+            break;
+        default:
+            break;
+        }
+        ++it;
+    }
+    return {};
+}
+
+ErrorOr<ByteBuffer> serialize_executable(Executable const& executable)
+{
+    TRY(ensure_serializable_instructions(executable));
+    for (auto constant : executable.constants)
+        TRY(ensure_serializable(constant));
+
+    AllocatingMemoryStream stream;
+
+    TRY(stream.write_value<u32>(executable_cache_magic));
+    TRY(stream.write_value<u32>(executable_cache_format_version));
+    TRY(stream.write_value<u32>(bytecode_layout_fingerprint()));
+
+    TRY(stream.write_value<u8>(executable.is_strict_mode));
+    TRY(stream.write_value<u32>(executable.number_of_registers));
+    TRY(stream.write_value<u32>(executable.property_lookup_caches.size()));
+    TRY(stream.write_value<u32>(executable.global_variable_caches.size()));
+    TRY(stream.write_value<u32>(executable.local_index_base));
+    TRY(stream.write_value<u32>(executable.argument_index_base));
+
+    TRY(stream.write_value<u32>(executable.bytecode.size()));
+    TRY(stream.write_until_depleted(executable.bytecode.span()));
+
+    TRY(stream.write_value<u32>(executable.constants.size()));
+    for (auto constant : executable.constants) {
+        if (constant.is_string()) {
+            TRY(stream.write_value(ConstantKind::String));
+            TRY(write_utf16_string(stream, constant.as_string().utf16_string_view()));
+        } else if (constant.is_bigint()) {
+            TRY(stream.write_value(ConstantKind::BigInt));
+            TRY(write_string(stream, TRY(constant.as_bigint().big_integer().to_base(10))));
+        } else {
+            TRY(stream.write_value(ConstantKind::Primitive));
+            TRY(stream.write_value<u64>(constant.encoded()));
+        }
+    }
+
+    TRY(stream.write_value<u32>(executable.string_table->size()));
+    for (u32 i = 0; i < executable.string_table->size(); ++i)
+        TRY(write_utf16_string(stream, executable.get_string({ i }).utf16_view()));
+
+    TRY(stream.write_value<u32>(executable.identifier_table->size()));
+    for (u32 i = 0; i < executable.identifier_table->size(); ++i)
+        TRY(write_utf16_string(stream, executable.get_identifier({ i }).view()));
+
+    // Compiled regexes are cheap to rebuild from their pattern, so we only store that.
+    TRY(stream.write_value<u32>(executable.regex_table->size()));
+    for (u32 i = 0; i < executable.regex_table->size(); ++i) {
+        auto const& regex = executable.regex_table->get(i);
+        TRY(write_string(stream, regex.pattern));
+        TRY(stream.write_value<u64>(to_underlying(regex.flags.value())));
+    }
+
+    TRY(stream.write_value<u32>(executable.exception_handlers.size()));
+    for (auto const& handlers : executable.exception_handlers) {
+        TRY(stream.write_value<u32>(handlers.start_offset));
+        TRY(stream.write_value<u32>(handlers.end_offset));
+        TRY(stream.write_value<u8>(handlers.handler_offset.has_value()));
+        TRY(stream.write_value<u32>(handlers.handler_offset.value_or(0)));
+        TRY(stream.write_value<u8>(handlers.finalizer_offset.has_value()));
+        TRY(stream.write_value<u32>(handlers.finalizer_offset.value_or(0)));
+    }
+
+    TRY(stream.write_value<u32>(executable.basic_block_start_offsets.size()));
+    for (auto offset : executable.basic_block_start_offsets)
+        TRY(stream.write_value<u32>(offset));
+
+    TRY(stream.write_value<u32>(executable.source_map.size()));
+    for (auto const& [offset, record] : executable.source_map) {
+        TRY(stream.write_value<u32>(offset));
+        TRY(stream.write_value<u32>(record.source_start_offset));
+        TRY(stream.write_value<u32>(record.source_end_offset));
+    }
+
+    TRY(stream.write_value<u32>(executable.local_variable_names.size()));
+    for (auto const& local : executable.local_variable_names) {
+        TRY(write_utf16_string(stream, local.name.view()));
+        TRY(stream.write_value(local.declaration_kind));
+    }
+
+    TRY(stream.write_value<u8>(executable.length_identifier.has_value()));
+    TRY(stream.write_value<u32>(executable.length_identifier.has_value() ? executable.length_identifier->value : 0));
+
+    return stream.read_until_eof();
+}
+
+// Nothing in a serialized executable can be trusted until it has been checked.
+static ErrorOr<HashTable<size_t>> validate_instruction_stream(ReadonlyBytes bytecode)
+{
+    HashTable<size_t> instruction_offsets;
+    bool ends_with_terminator = false;
+
+    size_t offset = 0;
+    while (offset < bytecode.size()) {
+        if (offset % alignof(Instruction) != 0 || bytecode.size() - offset < sizeof(Instruction))
+            return AK::Error::from_string_literal("Serialized executable has a truncated instruction");
+
+        auto const& instruction = *reinterpret_cast<Instruction const*>(bytecode.offset_pointer(offset));
+
+        // The fixed part has to be there before length() may look at any of the counts in it.
+        size_t fixed_length = 0;
+        switch (instruction.type()) {
+#define __BYTECODE_OP(op)                            \
+    case Instruction::Type::op:                      \
+        fixed_length = sizeof(Op::op);               \
+        ends_with_terminator = Op::op::IsTerminator; \
+        break;
+            ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        default:
+            return AK::Error::from_string_literal("Serialized executable has an unknown instruction");
+        }
+
+        if (bytecode.size() - offset < fixed_length)
+            return AK::Error::from_string_literal("Serialized executable has a truncated instruction");
+        auto length = instruction.length();
+        if (length < fixed_length || length > bytecode.size() - offset)
+            return AK::Error::from_string_literal("Serialized executable has a truncated instruction");
+
+        TRY(instruction_offsets.try_set(offset));
+        offset += length;
+    }
+
+    // Otherwise the interpreter would run off the end of the bytecode.
+    if (!ends_with_terminator)
+        return AK::Error::from_string_literal("Serialized executable doesn't end in a terminator");
+
+    return instruction_offsets;
+}
+
+template<typename OpType>
+static ErrorOr<void> validate_instruction_fields(Executable const& executable, OpType const& instruction)
+{
+    auto is_valid_identifier = [&](IdentifierTableIndex index) { return index.value < executable.identifier_table->size(); };
+    auto is_valid_string = [&](StringTableIndex index) { return index.value < executable.string_table->size(); };
+
+    if constexpr (requires { { instruction.identifier() } -> SameAs<IdentifierTableIndex>; }) {
+        if (!is_valid_identifier(instruction.identifier()))
+            return AK::Error::from_string_literal("Serialized executable has a bogus identifier");
+    }
+    if constexpr (requires { { instruction.property() } -> SameAs<IdentifierTableIndex>; }) {
+        if (!is_valid_identifier(instruction.property()))
+            return AK::Error::from_string_literal("Serialized executable has a bogus identifier");
+    }
+    if constexpr (requires { { instruction.name() } -> SameAs<IdentifierTableIndex>; }) {
+        if (!is_valid_identifier(instruction.name()))
+            return AK::Error::from_string_literal("Serialized executable has a bogus identifier");
+    }
+    if constexpr (requires { instruction.base_identifier(); }) {
+        if (auto const& base_identifier = instruction.base_identifier(); base_identifier.has_value() && !is_valid_identifier(*base_identifier))
+            return AK::Error::from_string_literal("Serialized executable has a bogus identifier");
+    }
+    if constexpr (requires { instruction.expression_string(); }) {
+        if (auto const& expression_string = instruction.expression_string(); expression_string.has_value() && !is_valid_string(*expression_string))
+            return AK::Error::from_string_literal("Serialized executable has a bogus string");
+    }
+    if constexpr (requires { instruction.error_string(); }) {
+        if (!is_valid_string(instruction.error_string()))
+            return AK::Error::from_string_literal("Serialized executable has a bogus string");
+    }
+
+    if constexpr (IsSame<OpType, Op::NewRegExp>) {
+        if (!is_valid_string(instruction.source_index()) || !is_valid_string(instruction.flags_index()) || instruction.regex_index().value() >= executable.regex_table->size())
+            return AK::Error::from_string_literal("Serialized executable has a bogus regex");
+    }
+
+    if constexpr (IsSame<OpType, Op::CallBuiltin>) {
+        if (to_underlying(instruction.builtin()) >= to_underlying(Builtin::__Count))
+            return AK::Error::from_string_literal("Serialized executable has a bogus builtin");
+    }
+
+    if constexpr (IsOneOf<OpType, Op::GetGlobal, Op::SetGlobal>) {
+        if (instruction.cache_index() >= executable.global_variable_caches.size())
+            return AK::Error::from_string_literal("Serialized executable has a bogus cache index");
+    } else if constexpr (requires { instruction.cache_index(); }) {
+        if (instruction.cache_index() >= executable.property_lookup_caches.size())
+            return AK::Error::from_string_literal("Serialized executable has a bogus cache index");
+    }
+
+    // Environment coordinates are used without any checks, and wouldn't be right for our environments anyway.
+    if constexpr (requires { instruction.reset_cache(); })
+        instruction.reset_cache();
+
+    return {};
+}
+
+static ErrorOr<void> validate_executable(Executable& executable, size_t argument_count)
+{
+    // The interpreter writes to the reserved registers no matter what the bytecode says.
+    if (executable.number_of_registers < Register::reserved_register_count)
+        return AK::Error::from_string_literal("Serialized executable has too few registers");
+
+    auto instruction_offsets = TRY(validate_instruction_stream(executable.bytecode.span()));
+    TRY(ensure_serializable_instructions(executable));
+
+    auto is_valid_target = [&](size_t offset) { return instruction_offsets.contains(offset); };
+
+    // Operands index straight into the frame, whose layout was already checked against the tables.
+    auto is_valid_operand = [&](Operand const& operand) {
+        auto index = operand.index();
+        switch (operand.type()) {
+        case Operand::Type::Register:
+            return index < executable.number_of_registers;
+        case Operand::Type::Constant:
+            return index >= executable.number_of_registers && index < executable.local_index_base;
+        case Operand::Type::Local:
+            return index >= executable.local_index_base && index < executable.argument_index_base;
+        case Operand::Type::Argument:
+            return index >= executable.argument_index_base && index - executable.argument_index_base < argument_count;
+        default:
+            return false;
+        }
+    };
+
+    InstructionStreamIterator it(executable.bytecode, &executable);
+    while (!it.at_end()) {
+        auto& instruction = const_cast<Instruction&>(*it);
+
+        bool has_valid_operands = true;
+        instruction.visit_operands([&](Operand& operand) {
+            if (!is_valid_operand(operand))
+                has_valid_operands = false;
+        });
+        if (!has_valid_operands)
+            return AK::Error::from_string_literal("Serialized executable has a bogus operand");
+
+        bool has_valid_labels = true;
+        instruction.visit_labels([&](Label& label) {
+            if (!is_valid_target(label.address()))
+                has_valid_labels = false;
+        });
+        if (!has_valid_labels)
+            return AK::Error::from_string_literal("Serialized executable has a bogus jump target");
+
+        switch (instruction.type()) {
+#define __BYTECODE_OP(op)                                                                   \
+    case Instruction::Type::op:                                                             \
+        TRY(validate_instruction_fields(executable, static_cast<Op::op const&>(instruction))); \
+        break;
+            ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        default:
+            VERIFY_NOT_REACHED();
+        }
+
+        ++it;
+    }
+
+    for (auto const& handlers : executable.exception_handlers) {
+        if ((handlers.handler_offset.has_value() && !is_valid_target(*handlers.handler_offset))
+            || (handlers.finalizer_offset.has_value() && !is_valid_target(*handlers.finalizer_offset)))
+            return AK::Error::from_string_literal("Serialized executable has a bogus exception handler");
+    }
+
+    for (auto offset : executable.basic_block_start_offsets) {
+        if (!is_valid_target(offset))
+            return AK::Error::from_string_literal("Serialized executable has a bogus basic block");
+    }
+
+    auto source_length = executable.source_code->code().length_in_code_units();
+    for (auto const& entry : executable.source_map) {
+        if (entry.value.source_start_offset > entry.value.source_end_offset || entry.value.source_end_offset > source_length)
+            return AK::Error::from_string_literal("Serialized executable has a bogus source range");
+    }
+
+    if (executable.length_identifier.has_value() && executable.length_identifier->value >= executable.identifier_table->size())
+        return AK::Error::from_string_literal("Serialized executable has a bogus identifier");
+
+    return {};
+}
+
+class ExecutableReader {
+public:
+    explicit ExecutableReader(ReadonlyBytes bytes)
+        : m_stream(bytes)
+    {
+    }
+
+    template<typename T>
+    ErrorOr<T> read() { return m_stream.read_value<T>(); }
+
+    // Counts and lengths are checked against what's left, so a damaged entry can't make us allocate wildly.
+    ErrorOr<u32> read_count(size_t element_size = 1)
+    {
+        auto count = TRY(read<u32>());
+        if (static_cast<u64>(count) * element_size > m_stream.remaining())
+            return AK::Error::from_string_literal("Serialized executable is truncated");
+        return count;
+    }
+
+    ErrorOr<ByteBuffer> read_bytes()
+    {
+        auto length = TRY(read_count());
+        auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+        TRY(m_stream.read_until_filled(buffer));
+        return buffer;
+    }
+
+    ErrorOr<String> read_string()
+    {
+        auto bytes = TRY(read_bytes());
+        return String::from_utf8(StringView { bytes });
+    }
+
+    ErrorOr<Utf16String> read_utf16_string()
+    {
+        auto is_ascii = TRY(read<u8>());
+        auto length = TRY(read_count(is_ascii ? 1 : sizeof(char16_t)));
+        if (is_ascii) {
+            auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+            TRY(m_stream.read_until_filled(buffer));
+            return Utf16String::from_utf8(StringView { buffer });
+        }
+        Vector<char16_t> code_units;
+        TRY(code_units.try_resize(length));
+        TRY(m_stream.read_until_filled({ reinterpret_cast<u8*>(code_units.data()), length * sizeof(char16_t) }));
+        return Utf16String::from_utf16(Utf16View { code_units.data(), length });
+    }
+
+    bool is_eof() const { return m_stream.is_eof(); }
+
+private:
+    FixedMemoryStream m_stream;
+};
+
+ErrorOr<GC::Ref<Executable>> deserialize_executable(VM& vm, ReadonlyBytes bytes, ECMAScriptFunctionObject const& function)
+{
+    ExecutableReader reader { bytes };
+
+    if (TRY(reader.read<u32>()) != executable_cache_magic
+        || TRY(reader.read<u32>()) != executable_cache_format_version
+        || TRY(reader.read<u32>()) != bytecode_layout_fingerprint())
+        return AK::Error::from_string_literal("Serialized executable is from an incompatible build");
+
+    auto is_strict_mode = TRY(reader.read<u8>()) != 0;
+    auto number_of_registers = TRY(reader.read<u32>());
+    auto number_of_property_lookup_caches = TRY(reader.read<u32>());
+    auto number_of_global_variable_caches = TRY(reader.read<u32>());
+    auto local_index_base = TRY(reader.read<u32>());
+    auto argument_index_base = TRY(reader.read<u32>());
+
+    auto bytecode = TRY(reader.read_bytes());
+
+    Vector<Value> constants;
+    auto constant_count = TRY(reader.read_count());
+    TRY(constants.try_ensure_capacity(constant_count));
+    for (u32 i = 0; i < constant_count; ++i) {
+        switch (TRY(reader.read<ConstantKind>())) {
+        case ConstantKind::Primitive: {
+            Value value;
+            auto encoded = TRY(reader.read<u64>());
+            __builtin_memcpy(static_cast<void*>(&value), &encoded, sizeof(encoded));
+            if (value.is_cell())
+                return AK::Error::from_string_literal("Serialized executable has a bogus constant");
+            constants.unchecked_append(value);
+            break;
+        }
+        case ConstantKind::String:
+            constants.unchecked_append(PrimitiveString::create(vm, TRY(reader.read_utf16_string())));
+            break;
+        case ConstantKind::BigInt: {
+            auto digits = TRY(reader.read_string());
+            constants.unchecked_append(BigInt::create(vm, TRY(Crypto::SignedBigInteger::from_base(10, digits))));
+            break;
+        }
+        default:
+            return AK::Error::from_string_literal("Serialized executable has an unknown constant kind");
+        }
+    }
+
+    auto string_table = make<StringTable>();
+    auto string_count = TRY(reader.read_count());
+    for (u32 i = 0; i < string_count; ++i)
+        string_table->insert(TRY(reader.read_utf16_string()));
+
+    auto identifier_table = make<IdentifierTable>();
+    auto identifier_count = TRY(reader.read_count());
+    for (u32 i = 0; i < identifier_count; ++i)
+        identifier_table->insert(TRY(reader.read_utf16_string()));
+
+    auto regex_table = make<RegexTable>();
+    auto regex_count = TRY(reader.read_count());
+    for (u32 i = 0; i < regex_count; ++i) {
+        auto pattern = TRY(reader.read_string());
+        regex::RegexOptions<ECMAScriptFlags> flags { static_cast<ECMAScriptFlags>(TRY(reader.read<u64>())) };
+        auto regex = Regex<ECMA262>::parse_pattern(pattern, flags);
+        if (regex.error != regex::Error::NoError)
+            return AK::Error::from_string_literal("Serialized executable has an invalid regex");
+        regex_table->insert({ .regex = move(regex), .pattern = move(pattern), .flags = flags });
+    }
+
+    Vector<Executable::ExceptionHandlers> exception_handlers;
+    auto exception_handler_count = TRY(reader.read_count());
+    for (u32 i = 0; i < exception_handler_count; ++i) {
+        Executable::ExceptionHandlers handlers {};
+        handlers.start_offset = TRY(reader.read<u32>());
+        handlers.end_offset = TRY(reader.read<u32>());
+        auto has_handler = TRY(reader.read<u8>()) != 0;
+        auto handler_offset = TRY(reader.read<u32>());
+        if (has_handler)
+            handlers.handler_offset = handler_offset;
+        auto has_finalizer = TRY(reader.read<u8>()) != 0;
+        auto finalizer_offset = TRY(reader.read<u32>());
+        if (has_finalizer)
+            handlers.finalizer_offset = finalizer_offset;
+        TRY(exception_handlers.try_append(handlers));
+    }
+
+    Vector<size_t> basic_block_start_offsets;
+    auto basic_block_count = TRY(reader.read_count(sizeof(u32)));
+    for (u32 i = 0; i < basic_block_count; ++i)
+        TRY(basic_block_start_offsets.try_append(TRY(reader.read<u32>())));
+
+    HashMap<size_t, SourceRecord> source_map;
+    auto source_record_count = TRY(reader.read_count(3 * sizeof(u32)));
+    for (u32 i = 0; i < source_record_count; ++i) {
+        auto offset = TRY(reader.read<u32>());
+        SourceRecord record;
+        record.source_start_offset = TRY(reader.read<u32>());
+        record.source_end_offset = TRY(reader.read<u32>());
+        TRY(source_map.try_set(offset, record));
+    }
+
+    Vector<LocalVariable> local_variable_names;
+    auto local_count = TRY(reader.read_count());
+    for (u32 i = 0; i < local_count; ++i) {
+        auto name = TRY(reader.read_utf16_string());
+        auto declaration_kind = TRY(reader.read<LocalVariable::DeclarationKind>());
+        TRY(local_variable_names.try_append({ .name = name, .declaration_kind = declaration_kind }));
+    }
+
+    auto has_length_identifier = TRY(reader.read<u8>()) != 0;
+    auto length_identifier = TRY(reader.read<u32>());
+
+    if (!reader.is_eof())
+        return AK::Error::from_string_literal("Serialized executable has trailing data");
+    if (local_index_base != number_of_registers + constants.size() || argument_index_base != local_index_base + local_variable_names.size())
+        return AK::Error::from_string_literal("Serialized executable has an inconsistent frame layout");
+
+    auto executable = vm.heap().allocate<Executable>(
+        Vector<u8> { bytecode.bytes() },
+        move(identifier_table),
+        move(string_table),
+        move(regex_table),
+        move(constants),
+        function.ecmascript_code().source_code(),
+        number_of_property_lookup_caches,
+        number_of_global_variable_caches,
+        number_of_registers,
+        is_strict_mode);
+
+    executable->exception_handlers = move(exception_handlers);
+    executable->basic_block_start_offsets = move(basic_block_start_offsets);
+    executable->source_map = move(source_map);
+    executable->local_variable_names = move(local_variable_names);
+    executable->local_index_base = local_index_base;
+    executable->argument_index_base = argument_index_base;
+    if (has_length_identifier)
+        executable->length_identifier = IdentifierTableIndex { length_identifier };
+
+    TRY(validate_executable(executable, function.formal_parameters().size()));
+
+    return executable;
+}
+
+}
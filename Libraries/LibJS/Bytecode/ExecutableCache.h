@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibGC/Ptr.h>
+#include <LibJS/Export.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// Storage for serialized executables that outlives the current process. The host decides where entries live.
+// Keys are produced by executable_cache_key(), and already include everything the bytecode depends on.
+// They start with a hash of the script's source text followed by a '-', so hosts can keep a script's entries together.
+class JS_API ExecutableCache {
+public:
+    virtual ~ExecutableCache() = default;
+
+    // Called in the middle of compiling, so this has to be a lot cheaper than generating the bytecode. A miss only costs us the compile.
+    virtual Optional<ByteBuffer> load(StringView key) = 0;
+    virtual void store(StringView key, ReadonlyBytes) = 0;
+};
+
+// Returns an empty Optional for functions that aren't worth caching.
+JS_API Optional<String> executable_cache_key(ECMAScriptFunctionObject const&);
+
+// Fails for executables that refer to AST nodes, or to heap values other than strings and BigInts.
+JS_API ErrorOr<ByteBuffer> serialize_executable(Executable const&);
+
+// Entries may have been written by another process, so this rejects any that could make the interpreter
+// read or write outside the executable and its frame.
+JS_API ErrorOr<GC::Ref<Executable>> deserialize_executable(VM&, ReadonlyBytes, ECMAScriptFunctionObject const&);
+
+}
@@ -11,12 +11,14 @@
 #include <LibGC/RootHashMap.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Export.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -71,6 +73,8 @@ struct Traits<JS::PropertyKeyAndEnumerableFlag> : public DefaultTraits<JS::Prope
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_jit_enabled = false;
+bool g_optimize_bytecode = true;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -716,6 +720,27 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
     }
 }
 
+bool Interpreter::run_native_code(Executable& executable, size_t entry_point)
+{
+    if (!g_jit_enabled)
+        return false;
+
+    if (!executable.native_executable) {
+        if (executable.did_try_to_compile_native_code || ++executable.execution_count < JIT::JIT_TIER_UP_EXECUTION_COUNT)
+            return false;
+        executable.did_try_to_compile_native_code = true;
+        executable.native_executable = JIT::Compiler::compile(executable);
+        if (!executable.native_executable)
+            return false;
+    }
+
+    // Let run_bytecode() report running out of stack space.
+    if (vm().did_reach_stack_space_limit()) [[unlikely]]
+        return false;
+
+    return executable.native_executable->run(*this, entry_point);
+}
+
 Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& executable, Optional<size_t> entry_point, Value initial_accumulator_value)
 {
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter will run unit {:p}", &executable);
@@ -750,7 +775,8 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
         registers_and_constants_and_locals_and_arguments[executable.number_of_registers + i] = executable.constants[i];
     }
 
-    run_bytecode(entry_point.value_or(0));
+    if (!run_native_code(executable, entry_point.value_or(0)))
+        run_bytecode(entry_point.value_or(0));
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
 
@@ -840,6 +866,23 @@ ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM& vm, ECMAScriptFunct
 {
     auto const& name = function.name();
 
+    auto* cache = vm.executable_cache();
+    auto cache_key = cache ? executable_cache_key(function) : Optional<String> {};
+
+    if (cache_key.has_value()) {
+        if (auto bytes = cache->load(*cache_key); bytes.has_value()) {
+            auto cached_executable = deserialize_executable(vm, *bytes, function);
+            if (!cached_executable.is_error()) {
+                auto bytecode_executable = cached_executable.release_value();
+                bytecode_executable->name = name;
+                if (Bytecode::g_dump_bytecode)
+                    bytecode_executable->dump();
+                return bytecode_executable;
+            }
+            dbgln_if(JS_BYTECODE_DEBUG, "Bytecode: Ignoring cached executable for {}: {}", name, cached_executable.error());
+        }
+    }
+
     auto executable_result = Bytecode::Generator::generate_from_function(vm, function);
     if (executable_result.is_error())
         return vm.throw_completion<InternalError>(ErrorType::NotImplemented, TRY_OR_THROW_OOM(vm, executable_result.error().to_string()));
@@ -850,6 +893,13 @@ ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM& vm, ECMAScriptFunct
     if (Bytecode::g_dump_bytecode)
         bytecode_executable->dump();
 
+    if (cache_key.has_value()) {
+        if (auto bytes = serialize_executable(*bytecode_executable); !bytes.is_error())
+            cache->store(*cache_key, bytes.value());
+        else
+            dbgln_if(JS_BYTECODE_DEBUG, "Bytecode: Not caching executable for {}: {}", name, bytes.error());
+    }
+
     return bytecode_executable;
 }
 
@@ -1062,6 +1112,12 @@ inline ThrowCompletionOr<Value> get_by_value(VM& vm, Optional<IdentifierTableInd
         // For "non-typed arrays":
         if (!object.may_interfere_with_indexed_property_access()
             && object_storage) {
+            // Number elements can't be accessors, so they can be returned as they are.
+            if (object_storage->is_simple_storage()) {
+                auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*object_storage);
+                if (is_number_element_kind(simple_storage.element_kind()) && simple_storage.inline_has_index(index))
+                    return simple_storage.elements().data()[index];
+            }
             auto maybe_value = [&] {
                 if (object_storage->is_simple_storage())
                     return static_cast<SimpleIndexedPropertyStorage const*>(object_storage)->inline_get(index);
@@ -1388,11 +1444,11 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<Utf16Fl
         if (storage
             && storage->is_simple_storage()
             && !object.may_interfere_with_indexed_property_access()) {
-            auto maybe_value = storage->get(index);
-            if (maybe_value.has_value()) {
-                auto existing_value = maybe_value->value;
-                if (!existing_value.is_accessor()) {
-                    storage->put(index, value);
+            auto& simple_storage = static_cast<SimpleIndexedPropertyStorage&>(*storage);
+            if (simple_storage.inline_has_index(index)) {
+                // Number elements can't be accessors, so there's no need to look at the existing value.
+                if (is_number_element_kind(simple_storage.element_kind()) || !simple_storage.elements().data()[index].is_accessor()) {
+                    simple_storage.put(index, value);
                     return {};
                 }
             }
@@ -86,7 +86,10 @@ public:
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
 private:
+    friend class JIT::Compiler;
+
     void run_bytecode(size_t entry_point);
+    bool run_native_code(Executable&, size_t entry_point);
 
     enum class HandleExceptionResponse {
         ExitFromExecutable,
@@ -106,8 +109,10 @@ private:
 };
 
 JS_API extern bool g_dump_bytecode;
+JS_API extern bool g_jit_enabled;
+JS_API extern bool g_optimize_bytecode;
 
 ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM&, ASTNode const&, JS::FunctionKind kind, Utf16FlyString const& name);
-ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
+JS_API ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
 
 }
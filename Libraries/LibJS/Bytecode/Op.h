@@ -421,6 +421,8 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     ByteString to_byte_string_impl(Bytecode::Executable const&) const;
 
+    IdentifierTableIndex name() const { return m_name; }
+
 private:
     IdentifierTableIndex m_name;
 };
@@ -697,6 +699,7 @@ public:
     }
 
     IdentifierTableIndex identifier() const { return m_identifier; }
+    void reset_cache() const { m_cache = {}; }
     Operand src() const { return m_src; }
 
 private:
@@ -722,6 +725,7 @@ public:
     }
 
     IdentifierTableIndex identifier() const { return m_identifier; }
+    void reset_cache() const { m_cache = {}; }
     Operand src() const { return m_src; }
 
 private:
@@ -747,6 +751,7 @@ public:
     }
 
     IdentifierTableIndex identifier() const { return m_identifier; }
+    void reset_cache() const { m_cache = {}; }
     Operand src() const { return m_src; }
 
 private:
@@ -772,6 +777,7 @@ public:
     }
 
     IdentifierTableIndex identifier() const { return m_identifier; }
+    void reset_cache() const { m_cache = {}; }
     Operand src() const { return m_src; }
 
 private:
@@ -799,6 +805,7 @@ public:
     }
 
     IdentifierTableIndex identifier() const { return m_identifier; }
+    void reset_cache() const { m_cache = {}; }
     Operand callee() const { return m_callee; }
     Operand this_() const { return m_this_value; }
 
@@ -823,6 +830,7 @@ public:
 
     Operand dst() const { return m_dst; }
     IdentifierTableIndex identifier() const { return m_identifier; }
+    void reset_cache() const { m_cache = {}; }
 
     void visit_operands_impl(Function<void(Operand&)> visitor)
     {
@@ -849,6 +857,7 @@ public:
 
     Operand dst() const { return m_dst; }
     IdentifierTableIndex identifier() const { return m_identifier; }
+    void reset_cache() const { m_cache = {}; }
 
     void visit_operands_impl(Function<void(Operand&)> visitor)
     {
@@ -966,6 +975,7 @@ public:
     Operand base() const { return m_base; }
     IdentifierTableIndex property() const { return m_property; }
     u32 cache_index() const { return m_cache_index; }
+    Optional<IdentifierTableIndex> const& base_identifier() const { return m_base_identifier; }
 
 private:
     Operand m_dst;
@@ -1084,6 +1094,7 @@ public:
     Operand dst() const { return m_dst; }
     Operand base() const { return m_base; }
     u32 cache_index() const { return m_cache_index; }
+    Optional<IdentifierTableIndex> const& base_identifier() const { return m_base_identifier; }
 
 private:
     Operand m_dst;
@@ -1239,6 +1250,7 @@ public:
     Operand src() const { return m_src; }
     PropertyKind kind() const { return m_kind; }
     u32 cache_index() const { return m_cache_index; }
+    Optional<IdentifierTableIndex> const& base_identifier() const { return m_base_identifier; }
 
 private:
     Operand m_base;
@@ -1400,6 +1412,7 @@ public:
     Operand dst() const { return m_dst; }
     Operand base() const { return m_base; }
     Operand property() const { return m_property; }
+    Optional<IdentifierTableIndex> const& base_identifier() const { return m_base_identifier; }
 
 private:
     Operand m_dst;
@@ -1466,6 +1479,7 @@ public:
     Operand property() const { return m_property; }
     Operand src() const { return m_src; }
     PropertyKind kind() const { return m_kind; }
+    Optional<IdentifierTableIndex> const& base_identifier() const { return m_base_identifier; }
 
 private:
     Operand m_base;
@@ -2898,6 +2912,7 @@ public:
 
     Operand dst() const { return m_dst; }
     IdentifierTableIndex identifier() const { return m_identifier; }
+    void reset_cache() const { m_cache = {}; }
 
 private:
     Operand m_dst;
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static void retarget_destination(PassPipelineExecutable& executable, PassPipelineExecutable::Entry& entry, Operand dst)
+{
+    auto const& instruction = executable.instruction(entry);
+    switch (instruction.type()) {
+    case Instruction::Type::Mov:
+        executable.replace<Op::Mov>(entry, dst, static_cast<Op::Mov const&>(instruction).src());
+        return;
+#define __BYTECODE_OP(OpTitleCase, ...)                                      \
+    case Instruction::Type::OpTitleCase: {                                   \
+        auto const& op = static_cast<Op::OpTitleCase const&>(instruction);   \
+        executable.replace<Op::OpTitleCase>(entry, dst, op.lhs(), op.rhs()); \
+        return;                                                              \
+    }
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__BYTECODE_OP)
+#undef __BYTECODE_OP
+#define __BYTECODE_OP(OpTitleCase, ...)                                    \
+    case Instruction::Type::OpTitleCase: {                                 \
+        auto const& op = static_cast<Op::OpTitleCase const&>(instruction); \
+        executable.replace<Op::OpTitleCase>(entry, dst, op.src());         \
+        return;                                                            \
+    }
+        JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void CoalesceMoves::perform(PassPipelineExecutable& executable)
+{
+    auto uses = executable.count_register_uses();
+    auto& entries = executable.entries();
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        // Keep going on the same instruction, so chains of moves collapse into it one by one.
+        while (!entries[i].is_removed) {
+            auto written = written_operand(executable.instruction(entries[i]));
+            if (!written.has_value() || !executable.is_temporary_register(*written))
+                break;
+
+            // The register must be written here and read by the Mov below, and nowhere else.
+            if (uses[written->index()] != 2)
+                break;
+
+            auto next = executable.next_in_basic_block(i);
+            if (!next.has_value())
+                break;
+            auto const& next_instruction = executable.instruction(entries[*next]);
+            if (next_instruction.type() != Instruction::Type::Mov)
+                break;
+            auto const& mov = static_cast<Op::Mov const&>(next_instruction);
+            if (mov.src() != *written)
+                break;
+
+            retarget_destination(executable, entries[i], mov.dst());
+            executable.remove(entries[*next]);
+            uses[written->index()] = 0;
+        }
+    }
+}
+
+}
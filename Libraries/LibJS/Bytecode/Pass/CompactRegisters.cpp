@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Bytecode/Register.h>
+
+namespace JS::Bytecode::Passes {
+
+void CompactRegisters::perform(PassPipelineExecutable& executable)
+{
+    auto& executable_to_compact = executable.executable();
+    auto uses = executable.count_register_uses();
+
+    // Reserved registers keep their index, everything else is packed right after them.
+    Vector<u32> new_register_index;
+    new_register_index.resize(executable_to_compact.number_of_registers);
+    u32 number_of_registers = 0;
+    for (u32 i = 0; i < executable_to_compact.number_of_registers; ++i) {
+        if (i < Register::reserved_register_count || uses[i] > 0)
+            new_register_index[i] = number_of_registers++;
+    }
+
+    auto removed_register_count = static_cast<u32>(executable_to_compact.number_of_registers - number_of_registers);
+    if (removed_register_count == 0)
+        return;
+
+    for (auto& entry : executable.entries()) {
+        if (entry.is_removed)
+            continue;
+        executable.instruction(entry).visit_operands([&](Operand& operand) {
+            switch (operand.type()) {
+            case Operand::Type::Register:
+                operand = Operand(Operand::Type::Register, new_register_index[operand.index()]);
+                break;
+            case Operand::Type::Constant:
+            case Operand::Type::Local:
+            case Operand::Type::Argument:
+                operand = Operand(operand.type(), operand.index() - removed_register_count);
+                break;
+            default:
+                VERIFY_NOT_REACHED();
+            }
+        });
+    }
+
+    executable_to_compact.number_of_registers = number_of_registers;
+    executable_to_compact.local_index_base -= removed_register_count;
+    executable_to_compact.argument_index_base -= removed_register_count;
+}
+
+}
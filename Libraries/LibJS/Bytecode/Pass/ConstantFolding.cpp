@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Runtime/Value.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::Bytecode::Passes {
+
+static ThrowCompletionOr<bool> loosely_equals(VM& vm, Value lhs, Value rhs) { return is_loosely_equal(vm, lhs, rhs); }
+static ThrowCompletionOr<bool> loosely_inequals(VM& vm, Value lhs, Value rhs) { return !TRY(is_loosely_equal(vm, lhs, rhs)); }
+static ThrowCompletionOr<bool> strict_equals(VM&, Value lhs, Value rhs) { return is_strictly_equal(lhs, rhs); }
+static ThrowCompletionOr<bool> strict_inequals(VM&, Value lhs, Value rhs) { return !is_strictly_equal(lhs, rhs); }
+
+// Only values whose conversions can't throw or run user code take part in folding.
+static bool is_foldable(Value value)
+{
+    return value.is_number() || value.is_string() || value.is_boolean() || value.is_nullish();
+}
+
+// Maps registers and locals to the constant they were last set to in the current basic block.
+// Arguments are never tracked, since a mapped arguments object can change them behind our back.
+class KnownConstants {
+public:
+    explicit KnownConstants(PassPipelineExecutable& executable)
+        : m_executable(executable)
+    {
+    }
+
+    Optional<Operand> constant_for(Operand operand) const
+    {
+        if (operand.is_constant())
+            return operand;
+        if (auto it = m_constants.find(operand); it != m_constants.end())
+            return it->value;
+        return {};
+    }
+
+    Optional<Value> foldable_value(Operand operand) const
+    {
+        auto constant = constant_for(operand);
+        if (!constant.has_value())
+            return {};
+        auto value = m_executable.constant_value(*constant).value();
+        if (!is_foldable(value))
+            return {};
+        return value;
+    }
+
+    void set(Operand operand, Operand constant)
+    {
+        if (!operand.is_local() && !m_executable.is_temporary_register(operand))
+            return;
+        if (m_executable.constant_value(constant)->is_special_empty_value())
+            return;
+        m_constants.set(operand, constant);
+    }
+
+    void forget(Operand operand) { m_constants.remove(operand); }
+    void clear() { m_constants.clear(); }
+
+private:
+    PassPipelineExecutable& m_executable;
+    HashMap<Operand, Operand> m_constants;
+};
+
+template<typename OpType>
+static void fold_binary_op(PassPipelineExecutable& executable, PassPipelineExecutable::Entry& entry, KnownConstants& known_constants, auto fold)
+{
+    auto const& instruction = static_cast<OpType const&>(executable.instruction(entry));
+    auto dst = instruction.dst();
+    auto lhs = known_constants.constant_for(instruction.lhs()).value_or(instruction.lhs());
+    auto rhs = known_constants.constant_for(instruction.rhs()).value_or(instruction.rhs());
+    auto lhs_value = known_constants.foldable_value(lhs);
+    auto rhs_value = known_constants.foldable_value(rhs);
+
+    known_constants.forget(dst);
+
+    if (lhs_value.has_value() && rhs_value.has_value()) {
+        if (auto result = fold(executable.vm(), *lhs_value, *rhs_value); !result.is_error()) {
+            auto constant = executable.add_constant(Value(result.release_value()));
+            executable.replace<Op::Mov>(entry, dst, constant);
+            known_constants.set(dst, constant);
+            return;
+        }
+    }
+
+    if (lhs != instruction.lhs() || rhs != instruction.rhs())
+        executable.replace<OpType>(entry, dst, lhs, rhs);
+}
+
+template<typename OpType>
+static void fold_unary_op(PassPipelineExecutable& executable, PassPipelineExecutable::Entry& entry, KnownConstants& known_constants, auto fold)
+{
+    auto const& instruction = static_cast<OpType const&>(executable.instruction(entry));
+    auto dst = instruction.dst();
+    auto src = known_constants.constant_for(instruction.src()).value_or(instruction.src());
+    auto src_value = known_constants.foldable_value(src);
+
+    known_constants.forget(dst);
+
+    if (src_value.has_value()) {
+        if (auto result = fold(executable.vm(), *src_value); !result.is_error()) {
+            auto constant = executable.add_constant(result.release_value());
+            executable.replace<Op::Mov>(entry, dst, constant);
+            known_constants.set(dst, constant);
+            return;
+        }
+    }
+
+    if (src != instruction.src())
+        executable.replace<OpType>(entry, dst, src);
+}
+
+// Turns a conditional jump on a known value into an unconditional one. No target means "fall through".
+static void fold_conditional_jump(PassPipelineExecutable& executable, PassPipelineExecutable::Entry& entry, Optional<Label> target)
+{
+    if (!target.has_value()) {
+        executable.remove(entry);
+        return;
+    }
+    executable.replace<Op::Jump>(entry, *target);
+}
+
+void ConstantFolding::perform(PassPipelineExecutable& executable)
+{
+    KnownConstants known_constants { executable };
+
+    for (auto& entry : executable.entries()) {
+        if (entry.starts_basic_block)
+            known_constants.clear();
+        if (entry.is_removed)
+            continue;
+
+        auto& instruction = executable.instruction(entry);
+        switch (instruction.type()) {
+        case Instruction::Type::Mov: {
+            auto const& mov = static_cast<Op::Mov const&>(instruction);
+            auto dst = mov.dst();
+            auto src = known_constants.constant_for(mov.src());
+            known_constants.forget(dst);
+            if (!src.has_value())
+                break;
+            if (*src != mov.src())
+                executable.replace<Op::Mov>(entry, dst, *src);
+            known_constants.set(dst, *src);
+            break;
+        }
+
+#define __BYTECODE_OP(OpTitleCase, op_snake_case)                                                              \
+    case Instruction::Type::OpTitleCase:                                                                       \
+        fold_binary_op<Op::OpTitleCase>(executable, entry, known_constants, [](VM& vm, Value lhs, Value rhs) { \
+            return op_snake_case(vm, lhs, rhs);                                                                \
+        });                                                                                                    \
+        break;
+            JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__BYTECODE_OP)
+            __BYTECODE_OP(Div, div)
+            __BYTECODE_OP(Exp, exp)
+            __BYTECODE_OP(Mod, mod)
+            __BYTECODE_OP(LooselyEquals, loosely_equals)
+            __BYTECODE_OP(LooselyInequals, loosely_inequals)
+            __BYTECODE_OP(StrictlyEquals, strict_equals)
+            __BYTECODE_OP(StrictlyInequals, strict_inequals)
+#undef __BYTECODE_OP
+
+        case Instruction::Type::BitwiseNot:
+            fold_unary_op<Op::BitwiseNot>(executable, entry, known_constants, [](VM& vm, Value value) { return bitwise_not(vm, value); });
+            break;
+        case Instruction::Type::Not:
+            fold_unary_op<Op::Not>(executable, entry, known_constants, [](VM&, Value value) -> ThrowCompletionOr<Value> { return Value(!value.to_boolean()); });
+            break;
+        case Instruction::Type::UnaryPlus:
+            fold_unary_op<Op::UnaryPlus>(executable, entry, known_constants, [](VM& vm, Value value) { return unary_plus(vm, value); });
+            break;
+        case Instruction::Type::UnaryMinus:
+            fold_unary_op<Op::UnaryMinus>(executable, entry, known_constants, [](VM& vm, Value value) { return unary_minus(vm, value); });
+            break;
+
+        case Instruction::Type::JumpIf: {
+            auto const& jump = static_cast<Op::JumpIf const&>(instruction);
+            if (auto value = known_constants.foldable_value(jump.condition()); value.has_value())
+                fold_conditional_jump(executable, entry, value->to_boolean() ? jump.true_target() : jump.false_target());
+            break;
+        }
+        case Instruction::Type::JumpTrue: {
+            auto const& jump = static_cast<Op::JumpTrue const&>(instruction);
+            if (auto value = known_constants.foldable_value(jump.condition()); value.has_value())
+                fold_conditional_jump(executable, entry, value->to_boolean() ? Optional<Label> { jump.target() } : OptionalNone {});
+            break;
+        }
+        case Instruction::Type::JumpFalse: {
+            auto const& jump = static_cast<Op::JumpFalse const&>(instruction);
+            if (auto value = known_constants.foldable_value(jump.condition()); value.has_value())
+                fold_conditional_jump(executable, entry, value->to_boolean() ? OptionalNone {} : Optional<Label> { jump.target() });
+            break;
+        }
+        case Instruction::Type::JumpNullish: {
+            auto const& jump = static_cast<Op::JumpNullish const&>(instruction);
+            if (auto value = known_constants.foldable_value(jump.condition()); value.has_value())
+                fold_conditional_jump(executable, entry, value->is_nullish() ? jump.true_target() : jump.false_target());
+            break;
+        }
+        case Instruction::Type::JumpUndefined: {
+            auto const& jump = static_cast<Op::JumpUndefined const&>(instruction);
+            if (auto value = known_constants.foldable_value(jump.condition()); value.has_value())
+                fold_conditional_jump(executable, entry, value->is_undefined() ? jump.true_target() : jump.false_target());
+            break;
+        }
+
+#define __BYTECODE_OP(op_TitleCase, op_snake_case, ...)                                                                  \
+    case Instruction::Type::Jump##op_TitleCase: {                                                                        \
+        auto const& jump = static_cast<Op::Jump##op_TitleCase const&>(instruction);                                      \
+        auto lhs = known_constants.foldable_value(jump.lhs());                                                           \
+        auto rhs = known_constants.foldable_value(jump.rhs());                                                           \
+        if (!lhs.has_value() || !rhs.has_value())                                                                        \
+            break;                                                                                                       \
+        if (auto result = op_snake_case(executable.vm(), *lhs, *rhs); !result.is_error())                                \
+            fold_conditional_jump(executable, entry, result.release_value() ? jump.true_target() : jump.false_target()); \
+        break;                                                                                                           \
+    }
+            JS_ENUMERATE_COMPARISON_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+
+        default:
+            if (writes_locals_implicitly(instruction)) {
+                known_constants.clear();
+                break;
+            }
+            // We don't know which operands this instruction writes, so forget about all of them.
+            instruction.visit_operands([&](Operand& operand) {
+                known_constants.forget(operand);
+            });
+            break;
+        }
+    }
+}
+
+}
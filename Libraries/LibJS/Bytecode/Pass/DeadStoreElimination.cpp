@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void DeadStoreElimination::perform(PassPipelineExecutable& executable)
+{
+    // Removing a Mov can leave its source register unread as well, so repeat until nothing changes.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        auto uses = executable.count_register_uses();
+
+        for (auto& entry : executable.entries()) {
+            if (entry.is_removed)
+                continue;
+            auto const& instruction = executable.instruction(entry);
+            if (instruction.type() != Instruction::Type::Mov)
+                continue;
+
+            auto const& mov = static_cast<Op::Mov const&>(instruction);
+            if (mov.dst() == mov.src()) {
+                executable.remove(entry);
+                continue;
+            }
+
+            if (executable.is_temporary_register(mov.dst()) && uses[mov.dst().index()] == 1) {
+                if (mov.src().is_register())
+                    changed = true;
+                executable.remove(entry);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Don't chase long (or circular) chains of jumps forever.
+static constexpr size_t max_jump_threading_hops = 8;
+
+void JumpThreading::perform(PassPipelineExecutable& executable)
+{
+    auto& entries = executable.entries();
+
+    auto final_target = [&](size_t offset) {
+        for (size_t hop = 0; hop < max_jump_threading_hops; ++hop) {
+            auto index = executable.resolve_jump_target(offset);
+            if (!index.has_value())
+                break;
+            auto const& target = executable.instruction(entries[*index]);
+            if (target.type() != Instruction::Type::Jump)
+                break;
+            auto next_offset = static_cast<Op::Jump const&>(target).target().address();
+            if (next_offset == offset)
+                break;
+            offset = next_offset;
+        }
+        return offset;
+    };
+
+    for (auto& entry : entries) {
+        if (entry.is_removed)
+            continue;
+        executable.instruction(entry).visit_labels([&](Label& label) {
+            label.set_address(final_target(label.address()));
+        });
+    }
+
+    // A jump to the instruction right after it does nothing.
+    for (size_t i = 0; i < entries.size(); ++i) {
+        auto& entry = entries[i];
+        if (entry.is_removed)
+            continue;
+        auto const& instruction = executable.instruction(entry);
+        if (instruction.type() != Instruction::Type::Jump)
+            continue;
+        auto target = executable.resolve_jump_target(static_cast<Op::Jump const&>(instruction).target().address());
+        auto next = executable.resolve_jump_target(i + 1 < entries.size() ? entries[i + 1].offset : executable.executable().bytecode.size());
+        if (target.has_value() && target == next)
+            executable.remove(entry);
+    }
+}
+
+}
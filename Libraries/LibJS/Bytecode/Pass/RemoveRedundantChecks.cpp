@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void RemoveRedundantChecks::perform(PassPipelineExecutable& executable)
+{
+    // Operands known to be initialized (ThrowIfTDZ) or not nullish (ThrowIfNullish) at this point of the basic block.
+    HashTable<Operand> initialized;
+    HashTable<Operand> not_nullish;
+
+    auto is_tracked = [&](Operand operand) {
+        return operand.is_local() || executable.is_temporary_register(operand);
+    };
+
+    auto is_initialized = [&](Operand operand) {
+        if (auto value = executable.constant_value(operand); value.has_value())
+            return !value->is_special_empty_value();
+        return initialized.contains(operand);
+    };
+
+    auto is_not_nullish = [&](Operand operand) {
+        if (auto value = executable.constant_value(operand); value.has_value())
+            return !value->is_special_empty_value() && !value->is_nullish();
+        return not_nullish.contains(operand);
+    };
+
+    auto forget = [&](Operand operand) {
+        initialized.remove(operand);
+        not_nullish.remove(operand);
+    };
+
+    for (auto& entry : executable.entries()) {
+        if (entry.starts_basic_block) {
+            initialized.clear();
+            not_nullish.clear();
+        }
+        if (entry.is_removed)
+            continue;
+
+        auto& instruction = executable.instruction(entry);
+        switch (instruction.type()) {
+        case Instruction::Type::ThrowIfTDZ: {
+            auto src = static_cast<Op::ThrowIfTDZ const&>(instruction).src();
+            if (is_initialized(src))
+                executable.remove(entry);
+            else if (is_tracked(src))
+                initialized.set(src);
+            break;
+        }
+        case Instruction::Type::ThrowIfNullish: {
+            auto src = static_cast<Op::ThrowIfNullish const&>(instruction).src();
+            if (is_not_nullish(src))
+                executable.remove(entry);
+            else if (is_tracked(src))
+                not_nullish.set(src);
+            break;
+        }
+        case Instruction::Type::Mov: {
+            auto const& mov = static_cast<Op::Mov const&>(instruction);
+            auto src_is_initialized = is_initialized(mov.src());
+            auto src_is_not_nullish = is_not_nullish(mov.src());
+            forget(mov.dst());
+            if (!is_tracked(mov.dst()))
+                break;
+            if (src_is_initialized)
+                initialized.set(mov.dst());
+            if (src_is_not_nullish)
+                not_nullish.set(mov.dst());
+            break;
+        }
+        default:
+            if (writes_locals_implicitly(instruction)) {
+                initialized.clear();
+                not_nullish.clear();
+                break;
+            }
+            if (auto written = written_operand(instruction); written.has_value()) {
+                forget(*written);
+                break;
+            }
+            instruction.visit_operands([&](Operand& operand) {
+                forget(operand);
+            });
+            break;
+        }
+    }
+}
+
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BinarySearch.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Bytecode/Register.h>
+
+namespace JS::Bytecode {
+
+PassPipelineExecutable::PassPipelineExecutable(VM& vm, Executable& executable)
+    : m_vm(vm)
+    , m_executable(executable)
+{
+    InstructionStreamIterator it(executable.bytecode, &executable);
+    while (!it.at_end()) {
+        m_entries.append({ .offset = it.offset() });
+        ++it;
+    }
+
+    auto mark_basic_block_start = [&](size_t offset) {
+        if (auto index = index_for_offset(offset); index.has_value())
+            m_entries[*index].starts_basic_block = true;
+    };
+
+    for (auto offset : executable.basic_block_start_offsets)
+        mark_basic_block_start(offset);
+
+    for (auto const& handlers : executable.exception_handlers) {
+        mark_basic_block_start(handlers.start_offset);
+        mark_basic_block_start(handlers.end_offset);
+        if (handlers.handler_offset.has_value())
+            mark_basic_block_start(*handlers.handler_offset);
+        if (handlers.finalizer_offset.has_value())
+            mark_basic_block_start(*handlers.finalizer_offset);
+    }
+
+    // Every jump target starts a block, and so does the instruction after anything that can jump.
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        bool has_labels = false;
+        instruction(m_entries[i]).visit_labels([&](Label& label) {
+            has_labels = true;
+            mark_basic_block_start(label.address());
+        });
+        if (has_labels && i + 1 < m_entries.size())
+            m_entries[i + 1].starts_basic_block = true;
+    }
+}
+
+Instruction& PassPipelineExecutable::instruction(Entry& entry)
+{
+    if (!entry.replacement.is_empty())
+        return *reinterpret_cast<Instruction*>(entry.replacement.data());
+    return *reinterpret_cast<Instruction*>(m_executable.bytecode.data() + entry.offset);
+}
+
+Instruction const& PassPipelineExecutable::instruction(Entry const& entry) const
+{
+    if (!entry.replacement.is_empty())
+        return *reinterpret_cast<Instruction const*>(entry.replacement.data());
+    return *reinterpret_cast<Instruction const*>(m_executable.bytecode.data() + entry.offset);
+}
+
+Optional<size_t> PassPipelineExecutable::index_for_offset(size_t offset) const
+{
+    size_t index = 0;
+    auto* entry = binary_search(m_entries, offset, &index, [](size_t needle, Entry const& entry) {
+        return static_cast<int>(needle > entry.offset) - static_cast<int>(needle < entry.offset);
+    });
+    if (!entry)
+        return {};
+    return index;
+}
+
+Optional<size_t> PassPipelineExecutable::resolve_jump_target(size_t offset) const
+{
+    auto index = index_for_offset(offset);
+    if (!index.has_value())
+        return {};
+    for (auto i = *index; i < m_entries.size(); ++i) {
+        if (!m_entries[i].is_removed)
+            return i;
+    }
+    return {};
+}
+
+Optional<size_t> PassPipelineExecutable::next_in_basic_block(size_t index) const
+{
+    for (auto i = index + 1; i < m_entries.size(); ++i) {
+        if (m_entries[i].starts_basic_block)
+            return {};
+        if (!m_entries[i].is_removed)
+            return i;
+    }
+    return {};
+}
+
+Optional<Value> PassPipelineExecutable::constant_value(Operand operand) const
+{
+    if (!operand.is_constant())
+        return {};
+    auto index = operand.index() - m_executable.number_of_registers;
+    VERIFY(index < m_executable.constants.size());
+    return m_executable.constants[index];
+}
+
+Operand PassPipelineExecutable::add_constant(Value value)
+{
+    VERIFY(!value.is_special_empty_value());
+    for (size_t i = 0; i < m_executable.constants.size(); ++i) {
+        if (m_executable.constants[i].encoded() == value.encoded())
+            return Operand(Operand::Type::Constant, m_executable.number_of_registers + i);
+    }
+
+    // Locals and arguments live after the constants, so they move up once this pass is done. See finish_pass().
+    m_executable.constants.append(value);
+    ++m_pending_constant_count;
+    return Operand(Operand::Type::Constant, m_executable.number_of_registers + m_executable.constants.size() - 1);
+}
+
+bool PassPipelineExecutable::is_temporary_register(Operand operand) const
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+Vector<u32> PassPipelineExecutable::count_register_uses()
+{
+    Vector<u32> uses;
+    uses.resize(m_executable.number_of_registers);
+    for (auto& entry : m_entries) {
+        if (entry.is_removed)
+            continue;
+        instruction(entry).visit_operands([&](Operand& operand) {
+            if (operand.is_register())
+                ++uses[operand.index()];
+        });
+    }
+    return uses;
+}
+
+size_t PassPipelineExecutable::instruction_count() const
+{
+    size_t count = 0;
+    for (auto const& entry : m_entries) {
+        if (!entry.is_removed)
+            ++count;
+    }
+    return count;
+}
+
+void PassPipelineExecutable::finish_pass()
+{
+    if (m_pending_constant_count == 0)
+        return;
+
+    auto shift = static_cast<u32>(m_pending_constant_count);
+    for (auto& entry : m_entries) {
+        if (entry.is_removed)
+            continue;
+        instruction(entry).visit_operands([shift](Operand& operand) {
+            if (operand.type() == Operand::Type::Local || operand.type() == Operand::Type::Argument)
+                operand.offset_index_by(shift);
+        });
+    }
+    m_executable.local_index_base += shift;
+    m_executable.argument_index_base += shift;
+    m_pending_constant_count = 0;
+}
+
+void PassPipelineExecutable::apply()
+{
+    VERIFY(m_pending_constant_count == 0);
+    VERIFY(m_executable.local_index_base == m_executable.number_of_registers + m_executable.constants.size());
+    VERIFY(m_executable.argument_index_base == m_executable.local_index_base + m_executable.local_variable_names.size());
+
+    auto old_size = m_executable.bytecode.size();
+
+    // A removed instruction maps to the offset of the next instruction that survived.
+    Vector<size_t> new_offsets;
+    new_offsets.ensure_capacity(m_entries.size());
+    Vector<u8> bytecode;
+    bytecode.ensure_capacity(old_size);
+    for (auto& entry : m_entries) {
+        new_offsets.unchecked_append(bytecode.size());
+        if (entry.is_removed)
+            continue;
+        auto& instruction = this->instruction(entry);
+        bytecode.append(reinterpret_cast<u8 const*>(&instruction), instruction.length());
+    }
+
+    auto map_offset = [&](size_t offset) -> size_t {
+        if (offset == old_size)
+            return bytecode.size();
+        return new_offsets[index_for_offset(offset).value()];
+    };
+
+    InstructionStreamIterator it(bytecode);
+    while (!it.at_end()) {
+        auto& instruction = const_cast<Instruction&>(*it);
+        instruction.visit_labels([&](Label& label) {
+            label.set_address(map_offset(label.address()));
+        });
+        ++it;
+    }
+
+    for (auto& handlers : m_executable.exception_handlers) {
+        handlers.start_offset = map_offset(handlers.start_offset);
+        handlers.end_offset = map_offset(handlers.end_offset);
+        if (handlers.handler_offset.has_value())
+            handlers.handler_offset = map_offset(*handlers.handler_offset);
+        if (handlers.finalizer_offset.has_value())
+            handlers.finalizer_offset = map_offset(*handlers.finalizer_offset);
+    }
+
+    Vector<size_t> basic_block_start_offsets;
+    basic_block_start_offsets.ensure_capacity(m_executable.basic_block_start_offsets.size());
+    for (auto offset : m_executable.basic_block_start_offsets) {
+        auto new_offset = map_offset(offset);
+        if (new_offset == bytecode.size())
+            continue;
+        if (!basic_block_start_offsets.is_empty() && basic_block_start_offsets.last() == new_offset)
+            continue;
+        basic_block_start_offsets.unchecked_append(new_offset);
+    }
+
+    HashMap<size_t, SourceRecord> source_map;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].is_removed)
+            continue;
+        if (auto source_record = m_executable.source_map.get(m_entries[i].offset); source_record.has_value())
+            source_map.set(new_offsets[i], *source_record);
+    }
+
+    m_executable.bytecode = move(bytecode);
+    m_executable.basic_block_start_offsets = move(basic_block_start_offsets);
+    m_executable.source_map = move(source_map);
+    m_entries.clear();
+}
+
+void PassManager::perform(VM& vm, Executable& executable)
+{
+    PassPipelineExecutable pipeline { vm, executable };
+
+    auto instruction_count_before = pipeline.instruction_count();
+    auto register_count_before = executable.number_of_registers;
+
+    Vector<size_t> removed_instruction_counts;
+    removed_instruction_counts.ensure_capacity(m_passes.size());
+    for (auto& pass : m_passes) {
+        auto instruction_count = pipeline.instruction_count();
+        pass->perform(pipeline);
+        pipeline.finish_pass();
+        removed_instruction_counts.unchecked_append(instruction_count - pipeline.instruction_count());
+    }
+
+    auto instruction_count_after = pipeline.instruction_count();
+    pipeline.apply();
+
+    if (g_dump_bytecode) {
+        warnln("\033[37;1mBytecode optimizations\033[0m \"{}\": {} -> {} instructions, {} -> {} registers",
+            executable.name,
+            instruction_count_before,
+            instruction_count_after,
+            register_count_before,
+            executable.number_of_registers);
+        for (size_t i = 0; i < m_passes.size(); ++i)
+            warnln("    {}: removed {} instructions", m_passes[i]->name(), removed_instruction_counts[i]);
+    }
+}
+
+namespace Passes {
+
+Optional<Operand> written_operand(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::Mov:
+        return static_cast<Op::Mov const&>(instruction).dst();
+#define __BYTECODE_OP(OpTitleCase, ...)  \
+    case Instruction::Type::OpTitleCase: \
+        return static_cast<Op::OpTitleCase const&>(instruction).dst();
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    default:
+        return {};
+    }
+}
+
+bool writes_locals_implicitly(Instruction const& instruction)
+{
+    // Block-level function declarations are stored straight into their locals. See BlockDeclarationInstantiation.
+    return instruction.type() == Instruction::Type::BlockDeclarationInstantiation;
+}
+
+}
+
+void optimize(VM& vm, Executable& executable)
+{
+    if (!g_optimize_bytecode)
+        return;
+
+    static PassManager* s_pass_manager = [] {
+        auto* pass_manager = new PassManager;
+        pass_manager->add<Passes::ConstantFolding>();
+        pass_manager->add<Passes::JumpThreading>();
+        pass_manager->add<Passes::RemoveRedundantChecks>();
+        pass_manager->add<Passes::CoalesceMoves>();
+        pass_manager->add<Passes::DeadStoreElimination>();
+        pass_manager->add<Passes::CompactRegisters>();
+        return pass_manager;
+    }();
+
+    if (g_dump_bytecode) {
+        warnln("\033[37;1mBefore optimization\033[0m");
+        executable.dump();
+    }
+
+    s_pass_manager->perform(vm, executable);
+}
+
+}
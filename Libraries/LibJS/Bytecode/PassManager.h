@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Operand.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// A mutable view of a finished Executable's instruction stream.
+// Passes remove and replace instructions here; apply() then lays out the new bytecode and relinks
+// labels, exception handlers, basic block starts and the source map.
+class PassPipelineExecutable {
+public:
+    PassPipelineExecutable(VM&, Executable&);
+
+    struct Entry {
+        // Offset of the instruction in the original bytecode. Labels keep pointing at these until apply().
+        size_t offset { 0 };
+        bool starts_basic_block { false };
+        bool is_removed { false };
+        Vector<u8> replacement;
+    };
+
+    VM& vm() { return m_vm; }
+    Executable& executable() { return m_executable; }
+    Vector<Entry>& entries() { return m_entries; }
+
+    Instruction& instruction(Entry&);
+    Instruction const& instruction(Entry const&) const;
+
+    template<typename OpType, typename... Args>
+    void replace(Entry& entry, Args&&... args)
+    {
+        static_assert(!OpType::IsVariableLength);
+        entry.replacement.resize(sizeof(OpType));
+        new (entry.replacement.data()) OpType(forward<Args>(args)...);
+    }
+
+    void remove(Entry& entry) { entry.is_removed = true; }
+
+    // Returns the index of the first instruction that will run when jumping to the given (original) offset.
+    Optional<size_t> resolve_jump_target(size_t offset) const;
+
+    // Returns the index of the next instruction that hasn't been removed, if it is in the same basic block.
+    Optional<size_t> next_in_basic_block(size_t index) const;
+
+    Optional<Value> constant_value(Operand) const;
+    Operand add_constant(Value);
+
+    bool is_temporary_register(Operand) const;
+
+    // Counts how often each register is mentioned by the remaining instructions.
+    Vector<u32> count_register_uses();
+
+    size_t instruction_count() const;
+
+    // Called by the PassManager between passes.
+    void finish_pass();
+
+    void apply();
+
+private:
+    Optional<size_t> index_for_offset(size_t offset) const;
+
+    VM& m_vm;
+    Executable& m_executable;
+    Vector<Entry> m_entries;
+    size_t m_pending_constant_count { 0 };
+};
+
+class Pass {
+public:
+    virtual ~Pass() = default;
+
+    virtual StringView name() const = 0;
+    virtual void perform(PassPipelineExecutable&) = 0;
+};
+
+class PassManager {
+public:
+    template<typename PassType>
+    void add()
+    {
+        m_passes.append(make<PassType>());
+    }
+
+    void perform(VM&, Executable&);
+
+private:
+    Vector<NonnullOwnPtr<Pass>> m_passes;
+};
+
+namespace Passes {
+
+// Folds operations on known constants (including values moved into a register or local earlier in the
+// same basic block) and turns conditional jumps on constants into unconditional ones.
+class ConstantFolding final : public Pass {
+public:
+    virtual StringView name() const override { return "ConstantFolding"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Retargets jumps that land on an unconditional Jump, and removes jumps to the next instruction.
+class JumpThreading final : public Pass {
+public:
+    virtual StringView name() const override { return "JumpThreading"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Removes ThrowIfTDZ and ThrowIfNullish checks of operands already checked earlier in the basic block.
+class RemoveRedundantChecks final : public Pass {
+public:
+    virtual StringView name() const override { return "RemoveRedundantChecks"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Makes an instruction that writes a temporary register write straight into the destination of the
+// Mov that immediately consumes it.
+class CoalesceMoves final : public Pass {
+public:
+    virtual StringView name() const override { return "CoalesceMoves"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Removes Movs into temporary registers that are never read, and Movs of an operand to itself.
+class DeadStoreElimination final : public Pass {
+public:
+    virtual StringView name() const override { return "DeadStoreElimination"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Renumbers the temporary registers still in use so the register file shrinks.
+class CompactRegisters final : public Pass {
+public:
+    virtual StringView name() const override { return "CompactRegisters"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+// Returns the only operand written by instructions whose effects the passes understand precisely.
+Optional<Operand> written_operand(Instruction const&);
+
+// Returns true for instructions that may write locals without mentioning them as operands.
+bool writes_locals_implicitly(Instruction const&);
+
+}
+
+void optimize(VM&, Executable&);
+
+}
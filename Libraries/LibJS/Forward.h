@@ -332,4 +332,11 @@ class Register;
 
 }
 
+namespace JIT {
+
+class Compiler;
+class NativeExecutable;
+
+}
+
 }
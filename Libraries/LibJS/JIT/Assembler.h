@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace JS::JIT {
+
+// A tiny x86-64 assembler with just enough instructions for the baseline compiler.
+struct Assembler {
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX = 1,
+        RDX = 2,
+        RBX = 3,
+        RSP = 4,
+        RBP = 5,
+        RSI = 6,
+        RDI = 7,
+        R8 = 8,
+        R9 = 9,
+        R10 = 10,
+        R11 = 11,
+        R12 = 12,
+        R13 = 13,
+        R14 = 14,
+        R15 = 15,
+    };
+
+    enum class Condition : u8 {
+        Overflow = 0x0,
+        UnsignedGreaterThanOrEqualTo = 0x3,
+        EqualTo = 0x4,
+        NotEqualTo = 0x5,
+        SignedLessThan = 0xC,
+        SignedGreaterThanOrEqualTo = 0xD,
+        SignedLessThanOrEqualTo = 0xE,
+        SignedGreaterThan = 0xF,
+    };
+
+    // A native code position that can be jumped to before it has been bound.
+    struct Label {
+        Optional<size_t> offset;
+        Vector<size_t> jump_sites;
+    };
+
+    explicit Assembler(Vector<u8>& output)
+        : m_output(output)
+    {
+    }
+
+    size_t offset() const { return m_output.size(); }
+
+    void emit8(u8 value) { m_output.append(value); }
+
+    void emit32(u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            emit8((value >> (i * 8)) & 0xff);
+    }
+
+    void emit64(u64 value)
+    {
+        for (size_t i = 0; i < 8; ++i)
+            emit8((value >> (i * 8)) & 0xff);
+    }
+
+    void patch32(size_t at, u32 value)
+    {
+        for (size_t i = 0; i < 4; ++i)
+            m_output[at + i] = (value >> (i * 8)) & 0xff;
+    }
+
+    // mov dst, imm64
+    void mov64(Reg dst, u64 imm)
+    {
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xb8 | encode(dst));
+        emit64(imm);
+    }
+
+    // mov dst, src
+    void mov64(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x89);
+        emit_modrm_register(src, dst);
+    }
+
+    // mov dst, [base + offset]
+    void load64(Reg dst, Reg base, i32 offset)
+    {
+        emit_rex(true, dst, base);
+        emit8(0x8b);
+        emit_modrm_memory(dst, base, offset);
+    }
+
+    // mov [base + offset], src
+    void store64(Reg base, i32 offset, Reg src)
+    {
+        emit_rex(true, src, base);
+        emit8(0x89);
+        emit_modrm_memory(src, base, offset);
+    }
+
+    // mov qword [base + offset], sign_extend(imm32)
+    void store64(Reg base, i32 offset, i32 imm)
+    {
+        emit_rex(true, Reg::RAX, base);
+        emit8(0xc7);
+        emit_modrm_memory(Reg::RAX, base, offset);
+        emit32(imm);
+    }
+
+    // shr dst, imm8
+    void shift_right64(Reg dst, u8 amount)
+    {
+        emit_rex(true, Reg::RAX, dst);
+        emit8(0xc1);
+        emit_modrm_register(static_cast<Reg>(5), dst);
+        emit8(amount);
+    }
+
+    // or dst, src
+    void bitwise_or64(Reg dst, Reg src)
+    {
+        emit_rex(true, src, dst);
+        emit8(0x09);
+        emit_modrm_register(src, dst);
+    }
+
+    // test lhs, rhs
+    void test64(Reg lhs, Reg rhs)
+    {
+        emit_rex(true, rhs, lhs);
+        emit8(0x85);
+        emit_modrm_register(rhs, lhs);
+    }
+
+    // add dst, src (32-bit)
+    void add32(Reg dst, Reg src)
+    {
+        emit_rex(false, src, dst);
+        emit8(0x01);
+        emit_modrm_register(src, dst);
+    }
+
+    // add dst, imm32 (32-bit)
+    void add32(Reg dst, i32 imm)
+    {
+        emit_rex(false, Reg::RAX, dst);
+        emit8(0x81);
+        emit_modrm_register(Reg::RAX, dst);
+        emit32(imm);
+    }
+
+    // test dst, dst (32-bit)
+    void test32(Reg reg)
+    {
+        emit_rex(false, reg, reg);
+        emit8(0x85);
+        emit_modrm_register(reg, reg);
+    }
+
+    // cmp lhs, rhs (32-bit)
+    void compare32(Reg lhs, Reg rhs)
+    {
+        emit_rex(false, rhs, lhs);
+        emit8(0x39);
+        emit_modrm_register(rhs, lhs);
+    }
+
+    // cmp lhs, imm32 (32-bit)
+    void compare32(Reg lhs, i32 imm)
+    {
+        emit_rex(false, Reg::RAX, lhs);
+        emit8(0x81);
+        emit_modrm_register(static_cast<Reg>(7), lhs);
+        emit32(imm);
+    }
+
+    // setcc dst8; movzx dst, dst8
+    void set_if(Condition condition, Reg dst)
+    {
+        // NOTE: A REX prefix makes the low byte of RSP..RDI addressable instead of AH..BH.
+        emit8(0x40 | (encode_extended(dst) ? 0x01 : 0));
+        emit8(0x0f);
+        emit8(0x90 | to_underlying(condition));
+        emit_modrm_register(Reg::RAX, dst);
+
+        emit_rex(false, dst, dst, true);
+        emit8(0x0f);
+        emit8(0xb6);
+        emit_modrm_register(dst, dst);
+    }
+
+    void push(Reg reg)
+    {
+        if (encode_extended(reg))
+            emit8(0x41);
+        emit8(0x50 | encode(reg));
+    }
+
+    void pop(Reg reg)
+    {
+        if (encode_extended(reg))
+            emit8(0x41);
+        emit8(0x58 | encode(reg));
+    }
+
+    // call reg
+    void call(Reg reg)
+    {
+        emit_rex(false, Reg::RAX, reg);
+        emit8(0xff);
+        emit_modrm_register(static_cast<Reg>(2), reg);
+    }
+
+    // jmp reg
+    void jump(Reg reg)
+    {
+        emit_rex(false, Reg::RAX, reg);
+        emit8(0xff);
+        emit_modrm_register(static_cast<Reg>(4), reg);
+    }
+
+    // jmp rel32, returning the offset of the rel32 field so it can be patched later.
+    size_t jump_with_unresolved_target()
+    {
+        emit8(0xe9);
+        auto site = offset();
+        emit32(0);
+        return site;
+    }
+
+    // jcc rel32, returning the offset of the rel32 field so it can be patched later.
+    size_t jump_if_with_unresolved_target(Condition condition)
+    {
+        emit8(0x0f);
+        emit8(0x80 | to_underlying(condition));
+        auto site = offset();
+        emit32(0);
+        return site;
+    }
+
+    void jump(Label& label)
+    {
+        add_jump_site(label, jump_with_unresolved_target());
+    }
+
+    void jump_if(Condition condition, Label& label)
+    {
+        add_jump_site(label, jump_if_with_unresolved_target(condition));
+    }
+
+    void resolve_jump(size_t site, size_t target)
+    {
+        patch32(site, static_cast<u32>(static_cast<i64>(target) - static_cast<i64>(site + 4)));
+    }
+
+    void link(Label& label)
+    {
+        VERIFY(!label.offset.has_value());
+        label.offset = offset();
+        for (auto site : label.jump_sites)
+            resolve_jump(site, *label.offset);
+        label.jump_sites.clear();
+    }
+
+    void ret() { emit8(0xc3); }
+
+    void trap()
+    {
+        // ud2
+        emit8(0x0f);
+        emit8(0x0b);
+    }
+
+private:
+    static constexpr u8 encode(Reg reg) { return to_underlying(reg) & 7; }
+    static constexpr bool encode_extended(Reg reg) { return to_underlying(reg) >= 8; }
+
+    void emit_rex(bool is_64bit, Reg reg, Reg rm, bool force = false)
+    {
+        u8 rex = 0x40;
+        if (is_64bit)
+            rex |= 0x08;
+        if (encode_extended(reg))
+            rex |= 0x04;
+        if (encode_extended(rm))
+            rex |= 0x01;
+        if (rex != 0x40 || force)
+            emit8(rex);
+    }
+
+    void emit_modrm_register(Reg reg, Reg rm)
+    {
+        emit8(0xc0 | (encode(reg) << 3) | encode(rm));
+    }
+
+    void emit_modrm_memory(Reg reg, Reg base, i32 offset)
+    {
+        // Always use a 32-bit displacement; this sidesteps the RBP/R13 special case for mod=00.
+        emit8(0x80 | (encode(reg) << 3) | encode(base));
+        // RSP and R12 as a base need a SIB byte.
+        if (encode(base) == encode(Reg::RSP))
+            emit8(0x24);
+        emit32(static_cast<u32>(offset));
+    }
+
+    void add_jump_site(Label& label, size_t site)
+    {
+        if (label.offset.has_value())
+            resolve_jump(site, *label.offset);
+        else
+            label.jump_sites.append(site);
+    }
+
+    Vector<u8>& m_output;
+};
+
+}
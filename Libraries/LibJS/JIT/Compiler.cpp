@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Platform.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/Value.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::JIT {
+
+using Reg = Assembler::Reg;
+using Condition = Assembler::Condition;
+
+// Callee-saved registers that hold our state across calls into C++.
+static constexpr auto INTERPRETER = Reg::R12;
+static constexpr auto REGISTERS = Reg::R13;
+static constexpr auto PROGRAM_COUNTER = Reg::R14;
+
+static ThrowCompletionOr<bool> loosely_equals(VM& vm, Value lhs, Value rhs) { return is_loosely_equal(vm, lhs, rhs); }
+static ThrowCompletionOr<bool> loosely_inequals(VM& vm, Value lhs, Value rhs) { return !TRY(is_loosely_equal(vm, lhs, rhs)); }
+static ThrowCompletionOr<bool> strict_equals(VM&, Value lhs, Value rhs) { return is_strictly_equal(lhs, rhs); }
+static ThrowCompletionOr<bool> strict_inequals(VM&, Value lhs, Value rhs) { return !is_strictly_equal(lhs, rhs); }
+
+// For two Int32 operands, every comparison jump boils down to a single signed 32-bit compare.
+#define JS_ENUMERATE_JIT_COMPARISON_JUMPS(X)                              \
+    X(LessThan, SignedLessThan, less_than)                                \
+    X(LessThanEquals, SignedLessThanOrEqualTo, less_than_equals)          \
+    X(GreaterThan, SignedGreaterThan, greater_than)                       \
+    X(GreaterThanEquals, SignedGreaterThanOrEqualTo, greater_than_equals) \
+    X(LooselyEquals, EqualTo, loosely_equals)                             \
+    X(LooselyInequals, NotEqualTo, loosely_inequals)                      \
+    X(StrictlyEquals, EqualTo, strict_equals)                             \
+    X(StrictlyInequals, NotEqualTo, strict_inequals)
+
+template<typename OpType>
+struct ComparisonJump {
+    static constexpr bool is_comparison_jump = false;
+};
+
+#define DEFINE_COMPARISON_JUMP(op_TitleCase, int32_condition, op_snake_case)                                         \
+    template<>                                                                                                       \
+    struct ComparisonJump<Bytecode::Op::Jump##op_TitleCase> {                                                        \
+        static constexpr bool is_comparison_jump = true;                                                             \
+        static constexpr auto condition = Condition::int32_condition;                                                \
+        static ThrowCompletionOr<bool> compare(VM& vm, Value lhs, Value rhs) { return op_snake_case(vm, lhs, rhs); } \
+    };
+JS_ENUMERATE_JIT_COMPARISON_JUMPS(DEFINE_COMPARISON_JUMP)
+#undef DEFINE_COMPARISON_JUMP
+
+static i32 operand_offset(Bytecode::Operand operand)
+{
+    return static_cast<i32>(operand.index() * sizeof(Value));
+}
+
+static void const* address_of(auto function)
+{
+    return reinterpret_cast<void const*>(function);
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& executable)
+{
+#if JS_JIT_SUPPORTED
+    Compiler compiler { executable };
+    return compiler.compile_executable();
+#else
+    (void)executable;
+    return nullptr;
+#endif
+}
+
+OwnPtr<NativeExecutable> Compiler::compile_executable()
+{
+    emit_trampoline();
+
+    Bytecode::InstructionStreamIterator it(m_executable.bytecode, &m_executable);
+    while (!it.at_end()) {
+        auto& instruction = *it;
+        auto bytecode_offset = it.offset();
+        m_mappings.append({ static_cast<u32>(bytecode_offset), static_cast<u32>(m_assembler.offset()) });
+
+        bool compiled = false;
+        switch (instruction.type()) {
+#define COMPILE_INSTRUCTION(name)                                                                             \
+    case Bytecode::Instruction::Type::name:                                                                   \
+        compiled = compile_instruction(static_cast<Bytecode::Op::name const&>(instruction), bytecode_offset); \
+        break;
+            ENUMERATE_BYTECODE_OPS(COMPILE_INSTRUCTION)
+#undef COMPILE_INSTRUCTION
+        default:
+            VERIFY_NOT_REACHED();
+        }
+
+        if (!compiled) {
+            dbgln_if(JS_BYTECODE_DEBUG, "JIT: Can't compile {} in {}", instruction.to_byte_string(m_executable), m_executable.name);
+            return nullptr;
+        }
+        ++it;
+    }
+
+    // Bytecode never falls off the end of an executable.
+    m_assembler.trap();
+
+    emit_exit();
+
+    for (auto const& jump : m_unresolved_jumps) {
+        auto native_offset = NativeExecutable::find_native_offset(m_mappings, jump.bytecode_offset);
+        if (!native_offset.has_value())
+            return nullptr;
+        m_assembler.resolve_jump(jump.site, *native_offset);
+    }
+
+    dbgln_if(JS_BYTECODE_DEBUG, "JIT: Compiled {} bytes of bytecode in {} to {} bytes of native code", m_executable.bytecode.size(), m_executable.name, m_output.size());
+
+    return NativeExecutable::create(m_output, move(m_mappings), *m_exit.offset);
+}
+
+template<typename OpType>
+bool Compiler::compile_instruction(OpType const& instruction, size_t bytecode_offset)
+{
+    using namespace Bytecode::Op;
+
+    if constexpr (IsSame<OpType, Mov>) {
+        // Cell pointers have to go through the GC write barrier.
+        Assembler::Label slow_case;
+        Assembler::Label done;
+        load_operand(Reg::RAX, instruction.src());
+        jump_if_cell(Reg::RAX, Reg::RDX, slow_case);
+        store_operand(instruction.dst(), Reg::RAX);
+        m_assembler.jump(done);
+
+        m_assembler.link(slow_case);
+        call_slow_path(address_of(&execute_slow_path<OpType>), instruction, bytecode_offset);
+        m_assembler.link(done);
+    } else if constexpr (IsSame<OpType, Add>) {
+        Assembler::Label slow_case;
+        Assembler::Label done;
+        load_operand(Reg::RAX, instruction.lhs());
+        load_operand(Reg::RCX, instruction.rhs());
+        jump_unless_int32(Reg::RAX, Reg::RDX, slow_case);
+        jump_unless_int32(Reg::RCX, Reg::RDX, slow_case);
+        m_assembler.add32(Reg::RAX, Reg::RCX);
+        m_assembler.jump_if(Condition::Overflow, slow_case);
+        box_int32(Reg::RAX, Reg::RCX);
+        store_operand(instruction.dst(), Reg::RAX);
+        m_assembler.jump(done);
+
+        m_assembler.link(slow_case);
+        call_slow_path(address_of(&execute_slow_path<OpType>), instruction, bytecode_offset);
+        jump_to_returned_address_if_not_null();
+        m_assembler.link(done);
+    } else if constexpr (IsSame<OpType, LessThan>) {
+        Assembler::Label slow_case;
+        Assembler::Label done;
+        load_operand(Reg::RAX, instruction.lhs());
+        load_operand(Reg::RCX, instruction.rhs());
+        jump_unless_int32(Reg::RAX, Reg::RDX, slow_case);
+        jump_unless_int32(Reg::RCX, Reg::RDX, slow_case);
+        m_assembler.compare32(Reg::RAX, Reg::RCX);
+        m_assembler.set_if(Condition::SignedLessThan, Reg::RAX);
+        box_boolean(Reg::RAX, Reg::RCX);
+        store_operand(instruction.dst(), Reg::RAX);
+        m_assembler.jump(done);
+
+        m_assembler.link(slow_case);
+        call_slow_path(address_of(&execute_slow_path<OpType>), instruction, bytecode_offset);
+        jump_to_returned_address_if_not_null();
+        m_assembler.link(done);
+    } else if constexpr (IsSame<OpType, Increment>) {
+        Assembler::Label slow_case;
+        Assembler::Label done;
+        load_operand(Reg::RAX, instruction.dst());
+        jump_unless_int32(Reg::RAX, Reg::RDX, slow_case);
+        m_assembler.add32(Reg::RAX, 1);
+        m_assembler.jump_if(Condition::Overflow, slow_case);
+        box_int32(Reg::RAX, Reg::RCX);
+        store_operand(instruction.dst(), Reg::RAX);
+        m_assembler.jump(done);
+
+        m_assembler.link(slow_case);
+        call_slow_path(address_of(&execute_slow_path<OpType>), instruction, bytecode_offset);
+        jump_to_returned_address_if_not_null();
+        m_assembler.link(done);
+    } else if constexpr (IsSame<OpType, Jump>) {
+        jump_to_bytecode_offset(instruction.target().address());
+    } else if constexpr (IsSame<OpType, JumpIf>) {
+        compile_boolean_jump(instruction, bytecode_offset, instruction.condition(), address_of(&control_flow_slow_path<OpType>), instruction.true_target().address(), instruction.false_target().address());
+    } else if constexpr (IsSame<OpType, JumpTrue>) {
+        compile_boolean_jump(instruction, bytecode_offset, instruction.condition(), address_of(&control_flow_slow_path<OpType>), instruction.target().address(), {});
+    } else if constexpr (IsSame<OpType, JumpFalse>) {
+        compile_boolean_jump(instruction, bytecode_offset, instruction.condition(), address_of(&control_flow_slow_path<OpType>), {}, instruction.target().address());
+    } else if constexpr (ComparisonJump<OpType>::is_comparison_jump) {
+        compile_int32_comparison_jump(instruction, bytecode_offset, ComparisonJump<OpType>::condition);
+    } else if constexpr (IsOneOf<OpType, JumpNullish, JumpUndefined>) {
+        call_slow_path(address_of(&control_flow_slow_path<OpType>), instruction, bytecode_offset);
+        m_assembler.jump(Reg::RAX);
+    } else if constexpr (IsSame<OpType, EnterUnwindContext>) {
+        call_slow_path(address_of(&control_flow_slow_path<OpType>), instruction, bytecode_offset);
+        jump_to_bytecode_offset(instruction.entry_point().address());
+    } else if constexpr (IsOneOf<OpType, End, Return, Await, Yield>) {
+        call_slow_path(address_of(&control_flow_slow_path<OpType>), instruction, bytecode_offset);
+        m_assembler.jump(m_exit);
+    } else if constexpr (IsOneOf<OpType, ContinuePendingUnwind, ScheduleJump>) {
+        // FIXME: These depend on the interpreter's scheduled jump state. Executables using them stay in the interpreter for now.
+        return false;
+    } else {
+        call_slow_path(address_of(&execute_slow_path<OpType>), instruction, bytecode_offset);
+        jump_to_returned_address_if_not_null();
+    }
+    return true;
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison_jump(OpType const& instruction, size_t bytecode_offset, Condition condition)
+{
+    Assembler::Label slow_case;
+    load_operand(Reg::RAX, instruction.lhs());
+    load_operand(Reg::RCX, instruction.rhs());
+    jump_unless_int32(Reg::RAX, Reg::RDX, slow_case);
+    jump_unless_int32(Reg::RCX, Reg::RDX, slow_case);
+    m_assembler.compare32(Reg::RAX, Reg::RCX);
+    jump_if_to_bytecode_offset(condition, instruction.true_target().address());
+    jump_to_bytecode_offset(instruction.false_target().address());
+
+    m_assembler.link(slow_case);
+    call_slow_path(address_of(&control_flow_slow_path<OpType>), instruction, bytecode_offset);
+    m_assembler.jump(Reg::RAX);
+}
+
+void Compiler::compile_boolean_jump(Bytecode::Instruction const& instruction, size_t bytecode_offset, Bytecode::Operand condition, void const* slow_path, Optional<size_t> true_target, Optional<size_t> false_target)
+{
+    Assembler::Label slow_case;
+    Assembler::Label fall_through;
+    load_operand(Reg::RAX, condition);
+    jump_unless_boolean(Reg::RAX, Reg::RDX, slow_case);
+    m_assembler.test32(Reg::RAX);
+    if (true_target.has_value())
+        jump_if_to_bytecode_offset(Condition::NotEqualTo, *true_target);
+    else
+        m_assembler.jump_if(Condition::NotEqualTo, fall_through);
+    if (false_target.has_value())
+        jump_to_bytecode_offset(*false_target);
+    else
+        m_assembler.jump(fall_through);
+
+    m_assembler.link(slow_case);
+    call_slow_path(slow_path, instruction, bytecode_offset);
+    jump_to_returned_address_if_not_null();
+    m_assembler.link(fall_through);
+}
+
+void Compiler::emit_trampoline()
+{
+    // void trampoline(Interpreter*, Value* registers, size_t* program_counter, void const* entry)
+    // NOTE: Five pushes on top of the return address keep the stack 16-byte aligned for our calls into C++.
+    m_assembler.push(Reg::RBX);
+    m_assembler.push(Reg::R12);
+    m_assembler.push(Reg::R13);
+    m_assembler.push(Reg::R14);
+    m_assembler.push(Reg::R15);
+    m_assembler.mov64(INTERPRETER, Reg::RDI);
+    m_assembler.mov64(REGISTERS, Reg::RSI);
+    m_assembler.mov64(PROGRAM_COUNTER, Reg::RDX);
+    m_assembler.jump(Reg::RCX);
+}
+
+void Compiler::emit_exit()
+{
+    m_assembler.link(m_exit);
+    m_assembler.pop(Reg::R15);
+    m_assembler.pop(Reg::R14);
+    m_assembler.pop(Reg::R13);
+    m_assembler.pop(Reg::R12);
+    m_assembler.pop(Reg::RBX);
+    m_assembler.ret();
+}
+
+void Compiler::load_operand(Reg dst, Bytecode::Operand operand)
+{
+    m_assembler.load64(dst, REGISTERS, operand_offset(operand));
+}
+
+void Compiler::store_operand(Bytecode::Operand operand, Reg src)
+{
+    m_assembler.store64(REGISTERS, operand_offset(operand), src);
+}
+
+void Compiler::jump_unless_int32(Reg value, Reg scratch, Assembler::Label& fail)
+{
+    m_assembler.mov64(scratch, value);
+    m_assembler.shift_right64(scratch, GC::TAG_SHIFT);
+    m_assembler.compare32(scratch, static_cast<i32>(INT32_TAG));
+    m_assembler.jump_if(Condition::NotEqualTo, fail);
+}
+
+void Compiler::jump_unless_boolean(Reg value, Reg scratch, Assembler::Label& fail)
+{
+    m_assembler.mov64(scratch, value);
+    m_assembler.shift_right64(scratch, GC::TAG_SHIFT);
+    m_assembler.compare32(scratch, static_cast<i32>(BOOLEAN_TAG));
+    m_assembler.jump_if(Condition::NotEqualTo, fail);
+}
+
+void Compiler::jump_if_cell(Reg value, Reg scratch, Assembler::Label& target)
+{
+    // Every tag with all of IS_CELL_PATTERN's bits set is at least IS_CELL_PATTERN.
+    m_assembler.mov64(scratch, value);
+    m_assembler.shift_right64(scratch, GC::TAG_SHIFT);
+    m_assembler.compare32(scratch, static_cast<i32>(GC::IS_CELL_PATTERN));
+    m_assembler.jump_if(Condition::UnsignedGreaterThanOrEqualTo, target);
+}
+
+void Compiler::box_int32(Reg value, Reg scratch)
+{
+    m_assembler.mov64(scratch, SHIFTED_INT32_TAG);
+    m_assembler.bitwise_or64(value, scratch);
+}
+
+void Compiler::box_boolean(Reg value, Reg scratch)
+{
+    m_assembler.mov64(scratch, SHIFTED_BOOLEAN_TAG);
+    m_assembler.bitwise_or64(value, scratch);
+}
+
+void Compiler::call_slow_path(void const* slow_path, Bytecode::Instruction const& instruction, size_t bytecode_offset)
+{
+    // Keep the program counter up to date for exception handling, stack traces and generator resumption.
+    m_assembler.store64(PROGRAM_COUNTER, 0, static_cast<i32>(bytecode_offset));
+    m_assembler.mov64(Reg::RDI, INTERPRETER);
+    m_assembler.mov64(Reg::RSI, bit_cast<FlatPtr>(&instruction));
+    m_assembler.mov64(Reg::RAX, bit_cast<FlatPtr>(slow_path));
+    m_assembler.call(Reg::RAX);
+}
+
+void Compiler::jump_to_returned_address_if_not_null()
+{
+    Assembler::Label continue_here;
+    m_assembler.test64(Reg::RAX, Reg::RAX);
+    m_assembler.jump_if(Condition::EqualTo, continue_here);
+    m_assembler.jump(Reg::RAX);
+    m_assembler.link(continue_here);
+}
+
+void Compiler::jump_to_bytecode_offset(size_t bytecode_offset)
+{
+    m_unresolved_jumps.append({ m_assembler.jump_with_unresolved_target(), bytecode_offset });
+}
+
+void Compiler::jump_if_to_bytecode_offset(Condition condition, size_t bytecode_offset)
+{
+    m_unresolved_jumps.append({ m_assembler.jump_if_with_unresolved_target(condition), bytecode_offset });
+}
+
+void const* Compiler::handle_exception(Bytecode::Interpreter& interpreter, Value exception)
+{
+    auto& native_executable = *interpreter.current_executable().native_executable;
+    auto& program_counter = interpreter.running_execution_context().program_counter;
+    if (interpreter.handle_exception(program_counter, exception) == Bytecode::Interpreter::HandleExceptionResponse::ExitFromExecutable)
+        return native_executable.exit_address();
+    return native_executable.address_for_bytecode_offset(program_counter);
+}
+
+template<typename OpType>
+void const* Compiler::execute_slow_path(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    if constexpr (IsSame<OpType, Bytecode::Op::Mov>) {
+        interpreter.set(instruction.dst(), interpreter.get(instruction.src()));
+    } else if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error()) [[unlikely]]
+            return handle_exception(interpreter, result.error_value());
+    }
+    return nullptr;
+}
+
+template<typename OpType>
+void const* Compiler::control_flow_slow_path(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    using namespace Bytecode::Op;
+    auto& native_executable = *interpreter.current_executable().native_executable;
+    auto address_of_target = [&](Bytecode::Label const& label) {
+        return native_executable.address_for_bytecode_offset(label.address());
+    };
+
+    if constexpr (IsSame<OpType, JumpIf>) {
+        if (interpreter.get(instruction.condition()).to_boolean())
+            return address_of_target(instruction.true_target());
+        return address_of_target(instruction.false_target());
+    } else if constexpr (IsSame<OpType, JumpTrue>) {
+        if (interpreter.get(instruction.condition()).to_boolean())
+            return address_of_target(instruction.target());
+        return nullptr;
+    } else if constexpr (IsSame<OpType, JumpFalse>) {
+        if (!interpreter.get(instruction.condition()).to_boolean())
+            return address_of_target(instruction.target());
+        return nullptr;
+    } else if constexpr (IsSame<OpType, JumpNullish>) {
+        if (interpreter.get(instruction.condition()).is_nullish())
+            return address_of_target(instruction.true_target());
+        return address_of_target(instruction.false_target());
+    } else if constexpr (IsSame<OpType, JumpUndefined>) {
+        if (interpreter.get(instruction.condition()).is_undefined())
+            return address_of_target(instruction.true_target());
+        return address_of_target(instruction.false_target());
+    } else if constexpr (ComparisonJump<OpType>::is_comparison_jump) {
+        auto result = ComparisonJump<OpType>::compare(interpreter.vm(), interpreter.get(instruction.lhs()), interpreter.get(instruction.rhs()));
+        if (result.is_error()) [[unlikely]]
+            return handle_exception(interpreter, result.error_value());
+        if (result.value())
+            return address_of_target(instruction.true_target());
+        return address_of_target(instruction.false_target());
+    } else if constexpr (IsSame<OpType, EnterUnwindContext>) {
+        interpreter.enter_unwind_context();
+        return nullptr;
+    } else if constexpr (IsSame<OpType, End>) {
+        interpreter.accumulator() = interpreter.get(instruction.value());
+        return nullptr;
+    } else {
+        static_assert(IsOneOf<OpType, Return, Await, Yield>);
+        instruction.execute_impl(interpreter);
+        return nullptr;
+    }
+}
+
+}
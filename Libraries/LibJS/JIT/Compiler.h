@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/Platform.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Operand.h>
+#include <LibJS/JIT/Assembler.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+// The generated code is x86-64 and follows the System V calling convention, so it can't run on Windows.
+#if ARCH(X86_64) && !defined(AK_OS_WINDOWS)
+#    define JS_JIT_SUPPORTED 1
+#else
+#    define JS_JIT_SUPPORTED 0
+#endif
+
+namespace JS::JIT {
+
+// Executables are compiled to native code once they have been entered this many times.
+static constexpr u32 JIT_TIER_UP_EXECUTION_COUNT = 16;
+
+// A baseline compiler that translates bytecode one instruction at a time.
+// Mov, Add, LessThan, Increment and the conditional jumps get inline fast paths for Int32 (and Boolean) values;
+// everything else calls back into the instruction's execute_impl().
+//
+// Native code runs with these registers pinned:
+//   R12: Bytecode::Interpreter*
+//   R13: the registers/constants/locals/arguments array of the running execution context
+//   R14: &ExecutionContext::program_counter, kept up to date before every call into C++
+class Compiler {
+public:
+    // Returns nullptr if the executable can't be compiled (unsupported platform or instruction).
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+private:
+    explicit Compiler(Bytecode::Executable& executable)
+        : m_executable(executable)
+        , m_assembler(m_output)
+    {
+    }
+
+    OwnPtr<NativeExecutable> compile_executable();
+
+    template<typename OpType>
+    bool compile_instruction(OpType const&, size_t bytecode_offset);
+
+    template<typename OpType>
+    void compile_int32_comparison_jump(OpType const&, size_t bytecode_offset, Assembler::Condition);
+
+    void compile_boolean_jump(Bytecode::Instruction const&, size_t bytecode_offset, Bytecode::Operand condition, void const* slow_path, Optional<size_t> true_target, Optional<size_t> false_target);
+
+    void emit_trampoline();
+    void emit_exit();
+
+    void load_operand(Assembler::Reg, Bytecode::Operand);
+    void store_operand(Bytecode::Operand, Assembler::Reg);
+
+    // Clobbers `scratch`.
+    void jump_unless_int32(Assembler::Reg value, Assembler::Reg scratch, Assembler::Label& fail);
+    void jump_unless_boolean(Assembler::Reg value, Assembler::Reg scratch, Assembler::Label& fail);
+    void jump_if_cell(Assembler::Reg value, Assembler::Reg scratch, Assembler::Label& target);
+
+    // Turns the zero-extended 32-bit integer in `value` into a NaN-boxed Value. Clobbers `scratch`.
+    void box_int32(Assembler::Reg value, Assembler::Reg scratch);
+    void box_boolean(Assembler::Reg value, Assembler::Reg scratch);
+
+    // Calls `slow_path(interpreter, instruction)`. The native address it returns (if any) is jumped to.
+    void call_slow_path(void const* slow_path, Bytecode::Instruction const&, size_t bytecode_offset);
+    void jump_to_returned_address_if_not_null();
+
+    void jump_to_bytecode_offset(size_t bytecode_offset);
+    void jump_if_to_bytecode_offset(Assembler::Condition, size_t bytecode_offset);
+
+    // Slow paths, called from native code.
+    template<typename OpType>
+    static void const* execute_slow_path(Bytecode::Interpreter&, OpType const&);
+    template<typename OpType>
+    static void const* control_flow_slow_path(Bytecode::Interpreter&, OpType const&);
+    static void const* handle_exception(Bytecode::Interpreter&, Value exception);
+
+    struct UnresolvedJump {
+        size_t site { 0 };
+        size_t bytecode_offset { 0 };
+    };
+
+    Bytecode::Executable& m_executable;
+    Vector<u8> m_output;
+    Assembler m_assembler;
+    Assembler::Label m_exit;
+    Vector<NativeExecutable::Mapping> m_mappings;
+    Vector<UnresolvedJump> m_unresolved_jumps;
+};
+
+}
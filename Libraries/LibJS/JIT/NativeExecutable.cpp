@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BinarySearch.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/ExecutionContext.h>
+
+#if JS_JIT_SUPPORTED
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+#if JS_JIT_SUPPORTED && defined(AK_OS_MACOS)
+#    include <libkern/OSCacheControl.h>
+#    include <pthread.h>
+#endif
+
+namespace JS::JIT {
+
+OwnPtr<NativeExecutable> NativeExecutable::create(ReadonlyBytes code, Vector<Mapping> mappings, size_t exit_offset)
+{
+#if !JS_JIT_SUPPORTED
+    (void)code;
+    (void)mappings;
+    (void)exit_offset;
+    return nullptr;
+#else
+    auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto size = round_up_to_power_of_two(code.size(), page_size);
+
+#    if defined(AK_OS_MACOS)
+    // The hardened runtime only lets us execute memory that was mapped with MAP_JIT, and never lets us mprotect()
+    // it to executable later. Instead, each thread can either write to all of its MAP_JIT memory or execute it.
+    auto* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS | MAP_JIT, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("JIT mmap");
+        return nullptr;
+    }
+
+    auto write_protect_is_supported = pthread_jit_write_protect_supported_np();
+    if (write_protect_is_supported)
+        pthread_jit_write_protect_np(0);
+    memcpy(memory, code.data(), code.size());
+    if (write_protect_is_supported)
+        pthread_jit_write_protect_np(1);
+    sys_icache_invalidate(memory, code.size());
+#    else
+    auto* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        perror("JIT mmap");
+        return nullptr;
+    }
+
+    memcpy(memory, code.data(), code.size());
+
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) < 0) {
+        perror("JIT mprotect");
+        munmap(memory, size);
+        return nullptr;
+    }
+#    endif
+
+    return adopt_own(*new NativeExecutable(static_cast<u8*>(memory), size, move(mappings), exit_offset));
+#endif
+}
+
+NativeExecutable::NativeExecutable(u8* code, size_t size, Vector<Mapping> mappings, size_t exit_offset)
+    : m_code(code)
+    , m_size(size)
+    , m_exit_offset(exit_offset)
+    , m_mappings(move(mappings))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+#if JS_JIT_SUPPORTED
+    munmap(m_code, m_size);
+#endif
+}
+
+Optional<u32> NativeExecutable::find_native_offset(ReadonlySpan<Mapping> sorted_mappings, size_t bytecode_offset)
+{
+    auto* mapping = binary_search(sorted_mappings, bytecode_offset, nullptr, [](size_t needle, Mapping const& mapping) {
+        return static_cast<int>(needle > mapping.bytecode_offset) - static_cast<int>(needle < mapping.bytecode_offset);
+    });
+    if (!mapping)
+        return {};
+    return mapping->native_offset;
+}
+
+void const* NativeExecutable::address_for_bytecode_offset(size_t bytecode_offset) const
+{
+    auto native_offset = find_native_offset(m_mappings, bytecode_offset);
+    VERIFY(native_offset.has_value());
+    return m_code + *native_offset;
+}
+
+bool NativeExecutable::run(Bytecode::Interpreter& interpreter, size_t entry_point)
+{
+    auto native_offset = find_native_offset(m_mappings, entry_point);
+    if (!native_offset.has_value())
+        return false;
+
+    auto& context = interpreter.running_execution_context();
+    context.program_counter = entry_point;
+
+    // The trampoline at offset 0 saves callee-saved registers, loads the pinned registers and jumps to the entry.
+    using Trampoline = void (*)(Bytecode::Interpreter*, Value*, size_t*, void const*);
+    auto trampoline = reinterpret_cast<Trampoline>(m_code);
+    trampoline(&interpreter, context.registers_and_constants_and_locals_and_arguments_span().data(), &context.program_counter, m_code + *native_offset);
+    return true;
+}
+
+}
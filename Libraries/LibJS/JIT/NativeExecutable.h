@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// Machine code generated for one Bytecode::Executable, mapped read+execute.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    struct Mapping {
+        u32 bytecode_offset { 0 };
+        u32 native_offset { 0 };
+    };
+
+    static OwnPtr<NativeExecutable> create(ReadonlyBytes code, Vector<Mapping> mappings, size_t exit_offset);
+    static Optional<u32> find_native_offset(ReadonlySpan<Mapping> sorted_mappings, size_t bytecode_offset);
+    ~NativeExecutable();
+
+    // Runs the native code starting at the instruction at `entry_point` in the current executable.
+    // Returns false without running anything if there is no native code for that instruction.
+    bool run(Bytecode::Interpreter&, size_t entry_point);
+
+    // Returns the native address of the instruction starting at `bytecode_offset`. The offset must be an instruction start.
+    void const* address_for_bytecode_offset(size_t bytecode_offset) const;
+    void const* exit_address() const { return m_code + m_exit_offset; }
+
+    size_t size() const { return m_size; }
+
+private:
+    NativeExecutable(u8* code, size_t size, Vector<Mapping> mappings, size_t exit_offset);
+
+    u8* m_code { nullptr };
+    size_t m_size { 0 };
+    size_t m_exit_offset { 0 };
+    Vector<Mapping> m_mappings;
+};
+
+}
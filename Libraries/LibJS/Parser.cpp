@@ -776,6 +776,11 @@ NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
         parse_module(program);
 
     program->set_end_offset({}, position().offset);
+
+    // Eval code is parsed with the caller's context, which affects how identifiers are resolved.
+    if (!m_state.initiated_by_eval)
+        m_source_code->set_was_parsed_as_program({});
+
     return program;
 }
 
@@ -16,6 +16,7 @@ namespace JS {
 class Accessor final : public Cell {
     GC_CELL(Accessor, Cell);
     GC_DECLARE_ALLOCATOR(Accessor);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(Accessor);
 
 public:
     static GC::Ref<Accessor> create(VM& vm, FunctionObject* getter, FunctionObject* setter)
@@ -173,6 +173,21 @@ ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object
     // 1. Let items be a new empty List.
     auto items = GC::RootVector<Value> { vm.heap() };
 
+    // OPTIMIZATION: HasProperty and Get can't run user code on fast arrays, so their elements can be copied straight out of storage.
+    auto const* array = as_if<Array>(object);
+    if (auto const* storage = array ? array->fast_element_storage() : nullptr; storage && length <= storage->array_like_size()) {
+        items.ensure_capacity(length);
+        for (size_t k = 0; k < length; ++k) {
+            auto value = storage->elements()[k];
+            if (!value.is_special_empty_value())
+                items.unchecked_append(value);
+            else if (holes == Holes::ReadThroughHoles)
+                items.unchecked_append(js_undefined());
+        }
+        TRY(array_merge_sort(vm, sort_compare, items));
+        return items;
+    }
+
     // 2. Let k be 0.
     // 3. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
@@ -325,6 +340,21 @@ bool Array::default_prototype_chain_intact() const
     return true;
 }
 
+SimpleIndexedPropertyStorage const* Array::fast_element_storage() const
+{
+    if (m_is_proxy_target || !default_prototype_chain_intact())
+        return nullptr;
+    auto const* storage = indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    return static_cast<SimpleIndexedPropertyStorage const*>(storage);
+}
+
+SimpleIndexedPropertyStorage* Array::fast_element_storage()
+{
+    return const_cast<SimpleIndexedPropertyStorage*>(static_cast<Array const&>(*this).fast_element_storage());
+}
+
 ThrowCompletionOr<bool> Array::internal_set(PropertyKey const& property_key, Value value, Value receiver, CacheablePropertyMetadata* cacheable_metadata, PropertyLookupPhase phase)
 {
     auto& vm = this->vm();
@@ -23,6 +23,7 @@ namespace JS {
 class JS_API Array : public Object {
     JS_OBJECT(Array, Object);
     GC_DECLARE_ALLOCATOR(Array);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(Array);
 
 public:
     static ThrowCompletionOr<GC::Ref<Array>> create(Realm&, u64 length, Object* prototype = nullptr);
@@ -62,6 +63,11 @@ public:
 
     bool default_prototype_chain_intact() const;
 
+    // Returns the storage of arrays that aren't proxy targets, have an intact default prototype chain and use simple storage.
+    // Their elements can be read and written directly, since doing so can't run any user code. Returns null for other arrays.
+    SimpleIndexedPropertyStorage const* fast_element_storage() const;
+    SimpleIndexedPropertyStorage* fast_element_storage();
+
     virtual void visit_edges(Cell::Visitor& visitor) override;
 
 protected:
@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -145,6 +146,12 @@ static ThrowCompletionOr<Object*> array_species_create(VM& vm, Object& original_
     return TRY(construct(vm, constructor.as_function(), Value(length))).ptr();
 }
 
+static SimpleIndexedPropertyStorage* fast_array_storage(Object& object)
+{
+    auto* array = as_if<Array>(object);
+    return array ? array->fast_element_storage() : nullptr;
+}
+
 // 23.1.3.1 Array.prototype.at ( index ), https://tc39.es/ecma262/#sec-array.prototype.at
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::at)
 {
@@ -697,6 +704,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
     // 4. Let k be 0.
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
+        // OPTIMIZATION: Read elements of fast arrays straight out of storage. The callback may change the array, so this is checked every time.
+        if (auto const* storage = fast_array_storage(*object)) {
+            if (k < storage->array_like_size() && storage->inline_has_index(k))
+                TRY(call(vm, callback_function.as_function(), this_arg, storage->elements()[k], Value(k), object));
+            continue;
+        }
+
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -795,6 +809,32 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Nothing below can run user code, so fast arrays can be searched straight in their storage.
+    if (auto const* storage = fast_array_storage(*object)) {
+        auto const& elements = storage->elements();
+        auto end = min(length, storage->array_like_size());
+
+        if (is_int32_element_kind(storage->element_kind())) {
+            // Int32 elements can only be strictly equal to numbers that fit in an Int32. Note that -0 is strictly equal to 0.
+            if (!search_element.is_number())
+                return Value(-1);
+            auto needle = search_element.is_negative_zero() ? Value(0) : Value(search_element.as_double());
+            if (!needle.is_int32())
+                return Value(-1);
+            for (; k < end; ++k) {
+                if (elements[k].is_int32() && elements[k].as_i32() == needle.as_i32())
+                    return Value(k);
+            }
+            return Value(-1);
+        }
+
+        for (; k < end; ++k) {
+            if (!elements[k].is_special_empty_value() && is_strictly_equal(search_element, elements[k]))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -958,16 +998,23 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
-        // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        Optional<Value> k_value;
 
+        // OPTIMIZATION: Read elements of fast arrays straight out of storage. The callback may change the array, so this is checked every time.
+        if (auto const* storage = fast_array_storage(*object)) {
+            if (k < storage->array_like_size() && storage->inline_has_index(k))
+                k_value = storage->elements()[k];
+        }
+        // b. Let kPresent be ? HasProperty(O, Pk).
         // c. If kPresent is true, then
-        if (k_present) {
+        else if (TRY(object->has_property(property_key))) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            k_value = TRY(object->get(property_key));
+        }
 
+        if (k_value.has_value()) {
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
-            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object));
 
             // iii. Perform ? CreateDataPropertyOrThrow(A, Pk, mappedValue).
             TRY(array->create_data_property_or_throw(property_key, mapped_value));
@@ -989,6 +1036,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::pop)
         TRY(this_object->set(vm.names.length, Value(0), Object::ShouldThrowExceptions::Yes));
         return js_undefined();
     }
+
+    // OPTIMIZATION: Fast arrays with a writable length can have their last element taken straight out of storage.
+    if (auto* storage = fast_array_storage(*this_object); storage && static_cast<Array&>(*this_object).length_is_writable()) {
+        auto element = storage->take_last().value;
+        if (element.is_special_empty_value())
+            return js_undefined();
+        return element;
+    }
+
     auto index = length - 1;
     auto element = TRY(this_object->get(index));
     TRY(this_object->delete_property_or_throw(index));
@@ -1005,6 +1061,14 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+
+    // OPTIMIZATION: Fast arrays that are extensible and have a writable length can be appended to directly.
+    if (auto* storage = fast_array_storage(*this_object); storage && static_cast<Array&>(*this_object).length_is_writable() && TRY(this_object->is_extensible())) {
+        for (size_t i = 0; i < argument_count; ++i)
+            this_object->indexed_properties().append(vm.argument(i));
+        return Value(new_length);
+    }
+
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -1408,6 +1472,37 @@ ThrowCompletionOr<void> array_merge_sort(VM& vm, Function<ThrowCompletionOr<doub
     return {};
 }
 
+// OPTIMIZATION: Without a comparefn, elements are compared by their string values. For Int32 elements, these strings can be
+//               created once up front, instead of twice for every comparison. Equal strings always come from equal values, so
+//               an unstable sort gives the same result as the stable sort required by the spec.
+static GC::RootVector<Value> sort_int32_elements_by_string(VM& vm, SimpleIndexedPropertyStorage const& storage)
+{
+    struct Element {
+        String key;
+        i32 value { 0 };
+    };
+
+    Vector<Element> elements;
+    elements.ensure_capacity(storage.array_like_size());
+    for (size_t i = 0; i < storage.array_like_size(); ++i) {
+        auto value = storage.elements()[i];
+        if (value.is_special_empty_value())
+            continue;
+        elements.unchecked_append({ String::number(value.as_i32()), value.as_i32() });
+    }
+
+    // NOTE: These strings are all ASCII, so comparing their bytes is the same as comparing their code units.
+    quick_sort(elements, [](auto const& a, auto const& b) {
+        return a.key.bytes_as_string_view() < b.key.bytes_as_string_view();
+    });
+
+    GC::RootVector<Value> sorted_list { vm.heap() };
+    sorted_list.ensure_capacity(elements.size());
+    for (auto const& element : elements)
+        sorted_list.unchecked_append(Value(element.value));
+    return sorted_list;
+}
+
 // 23.1.3.30 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1429,7 +1524,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     };
 
     // 5. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, skip-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles));
+    auto sorted_list = TRY([&]() -> ThrowCompletionOr<GC::RootVector<Value>> {
+        if (comparefn.is_undefined()) {
+            if (auto const* storage = fast_array_storage(*object); storage && is_int32_element_kind(storage->element_kind()) && length == storage->array_like_size())
+                return sort_int32_elements_by_string(vm, *storage);
+        }
+        return sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles);
+    }());
 
     // 6. Let itemCount be the number of elements in sortedList.
     auto item_count = sorted_list.size();
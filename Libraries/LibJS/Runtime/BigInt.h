@@ -19,6 +19,7 @@ namespace JS {
 class JS_API BigInt final : public Cell {
     GC_CELL(BigInt, Cell);
     GC_DECLARE_ALLOCATOR(BigInt);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(BigInt);
 
 public:
     [[nodiscard]] static GC::Ref<BigInt> create(VM&, Crypto::SignedBigInteger);
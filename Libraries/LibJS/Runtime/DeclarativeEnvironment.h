@@ -19,6 +19,7 @@ namespace JS {
 class JS_API DeclarativeEnvironment : public Environment {
     JS_ENVIRONMENT(DeclarativeEnvironment, Environment);
     GC_DECLARE_ALLOCATOR(DeclarativeEnvironment);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(DeclarativeEnvironment);
 
     struct Binding {
         Utf16FlyString name;
@@ -102,6 +102,7 @@ public:
 class JS_API ECMAScriptFunctionObject final : public FunctionObject {
     JS_OBJECT(ECMAScriptFunctionObject, FunctionObject);
     GC_DECLARE_ALLOCATOR(ECMAScriptFunctionObject);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(ECMAScriptFunctionObject);
 
 public:
     static GC::Ref<ECMAScriptFunctionObject> create(Realm&, Utf16FlyString name, ByteString source_text, Statement const& ecmascript_code, NonnullRefPtr<FunctionParameters const> parameters, i32 function_length, Vector<LocalVariable> local_variables_names, Environment* parent_environment, PrivateEnvironment* private_environment, FunctionKind, bool is_strict, FunctionParsingInsights, bool is_arrow_function = false, Variant<PropertyKey, PrivateName, Empty> class_field_initializer_name = {});
@@ -174,6 +175,7 @@ public:
 
     // This is used by LibWeb to disassociate event handler attribute callback functions from the nearest script on the call stack.
     // https://html.spec.whatwg.org/multipage/webappapis.html#getting-the-current-value-of-the-event-handler Step 3.11
+    ScriptOrModule const& script_or_module() const { return m_script_or_module; }
     void set_script_or_module(ScriptOrModule script_or_module) { m_script_or_module = move(script_or_module); }
 
     Variant<PropertyKey, PrivateName, Empty> const& class_field_initializer_name() const { return shared_data().m_class_field_initializer_name; }
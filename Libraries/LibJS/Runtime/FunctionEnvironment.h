@@ -14,6 +14,7 @@ namespace JS {
 class FunctionEnvironment final : public DeclarativeEnvironment {
     JS_ENVIRONMENT(FunctionEnvironment, DeclarativeEnvironment);
     GC_DECLARE_ALLOCATOR(FunctionEnvironment);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(FunctionEnvironment);
 
 public:
     enum class ThisBindingStatus : u8 {
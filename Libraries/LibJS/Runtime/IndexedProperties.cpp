@@ -17,6 +17,19 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     : IndexedPropertyStorage(IsSimpleStorage::Yes, initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements) {
+        if (value.is_special_empty_value())
+            ++m_number_of_empty_elements;
+        else
+            update_value_kind(value);
+    }
+}
+
+void SimpleIndexedPropertyStorage::update_value_kind(Value value)
+{
+    if (m_value_kind == ElementKind::PackedElements || value.is_int32() || value.is_special_empty_value())
+        return;
+    m_value_kind = value.is_number() ? ElementKind::PackedDouble : ElementKind::PackedElements;
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -59,6 +72,7 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     if (value.is_special_empty_value()) {
         ++m_number_of_empty_elements;
     }
+    update_value_kind(value);
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
@@ -100,10 +114,14 @@ bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
     if (old_size <= m_array_size) {
         m_number_of_empty_elements += m_array_size - old_size;
     } else {
+        // We have to look at every remaining element anyway, so take the chance to make the kind as specific as possible.
         m_number_of_empty_elements = 0;
+        m_value_kind = ElementKind::PackedInt32;
         for (auto& value : m_packed_elements) {
             if (value.is_special_empty_value())
                 ++m_number_of_empty_elements;
+            else
+                update_value_kind(value);
         }
     }
 
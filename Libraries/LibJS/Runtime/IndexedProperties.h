@@ -20,6 +20,33 @@ struct ValueAndAttributes {
     Optional<u32> property_offset {};
 };
 
+// Describes what a SimpleIndexedPropertyStorage holds, from most to least specific.
+// Int32 kinds only hold Int32 values, Double kinds hold any number, and holey kinds have at least one empty element.
+// Elements only ever move to a less specific value kind, while holes come and go with the elements themselves.
+enum class ElementKind : u8 {
+    PackedInt32,
+    PackedDouble,
+    PackedElements,
+    HoleyInt32,
+    HoleyDouble,
+    HoleyElements,
+};
+
+constexpr bool is_packed_element_kind(ElementKind kind)
+{
+    return kind == ElementKind::PackedInt32 || kind == ElementKind::PackedDouble || kind == ElementKind::PackedElements;
+}
+
+constexpr bool is_int32_element_kind(ElementKind kind)
+{
+    return kind == ElementKind::PackedInt32 || kind == ElementKind::HoleyInt32;
+}
+
+constexpr bool is_number_element_kind(ElementKind kind)
+{
+    return kind != ElementKind::PackedElements && kind != ElementKind::HoleyElements;
+}
+
 class IndexedProperties;
 class IndexedPropertyIterator;
 class GenericIndexedPropertyStorage;
@@ -95,13 +122,31 @@ public:
 
     bool has_empty_elements() const { return m_number_of_empty_elements.value() > 0; }
 
+    ElementKind element_kind() const
+    {
+        if (!has_empty_elements())
+            return m_value_kind;
+        switch (m_value_kind) {
+        case ElementKind::PackedInt32:
+            return ElementKind::HoleyInt32;
+        case ElementKind::PackedDouble:
+            return ElementKind::HoleyDouble;
+        default:
+            return ElementKind::HoleyElements;
+        }
+    }
+
 private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
+    void update_value_kind(Value);
 
     Checked<size_t> m_number_of_empty_elements { 0 };
     Vector<Value> m_packed_elements;
+
+    // Always one of the packed kinds, element_kind() adds the holes.
+    ElementKind m_value_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -178,6 +223,16 @@ public:
 
     size_t real_size() const;
 
+    // Generic storage can hold anything, including accessors, so it's always treated as holey elements.
+    ElementKind element_kind() const
+    {
+        if (!m_storage)
+            return ElementKind::PackedInt32;
+        if (!m_storage->is_simple_storage())
+            return ElementKind::HoleyElements;
+        return static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).element_kind();
+    }
+
     Vector<u32> indices() const;
 
     template<typename Callback>
@@ -97,6 +97,12 @@ Object::~Object()
         s_intrinsics.remove(this);
 }
 
+void Object::finalize()
+{
+    Base::finalize();
+    revoke_weak_ptrs();
+}
+
 void Object::initialize(Realm&)
 {
 }
@@ -1440,9 +1446,12 @@ void Object::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_shape);
     visitor.visit(m_storage);
 
-    m_indexed_properties.for_each_value([&visitor](auto& value) {
-        visitor.visit(value);
-    });
+    // Numbers don't refer to any cells, so there's nothing to visit in arrays that only hold numbers.
+    if (!is_number_element_kind(m_indexed_properties.element_kind())) {
+        m_indexed_properties.for_each_value([&visitor](auto& value) {
+            visitor.visit(value);
+        });
+    }
 
     if (m_private_elements) {
         for (auto& private_element : *m_private_elements)
@@ -56,6 +56,7 @@ class JS_API Object : public Cell
     , public Weakable<Object> {
     GC_CELL(Object, Cell);
     GC_DECLARE_ALLOCATOR(Object);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(Object);
 
 public:
     static GC::Ref<Object> create_prototype(Realm&, Object* prototype);
@@ -227,6 +228,7 @@ public:
     void set_has_parameter_map() { m_has_parameter_map = true; }
 
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
     void put_direct(size_t index, Value value) { m_storage[index] = value; }
@@ -110,8 +110,11 @@ PrimitiveString::PrimitiveString(String string)
 {
 }
 
-PrimitiveString::~PrimitiveString()
+PrimitiveString::~PrimitiveString() = default;
+
+void PrimitiveString::finalize()
 {
+    Base::finalize();
     if (has_utf16_string())
         vm().utf16_string_cache().remove(*m_utf16_string);
     if (has_utf8_string())
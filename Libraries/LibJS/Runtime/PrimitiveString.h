@@ -23,6 +23,7 @@ namespace JS {
 class JS_API PrimitiveString : public Cell {
     GC_CELL(PrimitiveString, Cell);
     GC_DECLARE_ALLOCATOR(PrimitiveString);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(PrimitiveString);
 
 public:
     [[nodiscard]] static GC::Ref<PrimitiveString> create(VM&, Utf16String);
@@ -79,12 +80,15 @@ private:
     explicit PrimitiveString(Utf16String);
     explicit PrimitiveString(String);
 
+    virtual void finalize() override;
+
     void resolve_rope_if_needed(EncodingPreference) const;
 };
 
 class RopeString final : public PrimitiveString {
     GC_CELL(RopeString, PrimitiveString);
     GC_DECLARE_ALLOCATOR(RopeString);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(RopeString);
 
 public:
     virtual ~RopeString() override;
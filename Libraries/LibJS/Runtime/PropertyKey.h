@@ -48,6 +48,8 @@ public:
             new (&m_string) Utf16FlyString(other.m_string);
         else
             m_bits = other.m_bits;
+        if (is_symbol())
+            GC::write_barrier(as_symbol());
     }
 
     PropertyKey(PropertyKey&& other) noexcept
@@ -56,6 +58,8 @@ public:
             new (&m_string) Utf16FlyString(move(other.m_string));
         else
             m_bits = exchange(other.m_bits, 0);
+        if (is_symbol())
+            GC::write_barrier(as_symbol());
     }
 
     template<Integral T>
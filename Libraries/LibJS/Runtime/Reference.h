@@ -127,10 +127,8 @@ private:
     Completion throw_reference_error(VM&) const;
 
     BaseType m_base_type { BaseType::Unresolvable };
-    union {
-        Value m_base_value {};
-        mutable Environment* m_base_environment;
-    };
+    Value m_base_value {};
+    mutable Environment* m_base_environment { nullptr };
     Variant<PropertyKey, PrivateName> m_name;
     Optional<Value> m_this_value;
     bool m_strict { false };
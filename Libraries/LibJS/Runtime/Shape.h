@@ -39,12 +39,19 @@ class PrototypeChainValidity final : public Cell
     , public Weakable<PrototypeChainValidity> {
     GC_CELL(PrototypeChainValidity, Cell);
     GC_DECLARE_ALLOCATOR(PrototypeChainValidity);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(PrototypeChainValidity);
 
 public:
     [[nodiscard]] bool is_valid() const { return m_valid; }
     void set_valid(bool valid) { m_valid = valid; }
 
 private:
+    virtual void finalize() override
+    {
+        Base::finalize();
+        revoke_weak_ptrs();
+    }
+
     bool m_valid { true };
     size_t padding { 0 };
 };
@@ -53,6 +60,7 @@ class JS_API Shape final : public Cell
     , public Weakable<Shape> {
     GC_CELL(Shape, Cell);
     GC_DECLARE_ALLOCATOR(Shape);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(Shape);
 
 public:
     virtual ~Shape() override;
@@ -116,6 +124,7 @@ private:
     void invalidate_all_prototype_chains_leading_to_this();
 
     virtual void visit_edges(Visitor&) override;
+    virtual void finalize() override;
 
     [[nodiscard]] GC::Ptr<Shape> get_or_prune_cached_forward_transition(TransitionKey const&);
     [[nodiscard]] GC::Ptr<Shape> get_or_prune_cached_prototype_transition(Object* prototype);
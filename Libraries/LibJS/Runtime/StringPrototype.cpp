@@ -48,21 +48,6 @@ static ThrowCompletionOr<GC::Ref<PrimitiveString>> primitive_string_from(VM& vm)
     return TRY(this_value.to_primitive_string(vm));
 }
 
-// 22.1.3.21.1 SplitMatch ( S, q, R ), https://tc39.es/ecma262/#sec-splitmatch
-// FIXME: This no longer exists in the spec!
-static Optional<size_t> split_match(Utf16View const& haystack, size_t start, Utf16View const& needle)
-{
-    auto r = needle.length_in_code_units();
-    auto s = haystack.length_in_code_units();
-    if (start + r > s)
-        return {};
-    for (size_t i = 0; i < r; ++i) {
-        if (haystack.code_unit_at(start + i) != needle.code_unit_at(i))
-            return {};
-    }
-    return start + r;
-}
-
 // 6.1.4.1 StringIndexOf ( string, searchValue, fromIndex ), https://tc39.es/ecma262/#sec-stringindexof
 Optional<size_t> string_index_of(Utf16View const& string, Utf16View const& search_value, size_t from_index)
 {
@@ -81,17 +66,11 @@ Optional<size_t> string_index_of(Utf16View const& string, Utf16View const& searc
         return {};
 
     // 4. For each integer i such that fromIndex ≤ i ≤ len - searchLen, in ascending order, do
-    for (size_t i = from_index; i <= string_length - search_length; ++i) {
-        // a. Let candidate be the substring of string from i to i + searchLen.
-        auto candidate = string.substring_view(i, search_length);
-
-        // b. If candidate is searchValue, return i.
-        if (candidate == search_value)
-            return i;
-    }
-
+    //     a. Let candidate be the substring of string from i to i + searchLen.
+    //     b. If candidate is searchValue, return i.
     // 5. Return -1.
-    return {};
+    // OPTIMIZATION: Utf16View scans for candidates many code units at a time.
+    return string.find_code_unit_offset(search_value, from_index);
 }
 
 // 7.2.9 Static Semantics: IsStringWellFormedUnicode ( string )
@@ -1109,21 +1088,20 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::split)
         return array;
     }
 
+    auto string_view = string->utf16_string_view();
+    auto separator_view = separator->utf16_string_view();
+
     // 12. Let i be 0.
     size_t start = 0;
 
     // 13. Let j be StringIndexOf(S, R, 0).
-    auto position = start;
+    // NOTE: An empty separator would match right where each segment starts, so we look for it one code unit later.
+    auto position = string_index_of(string_view, separator_view, separator_length == 0 ? 1 : 0);
 
     // 14. Repeat, while j ≠ -1,
-    while (position != string_length) {
+    while (position.has_value() && *position != string_length) {
         // a. Let T be the substring of S from i to j.
-        auto match = split_match(string->utf16_string_view(), position, separator->utf16_string_view());
-        if (!match.has_value() || match.value() == start) {
-            ++position;
-            continue;
-        }
-        auto segment = string->utf16_string_view().substring_view(start, position - start);
+        auto segment = string_view.substring_view(start, *position - start);
 
         // b. Append T to substrings.
         MUST(array->create_data_property_or_throw(array_length, PrimitiveString::create(vm, segment)));
@@ -1134,14 +1112,14 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::split)
             return array;
 
         // d. Set i to j + separatorLength.
-        start = match.value();
+        start = *position + separator_length;
 
         // e. Set j to StringIndexOf(S, R, i).
-        position = start;
+        position = string_index_of(string_view, separator_view, separator_length == 0 ? start + 1 : start);
     }
 
     // 15. Let T be the substring of S from i.
-    auto rest = string->utf16_string_view().substring_view(start);
+    auto rest = string_view.substring_view(start);
 
     // 16. Append T to substrings.
     MUST(array->create_data_property_or_throw(array_length, PrimitiveString::create(vm, rest)));
@@ -17,6 +17,7 @@ namespace JS {
 class JS_API Symbol final : public Cell {
     GC_CELL(Symbol, Cell);
     GC_DECLARE_ALLOCATOR(Symbol);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(Symbol);
 
 public:
     [[nodiscard]] static GC::Ref<Symbol> create(VM&, Optional<Utf16String> description, bool is_global);
@@ -69,6 +69,10 @@ VM::VM(ErrorMessages error_messages)
     })
     , m_error_messages(move(error_messages))
 {
+    m_heap.set_gather_precise_stack_ranges([this](Vector<GC::Heap::PreciseStackRange>& ranges) {
+        gather_precise_stack_ranges(ranges);
+    });
+
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
 
     m_empty_string = m_heap.allocate<PrimitiveString>(String {});
@@ -283,6 +287,24 @@ void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
         roots.set(job, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
 }
 
+void VM::gather_precise_stack_ranges(Vector<GC::Heap::PreciseStackRange>& ranges)
+{
+    // Execution contexts usually live on the native stack, together with the interpreter's registers, locals and
+    // arguments. gather_roots() visits every one of those precisely, so the heap doesn't have to scan them.
+    auto add_ranges_from_execution_context_stack = [&ranges](Vector<ExecutionContext*> const& stack) {
+        for (auto* execution_context : stack) {
+            auto values = execution_context->registers_and_constants_and_locals_and_arguments_span();
+            ranges.append({
+                .base = bit_cast<FlatPtr>(execution_context),
+                .end = bit_cast<FlatPtr>(values.data() + values.size()),
+            });
+        }
+    };
+    add_ranges_from_execution_context_stack(m_execution_context_stack);
+    for (auto& saved_stack : m_saved_execution_context_stacks)
+        add_ranges_from_execution_context_stack(saved_stack);
+}
+
 // 9.1.2.1 GetIdentifierReference ( env, name, strict ), https://tc39.es/ecma262/#sec-getidentifierreference
 ThrowCompletionOr<Reference> VM::get_identifier_reference(Environment* environment, Utf16FlyString name, bool strict, size_t hops)
 {
@@ -19,6 +19,7 @@
 #include <LibGC/Function.h>
 #include <LibGC/Heap.h>
 #include <LibGC/RootVector.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/CyclicModule.h>
 #include <LibJS/Export.h>
 #include <LibJS/ModuleLoading.h>
@@ -66,6 +67,7 @@ public:
     void dump_backtrace() const;
 
     void gather_roots(HashMap<GC::Cell*, GC::HeapRoot>&);
+    void gather_precise_stack_ranges(Vector<GC::Heap::PreciseStackRange>&);
 
 #define __JS_ENUMERATE(SymbolName, snake_name)             \
     GC::Ref<Symbol> well_known_symbol_##snake_name() const \
@@ -268,6 +270,10 @@ public:
     Agent* agent() { return m_agent; }
     Agent const* agent() const { return m_agent; }
 
+    // Lets compiled functions be reused across runs. See Bytecode::ExecutableCache.
+    void set_executable_cache(OwnPtr<Bytecode::ExecutableCache> cache) { m_executable_cache = move(cache); }
+    Bytecode::ExecutableCache* executable_cache() { return m_executable_cache; }
+
     void save_execution_context_stack();
     void clear_execution_context_stack();
     void restore_execution_context_stack();
@@ -363,6 +369,8 @@ private:
 
     OwnPtr<Bytecode::Interpreter> m_bytecode_interpreter;
 
+    OwnPtr<Bytecode::ExecutableCache> m_executable_cache;
+
     bool m_dynamic_imports_allowed { false };
 };
 
@@ -453,6 +453,7 @@ private:
             //       See also: NanBoxedValue::extract_pointer.
             m_value.encoded = tag | (reinterpret_cast<u64>(ptr) & 0x0000ffffffffffffULL);
         }
+        did_store();
     }
 
     [[nodiscard]] ThrowCompletionOr<Value> invoke_internal(VM&, PropertyKey const&, Optional<GC::RootVector<Value>> arguments);
@@ -707,7 +708,6 @@ struct Formatter<JS::Value> : Formatter<StringView> {
 template<>
 struct Traits<JS::Value> : DefaultTraits<JS::Value> {
     static unsigned hash(JS::Value value) { return Traits<u64>::hash(value.encoded()); }
-    static constexpr bool is_trivial() { return true; }
 };
 
 template<>
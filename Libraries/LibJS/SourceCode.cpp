@@ -5,7 +5,9 @@
  */
 
 #include <AK/BinarySearch.h>
+#include <AK/Hex.h>
 #include <AK/Utf8View.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibJS/SourceCode.h>
 #include <LibJS/SourceRange.h>
 #include <LibJS/Token.h>
@@ -138,4 +140,13 @@ SourceRange SourceCode::range_from_offsets(u32 start_offset, u32 end_offset) con
     return SourceRange { *this, *start, *end };
 }
 
+String const& SourceCode::content_hash() const
+{
+    if (!m_content_hash.has_value()) {
+        auto digest = Crypto::Hash::SHA256::hash(m_code.utf16_view().bytes());
+        m_content_hash = MUST(String::from_byte_string(encode_hex(digest.bytes())));
+    }
+    return *m_content_hash;
+}
+
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/String.h>
 #include <AK/Utf16String.h>
 #include <AK/Vector.h>
@@ -24,6 +25,14 @@ public:
 
     SourceRange range_from_offsets(u32 start_offset, u32 end_offset) const;
 
+    // Hex-encoded SHA-256 of the source text. Computed on first use.
+    String const& content_hash() const;
+
+    // Set once the whole source text has been parsed as a script or module, as opposed to eval code, the source of a
+    // dynamic function, or a fragment of another source text. Only then do the same contents always compile the same way.
+    bool was_parsed_as_program() const { return m_was_parsed_as_program; }
+    void set_was_parsed_as_program(Badge<Parser>) const { m_was_parsed_as_program = true; }
+
 private:
     SourceCode(String filename, Utf16String code);
 
@@ -35,6 +44,9 @@ private:
     // line:column they map to. This can then be binary-searched.
     void fill_position_cache() const;
     Vector<Position> mutable m_cached_positions;
+
+    Optional<String> mutable m_content_hash;
+    bool mutable m_was_parsed_as_program { false };
 };
 
 }
@@ -0,0 +1,76 @@
+// test-js: enable-jit
+
+// These functions are called often enough to be compiled by the baseline JIT.
+const HOT = 100;
+
+test("Int32 fast paths fall back to the generic operations", () => {
+    function sum(a, b) {
+        let total = 0;
+        for (let i = a; i < b; ++i) total = total + i;
+        return total;
+    }
+
+    for (let i = 0; i < HOT; ++i) expect(sum(0, 10)).toBe(45);
+
+    expect(sum(2147483640, 2147483650)).toBe(21474836445);
+    expect(sum(0.5, 3)).toBe(4.5);
+    expect(sum(0n, 4n)).toBe(6n);
+});
+
+test("Add falls back on overflow and non-numbers", () => {
+    function add(a, b) {
+        return a + b;
+    }
+
+    for (let i = 0; i < HOT; ++i) expect(add(i, 1)).toBe(i + 1);
+
+    expect(add(2147483647, 1)).toBe(2147483648);
+    expect(add(-2147483648, -1)).toBe(-2147483649);
+    expect(add("foo", 1)).toBe("foo1");
+    expect(add(1.5, 1)).toBe(2.5);
+});
+
+test("Comparison jumps with mixed operand types", () => {
+    function compare(a, b) {
+        if (a < b) return "less";
+        if (a == b) return "equal";
+        return "greater";
+    }
+
+    for (let i = 0; i < HOT; ++i) expect(compare(i, 50)).toBe(i < 50 ? "less" : i == 50 ? "equal" : "greater");
+
+    expect(compare("a", "b")).toBe("less");
+    expect(compare(1, "1")).toBe("equal");
+    expect(compare(2.5, 2)).toBe("greater");
+    expect(compare(undefined, 0)).toBe("greater");
+});
+
+test("Exceptions thrown from JIT-compiled code", () => {
+    function maybeThrow(value) {
+        try {
+            if (value > 10) throw new Error("too big");
+            return value;
+        } catch (e) {
+            return e.message;
+        }
+    }
+
+    function throwUncaught(value) {
+        return value.property.access;
+    }
+
+    for (let i = 0; i < HOT; ++i) {
+        expect(maybeThrow(i)).toBe(i > 10 ? "too big" : i);
+        expect(throwUncaught({ property: { access: i } })).toBe(i);
+    }
+
+    expect(() => throwUncaught(undefined)).toThrow(TypeError);
+});
+
+test("Generators resume in JIT-compiled code", () => {
+    function* counter(limit) {
+        for (let i = 0; i < limit; ++i) yield i;
+    }
+
+    for (let i = 0; i < HOT; ++i) expect([...counter(5)]).toEqual([0, 1, 2, 3, 4]);
+});
@@ -0,0 +1,117 @@
+describe("Int32 elements", () => {
+    test("indexOf only finds numbers that are equal", () => {
+        const array = [1, 2, 3, 0];
+        expect(array.indexOf(2)).toBe(1);
+        expect(array.indexOf(2.0)).toBe(1);
+        expect(array.indexOf(2.5)).toBe(-1);
+        expect(array.indexOf("2")).toBe(-1);
+        expect(array.indexOf(-0)).toBe(3);
+        expect(array.indexOf(NaN)).toBe(-1);
+        expect(array.indexOf(3, -1)).toBe(-1);
+    });
+
+    test("indexOf skips holes", () => {
+        const array = [1, , 3];
+        expect(array.indexOf(undefined)).toBe(-1);
+        expect(array.indexOf(3)).toBe(2);
+    });
+
+    test("default sort compares strings", () => {
+        expect([10, 9, 1, -1, 100, -10, 0].sort()).toEqual([-1, -10, 0, 1, 10, 100, 9]);
+        expect([2147483647, -2147483648, 3].sort()).toEqual([-2147483648, 2147483647, 3]);
+    });
+
+    test("default sort moves holes to the end", () => {
+        const array = [3, , 1, , 2];
+        array.sort();
+        expect(array.length).toBe(5);
+        expect(array[0]).toBe(1);
+        expect(array[1]).toBe(2);
+        expect(array[2]).toBe(3);
+        expect(3 in array).toBeFalse();
+        expect(4 in array).toBeFalse();
+    });
+});
+
+describe("Element kind transitions", () => {
+    test("storing doubles and objects", () => {
+        const array = [1, 2, 3];
+        array[1] = 2.5;
+        expect(array.indexOf(2.5)).toBe(1);
+        expect(array.indexOf(3)).toBe(2);
+
+        const object = {};
+        array[0] = object;
+        expect(array.indexOf(object)).toBe(0);
+        expect(array.sort()).toEqual([2.5, 3, object]);
+    });
+
+    test("-0 and NaN are not Int32 elements", () => {
+        const array = [0, 1];
+        array.push(-0);
+        expect(Object.is(array[2], -0)).toBeTrue();
+        expect(array.indexOf(-0)).toBe(0);
+        array.push(NaN);
+        expect(array.indexOf(NaN)).toBe(-1);
+        expect(array.includes(NaN)).toBeTrue();
+    });
+
+    test("objects referenced only from an array stay alive", () => {
+        const array = [1, 2];
+        array.push({ foo: "bar" });
+        gc();
+        expect(array[2].foo).toBe("bar");
+    });
+});
+
+describe("push and pop", () => {
+    test("holes read as undefined", () => {
+        const array = [1, , , 2];
+        expect(array.pop()).toBe(2);
+        expect(array.pop()).toBeUndefined();
+        expect(array.length).toBe(2);
+        expect(array.push(3, 4)).toBe(4);
+        expect(array).toEqual([1, undefined, 3, 4]);
+    });
+
+    test("non-writable length", () => {
+        const array = [1, 2];
+        Object.defineProperty(array, "length", { writable: false });
+        expect(() => array.push(3)).toThrow(TypeError);
+        expect(() => array.pop()).toThrow(TypeError);
+    });
+
+    test("non-extensible arrays", () => {
+        const array = [1, 2];
+        Object.preventExtensions(array);
+        expect(() => array.push(3)).toThrow(TypeError);
+        expect(array.length).toBe(2);
+    });
+});
+
+describe("Callbacks that change the array", () => {
+    test("forEach", () => {
+        const array = [1, 2, 3, 4];
+        const seen = [];
+        array.forEach(value => {
+            seen.push(value);
+            if (value === 2) array.length = 3;
+        });
+        expect(seen).toEqual([1, 2, 3]);
+    });
+
+    test("map", () => {
+        const array = [1, 2, 3];
+        const result = array.map((value, index) => {
+            if (index === 0) {
+                Object.defineProperty(array, 2, { get: () => 30 });
+                delete array[1];
+            }
+            return value * 2;
+        });
+        expect(result.length).toBe(3);
+        expect(1 in result).toBeFalse();
+        expect(result[0]).toBe(2);
+        expect(result[2]).toBe(60);
+    });
+});
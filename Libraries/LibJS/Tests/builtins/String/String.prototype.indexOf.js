@@ -29,3 +29,16 @@ test("UTF-16", () => {
     expect(s.indexOf("\ude00")).toBe(1);
     expect(s.indexOf("a")).toBe(-1);
 });
+
+test("long strings", () => {
+    var s = "a".repeat(100);
+    expect(s.indexOf("ab")).toBe(-1);
+    expect((s + "ab").indexOf("ab")).toBe(100);
+    expect((s + "ab" + s + "ab").indexOf("ab", 101)).toBe(202);
+
+    var t = "héllo wörld ".repeat(10);
+    expect(t.indexOf("wö")).toBe(6);
+    expect(t.indexOf("wö", 7)).toBe(18);
+    expect(t.indexOf("o w")).toBe(4);
+    expect(t.indexOf("é", 2)).toBe(13);
+});
@@ -25,6 +25,14 @@ test("basic functionality", () => {
     expect("a,b,,c,d".split(",")).toEqual(["a", "b", "", "c", "d"]);
     expect(",a,b,,c,d,".split(",")).toEqual(["", "a", "b", "", "c", "d", ""]);
     expect(",a,b,,,c,d,".split(",,")).toEqual([",a,b", ",c,d,"]);
+    expect("aaaa".split("aa")).toEqual(["", "", ""]);
+    expect(("x".repeat(40) + "needle" + "x".repeat(3)).split("needle")).toEqual(["x".repeat(40), "xxx"]);
+});
+
+test("UTF-16", () => {
+    expect("😀a😀b".split("😀")).toEqual(["", "a", "b"]);
+    expect("héllo wörld".split("ö")).toEqual(["héllo w", "rld"]);
+    expect("😀".split("")).toEqual(["\ud83d", "\ude00"]);
 });
 
 test("limits", () => {
@@ -0,0 +1,97 @@
+test("Constants propagate through locals and registers", () => {
+    function compute() {
+        let a = 6;
+        let b = a * 7;
+        const c = b - 2;
+        return c + "!";
+    }
+    expect(compute()).toBe("40!");
+});
+
+test("Folded conditions still take the right branch", () => {
+    function branches() {
+        const flag = 1 < 2;
+        let result = [];
+        if (flag) result.push("then");
+        else result.push("else");
+        const nothing = null;
+        result.push(nothing ?? "fallback");
+        while (!flag) result.push("never");
+        return result;
+    }
+    expect(branches()).toEqual(["then", "fallback"]);
+});
+
+test("BigInt and mixed operations are not folded", () => {
+    function mixed() {
+        const big = 10n;
+        return big + 1;
+    }
+    expect(mixed).toThrowWithMessage(TypeError, "Cannot use addition operator with BigInt and other type");
+});
+
+test("TDZ checks are kept where they matter", () => {
+    function readBeforeInitialization() {
+        x;
+        let x = 1;
+        return x;
+    }
+    expect(readBeforeInitialization).toThrowWithMessage(ReferenceError, "Binding x is not initialized");
+
+    function readTwice() {
+        let y = 2;
+        return y + y;
+    }
+    expect(readTwice()).toBe(4);
+});
+
+test("Nullish checks are kept where they matter", () => {
+    function destructure(value) {
+        const { a } = value;
+        const { b } = value;
+        return a + b;
+    }
+    expect(destructure({ a: 1, b: 2 })).toBe(3);
+    expect(() => destructure(null)).toThrow(TypeError);
+});
+
+test("Values written inside try blocks are seen by handlers", () => {
+    function tryCatch() {
+        let state = 1;
+        try {
+            state = state + 1;
+            throw new Error("boom");
+        } catch {
+            state = state * 10;
+        } finally {
+            state = state + 3;
+        }
+        return state;
+    }
+    expect(tryCatch()).toBe(23);
+});
+
+test("Generators keep their state across yields", () => {
+    function* generator() {
+        let i = 1;
+        const two = i + 1;
+        yield two;
+        i = i + two;
+        yield i;
+    }
+    expect([...generator()]).toEqual([2, 3]);
+});
+
+test("Block-level function declarations are visible after instantiation", () => {
+    function blockFunction() {
+        let result;
+        {
+            result = f();
+            function f() {
+                return "hoisted";
+            }
+        }
+        return result;
+    }
+    expect(blockFunction()).toBe("hoisted");
+});
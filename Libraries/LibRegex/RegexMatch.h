@@ -14,6 +14,7 @@
 #include <AK/Error.h>
 #include <AK/FlyString.h>
 #include <AK/MemMem.h>
+#include <AK/SIMDSearch.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
 #include <AK/Utf16String.h>
@@ -215,6 +216,30 @@ public:
             [&](Utf16View const& view) -> u32 { return view.code_point_at(code_unit_index); });
     }
 
+    // Returns the offset of the first code unit at or after code_unit_index that is one of the given ASCII characters.
+    Optional<size_t> find_any_of_ascii(ReadonlySpan<char> characters, size_t code_unit_index) const
+    {
+        return m_view.visit(
+            [&](StringView view) { return find_any_of_code_units(view.bytes(), characters, code_unit_index); },
+            [&](Utf16View const& view) {
+                if (view.has_ascii_storage())
+                    return find_any_of_code_units(view.ascii_span(), characters, code_unit_index);
+                return find_any_of_code_units(view.utf16_span(), characters, code_unit_index);
+            });
+    }
+
+    // Returns the offset of the first occurrence of the given ASCII string at or after code_unit_index.
+    Optional<size_t> find_ascii(StringView needle, size_t code_unit_index) const
+    {
+        return m_view.visit(
+            [&](StringView view) { return find_code_units(view.bytes(), needle.bytes(), code_unit_index); },
+            [&](Utf16View const& view) {
+                if (view.has_ascii_storage())
+                    return find_code_units(view.ascii_span(), needle.bytes(), code_unit_index);
+                return find_code_units(view.utf16_span(), needle.bytes(), code_unit_index);
+            });
+    }
+
     // Returns the code point at the code unit offset if the Unicode flag is set. Otherwise, returns the code unit.
     u32 unicode_aware_code_point_at(size_t code_unit_index) const
     {
@@ -120,6 +120,13 @@ Regex<Parser>& Regex<Parser>::operator=(Regex&& regex)
     return *this;
 }
 
+template<class Parser>
+void Regex<Parser>::set_engine_for_testing(Engine engine)
+{
+    VERIFY(engine == Engine::Backtracking || parser_result.optimization_data.can_use_pike_vm);
+    parser_result.optimization_data.use_pike_vm = engine == Engine::PikeVM;
+}
+
 template<class Parser>
 typename ParserTraits<Parser>::OptionsType Regex<Parser>::options() const
 {
@@ -210,6 +217,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
     auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
+    auto use_pike_vm = m_pattern->parser_result.optimization_data.use_pike_vm;
 
     auto compare_range = [insensitive = input.regex_options & AllFlags::Insensitive](auto needle, CharRange range) {
         auto upper_case_needle = needle;
@@ -255,7 +263,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, temp_operations);
+            auto success = use_pike_vm ? execute_pike_vm(input, state, temp_operations, {}).has_value() : execute(input, state, temp_operations);
             // This success is acceptable only if it doesn't read anything from the input (input length is 0).
             if (success && (state.string_position <= view_index)) {
                 operations = temp_operations;
@@ -278,6 +286,13 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
                     break;
             }
 
+            if (continue_search && !only_start_of_line) {
+                auto next_possible_start = find_next_possible_start(input, view_index);
+                if (!next_possible_start.has_value())
+                    break;
+                view_index = *next_possible_start;
+            }
+
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
             //        the vm. Add new OpCode for MinMatchLengthFromSp with the value of
@@ -307,45 +322,61 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            if (execute(input, state, operations)) {
-                succeeded = true;
-
-                if (input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine) && state.string_position == input.view.length()) {
-                    if (!continue_search)
-                        break;
-                    continue;
-                }
-                if (input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine) && view_index == 0) {
-                    if (!continue_search)
-                        break;
-                    continue;
+            if (use_pike_vm) {
+                // NOTE: Rather than being called again for each position after this one, the Pike VM looks for a match
+                //       that starts at any of them in one go.
+                Optional<size_t> last_start_position;
+                if (continue_search && !only_start_of_line) {
+                    last_start_position = view_length - match_length_minimum;
+                    if (input.regex_options.has_flag_set(AllFlags::Multiline) && match_length_minimum == 0)
+                        last_start_position = view_length - 1;
                 }
 
-                dbgln_if(REGEX_DEBUG, "state.string_position={}, view_index={}", state.string_position, view_index);
-                dbgln_if(REGEX_DEBUG, "[match] Found a match (length={}): '{}'", state.string_position - view_index, input.view.substring_view(view_index, state.string_position - view_index));
-
-                ++match_count;
+                auto match_start = execute_pike_vm(input, state, operations, last_start_position);
+                if (!match_start.has_value())
+                    break;
+                view_index = *match_start;
+            } else if (!execute(input, state, operations)) {
+                goto done_matching;
+            }
 
-                if (continue_search) {
-                    append_match(input, state, view_index);
+            succeeded = true;
 
-                    bool has_zero_length = state.string_position == view_index;
-                    view_index = state.string_position - (has_zero_length ? 0 : 1);
-                    if (single_match_only)
-                        break;
-                    continue;
-                }
-                if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful)) {
-                    append_match(input, state, view_index);
+            if (input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine) && state.string_position == input.view.length()) {
+                if (!continue_search)
                     break;
-                }
-                if (state.string_position < view_length) {
-                    return { false, 0, {}, {}, {}, operations };
-                }
+                continue;
+            }
+            if (input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine) && view_index == 0) {
+                if (!continue_search)
+                    break;
+                continue;
+            }
+
+            dbgln_if(REGEX_DEBUG, "state.string_position={}, view_index={}", state.string_position, view_index);
+            dbgln_if(REGEX_DEBUG, "[match] Found a match (length={}): '{}'", state.string_position - view_index, input.view.substring_view(view_index, state.string_position - view_index));
 
+            ++match_count;
+
+            if (continue_search) {
+                append_match(input, state, view_index);
+
+                bool has_zero_length = state.string_position == view_index;
+                view_index = state.string_position - (has_zero_length ? 0 : 1);
+                if (single_match_only)
+                    break;
+                continue;
+            }
+            if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful)) {
                 append_match(input, state, view_index);
                 break;
             }
+            if (state.string_position < view_length) {
+                return { false, 0, {}, {}, {}, operations };
+            }
+
+            append_match(input, state, view_index);
+            break;
 
         done_matching:
             if (!continue_search || only_start_of_line)
@@ -603,6 +634,182 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
     VERIFY_NOT_REACHED();
 }
 
+// NOTE: Two threads at the same position in the input behave the same from there on if they're at the same instruction, and
+//       have the same repetition counts. A checkpoint only makes a difference if it was set at the current position,
+//       since that is all JumpNonEmpty looks at, and the Pike VM never moves backwards in the input.
+static u64 pike_vm_thread_hash(MatchState const& state)
+{
+    u64 hash = 0xcbf29ce484222325;
+    auto combine = [&hash](u64 value) {
+        hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    };
+
+    combine(state.instruction_position);
+    combine(state.string_position_in_code_units);
+    combine(state.repetition_marks.size());
+    for (auto mark : state.repetition_marks)
+        combine(mark);
+    for (size_t i = 0; i < state.checkpoints.size(); ++i) {
+        if (state.checkpoints[i] == state.string_position + 1)
+            combine(i);
+    }
+
+    return hash;
+}
+
+// This runs all the ways the pattern could match side by side, one position in the input at a time, instead of trying
+// them one after another like execute() does. Threads are kept in the order that execute() would try them in, and a
+// thread that gets to a state that a thread before it has already been in at the current position is dropped, as it
+// can't match if that one didn't. That bounds the work per position by the size of the bytecode, so matching takes
+// linear time in the length of the input.
+// If last_start_position is set, this also looks for a match that starts at any position up to it, and returns where
+// the match that it found starts.
+template<class Parser>
+Optional<size_t> Matcher<Parser>::execute_pike_vm(MatchInput const& input, MatchState& state, size_t& operations, Optional<size_t> last_start_position) const
+{
+    struct Thread {
+        MatchState state;
+        size_t start_position { 0 };
+    };
+
+    auto& bytecode = m_pattern->parser_result.bytecode;
+    auto& jump_targets = m_pattern->parser_result.optimization_data.pike_vm_jump_targets;
+
+    Vector<Thread> threads;
+    Vector<Thread> next_threads;
+    Vector<MatchState> pending_forks;
+    HashTable<u64, SufficientlyUniformValueTraits> seen_thread_hashes;
+    Optional<Thread> match;
+
+    auto run_thread = [&](Thread& thread, size_t position) -> bool {
+        auto current = move(thread.state);
+        pending_forks.clear_with_capacity();
+
+        // NOTE: Two threads can only get into the same state at an instruction that can be jumped to, so that's the only
+        //       place we need to look for duplicates. Threads that have just moved on to this position are checked too,
+        //       as they may have gotten here from different positions.
+        auto is_resuming = true;
+
+        for (;;) {
+            auto result = ExecutionResult::Failed;
+            auto is_duplicate = false;
+            if (is_resuming || jump_targets[current.instruction_position])
+                is_duplicate = seen_thread_hashes.set(pike_vm_thread_hash(current)) != HashSetResult::InsertedNewEntry;
+            is_resuming = false;
+
+            if (!is_duplicate) {
+                auto& opcode = bytecode.get_opcode(current);
+                ++operations;
+
+#if REGEX_DEBUG
+                s_regex_dbg.print_opcode("PikeVM", opcode, current, 0, false);
+#endif
+
+                result = opcode.execute(input, current);
+
+#if REGEX_DEBUG
+                s_regex_dbg.print_result(opcode, bytecode, input, current, result);
+#endif
+
+                // NOTE: Replacing forks only exist to drop alternatives that can't match early, which we don't need to do.
+                input.fork_to_replace.clear();
+                current.instruction_position += opcode.size();
+            }
+
+            switch (result) {
+            case ExecutionResult::Continue:
+                if (current.string_position == position)
+                    continue;
+                next_threads.append({ move(current), thread.start_position });
+                break;
+            case ExecutionResult::Fork_PrioHigh:
+                pending_forks.append(current);
+                current.instruction_position = current.fork_at_position;
+                continue;
+            case ExecutionResult::Fork_PrioLow:
+                pending_forks.append(current);
+                pending_forks.last().instruction_position = current.fork_at_position;
+                continue;
+            case ExecutionResult::Succeeded:
+                match = Thread { move(current), thread.start_position };
+                return true;
+            case ExecutionResult::Failed:
+            case ExecutionResult::Failed_ExecuteLowPrioForks:
+                break;
+            }
+
+            if (pending_forks.is_empty())
+                return false;
+            current = pending_forks.take_last();
+        }
+    };
+
+    auto should_start_thread_at = [&](size_t position) {
+        return last_start_position.has_value() && position <= *last_start_position && !match.has_value();
+    };
+
+    auto start_position = state.string_position;
+    threads.append({ state, start_position });
+
+    for (auto position = start_position; !threads.is_empty() || should_start_thread_at(position); ++position) {
+        // With no threads left, nothing happens until we get to a position that a match can start at.
+        if (threads.is_empty()) {
+            auto next_possible_start = find_next_possible_start(input, position);
+            if (!next_possible_start.has_value() || !should_start_thread_at(*next_possible_start))
+                break;
+            position = *next_possible_start;
+        }
+
+        // A match that starts here is only of interest if none of the threads that started before it match.
+        if (position != start_position && should_start_thread_at(position)) {
+            threads.append({ state, position });
+            threads.last().state.string_position = position;
+            threads.last().state.string_position_in_code_units = position;
+        }
+
+        seen_thread_hashes.clear_with_capacity();
+
+        for (auto& thread : threads) {
+            if (thread.state.string_position != position) {
+                next_threads.append(move(thread));
+                continue;
+            }
+
+            // Once a thread has matched, the threads after it can't produce the match that execute() would have found.
+            if (run_thread(thread, position))
+                break;
+        }
+
+        swap(threads, next_threads);
+        next_threads.clear_with_capacity();
+    }
+
+    if (!match.has_value())
+        return {};
+
+    state = move(match->state);
+    return match->start_position;
+}
+
+template<class Parser>
+Optional<size_t> Matcher<Parser>::find_next_possible_start(MatchInput const& input, size_t position) const
+{
+    auto const& optimization_data = m_pattern->parser_result.optimization_data;
+
+    if (!input.regex_options.has_flag_set(AllFlags::Insensitive)) {
+        if (!optimization_data.starting_literal.is_empty())
+            return input.view.find_ascii(optimization_data.starting_literal, position);
+        if (!optimization_data.starting_characters.is_empty())
+            return input.view.find_any_of_ascii(optimization_data.starting_characters, position);
+        return position;
+    }
+
+    // NOTE: With Unicode case folding, some non-ASCII characters match ASCII ones too (e.g. KELVIN SIGN and 'k').
+    if (input.view.unicode() || optimization_data.starting_characters_insensitive.is_empty())
+        return position;
+    return input.view.find_any_of_ascii(optimization_data.starting_characters_insensitive, position);
+}
+
 template class Matcher<PosixBasicParser>;
 template class Regex<PosixBasicParser>;
 
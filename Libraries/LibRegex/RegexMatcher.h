@@ -72,6 +72,8 @@ public:
 
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    Optional<size_t> execute_pike_vm(MatchInput const& input, MatchState& state, size_t& operations, Optional<size_t> last_start_position) const;
+    Optional<size_t> find_next_possible_start(MatchInput const& input, size_t position) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
@@ -223,6 +225,14 @@ public:
         return result.success;
     }
 
+    enum class Engine {
+        Backtracking,
+        PikeVM,
+    };
+
+    // Normally, the optimizer picks the engine. This lets tests and benchmarks compare the engines on the same pattern.
+    void set_engine_for_testing(Engine);
+
     using BasicBlockList = Vector<Detail::Block>;
     static BasicBlockList split_basic_blocks(ByteCode const&);
 
@@ -232,6 +242,8 @@ private:
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
     void fill_optimization_data(BasicBlockList const&);
+    void fill_starting_literal(BasicBlockList const&);
+    void fill_starting_characters(Vector<CharRange> const& starting_ranges);
 };
 
 // free standing functions for match, search and has_match
@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/Function.h>
+#include <AK/GenericShorthands.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
 #include <AK/RedBlackTree.h>
@@ -25,14 +26,192 @@ namespace regex {
 
 using Detail::Block;
 
+// The Pike VM can only tell threads apart by their position in the bytecode and input, so it can't run anything that
+// depends on what an earlier part of the pattern captured, or that moves backwards in the input.
+static bool has_backreferences_or_lookarounds(ByteCode const& bytecode)
+{
+    auto state = MatchState::only_for_enumeration();
+    auto bytecode_size = bytecode.size();
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto compares = static_cast<OpCode_Compare const&>(opcode).flat_compares();
+            if (any_of(compares, [](auto& compare) { return compare.type == CharacterCompareType::Reference; }))
+                return true;
+            break;
+        }
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::PopSaved:
+            return true;
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+    return false;
+}
+
+static Vector<bool> find_jump_targets(ByteCode const& bytecode)
+{
+    Vector<bool> jump_targets;
+    jump_targets.resize(bytecode.size() + 1);
+
+    auto mark_target = [&]<typename T>(OpCode const& opcode, size_t position) {
+        auto const& jump = static_cast<T const&>(opcode);
+        jump_targets[position + jump.size() + jump.offset()] = true;
+    };
+
+    auto state = MatchState::only_for_enumeration();
+    auto bytecode_size = bytecode.size();
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Jump:
+            mark_target.template operator()<OpCode_Jump>(opcode, state.instruction_position);
+            break;
+        case OpCodeId::JumpNonEmpty:
+            mark_target.template operator()<OpCode_JumpNonEmpty>(opcode, state.instruction_position);
+            break;
+        case OpCodeId::ForkJump:
+            mark_target.template operator()<OpCode_ForkJump>(opcode, state.instruction_position);
+            break;
+        case OpCodeId::ForkStay:
+            mark_target.template operator()<OpCode_ForkStay>(opcode, state.instruction_position);
+            break;
+        case OpCodeId::ForkReplaceJump:
+            mark_target.template operator()<OpCode_ForkReplaceJump>(opcode, state.instruction_position);
+            break;
+        case OpCodeId::ForkReplaceStay:
+            mark_target.template operator()<OpCode_ForkReplaceStay>(opcode, state.instruction_position);
+            break;
+        case OpCodeId::Repeat:
+            jump_targets[state.instruction_position - static_cast<OpCode_Repeat const&>(opcode).offset()] = true;
+            break;
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+    return jump_targets;
+}
+
+// Backtracking can take more than linear time on any pattern with an unbounded loop that might give back what it
+// matched, whether the loops are nested (e.g. (a+)+), the loop has alternatives that overlap (e.g. (a|aa)*), or the
+// text a loop matches could also be matched by what follows it (e.g. .*a.*a, or a.*b). The only loops that are provably
+// unambiguous are those that don't fork anywhere else in their body, and that either were rewritten as atomic groups
+// (the optimizer has shown that what follows them can't start with what they match) or are followed by nothing that
+// could fail (so the first way through them is always taken). Patterns with any other unbounded loop are run on the
+// Pike VM, which is linear in the length of the input.
+static bool has_possibly_ambiguous_unbounded_loops(ByteCode const& bytecode)
+{
+    auto is_atomic_fork = [](OpCodeId id) {
+        return id == OpCodeId::ForkReplaceJump || id == OpCodeId::ForkReplaceStay;
+    };
+    auto is_fork = [](OpCodeId id) {
+        return first_is_one_of(id, OpCodeId::ForkJump, OpCodeId::ForkStay, OpCodeId::ForkReplaceJump, OpCodeId::ForkReplaceStay, OpCodeId::JumpNonEmpty);
+    };
+
+    auto bytecode_size = bytecode.size();
+
+    auto forks_between = [&](size_t from, size_t to) {
+        auto state = MatchState::only_for_enumeration();
+        for (state.instruction_position = from; state.instruction_position < to;) {
+            auto& opcode = bytecode.get_opcode(state);
+            if (is_fork(opcode.opcode_id()))
+                return true;
+            state.instruction_position += opcode.size();
+        }
+        return false;
+    };
+
+    auto nothing_can_fail_after = [&](size_t from) {
+        auto state = MatchState::only_for_enumeration();
+        for (state.instruction_position = from; state.instruction_position < bytecode_size;) {
+            auto& opcode = bytecode.get_opcode(state);
+            switch (opcode.opcode_id()) {
+            case OpCodeId::Checkpoint:
+            case OpCodeId::SaveLeftCaptureGroup:
+            case OpCodeId::SaveRightCaptureGroup:
+            case OpCodeId::SaveRightNamedCaptureGroup:
+            case OpCodeId::ClearCaptureGroup:
+            case OpCodeId::Exit:
+                break;
+            default:
+                return false;
+            }
+            state.instruction_position += opcode.size();
+        }
+        return true;
+    };
+
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto position = state.instruction_position;
+        auto end = position + opcode.size();
+
+        ssize_t offset = 0;
+        auto form = opcode.opcode_id();
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Jump:
+            offset = static_cast<OpCode_Jump const&>(opcode).offset();
+            break;
+        case OpCodeId::JumpNonEmpty:
+            offset = static_cast<OpCode_JumpNonEmpty const&>(opcode).offset();
+            form = static_cast<OpCode_JumpNonEmpty const&>(opcode).form();
+            break;
+        case OpCodeId::ForkJump:
+            offset = static_cast<OpCode_ForkJump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkStay:
+            offset = static_cast<OpCode_ForkStay const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkReplaceJump:
+            offset = static_cast<OpCode_ForkReplaceJump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkReplaceStay:
+            offset = static_cast<OpCode_ForkReplaceStay const&>(opcode).offset();
+            break;
+        default:
+            break;
+        }
+
+        if (offset < 0) {
+            auto body_start = end + offset;
+            auto is_atomic = is_atomic_fork(form);
+
+            // Loops that may be skipped entirely (e.g. a*) are entered through a fork, and jump back to it unconditionally.
+            if (form == OpCodeId::Jump) {
+                auto entry_state = MatchState::only_for_enumeration();
+                entry_state.instruction_position = body_start;
+                auto& entry = bytecode.get_opcode(entry_state);
+                is_atomic = is_atomic_fork(entry.opcode_id());
+                body_start += entry.size();
+            }
+
+            if (forks_between(body_start, position) || !(is_atomic || nothing_can_fail_after(end)))
+                return true;
+        }
+
+        state.instruction_position = end;
+    }
+    return false;
+}
+
 template<typename Parser>
 void Regex<Parser>::run_optimization_passes()
 {
     rewrite_with_useless_jumps_removed();
 
     auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
+    if (attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        fill_starting_literal(blocks);
         return;
+    }
 
     // Rewrite fork loops as atomic groups
     // e.g. a*b -> (ATOMIC a*)b
@@ -41,6 +220,12 @@ void Regex<Parser>::run_optimization_passes()
     fill_optimization_data(split_basic_blocks(parser_result.bytecode));
 
     parser_result.bytecode.flatten();
+
+    parser_result.optimization_data.can_use_pike_vm = !has_backreferences_or_lookarounds(parser_result.bytecode);
+    if (parser_result.optimization_data.can_use_pike_vm) {
+        parser_result.optimization_data.use_pike_vm = has_possibly_ambiguous_unbounded_loops(parser_result.bytecode);
+        parser_result.optimization_data.pike_vm_jump_targets = find_jump_targets(parser_result.bytecode);
+    }
 }
 
 struct StaticallyInterpretedCompares {
@@ -203,6 +388,8 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
         }
     };
 
+    fill_starting_literal(blocks);
+
     auto& bytecode = parser_result.bytecode;
 
     auto state = MatchState::only_for_enumeration();
@@ -228,6 +415,7 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
                 parser_result.optimization_data.starting_ranges_insensitive.append({ to_ascii_lowercase(it.key()), to_ascii_lowercase(*it) });
                 quick_sort(parser_result.optimization_data.starting_ranges_insensitive, [](CharRange a, CharRange b) { return a.from < b.from; });
             }
+            fill_starting_characters(parser_result.optimization_data.starting_ranges);
             return;
         }
         case OpCodeId::CheckBegin:
@@ -246,6 +434,62 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
     }
 }
 
+template<typename Parser>
+void Regex<Parser>::fill_starting_literal(BasicBlockList const& blocks)
+{
+    if (blocks.is_empty())
+        return;
+
+    auto& bytecode = parser_result.bytecode;
+    auto state = MatchState::only_for_enumeration();
+    auto block = blocks.first();
+
+    // Every match goes through the first block, so the characters that it compares against one after the other are
+    // what every match starts with.
+    StringBuilder starting_literal;
+    for (state.instruction_position = block.start; state.instruction_position < block.end;) {
+        auto& opcode = bytecode.get_opcode(state);
+        if (opcode.opcode_id() == OpCodeId::Compare) {
+            auto flat_compares = static_cast<OpCode_Compare const&>(opcode).flat_compares();
+            if (flat_compares.size() != 1 || flat_compares.first().type != CharacterCompareType::Char || !is_ascii(flat_compares.first().value))
+                break;
+            starting_literal.append(static_cast<char>(flat_compares.first().value));
+        } else if (!first_is_one_of(opcode.opcode_id(), OpCodeId::Checkpoint, OpCodeId::ClearCaptureGroup, OpCodeId::SaveLeftCaptureGroup, OpCodeId::SaveRightCaptureGroup, OpCodeId::SaveRightNamedCaptureGroup)) {
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+    if (!starting_literal.is_empty())
+        parser_result.optimization_data.starting_literal = starting_literal.to_byte_string();
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_starting_characters(Vector<CharRange> const& starting_ranges)
+{
+    // NOTE: Scanning for a character costs about as much for each of them, so this is only worth it for a few.
+    static constexpr size_t max_starting_characters = 8;
+
+    Vector<char> characters;
+    for (auto range : starting_ranges) {
+        if (range.to > 0x7f || range.to - range.from >= max_starting_characters - characters.size())
+            return;
+        for (auto code_point = range.from; code_point <= range.to; ++code_point)
+            characters.append(static_cast<char>(code_point));
+    }
+
+    Vector<char> characters_insensitive;
+    for (auto character : characters) {
+        for (auto variant : { to_ascii_lowercase(character), to_ascii_uppercase(character) }) {
+            if (!characters_insensitive.contains_slow(variant))
+                characters_insensitive.append(variant);
+        }
+    }
+
+    parser_result.optimization_data.starting_characters = move(characters);
+    if (characters_insensitive.size() <= max_starting_characters)
+        parser_result.optimization_data.starting_characters_insensitive = move(characters_insensitive);
+}
+
 template<typename Parser>
 typename Regex<Parser>::BasicBlockList Regex<Parser>::split_basic_blocks(ByteCode const& bytecode)
 {
@@ -67,7 +67,20 @@ public:
             // If populated, the pattern only accepts strings that start with a character in these ranges.
             Vector<CharRange> starting_ranges;
             Vector<CharRange> starting_ranges_insensitive;
+            // If populated, the pattern only accepts strings that start with one of these few ASCII characters, so a
+            // search can skip ahead to where one of them occurs.
+            Vector<char> starting_characters;
+            Vector<char> starting_characters_insensitive;
+            // If populated, the pattern only accepts strings that start with this ASCII literal, unless it's matched case-insensitively.
+            ByteString starting_literal;
             bool only_start_of_line = false;
+            // If set, the pattern has no backreferences or lookarounds, so it can be matched by the Pike VM.
+            bool can_use_pike_vm = false;
+            // If set, the pattern is matched by the Pike VM rather than by backtracking. That's only worth it for patterns
+            // that can take exponential or quadratic time to backtrack through, since the Pike VM is slower otherwise.
+            bool use_pike_vm = false;
+            // For each position in the bytecode, whether any instruction jumps or forks to it.
+            Vector<bool> pike_vm_jump_targets;
         } optimization_data {};
     };
 
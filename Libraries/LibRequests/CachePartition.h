@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+
+namespace Requests {
+
+// The serialized sites of the top-level document and of the frame that made a request. RequestServer's disk cache is
+// shared by every WebContent process, so a stored response is only used for requests from the same partition.
+struct CachePartition {
+    ByteString top_level_site;
+    ByteString frame_site;
+
+    bool operator==(CachePartition const&) const = default;
+};
+
+}
+
+namespace IPC {
+
+template<>
+inline ErrorOr<void> encode(Encoder& encoder, Requests::CachePartition const& partition)
+{
+    TRY(encoder.encode(partition.top_level_site));
+    TRY(encoder.encode(partition.frame_site));
+    return {};
+}
+
+template<>
+inline ErrorOr<Requests::CachePartition> decode(Decoder& decoder)
+{
+    auto top_level_site = TRY(decoder.decode<ByteString>());
+    auto frame_site = TRY(decoder.decode<ByteString>());
+
+    return Requests::CachePartition {
+        .top_level_site = move(top_level_site),
+        .frame_site = move(frame_site),
+    };
+}
+
+}
@@ -8,6 +8,7 @@
 
 namespace Requests {
 
+struct CachePartition;
 class Request;
 class RequestClient;
 class WebSocket;
@@ -138,6 +138,11 @@ void Animatable::disassociate_with_animation(GC::Ref<Animation> animation)
     impl.associated_animations.remove_first_matching([&](auto element) { return animation == element; });
 }
 
+bool Animatable::has_associated_animations() const
+{
+    return m_impl && !m_impl->associated_animations.is_empty();
+}
+
 void Animatable::add_transitioned_properties(Optional<CSS::PseudoElement> pseudo_element, Vector<Vector<CSS::PropertyID>> properties, CSS::StyleValueVector delays, CSS::StyleValueVector durations, CSS::StyleValueVector timing_functions, CSS::StyleValueVector transition_behaviors)
 {
     VERIFY(properties.size() == delays.size());
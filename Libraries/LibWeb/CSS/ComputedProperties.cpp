@@ -44,10 +44,180 @@ namespace Web::CSS {
 
 GC_DEFINE_ALLOCATOR(ComputedProperties);
 
+namespace {
+
+struct PropertyGroupLayout {
+    struct Slot {
+        u16 group { 0 };
+        u16 index { 0 };
+    };
+
+    Array<Slot, number_of_longhand_properties> slots;
+    Array<bool, ComputedProperties::max_property_group_count> group_is_inherited {};
+    size_t group_count { 0 };
+};
+
+}
+
+static PropertyGroupLayout const& property_group_layout()
+{
+    static PropertyGroupLayout const layout = [] {
+        PropertyGroupLayout layout;
+
+        struct OpenGroup {
+            Optional<u16> group;
+            u16 size { 0 };
+        };
+        OpenGroup inherited_group;
+        OpenGroup non_inherited_group;
+
+        for (size_t i = 0; i < number_of_longhand_properties; ++i) {
+            auto is_inherited = is_inherited_property(static_cast<PropertyID>(i + to_underlying(first_longhand_property_id)));
+            auto& open_group = is_inherited ? inherited_group : non_inherited_group;
+            if (!open_group.group.has_value() || open_group.size == ComputedProperties::PropertyGroup::property_count) {
+                VERIFY(layout.group_count < ComputedProperties::max_property_group_count);
+                open_group = { static_cast<u16>(layout.group_count++), 0 };
+                layout.group_is_inherited[*open_group.group] = is_inherited;
+            }
+            layout.slots[i] = { *open_group.group, open_group.size++ };
+        }
+
+        return layout;
+    }();
+    return layout;
+}
+
+static PropertyGroupLayout::Slot property_group_slot(PropertyID property_id)
+{
+    VERIFY(property_id >= first_longhand_property_id && property_id <= last_longhand_property_id);
+    return property_group_layout().slots[to_underlying(property_id) - to_underlying(first_longhand_property_id)];
+}
+
+static Array<RefPtr<ComputedProperties::PropertyGroup>, ComputedProperties::max_property_group_count> const& initial_property_groups()
+{
+    static auto const groups = [] {
+        Array<RefPtr<ComputedProperties::PropertyGroup>, ComputedProperties::max_property_group_count> groups;
+        for (size_t group = 0; group < property_group_layout().group_count; ++group)
+            groups[group] = make_ref_counted<ComputedProperties::PropertyGroup>();
+
+        for (size_t i = 0; i < number_of_longhand_properties; ++i) {
+            auto property_id = static_cast<PropertyID>(i + to_underlying(first_longhand_property_id));
+            auto slot = property_group_slot(property_id);
+            groups[slot.group]->values[slot.index] = property_initial_value(property_id);
+        }
+
+        return groups;
+    }();
+    return groups;
+}
+
+static bool are_equal(RefPtr<StyleValue const> const& a, RefPtr<StyleValue const> const& b)
+{
+    if (a.ptr() == b.ptr())
+        return true;
+    if (!a || !b)
+        return false;
+    return a->type() == b->type() && *a == *b;
+}
+
 ComputedProperties::ComputedProperties() = default;
 
 ComputedProperties::~ComputedProperties() = default;
 
+GC::Ref<ComputedProperties> ComputedProperties::clone() const
+{
+    auto clone = heap().allocate<ComputedProperties>();
+    clone->m_animation_name_source = m_animation_name_source;
+    clone->m_transition_property_source = m_transition_property_source;
+    clone->m_property_groups = m_property_groups;
+    clone->m_property_important = m_property_important;
+    clone->m_property_inherited = m_property_inherited;
+    clone->m_animated_property_inherited = m_animated_property_inherited;
+    clone->m_animated_property_values = m_animated_property_values;
+    clone->m_math_depth = m_math_depth;
+    clone->m_font_list = m_font_list;
+    clone->m_first_available_computed_font = m_first_available_computed_font;
+    clone->m_line_height = m_line_height;
+    clone->m_attempted_pseudo_class_matches = m_attempted_pseudo_class_matches;
+    return clone;
+}
+
+void ComputedProperties::share_property_groups_with_parent(ComputedProperties const* parent_style)
+{
+    auto const& layout = property_group_layout();
+    auto const& initial_groups = initial_property_groups();
+
+    for (size_t group = 0; group < layout.group_count; ++group) {
+        if (parent_style && layout.group_is_inherited[group] && parent_style->m_property_groups[group])
+            m_property_groups[group] = parent_style->m_property_groups[group];
+        else
+            m_property_groups[group] = initial_groups[group];
+    }
+}
+
+static bool are_equal(ComputedProperties::PropertyGroup const& a, ComputedProperties::PropertyGroup const& b)
+{
+    for (size_t i = 0; i < ComputedProperties::PropertyGroup::property_count; ++i) {
+        if (!are_equal(a.values[i], b.values[i]))
+            return false;
+    }
+    return true;
+}
+
+void ComputedProperties::share_equal_property_groups(ComputedProperties const* parent_style)
+{
+    auto const& initial_groups = initial_property_groups();
+
+    for (size_t group = 0; group < property_group_layout().group_count; ++group) {
+        auto& my_group = m_property_groups[group];
+        if (!my_group)
+            continue;
+
+        if (parent_style) {
+            auto const& parent_group = parent_style->m_property_groups[group];
+            if (parent_group && (my_group.ptr() == parent_group.ptr() || are_equal(*my_group, *parent_group))) {
+                my_group = parent_group;
+                continue;
+            }
+        }
+
+        auto const& initial_group = initial_groups[group];
+        if (my_group.ptr() != initial_group.ptr() && are_equal(*my_group, *initial_group))
+            my_group = initial_group;
+    }
+}
+
+StyleValue const* ComputedProperties::property_value(PropertyID property_id) const
+{
+    auto slot = property_group_slot(property_id);
+    auto const& group = m_property_groups[slot.group];
+    return group ? group->values[slot.index].ptr() : nullptr;
+}
+
+void ComputedProperties::set_property_value(PropertyID property_id, NonnullRefPtr<StyleValue const> value)
+{
+    auto slot = property_group_slot(property_id);
+    auto& group = m_property_groups[slot.group];
+
+    if (!group) {
+        group = make_ref_counted<PropertyGroup>();
+    } else {
+        // NOTE: Replacing a value with itself would needlessly stop us from sharing the group. Values that are only
+        //       equal are not worth comparing here, since this is on the hot path of computing every style. Groups
+        //       that end up equal are shared again once the style is computed, see share_equal_property_groups().
+        if (group->values[slot.index].ptr() == value.ptr())
+            return;
+
+        if (group->ref_count() > 1) {
+            auto copy = make_ref_counted<PropertyGroup>();
+            copy->values = group->values;
+            group = move(copy);
+        }
+    }
+
+    group->values[slot.index] = move(value);
+}
+
 void ComputedProperties::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -116,7 +286,7 @@ void ComputedProperties::set_property(PropertyID id, NonnullRefPtr<StyleValue co
 {
     VERIFY(id >= first_longhand_property_id && id <= last_longhand_property_id);
 
-    m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)] = move(value);
+    set_property_value(id, move(value));
     set_property_important(id, important);
     set_property_inherited(id, inherited);
 }
@@ -125,7 +295,8 @@ void ComputedProperties::revert_property(PropertyID id, ComputedProperties const
 {
     VERIFY(id >= first_longhand_property_id && id <= last_longhand_property_id);
 
-    m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)] = style_for_revert.m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)];
+    if (auto const* value = style_for_revert.property_value(id))
+        set_property_value(id, *value);
     set_property_important(id, style_for_revert.is_property_important(id) ? Important::Yes : Important::No);
     set_property_inherited(id, style_for_revert.is_property_inherited(id) ? Inherited::Yes : Inherited::No);
 }
@@ -156,7 +327,7 @@ StyleValue const& ComputedProperties::property(PropertyID property_id, WithAnima
     }
 
     // By the time we call this method, all properties have values assigned.
-    return *m_property_values[to_underlying(property_id) - to_underlying(first_longhand_property_id)];
+    return *property_value(property_id);
 }
 
 Variant<LengthPercentage, NormalGap> ComputedProperties::gap_value(PropertyID id) const
@@ -803,9 +974,10 @@ Positioning ComputedProperties::position() const
 
 bool ComputedProperties::operator==(ComputedProperties const& other) const
 {
-    for (size_t i = 0; i < m_property_values.size(); ++i) {
-        auto const& my_style = m_property_values[i];
-        auto const& other_style = other.m_property_values[i];
+    for (size_t i = 0; i < number_of_longhand_properties; ++i) {
+        auto property_id = static_cast<PropertyID>(i + to_underlying(first_longhand_property_id));
+        auto const* my_style = property_value(property_id);
+        auto const* other_style = other.property_value(property_id);
         if (!my_style) {
             if (other_style)
                 return false;
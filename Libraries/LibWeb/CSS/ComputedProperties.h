@@ -9,6 +9,7 @@
 
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Ptr.h>
 #include <LibGfx/Font/Font.h>
@@ -34,12 +35,43 @@ public:
 
     virtual ~ComputedProperties() override;
 
+    [[nodiscard]] GC::Ref<ComputedProperties> clone() const;
+
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (size_t i = 0; i < m_property_values.size(); ++i) {
-            if (m_property_values[i])
-                callback(static_cast<PropertyID>(i + to_underlying(first_longhand_property_id)), *m_property_values[i]);
+        for (size_t i = 0; i < number_of_longhand_properties; ++i) {
+            auto property_id = static_cast<PropertyID>(i + to_underlying(first_longhand_property_id));
+            if (auto const* value = property_value(property_id))
+                callback(property_id, *value);
+        }
+    }
+
+    // Longhand values are kept in groups of related properties (in property ID order), with inherited and
+    // non-inherited properties in separate groups. A group is never modified while it's shared, so styles can share the
+    // groups they have in common with their parent or with each other, and only copy a group when a value in it changes.
+    class PropertyGroup final : public RefCounted<PropertyGroup> {
+    public:
+        static constexpr size_t property_count = 16;
+
+        Array<RefPtr<StyleValue const>, property_count> values;
+    };
+    static constexpr size_t max_property_group_count = ceil_div(number_of_longhand_properties, PropertyGroup::property_count) + 1;
+
+    // Starts out with the groups of inherited properties of the parent style, if any, and the initial values of
+    // everything else, so that groups that end up with the same values stay shared.
+    void share_property_groups_with_parent(ComputedProperties const* parent_style);
+
+    // Replaces each group with the corresponding group of the parent style or with the group of initial values, if
+    // their values are equal. This is done once the style is computed, so that each group is only compared once.
+    void share_equal_property_groups(ComputedProperties const* parent_style);
+
+    template<typename Callback>
+    void for_each_property_group(Callback callback) const
+    {
+        for (auto const& group : m_property_groups) {
+            if (group)
+                callback(*group);
         }
     }
 
@@ -265,10 +297,13 @@ private:
     Overflow overflow(PropertyID) const;
     Vector<ShadowData> shadow(PropertyID, Layout::Node const&) const;
 
+    StyleValue const* property_value(PropertyID) const;
+    void set_property_value(PropertyID, NonnullRefPtr<StyleValue const>);
+
     GC::Ptr<CSSStyleDeclaration const> m_animation_name_source;
     GC::Ptr<CSSStyleDeclaration const> m_transition_property_source;
 
-    Array<RefPtr<StyleValue const>, number_of_longhand_properties> m_property_values;
+    Array<RefPtr<PropertyGroup>, max_property_group_count> m_property_groups;
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_property_important {};
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_property_inherited {};
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_animated_property_inherited {};
@@ -80,6 +80,68 @@ static bool can_selector_use_fast_matches(Selector const& selector)
     return true;
 }
 
+// Matching off the main thread is limited to selectors that only read the DOM. Anything that might allocate, copy a
+// ref-counted string, or depend on document state that's kept elsewhere has to be matched on the main thread.
+static bool can_selector_be_matched_off_main_thread(Selector const& selector)
+{
+    auto is_in_named_namespace = [](Selector::SimpleSelector::QualifiedName const& qualified_name) {
+        return qualified_name.namespace_type == Selector::SimpleSelector::QualifiedName::NamespaceType::Named;
+    };
+
+    for (auto const& compound_selector : selector.compound_selectors()) {
+        if (compound_selector.combinator == Selector::Combinator::Column)
+            return false;
+
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Id:
+            case Selector::SimpleSelector::Type::Class:
+                break;
+            case Selector::SimpleSelector::Type::TagName:
+            case Selector::SimpleSelector::Type::Universal:
+                if (is_in_named_namespace(simple_selector.qualified_name()))
+                    return false;
+                break;
+            case Selector::SimpleSelector::Type::Attribute:
+                if (is_in_named_namespace(simple_selector.attribute().qualified_name))
+                    return false;
+                break;
+            case Selector::SimpleSelector::Type::PseudoClass: {
+                auto const& pseudo_class = simple_selector.pseudo_class();
+                if (!first_is_one_of(pseudo_class.type,
+                        PseudoClass::Active,
+                        PseudoClass::AnyLink,
+                        PseudoClass::Defined,
+                        PseudoClass::Empty,
+                        PseudoClass::FirstChild,
+                        PseudoClass::Focus,
+                        PseudoClass::FocusVisible,
+                        PseudoClass::Heading,
+                        PseudoClass::Hover,
+                        PseudoClass::Is,
+                        PseudoClass::LastChild,
+                        PseudoClass::Link,
+                        PseudoClass::Not,
+                        PseudoClass::OnlyChild,
+                        PseudoClass::Root,
+                        PseudoClass::Visited,
+                        PseudoClass::Where))
+                    return false;
+                for (auto const& argument_selector : pseudo_class.argument_selector_list) {
+                    if (!argument_selector->can_be_matched_off_main_thread())
+                        return false;
+                }
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     : m_compound_selectors(move(compound_selectors))
 {
@@ -133,6 +195,11 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     collect_ancestor_hashes();
 
     m_can_use_fast_matches = can_selector_use_fast_matches(*this);
+
+    // NOTE: Matching must not fill in any lazily computed members while off the main thread, so we do it now.
+    m_can_be_matched_off_main_thread = can_selector_be_matched_off_main_thread(*this);
+    if (m_can_be_matched_off_main_thread)
+        (void)sibling_invalidation_distance();
 }
 
 void Selector::collect_ancestor_hashes()
@@ -54,6 +54,49 @@ static inline GC::Ptr<DOM::Node const> traverse_up(GC::Ptr<DOM::Node const> node
     return node->parent();
 }
 
+void apply_selector_involvement(ElementSelectorInvolvement const& element_involvement)
+{
+    auto& element = const_cast<DOM::Element&>(*element_involvement.element);
+    switch (element_involvement.involvement) {
+    case SelectorInvolvement::HasPseudoClassInSubjectPosition:
+        element.set_affected_by_has_pseudo_class_in_subject_position(true);
+        return;
+    case SelectorInvolvement::HasPseudoClassInNonSubjectPosition:
+        element.set_affected_by_has_pseudo_class_in_non_subject_position(true);
+        return;
+    case SelectorInvolvement::HasPseudoClassWithRelativeSelectorThatHasSiblingCombinator:
+        element.set_affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator(true);
+        return;
+    case SelectorInvolvement::DirectSiblingCombinator:
+        element.set_affected_by_direct_sibling_combinator(true);
+        element.set_sibling_invalidation_distance(max(element_involvement.sibling_invalidation_distance, element.sibling_invalidation_distance()));
+        return;
+    case SelectorInvolvement::IndirectSiblingCombinator:
+        element.set_affected_by_indirect_sibling_combinator(true);
+        return;
+    case SelectorInvolvement::SiblingPositionOrCountPseudoClass:
+        element.set_affected_by_sibling_position_or_count_pseudo_class(true);
+        return;
+    case SelectorInvolvement::NthChildPseudoClass:
+        element.set_affected_by_nth_child_pseudo_class(true);
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static void note_selector_involvement(MatchContext& context, DOM::Element const& element, SelectorInvolvement involvement, size_t sibling_invalidation_distance = 0)
+{
+    if (!context.collect_per_element_selector_involvement_metadata)
+        return;
+
+    ElementSelectorInvolvement element_involvement { element, involvement, sibling_invalidation_distance };
+    if (context.deferred_selector_involvement) {
+        context.deferred_selector_involvement->append(element_involvement);
+        return;
+    }
+    apply_selector_involvement(element_involvement);
+}
+
 // https://www.rfc-editor.org/rfc/rfc4647.html#section-3.3.2
 // NB: Language tags only use ASCII characters, so we can get away with using StringView.
 static bool language_range_matches_tag(StringView language_range, StringView language_tag)
@@ -180,9 +223,7 @@ static inline bool matches_relative_selector(CSS::Selector const& selector, size
         return has;
     }
     case CSS::Selector::Combinator::NextSibling: {
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(*anchor).set_affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator(true);
-        }
+        note_selector_involvement(context, *anchor, SelectorInvolvement::HasPseudoClassWithRelativeSelectorThatHasSiblingCombinator);
         auto* sibling = element.next_element_sibling();
         if (!sibling)
             return false;
@@ -191,9 +232,7 @@ static inline bool matches_relative_selector(CSS::Selector const& selector, size
         return matches_relative_selector(selector, compound_index + 1, *sibling, shadow_host, context, anchor);
     }
     case CSS::Selector::Combinator::SubsequentSibling: {
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(*anchor).set_affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator(true);
-        }
+        note_selector_involvement(context, *anchor, SelectorInvolvement::HasPseudoClassWithRelativeSelectorThatHasSiblingCombinator);
         for (auto const* sibling = element.next_element_sibling(); sibling; sibling = sibling->next_element_sibling()) {
             if (!matches(selector, compound_index, *sibling, shadow_host, context, {}, SelectorKind::Relative, anchor))
                 continue;
@@ -250,6 +289,11 @@ static inline bool matches_indeterminate_pseudo_class(DOM::Element const& elemen
 
 static inline void for_each_matching_attribute(CSS::Selector::SimpleSelector::Attribute const& attribute_selector, GC::Ptr<CSS::CSSStyleSheet const> style_sheet_for_rule, DOM::Element const& element, Function<IterationDecision(DOM::Attr const&)> const& process_attribute)
 {
+    // NOTE: Asking an element without attributes for its NamedNodeMap would allocate one, which we must not do while
+    //       matching off the main thread.
+    if (!element.has_attributes())
+        return;
+
     auto const& qualified_name = attribute_selector.qualified_name;
     auto const& attribute_name = qualified_name.name.name;
 
@@ -556,19 +600,13 @@ static inline bool matches_pseudo_class(CSS::Selector::SimpleSelector::PseudoCla
         return focused_area && element.is_inclusive_ancestor_of(*focused_area);
     }
     case CSS::PseudoClass::FirstChild:
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_sibling_position_or_count_pseudo_class(true);
-        }
+        note_selector_involvement(context, element, SelectorInvolvement::SiblingPositionOrCountPseudoClass);
         return !element.previous_element_sibling();
     case CSS::PseudoClass::LastChild:
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_sibling_position_or_count_pseudo_class(true);
-        }
+        note_selector_involvement(context, element, SelectorInvolvement::SiblingPositionOrCountPseudoClass);
         return !element.next_element_sibling();
     case CSS::PseudoClass::OnlyChild:
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_sibling_position_or_count_pseudo_class(true);
-        }
+        note_selector_involvement(context, element, SelectorInvolvement::SiblingPositionOrCountPseudoClass);
         return !(element.previous_element_sibling() || element.next_element_sibling());
     case CSS::PseudoClass::Empty: {
         if (!element.has_children())
@@ -594,19 +632,13 @@ static inline bool matches_pseudo_class(CSS::Selector::SimpleSelector::PseudoCla
     case CSS::PseudoClass::Scope:
         return scope ? &element == scope : is<HTML::HTMLHtmlElement>(element);
     case CSS::PseudoClass::FirstOfType:
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_sibling_position_or_count_pseudo_class(true);
-        }
+        note_selector_involvement(context, element, SelectorInvolvement::SiblingPositionOrCountPseudoClass);
         return !previous_sibling_with_same_tag_name(element);
     case CSS::PseudoClass::LastOfType:
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_sibling_position_or_count_pseudo_class(true);
-        }
+        note_selector_involvement(context, element, SelectorInvolvement::SiblingPositionOrCountPseudoClass);
         return !next_sibling_with_same_tag_name(element);
     case CSS::PseudoClass::OnlyOfType:
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_sibling_position_or_count_pseudo_class(true);
-        }
+        note_selector_involvement(context, element, SelectorInvolvement::SiblingPositionOrCountPseudoClass);
         return !previous_sibling_with_same_tag_name(element) && !next_sibling_with_same_tag_name(element);
     case CSS::PseudoClass::Lang:
         return matches_lang_pseudo_class(element, pseudo_class.languages);
@@ -640,13 +672,10 @@ static inline bool matches_pseudo_class(CSS::Selector::SimpleSelector::PseudoCla
         // :has() cannot be nested in a :has()
         if (selector_kind == SelectorKind::Relative)
             return false;
-        if (context.collect_per_element_selector_involvement_metadata) {
-            if (&element == context.subject) {
-                const_cast<DOM::Element&>(element).set_affected_by_has_pseudo_class_in_subject_position(true);
-            } else {
-                const_cast<DOM::Element&>(element).set_affected_by_has_pseudo_class_in_non_subject_position(true);
-            }
-        }
+        if (&element == context.subject)
+            note_selector_involvement(context, element, SelectorInvolvement::HasPseudoClassInSubjectPosition);
+        else
+            note_selector_involvement(context, element, SelectorInvolvement::HasPseudoClassInNonSubjectPosition);
         // These selectors should be relative selectors (https://drafts.csswg.org/selectors-4/#relative-selector)
         for (auto& selector : pseudo_class.argument_selector_list) {
             if (matches_has_pseudo_class(selector, element, shadow_host, context))
@@ -674,9 +703,7 @@ static inline bool matches_pseudo_class(CSS::Selector::SimpleSelector::PseudoCla
         if (!parent)
             return false;
 
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_nth_child_pseudo_class(true);
-        }
+        note_selector_involvement(context, element, SelectorInvolvement::NthChildPseudoClass);
 
         auto matches_selector_list = [&context, shadow_host](CSS::SelectorList const& list, DOM::Element const& element) {
             if (list.is_empty())
@@ -1187,19 +1214,14 @@ bool matches(CSS::Selector const& selector, int component_list_index, DOM::Eleme
         return matches(selector, component_list_index - 1, static_cast<DOM::Element const&>(*parent), shadow_host, context, scope, selector_kind, anchor);
     }
     case CSS::Selector::Combinator::NextSibling:
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_direct_sibling_combinator(true);
-            auto new_sibling_invalidation_distance = max(selector.sibling_invalidation_distance(), element.sibling_invalidation_distance());
-            const_cast<DOM::Element&>(element).set_sibling_invalidation_distance(new_sibling_invalidation_distance);
-        }
+        if (context.collect_per_element_selector_involvement_metadata)
+            note_selector_involvement(context, element, SelectorInvolvement::DirectSiblingCombinator, selector.sibling_invalidation_distance());
         VERIFY(component_list_index != 0);
         if (auto* sibling = element.previous_element_sibling())
             return matches(selector, component_list_index - 1, *sibling, shadow_host, context, scope, selector_kind, anchor);
         return false;
     case CSS::Selector::Combinator::SubsequentSibling:
-        if (context.collect_per_element_selector_involvement_metadata) {
-            const_cast<DOM::Element&>(element).set_affected_by_indirect_sibling_combinator(true);
-        }
+        note_selector_involvement(context, element, SelectorInvolvement::IndirectSiblingCombinator);
         VERIFY(component_list_index != 0);
         for (auto* sibling = element.previous_element_sibling(); sibling; sibling = sibling->previous_element_sibling()) {
             if (matches(selector, component_list_index - 1, *sibling, shadow_host, context, scope, selector_kind, anchor))
@@ -16,13 +16,35 @@ enum class SelectorKind {
     Relative,
 };
 
+enum class SelectorInvolvement : u8 {
+    HasPseudoClassInSubjectPosition,
+    HasPseudoClassInNonSubjectPosition,
+    HasPseudoClassWithRelativeSelectorThatHasSiblingCombinator,
+    DirectSiblingCombinator,
+    IndirectSiblingCombinator,
+    SiblingPositionOrCountPseudoClass,
+    NthChildPseudoClass,
+};
+
+struct ElementSelectorInvolvement {
+    GC::Ref<DOM::Element const> element;
+    SelectorInvolvement involvement;
+    size_t sibling_invalidation_distance { 0 };
+};
+
 struct MatchContext {
     GC::Ptr<CSS::CSSStyleSheet const> style_sheet_for_rule {};
     GC::Ptr<DOM::Element const> subject {};
     bool collect_per_element_selector_involvement_metadata { false };
     CSS::PseudoClassBitmap attempted_pseudo_class_matches {};
+
+    // Matching off the main thread must not write to the DOM, so the per-element metadata is recorded here instead,
+    // for the main thread to apply later.
+    Vector<ElementSelectorInvolvement>* deferred_selector_involvement { nullptr };
 };
 
+void apply_selector_involvement(ElementSelectorInvolvement const&);
+
 bool matches(CSS::Selector const&, DOM::Element const&, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context, Optional<CSS::PseudoElement> = {}, GC::Ptr<DOM::ParentNode const> scope = {}, SelectorKind selector_kind = SelectorKind::Normal, GC::Ptr<DOM::Element const> anchor = nullptr);
 
 }
@@ -17,12 +17,14 @@
 #include <AK/Math.h>
 #include <AK/NonnullRawPtr.h>
 #include <AK/QuickSort.h>
+#include <LibCore/System.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/FontStyleMapping.h>
 #include <LibGfx/Font/Typeface.h>
 #include <LibGfx/Font/WOFF/Loader.h>
 #include <LibGfx/Font/WOFF2/Loader.h>
+#include <LibThreading/WorkerThread.h>
 #include <LibWeb/Animations/AnimationEffect.h>
 #include <LibWeb/Animations/DocumentTimeline.h>
 #include <LibWeb/Bindings/PrincipalHostDefined.h>
@@ -76,6 +78,7 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Response.h>
@@ -186,7 +189,8 @@ StyleComputer::StyleComputer(DOM::Document& document)
     , m_default_font_metrics(16, Platform::FontPlugin::the().default_font(16)->pixel_metrics())
     , m_root_element_font_metrics(m_default_font_metrics)
 {
-    m_ancestor_filter = make<CountingBloomFilter<u8, 14>>();
+    m_ancestor_filter = make<AncestorFilter>();
+    m_style_sharing_cache = make<StyleSharingCache>();
     m_qualified_layer_names_in_order.append({});
 }
 
@@ -198,6 +202,8 @@ void StyleComputer::visit_edges(Visitor& visitor)
     visitor.visit(m_document);
     visitor.visit(m_loaded_fonts);
     visitor.visit(m_user_style_sheet);
+    visitor.visit(m_style_sharing_cache->candidates);
+    visitor.visit(m_rules_matched_in_parallel);
 }
 
 FontLoader::FontLoader(StyleComputer& style_computer, GC::Ptr<CSSStyleSheet> parent_style_sheet, FlyString family_name, Vector<Gfx::UnicodeRange> unicode_ranges, Vector<URL> urls, Function<void(RefPtr<Gfx::Typeface const>)> on_load)
@@ -421,7 +427,7 @@ void StyleComputer::for_each_stylesheet(CascadeOrigin cascade_origin, Callback c
     }
 }
 
-RuleCache const* StyleComputer::rule_cache_for_cascade_origin(CascadeOrigin cascade_origin, Optional<FlyString const> qualified_layer_name, GC::Ptr<DOM::ShadowRoot const> shadow_root) const
+RuleCache const* StyleComputer::rule_cache_for_cascade_origin(CascadeOrigin cascade_origin, Optional<FlyString const&> qualified_layer_name, GC::Ptr<DOM::ShadowRoot const> shadow_root) const
 {
     auto const* rule_caches_for_document_and_shadow_roots = [&]() -> RuleCachesForDocumentAndShadowRoots const* {
         switch (cascade_origin) {
@@ -505,8 +511,16 @@ bool StyleComputer::invalidation_property_used_in_has_selector(InvalidationSet::
     return false;
 }
 
-Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::PseudoElement> pseudo_element, PseudoClassBitmap& attempted_pseudo_class_matches, Optional<FlyString const> qualified_layer_name) const
+Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::PseudoElement> pseudo_element, PseudoClassBitmap& attempted_pseudo_class_matches, Optional<FlyString const&> qualified_layer_name) const
 {
+    return collect_matching_rules_impl(element, cascade_origin, pseudo_element, attempted_pseudo_class_matches, qualified_layer_name, *m_ancestor_filter, nullptr).release_value();
+}
+
+Optional<Vector<MatchingRule const*>> StyleComputer::collect_matching_rules_impl(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::PseudoElement> pseudo_element, PseudoClassBitmap& attempted_pseudo_class_matches, Optional<FlyString const&> qualified_layer_name, AncestorFilter const& ancestor_filter, Vector<SelectorEngine::ElementSelectorInvolvement>* deferred_selector_involvement) const
+{
+    bool const is_off_main_thread = deferred_selector_involvement;
+    bool must_match_on_main_thread = false;
+
     auto const& root_node = element.root();
     auto shadow_root = as_if<DOM::ShadowRoot>(root_node);
     auto element_shadow_root = element.shadow_root();
@@ -539,9 +553,12 @@ Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::Element c
             return;
 
         auto const& selector = rule_to_run.selector;
-        if (selector.can_use_ancestor_filter() && should_reject_with_ancestor_filter(selector))
+        if (selector.can_use_ancestor_filter() && should_reject_with_ancestor_filter(ancestor_filter, selector))
             return;
 
+        if (is_off_main_thread && !selector.can_be_matched_off_main_thread())
+            must_match_on_main_thread = true;
+
         rules_to_run.unchecked_append(rule_to_run);
     };
 
@@ -580,6 +597,9 @@ Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::Element c
             add_rules_from_cache(*rule_cache);
     }
 
+    if (must_match_on_main_thread)
+        return {};
+
     Vector<MatchingRule const*> matching_rules;
     matching_rules.ensure_capacity(rules_to_run.size());
 
@@ -598,6 +618,7 @@ Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::Element c
             .style_sheet_for_rule = *rule_to_run.sheet,
             .subject = element,
             .collect_per_element_selector_involvement_metadata = true,
+            .deferred_selector_involvement = deferred_selector_involvement,
         };
         ScopeGuard guard = [&] {
             attempted_pseudo_class_matches |= context.attempted_pseudo_class_matches;
@@ -2457,6 +2478,136 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_pseudo_element_style_if_neede
     return compute_style_impl(element, move(pseudo_element), ComputeStyleMode::CreatePseudoElementStyleIfNeeded, did_change_custom_properties);
 }
 
+// Whether the element's style may be shared with its siblings, provided that every selector matches them the same way.
+static bool can_share_style(DOM::Element const& element)
+{
+    if (!element.is_html_element() || element.is_custom() || element.use_pseudo_element().has_value())
+        return false;
+
+    // Shadow hosts, slotted elements and elements with inline style have inputs to their style that their siblings
+    // don't share.
+    if (element.shadow_root() || element.inline_style())
+        return false;
+    auto const* parent = element.parent_element();
+    if (!parent || parent->shadow_root())
+        return false;
+
+    // Animations and transitions write their effect into the computed style of their target.
+    return !element.has_associated_animations() && !element.cached_animation_name_animation({});
+}
+
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    auto attribute_count = a.attribute_list_size();
+    if (attribute_count != b.attribute_list_size())
+        return false;
+    if (attribute_count == 0)
+        return true;
+
+    auto const& a_attributes = *a.attributes();
+    auto const& b_attributes = *b.attributes();
+    for (u32 i = 0; i < attribute_count; ++i) {
+        auto const& a_attribute = *a_attributes.item(i);
+        auto const& b_attribute = *b_attributes.item(i);
+        if (a_attribute.local_name() != b_attribute.local_name()
+            || a_attribute.namespace_uri() != b_attribute.namespace_uri()
+            || a_attribute.value() != b_attribute.value())
+            return false;
+    }
+    return true;
+}
+
+static bool is_shadow_including_inclusive_ancestor_of(DOM::Element const& element, DOM::Node const* node)
+{
+    return node && (&element == node || element.is_shadow_including_ancestor_of(*node));
+}
+
+// Whether the pseudo-classes that were tried against the candidate while matching selectors match the element the
+// same way. Anything we can't easily tell is assumed to differ.
+static bool matches_same_pseudo_classes(ComputedProperties const& candidate_style, DOM::Element const& candidate, DOM::Element const& element)
+{
+    auto const& document = element.document();
+
+    for (size_t i = 0; i < to_underlying(PseudoClass::__Count); ++i) {
+        auto pseudo_class = static_cast<PseudoClass>(i);
+        if (!candidate_style.has_attempted_match_against_pseudo_class(pseudo_class))
+            continue;
+
+        switch (pseudo_class) {
+        // These only depend on the tag name, attributes and ancestors, which the elements have in common. The selectors
+        // inside :is(), :not() and :where() are tracked on their own.
+        case PseudoClass::AnyLink:
+        case PseudoClass::Disabled:
+        case PseudoClass::Enabled:
+        case PseudoClass::Heading:
+        case PseudoClass::Is:
+        case PseudoClass::Lang:
+        case PseudoClass::Link:
+        case PseudoClass::LocalLink:
+        case PseudoClass::Not:
+        case PseudoClass::Root:
+        case PseudoClass::Visited:
+        case PseudoClass::Where:
+            continue;
+        case PseudoClass::Active:
+            if (candidate.is_active() != element.is_active())
+                return false;
+            continue;
+        case PseudoClass::Checked:
+        case PseudoClass::Unchecked:
+            if (candidate.matches_checked_pseudo_class() != element.matches_checked_pseudo_class()
+                || candidate.matches_unchecked_pseudo_class() != element.matches_unchecked_pseudo_class())
+                return false;
+            continue;
+        case PseudoClass::Defined:
+            if (candidate.is_defined() != element.is_defined())
+                return false;
+            continue;
+        case PseudoClass::Focus:
+        case PseudoClass::FocusVisible:
+        case PseudoClass::FocusWithin:
+            if (is_shadow_including_inclusive_ancestor_of(candidate, document.focused_area().ptr()) || is_shadow_including_inclusive_ancestor_of(element, document.focused_area().ptr()))
+                return false;
+            continue;
+        case PseudoClass::Hover:
+            if (is_shadow_including_inclusive_ancestor_of(candidate, document.hovered_node()) || is_shadow_including_inclusive_ancestor_of(element, document.hovered_node()))
+                return false;
+            continue;
+        case PseudoClass::PlaceholderShown:
+            if (candidate.matches_placeholder_shown_pseudo_class() != element.matches_placeholder_shown_pseudo_class())
+                return false;
+            continue;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool can_share_style_with_candidate(DOM::Element const& element, DOM::Element const& candidate)
+{
+    if (&candidate == &element || candidate.parent() != element.parent())
+        return false;
+    if (candidate.local_name() != element.local_name() || candidate.namespace_uri() != element.namespace_uri())
+        return false;
+
+    auto candidate_style = candidate.computed_properties();
+    if (!candidate_style || candidate.needs_style_update() || !can_share_style(candidate))
+        return false;
+
+    // The candidate's style must not depend on anything but what the elements have in common.
+    if (candidate.style_uses_attr_css_function()
+        || candidate.style_affected_by_structural_changes()
+        || candidate.affected_by_has_pseudo_class_in_subject_position()
+        || candidate.affected_by_has_pseudo_class_in_non_subject_position())
+        return false;
+    if (auto const& animation_name = candidate_style->property(PropertyID::AnimationName); !animation_name.is_keyword() || animation_name.to_keyword() != Keyword::None)
+        return false;
+
+    return have_same_attributes(candidate, element)
+        && matches_same_pseudo_classes(*candidate_style, candidate, element);
+}
+
 GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& element, Optional<CSS::PseudoElement> pseudo_element, ComputeStyleMode mode, Optional<bool&> did_change_custom_properties) const
 {
     build_rule_cache_if_needed();
@@ -2476,10 +2627,30 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
 
     ScopeGuard guard { [&element]() { element.set_needs_style_update(false); } };
 
+    // OPTIMIZATION: Siblings that every selector matches the same way end up with the same style, so rather than doing
+    //               the cascade for each of them, we share the style of one we've already computed.
+    bool may_share_style = mode == ComputeStyleMode::Normal
+        && !pseudo_element.has_value()
+        && m_style_sharing_cache->enabled
+        && can_share_style(element);
+
+    if (may_share_style) {
+        if (auto style = share_style_of_sibling_if_possible(element, did_change_custom_properties)) {
+            ++m_style_sharing_cache->statistics.hits;
+            return style;
+        }
+        ++m_style_sharing_cache->statistics.misses;
+    }
+
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
     PseudoClassBitmap attempted_pseudo_class_matches;
-    auto matching_rule_set = build_matching_rule_set(element, pseudo_element, attempted_pseudo_class_matches, did_match_any_pseudo_element_rules, mode);
+    Optional<MatchingRuleSet> rules_matched_in_parallel;
+    if (mode == ComputeStyleMode::Normal && !pseudo_element.has_value())
+        rules_matched_in_parallel = take_rules_matched_in_parallel(element, attempted_pseudo_class_matches);
+    auto matching_rule_set = rules_matched_in_parallel.has_value()
+        ? rules_matched_in_parallel.release_value()
+        : build_matching_rule_set(element, pseudo_element, attempted_pseudo_class_matches, did_match_any_pseudo_element_rules, mode);
 
     DOM::AbstractElement abstract_element { element, pseudo_element };
     auto old_custom_properties = abstract_element.custom_properties();
@@ -2534,6 +2705,46 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
         *did_change_custom_properties = true;
     }
 
+    if (may_share_style) {
+        auto& candidates = m_style_sharing_cache->candidates;
+        if (candidates.size() == StyleSharingCache::capacity)
+            candidates.take_last();
+        candidates.prepend(element);
+    }
+
+    return computed_properties;
+}
+
+GC::Ptr<ComputedProperties> StyleComputer::share_style_of_sibling_if_possible(DOM::Element& element, Optional<bool&> did_change_custom_properties) const
+{
+    GC::Ptr<DOM::Element> candidate;
+    for (auto& it : m_style_sharing_cache->candidates) {
+        if (can_share_style_with_candidate(element, *it)) {
+            candidate = it;
+            break;
+        }
+    }
+    if (!candidate)
+        return {};
+
+    DOM::AbstractElement abstract_element { element };
+    auto old_custom_properties = abstract_element.custom_properties();
+
+    element.set_custom_properties({}, candidate->custom_properties({}));
+    element.set_cascaded_properties({}, candidate->cascaded_properties({}));
+    if (candidate->style_uses_var_css_function())
+        element.set_style_uses_var_css_function();
+
+    auto computed_properties = candidate->computed_properties()->clone();
+
+    // NOTE: Transitions are per element, so we run the transition steps of compute_properties() for this element.
+    compute_transitioned_properties(computed_properties, element, {});
+    if (auto previous_style = element.computed_properties())
+        start_needed_transitions(*previous_style, computed_properties, element, {});
+
+    if (did_change_custom_properties.has_value() && abstract_element.custom_properties() != old_custom_properties)
+        *did_change_custom_properties = true;
+
     return computed_properties;
 }
 
@@ -2625,6 +2836,11 @@ GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::Element& elem
     DOM::AbstractElement abstract_element { element, pseudo_element };
     auto computed_style = document().heap().allocate<CSS::ComputedProperties>();
 
+    GC::Ptr<ComputedProperties const> parent_style;
+    if (auto parent_element = element.element_to_inherit_style_from(pseudo_element))
+        parent_style = parent_element->computed_properties();
+    computed_style->share_property_groups_with_parent(parent_style.ptr());
+
     auto new_font_size = recascade_font_size_if_needed(element, pseudo_element, cascaded_properties);
     if (new_font_size)
         computed_style->set_property(PropertyID::FontSize, *new_font_size, ComputedProperties::Inherited::No, Important::No);
@@ -2769,6 +2985,10 @@ GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::Element& elem
         start_needed_transitions(*previous_style, computed_style, element, pseudo_element);
     }
 
+    // 9. Share the groups of properties that have the same values as in the parent style or as the initial values,
+    //    rather than keeping copies.
+    computed_style->share_equal_property_groups(parent_style.ptr());
+
     return computed_style;
 }
 
@@ -3075,6 +3295,9 @@ void StyleComputer::invalidate_rule_cache()
 
     m_pseudo_class_rule_cache = {};
     m_style_invalidation_data = nullptr;
+
+    // NOTE: The rules matched in parallel point into the rule caches.
+    m_rules_matched_in_parallel.clear();
 }
 
 void StyleComputer::did_load_font(FlyString const&)
@@ -3357,6 +3580,14 @@ void StyleComputer::reset_ancestor_filter()
     m_ancestor_filter->clear();
 }
 
+void StyleComputer::set_style_sharing_enabled(Badge<DOM::Document>, bool enabled)
+{
+    m_style_sharing_cache->enabled = enabled;
+    m_style_sharing_cache->candidates.clear();
+    if (enabled)
+        m_style_sharing_cache->statistics = {};
+}
+
 void StyleComputer::push_ancestor(DOM::Element const& element)
 {
     for_each_element_hash(element, [&](u32 hash) {
@@ -3371,6 +3602,207 @@ void StyleComputer::pop_ancestor(DOM::Element const& element)
     });
 }
 
+static bool s_parallel_rule_matching_enabled = true;
+
+// Handing rule matching to other threads only pays off when there's plenty of it to do.
+static constexpr size_t minimum_element_count_for_parallel_rule_matching = 256;
+static constexpr size_t maximum_rule_matching_thread_count = 4;
+
+void StyleComputer::set_parallel_rule_matching_enabled(bool enabled)
+{
+    s_parallel_rule_matching_enabled = enabled;
+}
+
+static Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>>& rule_matching_worker_threads()
+{
+    static Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> worker_threads;
+    static bool did_create_worker_threads = false;
+
+    if (!did_create_worker_threads) {
+        did_create_worker_threads = true;
+
+        // NOTE: The main thread matches rules as well.
+        auto thread_count = min<size_t>(max(Core::System::hardware_concurrency(), 1u), maximum_rule_matching_thread_count);
+        for (size_t i = 1; i < thread_count; ++i) {
+            auto worker_thread = Threading::WorkerThread<Error>::create("StyleWorker"sv);
+            if (worker_thread.is_error()) {
+                dbgln("StyleComputer: Unable to create rule matching thread: {}", worker_thread.error());
+                break;
+            }
+            worker_threads.append(worker_thread.release_value());
+        }
+    }
+
+    return worker_threads;
+}
+
+void StyleComputer::match_rules_in_parallel(Badge<DOM::Document>, ReadonlySpan<GC::Ref<DOM::Element>> elements)
+{
+    m_rules_matched_in_parallel.clear();
+
+    if (!s_parallel_rule_matching_enabled || elements.size() < minimum_element_count_for_parallel_rule_matching)
+        return;
+
+    auto& worker_threads = rule_matching_worker_threads();
+    if (worker_threads.is_empty())
+        return;
+
+    build_rule_cache_if_needed();
+
+    // NOTE: FlyString computes its hash the first time it's asked for it, which isn't thread-safe. So we make sure the
+    //       hashes that the worker threads will look up have been computed already.
+    HashTable<DOM::Element const*> elements_with_computed_hashes;
+    for (auto const& element : elements) {
+        for (DOM::Element const* it = element.ptr(); it; it = it->parent_or_shadow_host_element()) {
+            if (elements_with_computed_hashes.set(it) != HashSetResult::InsertedNewEntry)
+                break;
+            (void)it->lowercased_local_name().hash();
+            for_each_element_hash(*it, [](u32) { });
+        }
+    }
+
+    Vector<Optional<RulesMatchedInParallel>> results;
+    results.resize(elements.size());
+
+    // Each thread gets a contiguous run of elements in tree order, so that consecutive elements mostly share their
+    // ancestors.
+    auto chunk_size = ceil_div(elements.size(), worker_threads.size() + 1);
+    auto match_rules_for_chunk = [&](size_t chunk_index) {
+        auto start = min(chunk_index * chunk_size, elements.size());
+        auto length = min(chunk_size, elements.size() - start);
+        return [this, chunk_elements = elements.slice(start, length), chunk_results = results.span().slice(start, length)] {
+            match_rules_off_main_thread(chunk_elements, chunk_results);
+        };
+    };
+
+    Vector<Threading::WorkerThread<Error>*> busy_worker_threads;
+    for (size_t i = 0; i < worker_threads.size(); ++i) {
+        auto match_rules = match_rules_for_chunk(i + 1);
+        auto did_start_task = worker_threads[i]->start_task([match_rules = move(match_rules)]() -> ErrorOr<void> {
+            match_rules();
+            return {};
+        });
+        if (did_start_task)
+            busy_worker_threads.append(worker_threads[i].ptr());
+        else
+            match_rules();
+    }
+
+    match_rules_for_chunk(0)();
+
+    for (auto* worker_thread : busy_worker_threads)
+        MUST(worker_thread->wait_until_task_is_finished());
+
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (results[i].has_value())
+            m_rules_matched_in_parallel.set(*elements[i], results[i].release_value());
+    }
+
+    dbgln_if(LIBWEB_CSS_DEBUG, "StyleComputer: Matched rules for {} of {} elements on {} threads", m_rules_matched_in_parallel.size(), elements.size(), worker_threads.size() + 1);
+}
+
+void StyleComputer::discard_rules_matched_in_parallel(Badge<DOM::Document>)
+{
+    m_rules_matched_in_parallel.clear();
+}
+
+void StyleComputer::match_rules_off_main_thread(ReadonlySpan<GC::Ref<DOM::Element>> elements, Span<Optional<RulesMatchedInParallel>> results) const
+{
+    // Each thread has an ancestor filter of its own, which we keep in the state that the main thread's filter would be
+    // in while updating the style of the element at hand.
+    auto ancestor_filter = make<AncestorFilter>();
+    ancestor_filter->clear();
+    Vector<DOM::Element const*> ancestors_in_filter;
+    Vector<DOM::Element const*> ancestors;
+
+    for (size_t i = 0; i < elements.size(); ++i) {
+        auto const& element = *elements[i];
+
+        ancestors.clear_with_capacity();
+        for (auto const* ancestor = element.parent_or_shadow_host_element(); ancestor; ancestor = ancestor->parent_or_shadow_host_element())
+            ancestors.append(ancestor);
+        ancestors.reverse();
+
+        size_t common_ancestor_count = 0;
+        while (common_ancestor_count < min(ancestors.size(), ancestors_in_filter.size()) && ancestors[common_ancestor_count] == ancestors_in_filter[common_ancestor_count])
+            ++common_ancestor_count;
+
+        while (ancestors_in_filter.size() > common_ancestor_count) {
+            for_each_element_hash(*ancestors_in_filter.take_last(), [&](u32 hash) {
+                ancestor_filter->decrement(hash);
+            });
+        }
+        for (size_t j = common_ancestor_count; j < ancestors.size(); ++j) {
+            for_each_element_hash(*ancestors[j], [&](u32 hash) {
+                ancestor_filter->increment(hash);
+            });
+            ancestors_in_filter.append(ancestors[j]);
+        }
+
+        results[i] = match_rules_off_main_thread(element, *ancestor_filter);
+    }
+}
+
+Optional<StyleComputer::RulesMatchedInParallel> StyleComputer::match_rules_off_main_thread(DOM::Element const& element, AncestorFilter const& ancestor_filter) const
+{
+    RulesMatchedInParallel rules;
+
+    auto collect_matching_rules_into = [&](Vector<MatchingRule const*>& matching_rules, CascadeOrigin cascade_origin, Optional<FlyString const&> qualified_layer_name) {
+        auto collected_rules = collect_matching_rules_impl(element, cascade_origin, {}, rules.attempted_pseudo_class_matches, qualified_layer_name, ancestor_filter, &rules.selector_involvement);
+        if (!collected_rules.has_value())
+            return false;
+        matching_rules = collected_rules.release_value();
+        return true;
+    };
+
+    if (!collect_matching_rules_into(rules.user_agent_rules, CascadeOrigin::UserAgent, {}))
+        return {};
+    if (!collect_matching_rules_into(rules.user_rules, CascadeOrigin::User, {}))
+        return {};
+
+    rules.author_rules.resize(m_qualified_layer_names_in_order.size() + 1);
+    for (size_t i = 0; i < m_qualified_layer_names_in_order.size(); ++i) {
+        if (!collect_matching_rules_into(rules.author_rules[i], CascadeOrigin::Author, m_qualified_layer_names_in_order[i]))
+            return {};
+    }
+    if (!collect_matching_rules_into(rules.author_rules.last(), CascadeOrigin::Author, {}))
+        return {};
+
+    return rules;
+}
+
+Optional<StyleComputer::MatchingRuleSet> StyleComputer::take_rules_matched_in_parallel(DOM::Element const& element, PseudoClassBitmap& attempted_pseudo_class_matches) const
+{
+    auto rules = m_rules_matched_in_parallel.take(element);
+    if (!rules.has_value())
+        return {};
+
+    // NOTE: The element's selector involvement metadata was reset right before computing its style, so this is the
+    //       earliest we can apply what was collected while matching.
+    for (auto const& element_involvement : rules->selector_involvement)
+        SelectorEngine::apply_selector_involvement(element_involvement);
+    attempted_pseudo_class_matches |= rules->attempted_pseudo_class_matches;
+
+    VERIFY(rules->author_rules.size() == m_qualified_layer_names_in_order.size() + 1);
+
+    MatchingRuleSet matching_rule_set;
+    matching_rule_set.user_agent_rules = move(rules->user_agent_rules);
+    sort_matching_rules(matching_rule_set.user_agent_rules);
+    matching_rule_set.user_rules = move(rules->user_rules);
+    sort_matching_rules(matching_rule_set.user_rules);
+
+    for (size_t i = 0; i < rules->author_rules.size(); ++i) {
+        auto& layer_rules = rules->author_rules[i];
+        sort_matching_rules(layer_rules);
+        if (i < m_qualified_layer_names_in_order.size())
+            matching_rule_set.author_rules.append({ m_qualified_layer_names_in_order[i], move(layer_rules) });
+        else
+            matching_rule_set.author_rules.append({ {}, move(layer_rules) });
+    }
+
+    return matching_rule_set;
+}
+
 size_t StyleComputer::number_of_css_font_faces_with_loading_in_progress() const
 {
     size_t count = 0;
@@ -3471,7 +3903,7 @@ void RuleCache::for_each_matching_rules(DOM::Element const& element, Optional<Ps
                 return;
         }
     }
-    if (auto id = element.id(); id.has_value()) {
+    if (auto const& id = element.id(); id.has_value()) {
         if (auto it = rules_by_id.find(id.value()); it != rules_by_id.end()) {
             if (callback(it->value) == IterationDecision::Break)
                 return;
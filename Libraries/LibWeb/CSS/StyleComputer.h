@@ -19,6 +19,7 @@
 #include <LibWeb/CSS/CascadeOrigin.h>
 #include <LibWeb/CSS/CascadedProperties.h>
 #include <LibWeb/CSS/Selector.h>
+#include <LibWeb/CSS/SelectorEngine.h>
 #include <LibWeb/CSS/StyleInvalidationData.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Forward.h>
@@ -138,6 +139,8 @@ public:
 
     static Optional<String> user_agent_style_sheet_source(StringView name);
 
+    using AncestorFilter = CountingBloomFilter<u8, 14>;
+
     explicit StyleComputer(DOM::Document&);
     ~StyleComputer();
 
@@ -155,7 +158,7 @@ public:
 
     [[nodiscard]] RuleCache const& get_pseudo_class_rule_cache(PseudoClass) const;
 
-    [[nodiscard]] Vector<MatchingRule const*> collect_matching_rules(DOM::Element const&, CascadeOrigin, Optional<CSS::PseudoElement>, PseudoClassBitmap& attempted_pseudo_class_matches, Optional<FlyString const> qualified_layer_name = {}) const;
+    [[nodiscard]] Vector<MatchingRule const*> collect_matching_rules(DOM::Element const&, CascadeOrigin, Optional<CSS::PseudoElement>, PseudoClassBitmap& attempted_pseudo_class_matches, Optional<FlyString const&> qualified_layer_name = {}) const;
 
     InvalidationSet invalidation_set_for_properties(Vector<InvalidationSet::Property> const&) const;
     bool invalidation_property_used_in_has_selector(InvalidationSet::Property const&) const;
@@ -180,6 +183,25 @@ public:
 
     void set_viewport_rect(Badge<DOM::Document>, CSSPixelRect const& viewport_rect) { m_viewport_rect = viewport_rect; }
 
+    struct StyleSharingStatistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+    };
+
+    // NOTE: Style sharing is only enabled while the document updates the style of its elements, as that's when the
+    //       style of previously visited siblings is known to be up to date. Enabling it resets the statistics.
+    void set_style_sharing_enabled(Badge<DOM::Document>, bool);
+    [[nodiscard]] StyleSharingStatistics const& style_sharing_statistics() const { return m_style_sharing_cache->statistics; }
+
+    // Matches rules for the given elements on a pool of worker threads, before the document computes their style.
+    // compute_style() then uses the rules matched for an element instead of matching them itself. Elements for which
+    // some rule can only be matched on the main thread are left to compute_style().
+    void match_rules_in_parallel(Badge<DOM::Document>, ReadonlySpan<GC::Ref<DOM::Element>>);
+    void discard_rules_matched_in_parallel(Badge<DOM::Document>);
+
+    // NOTE: This is meant for debugging, as a way to rule out the worker threads.
+    static void set_parallel_rule_matching_enabled(bool);
+
     void collect_animation_into(DOM::Element&, Optional<CSS::PseudoElement>, GC::Ref<Animations::KeyframeEffect> animation, ComputedProperties&) const;
 
     [[nodiscard]] bool may_have_has_selectors() const;
@@ -193,6 +215,7 @@ public:
     void compute_font(ComputedProperties&, DOM::Element const*, Optional<CSS::PseudoElement>) const;
 
     [[nodiscard]] inline bool should_reject_with_ancestor_filter(Selector const&) const;
+    [[nodiscard]] static inline bool should_reject_with_ancestor_filter(AncestorFilter const&, Selector const&);
 
     static NonnullRefPtr<StyleValue const> compute_value_of_custom_property(DOM::AbstractElement, FlyString const& custom_property, Optional<Parser::GuardedSubstitutionContexts&> = {});
 
@@ -226,8 +249,26 @@ private:
 
     [[nodiscard]] MatchingRuleSet build_matching_rule_set(DOM::Element const&, Optional<PseudoElement>, PseudoClassBitmap& attempted_pseudo_class_matches, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
 
+    // The rules matched for an element by a worker thread, before sorting.
+    struct RulesMatchedInParallel {
+        Vector<MatchingRule const*> user_agent_rules;
+        Vector<MatchingRule const*> user_rules;
+        // One entry for each of m_qualified_layer_names_in_order, followed by the un-@layer-ed author rules.
+        Vector<Vector<MatchingRule const*>> author_rules;
+        PseudoClassBitmap attempted_pseudo_class_matches;
+        Vector<SelectorEngine::ElementSelectorInvolvement> selector_involvement;
+    };
+
+    // Returns an empty Optional if a rule has to be matched on the main thread. Matching off the main thread requires
+    // a place to defer the selector involvement metadata to.
+    [[nodiscard]] Optional<Vector<MatchingRule const*>> collect_matching_rules_impl(DOM::Element const&, CascadeOrigin, Optional<CSS::PseudoElement>, PseudoClassBitmap& attempted_pseudo_class_matches, Optional<FlyString const&> qualified_layer_name, AncestorFilter const&, Vector<SelectorEngine::ElementSelectorInvolvement>* deferred_selector_involvement) const;
+    [[nodiscard]] Optional<RulesMatchedInParallel> match_rules_off_main_thread(DOM::Element const&, AncestorFilter const&) const;
+    void match_rules_off_main_thread(ReadonlySpan<GC::Ref<DOM::Element>>, Span<Optional<RulesMatchedInParallel>>) const;
+    [[nodiscard]] Optional<MatchingRuleSet> take_rules_matched_in_parallel(DOM::Element const&, PseudoClassBitmap& attempted_pseudo_class_matches) const;
+
     LogicalAliasMappingContext compute_logical_alias_mapping_context(DOM::Element&, Optional<CSS::PseudoElement>, ComputeStyleMode, MatchingRuleSet const&) const;
     [[nodiscard]] GC::Ptr<ComputedProperties> compute_style_impl(DOM::Element&, Optional<CSS::PseudoElement>, ComputeStyleMode, Optional<bool&> did_change_custom_properties) const;
+    [[nodiscard]] GC::Ptr<ComputedProperties> share_style_of_sibling_if_possible(DOM::Element&, Optional<bool&> did_change_custom_properties) const;
     [[nodiscard]] GC::Ref<CascadedProperties> compute_cascaded_values(DOM::Element&, Optional<CSS::PseudoElement>, bool did_match_any_pseudo_element_rules, ComputeStyleMode, MatchingRuleSet const&, Optional<LogicalAliasMappingContext>, ReadonlySpan<PropertyID> properties_to_cascade) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_descending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
@@ -280,7 +321,7 @@ private:
 
     void make_rule_cache_for_cascade_origin(CascadeOrigin, SelectorInsights&);
 
-    [[nodiscard]] RuleCache const* rule_cache_for_cascade_origin(CascadeOrigin, Optional<FlyString const> qualified_layer_name, GC::Ptr<DOM::ShadowRoot const>) const;
+    [[nodiscard]] RuleCache const* rule_cache_for_cascade_origin(CascadeOrigin, Optional<FlyString const&> qualified_layer_name, GC::Ptr<DOM::ShadowRoot const>) const;
 
     static void collect_selector_insights(Selector const&, SelectorInsights&);
 
@@ -302,7 +343,20 @@ private:
 
     CSSPixelRect m_viewport_rect;
 
-    OwnPtr<CountingBloomFilter<u8, 14>> m_ancestor_filter;
+    OwnPtr<AncestorFilter> m_ancestor_filter;
+
+    // Elements whose style was computed most recently, most recent first. Their siblings may share their style if
+    // every selector would match them the same way.
+    struct StyleSharingCache {
+        static constexpr size_t capacity = 16;
+
+        bool enabled { false };
+        Vector<GC::Ref<DOM::Element>, capacity> candidates;
+        StyleSharingStatistics statistics;
+    };
+    OwnPtr<StyleSharingCache> m_style_sharing_cache;
+
+    mutable HashMap<GC::Ref<DOM::Element const>, RulesMatchedInParallel> m_rules_matched_in_parallel;
 };
 
 class FontLoader final : public GC::Cell {
@@ -340,11 +394,16 @@ private:
 };
 
 inline bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+{
+    return should_reject_with_ancestor_filter(*m_ancestor_filter, selector);
+}
+
+inline bool StyleComputer::should_reject_with_ancestor_filter(AncestorFilter const& ancestor_filter, Selector const& selector)
 {
     for (u32 hash : selector.ancestor_hashes()) {
         if (hash == 0)
             break;
-        if (!m_ancestor_filter->may_contain(hash))
+        if (!ancestor_filter.may_contain(hash))
             return true;
     }
     return false;
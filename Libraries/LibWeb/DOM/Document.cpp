@@ -123,6 +123,7 @@
 #include <LibWeb/HTML/HashChangeEvent.h>
 #include <LibWeb/HTML/ListOfAvailableImages.h>
 #include <LibWeb/HTML/Location.h>
+#include <LibWeb/HTML/MapOfPreloadedResources.h>
 #include <LibWeb/HTML/MessageEvent.h>
 #include <LibWeb/HTML/MessagePort.h>
 #include <LibWeb/HTML/Navigable.h>
@@ -493,8 +494,11 @@ Document::Document(JS::Realm& realm, const URL::URL& url, TemporaryDocumentForFr
     HTML::main_thread_event_loop().register_document({}, *this);
 }
 
-Document::~Document()
+Document::~Document() = default;
+
+void Document::finalize()
 {
+    Base::finalize();
     HTML::main_thread_event_loop().unregister_document({}, *this);
 }
 
@@ -507,6 +511,7 @@ void Document::initialize(JS::Realm& realm)
     m_selection = realm.create<Selection::Selection>(realm, *this);
 
     m_list_of_available_images = realm.create<HTML::ListOfAvailableImages>();
+    m_map_of_preloaded_resources = realm.create<HTML::MapOfPreloadedResources>();
 
     page().client().page_did_create_new_document(*this);
 }
@@ -591,6 +596,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
 
     visitor.visit(m_associated_animation_timelines);
     visitor.visit(m_list_of_available_images);
+    visitor.visit(m_map_of_preloaded_resources);
 
     for (auto* form_associated_element : m_form_associated_elements_with_form_attribute)
         visitor.visit(form_associated_element->form_associated_element_to_html_element());
@@ -1364,6 +1370,7 @@ void Document::update_layout(UpdateLayoutReason reason)
     m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
         if (child.needs_layout_update()) {
             child.reset_cached_intrinsic_sizes();
+            child.clear_retained_layout();
         }
         child.clear_contained_abspos_children();
         return TraversalDecision::Continue;
@@ -1390,6 +1397,7 @@ void Document::update_layout(UpdateLayoutReason reason)
     });
 
     Layout::LayoutState layout_state;
+    layout_state.retains_results_for_relayout_boundaries = true;
 
     {
         Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
@@ -1410,6 +1418,16 @@ void Document::update_layout(UpdateLayoutReason reason)
                 Layout::AvailableSize::make_definite(viewport_rect.height())));
     }
 
+    layout_state.retain_results_for_relayout_boundaries();
+
+    m_last_layout_statistics = {};
+    for (auto const& it : layout_state.used_values_per_layout_node) {
+        if (it.key->is_box())
+            ++m_last_layout_statistics.boxes_laid_out;
+    }
+    m_last_layout_statistics.boxes_reused = layout_state.reused_box_count();
+    m_last_layout_statistics.boxes_laid_out -= m_last_layout_statistics.boxes_reused;
+
     layout_state.commit(*m_layout_root);
 
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
@@ -1451,7 +1469,7 @@ void Document::update_layout(UpdateLayoutReason reason)
         window->scroll_by(0, 0);
 
     if constexpr (UPDATE_LAYOUT_DEBUG) {
-        dbgln("LAYOUT {} {} µs", to_string(reason), timer.elapsed_time().to_microseconds());
+        dbgln("LAYOUT {} {} µs ({} boxes laid out, {} reused)", to_string(reason), timer.elapsed_time().to_microseconds(), m_last_layout_statistics.boxes_laid_out, m_last_layout_statistics.boxes_reused);
     }
 }
 
@@ -1528,6 +1546,33 @@ void Document::update_layout(UpdateLayoutReason reason)
     return invalidation;
 }
 
+// Collects the elements that update_style_recursively() will compute the style of from scratch, in the same order.
+static void collect_elements_needing_style_update(Node& node, Vector<GC::Ref<Element>>& elements)
+{
+    bool const needs_full_style_update = node.document().needs_full_style_update();
+
+    if (auto* element = as_if<Element>(node); element && !element->use_pseudo_element().has_value()) {
+        if (needs_full_style_update || element->needs_style_update())
+            elements.append(*element);
+    }
+
+    if (!needs_full_style_update && !node.child_needs_style_update())
+        return;
+
+    if (auto* element = as_if<Element>(node)) {
+        if (auto shadow_root = element->shadow_root()) {
+            if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update())
+                collect_elements_needing_style_update(*shadow_root, elements);
+        }
+    }
+
+    node.for_each_child([&](auto& child) {
+        if (needs_full_style_update || child.needs_style_update() || child.child_needs_style_update())
+            collect_elements_needing_style_update(child, elements);
+        return IterationDecision::Continue;
+    });
+}
+
 void Document::update_style()
 {
     if (!browsing_context())
@@ -1556,8 +1601,17 @@ void Document::update_style()
     evaluate_media_rules();
 
     style_computer().reset_ancestor_filter();
+    style_computer().set_style_sharing_enabled({}, true);
+
+    // OPTIMIZATION: Matching rules is the bulk of the work when many elements need their style recomputed, and unlike
+    //               the rest of it, it can be done on other threads.
+    Vector<GC::Ref<Element>> elements_needing_style_update;
+    collect_elements_needing_style_update(*this, elements_needing_style_update);
+    style_computer().match_rules_in_parallel({}, elements_needing_style_update);
 
     auto invalidation = update_style_recursively(*this, style_computer(), false, false);
+    style_computer().discard_rules_matched_in_parallel({});
+    style_computer().set_style_sharing_enabled({}, false);
     if (!invalidation.is_none())
         invalidate_display_list();
     if (invalidation.rebuild_stacking_context_tree)
@@ -1565,6 +1619,41 @@ void Document::update_style()
     m_needs_full_style_update = false;
 }
 
+Document::StyleMemoryStatistics Document::style_memory_statistics()
+{
+    StyleMemoryStatistics statistics;
+    HashTable<CSS::ComputedProperties::PropertyGroup const*> property_groups;
+    size_t property_group_references = 0;
+
+    auto add_style = [&](CSS::ComputedProperties const& style) {
+        ++statistics.computed_style_count;
+        style.for_each_property_group([&](auto const& group) {
+            property_groups.set(&group);
+            ++property_group_references;
+        });
+    };
+
+    for_each_shadow_including_inclusive_descendant([&](Node& node) {
+        auto* element = as_if<Element>(node);
+        if (!element)
+            return TraversalDecision::Continue;
+
+        if (auto style = element->computed_properties())
+            add_style(*style);
+        for (auto i = 0; i < to_underlying(CSS::PseudoElement::KnownPseudoElementCount); ++i) {
+            if (auto style = element->computed_properties(static_cast<CSS::PseudoElement>(i)))
+                add_style(*style);
+        }
+        return TraversalDecision::Continue;
+    });
+
+    // NOTE: Without sharing, every style would have a copy of each of its property groups.
+    statistics.property_group_count = property_groups.size();
+    statistics.bytes = statistics.computed_style_count * sizeof(CSS::ComputedProperties) + property_groups.size() * sizeof(CSS::ComputedProperties::PropertyGroup);
+    statistics.bytes_without_sharing = statistics.computed_style_count * sizeof(CSS::ComputedProperties) + property_group_references * sizeof(CSS::ComputedProperties::PropertyGroup);
+    return statistics;
+}
+
 void Document::update_animated_style_if_needed()
 {
     if (!m_needs_animated_style_update)
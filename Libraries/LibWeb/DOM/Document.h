@@ -341,6 +341,21 @@ public:
     void update_style();
     void update_layout(UpdateLayoutReason);
     void update_paint_and_hit_testing_properties_if_needed();
+
+    struct LayoutStatistics {
+        size_t boxes_laid_out { 0 };
+        size_t boxes_reused { 0 };
+    };
+    LayoutStatistics const& last_layout_statistics() const { return m_last_layout_statistics; }
+
+    struct StyleMemoryStatistics {
+        size_t computed_style_count { 0 };
+        size_t property_group_count { 0 };
+        size_t bytes { 0 };
+        size_t bytes_without_sharing { 0 };
+    };
+    StyleMemoryStatistics style_memory_statistics();
+
     void update_animated_style_if_needed();
 
     void invalidate_layout_tree(InvalidateLayoutTreeReason);
@@ -696,6 +711,17 @@ public:
     HTML::ListOfAvailableImages& list_of_available_images();
     HTML::ListOfAvailableImages const& list_of_available_images() const;
 
+    HTML::MapOfPreloadedResources& map_of_preloaded_resources() { return *m_map_of_preloaded_resources; }
+
+    // https://html.spec.whatwg.org/multipage/parsing.html#list-of-speculative-fetch-urls
+    HashTable<URL::URL>& list_of_speculative_fetch_urls() { return m_list_of_speculative_fetch_urls; }
+
+    struct SpeculativeFetchStatistics {
+        size_t fetches_started { 0 };
+        size_t fetches_used { 0 };
+    };
+    SpeculativeFetchStatistics& speculative_fetch_statistics() { return m_speculative_fetch_statistics; }
+
     void register_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver&);
     void unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver&);
 
@@ -922,6 +948,7 @@ public:
 protected:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
     Document(JS::Realm&, URL::URL const&, TemporaryDocumentForFragmentParsing = TemporaryDocumentForFragmentParsing::No);
 
@@ -1087,6 +1114,8 @@ private:
     bool m_needs_full_style_update { false };
     bool m_needs_full_layout_tree_update { false };
 
+    LayoutStatistics m_last_layout_statistics;
+
     bool m_needs_animated_style_update { false };
 
     HashTable<GC::Ptr<NodeIterator>> m_node_iterators;
@@ -1154,6 +1183,12 @@ private:
     // https://html.spec.whatwg.org/multipage/images.html#list-of-available-images
     GC::Ptr<HTML::ListOfAvailableImages> m_list_of_available_images;
 
+    // https://html.spec.whatwg.org/multipage/links.html#map-of-preloaded-resources
+    GC::Ptr<HTML::MapOfPreloadedResources> m_map_of_preloaded_resources;
+
+    HashTable<URL::URL> m_list_of_speculative_fetch_urls;
+    SpeculativeFetchStatistics m_speculative_fetch_statistics;
+
     GC::Ptr<CSS::VisualViewport> m_visual_viewport;
 
     // NOTE: Not in the spec per se, but Document must be able to access all IntersectionObservers whose root is in the document.
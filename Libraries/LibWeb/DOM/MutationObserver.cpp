@@ -39,6 +39,7 @@ MutationObserver::~MutationObserver()
 
 void MutationObserver::finalize()
 {
+    Base::finalize();
     HTML::relevant_similar_origin_window_agent(*this).mutation_observers.remove(*this);
 }
 
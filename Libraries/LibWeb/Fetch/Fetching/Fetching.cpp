@@ -13,7 +13,9 @@
 #include <AK/Debug.h>
 #include <AK/ScopeGuard.h>
 #include <LibJS/Runtime/Completion.h>
+#include <LibRequests/CachePartition.h>
 #include <LibRequests/RequestTimingInfo.h>
+#include <LibURL/Site.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Bindings/PrincipalHostDefined.h>
 #include <LibWeb/ContentSecurityPolicy/BlockingAlgorithms.h>
@@ -45,6 +47,7 @@
 #include <LibWeb/FileAPI/Blob.h>
 #include <LibWeb/FileAPI/BlobURLStore.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/MapOfPreloadedResources.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
@@ -154,11 +157,10 @@ WebIDL::ExceptionOr<GC::Ref<Infrastructure::FetchController>> fetch(JS::Realm& r
             fetch_params->set_preloaded_response_candidate(response);
         });
 
-        // FIXME: 3. Let foundPreloadedResource be the result of invoking consume a preloaded resource for request’s
+        // 3. Let foundPreloadedResource be the result of invoking consume a preloaded resource for request’s
         //    window, given request’s URL, request’s destination, request’s mode, request’s credentials mode,
         //    request’s integrity metadata, and onPreloadedResponseAvailable.
-        auto found_preloaded_resource = false;
-        (void)on_preloaded_response_available;
+        auto found_preloaded_resource = HTML::consume_a_preloaded_resource(as<HTML::Window>(request.client()->global_object()), request.url(), request.destination(), request.mode(), request.credentials_mode(), request.integrity_metadata(), on_preloaded_response_available);
 
         // 4. If foundPreloadedResource is true and fetchParams’s preloaded response candidate is null, then set
         //    fetchParams’s preloaded response candidate to "pending".
@@ -2291,6 +2293,33 @@ static void log_response(auto const& status_code, auto const& headers, auto cons
 }
 #endif
 
+// AD-HOC: RequestServer keeps a disk cache that is shared by every WebContent process. Responses stored in it are only
+//         used for requests from the same top-level site and frame site, so that one site can't learn which resources
+//         another site has loaded.
+static Optional<Requests::CachePartition> determine_the_disk_cache_partition(Infrastructure::Request const& request)
+{
+    if (request.cache_mode() == Infrastructure::Request::CacheMode::NoStore)
+        return {};
+
+    GC::Ptr<HTML::Environment const> environment = request.reserved_client();
+    if (!environment)
+        environment = request.client();
+    if (!environment)
+        return {};
+
+    auto partition_key = Infrastructure::determine_the_network_partition_key(*environment);
+    auto frame_origin = environment->creation_url.origin();
+
+    // Opaque origins aren't same-site with anything, so no other request could use the response.
+    if (partition_key.top_level_origin.is_opaque() || frame_origin.is_opaque())
+        return {};
+
+    return Requests::CachePartition {
+        .top_level_site = URL::Site::obtain(partition_key.top_level_origin).serialize().to_byte_string(),
+        .frame_site = URL::Site::obtain(frame_origin).serialize().to_byte_string(),
+    };
+}
+
 // https://fetch.spec.whatwg.org/#concept-http-network-fetch
 // Drop-in replacement for 'HTTP-network fetch', but obviously non-standard :^)
 // It also handles file:// URLs since those can also go through ResourceLoader.
@@ -2316,6 +2345,7 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
     load_request.set_url(request->current_url());
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
+    load_request.set_cache_partition(determine_the_disk_cache_partition(*request));
 
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
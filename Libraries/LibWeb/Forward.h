@@ -675,6 +675,7 @@ class ImageData;
 class ImageRequest;
 class ListOfAvailableImages;
 class Location;
+class MapOfPreloadedResources;
 class MediaError;
 class MessageChannel;
 class MessageEvent;
@@ -699,6 +700,7 @@ class Path2D;
 class Plugin;
 class PluginArray;
 class PopoverInvokerElement;
+class PreloadEntry;
 class PromiseRejectionEvent;
 class RadioNodeList;
 class SelectedFile;
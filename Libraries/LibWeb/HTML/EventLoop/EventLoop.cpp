@@ -32,6 +32,9 @@ namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(EventLoop);
 
+// How long to wait between rounds of garbage collection work while the event loop is otherwise idle.
+static constexpr int idle_garbage_collection_work_delay_ms = 10;
+
 EventLoop::EventLoop(Type type)
     : m_type(type)
 {
@@ -54,6 +57,7 @@ void EventLoop::visit_edges(Visitor& visitor)
     visitor.visit(m_backup_incumbent_realm_stack);
     visitor.visit(m_rendering_task_function);
     visitor.visit(m_system_event_loop_timer);
+    visitor.visit(m_idle_garbage_collection_timer);
 }
 
 void EventLoop::schedule()
@@ -68,6 +72,33 @@ void EventLoop::schedule()
         m_system_event_loop_timer->restart();
 }
 
+void EventLoop::schedule_idle_garbage_collection_work()
+{
+    if (!m_idle_garbage_collection_timer) {
+        m_idle_garbage_collection_timer = Platform::Timer::create_single_shot(heap(), idle_garbage_collection_work_delay_ms, GC::create_function(heap(), [this] {
+            perform_idle_garbage_collection_work();
+        }));
+    }
+
+    if (!m_idle_garbage_collection_timer->is_active())
+        m_idle_garbage_collection_timer->restart();
+}
+
+void EventLoop::perform_idle_garbage_collection_work()
+{
+    // Tasks come first. process() schedules us again once the event loop is idle.
+    if (m_task_queue->has_runnable_tasks())
+        return;
+
+    // Make progress on incremental marking so that the final GC pause is short, and sweep the blocks the last
+    // collection left for lazy sweeping.
+    heap().perform_incremental_marking_step();
+    heap().perform_lazy_sweeping_step();
+
+    if (heap().is_incremental_marking_in_progress() || heap().has_unswept_blocks())
+        schedule_idle_garbage_collection_work();
+}
+
 EventLoop& main_thread_event_loop()
 {
     return *static_cast<HTML::Agent*>(Bindings::main_thread_vm().agent())->event_loop;
@@ -221,6 +252,10 @@ void EventLoop::process()
     // If there are eligible tasks in the queue, schedule a new round of processing. :^)
     if (m_task_queue->has_runnable_tasks() || (!m_microtask_queue->is_empty() && !m_performing_a_microtask_checkpoint)) {
         schedule();
+    } else if (m_type == Type::Window && (heap().is_incremental_marking_in_progress() || heap().has_unswept_blocks())) {
+        // OPTIMIZATION: Use idle time for garbage collection work. This runs on a timer of its own with a delay, so that we
+        //               don't spin on the event loop while there's nothing else to do.
+        schedule_idle_garbage_collection_work();
     }
 }
 
@@ -631,7 +666,9 @@ void EventLoop::register_document(Badge<DOM::Document>, DOM::Document& document)
 
 void EventLoop::unregister_document(Badge<DOM::Document>, DOM::Document& document)
 {
-    bool did_remove = m_documents.remove_first_matching([&](auto& entry) { return entry.ptr() == &document; });
+    // NOTE: Documents unregister themselves when they are finalized, after Object::finalize() has already revoked the
+    //       WeakPtr we hold to them.
+    bool did_remove = m_documents.remove_first_matching([&](auto& entry) { return !entry || entry.ptr() == &document; });
     VERIFY(did_remove);
 }
 
@@ -183,6 +183,8 @@ void EventSource::initialize(JS::Realm& realm)
 // https://html.spec.whatwg.org/multipage/server-sent-events.html#garbage-collection
 void EventSource::finalize()
 {
+    Base::finalize();
+
     // If an EventSource object is garbage collected while its connection is still open, the user agent must abort any
     // instance of the fetch algorithm opened by this EventSource.
     if (m_ready_state != ReadyState::Closed) {
@@ -48,6 +48,14 @@ HTMLLinkElement::HTMLLinkElement(DOM::Document& document, DOM::QualifiedName qua
 
 HTMLLinkElement::~HTMLLinkElement() = default;
 
+void HTMLLinkElement::finalize()
+{
+    Base::finalize();
+    // ^ResourceClient
+    set_resource(nullptr);
+    Weakable<ResourceClient>::revoke_weak_ptrs();
+}
+
 void HTMLLinkElement::initialize(JS::Realm& realm)
 {
     WEB_SET_PROTOTYPE_FOR_INTERFACE(HTMLLinkElement);
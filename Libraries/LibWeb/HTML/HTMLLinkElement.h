@@ -69,6 +69,7 @@ private:
 
     // ^HTMLElement
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
     virtual bool is_implicitly_potentially_render_blocking() const override;
 
     struct LinkProcessingOptions {
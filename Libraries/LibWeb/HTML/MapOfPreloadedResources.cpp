@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/HTML/MapOfPreloadedResources.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/SRI/SRI.h>
+
+namespace Web::HTML {
+
+GC_DEFINE_ALLOCATOR(PreloadEntry);
+GC_DEFINE_ALLOCATOR(MapOfPreloadedResources);
+
+GC::Ref<PreloadEntry> PreloadEntry::create(GC::Heap& heap, String integrity_metadata, bool speculative)
+{
+    return heap.allocate<PreloadEntry>(move(integrity_metadata), speculative);
+}
+
+PreloadEntry::PreloadEntry(String integrity_metadata, bool speculative)
+    : m_integrity_metadata(move(integrity_metadata))
+    , m_speculative(speculative)
+{
+}
+
+void PreloadEntry::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_response);
+    visitor.visit(m_on_response_available);
+}
+
+u32 MapOfPreloadedResources::Key::hash() const
+{
+    u32 destination_hash = destination.has_value() ? to_underlying(*destination) + 1 : 0;
+    u32 modes_hash = pair_int_hash(to_underlying(mode), to_underlying(credentials_mode));
+    return pair_int_hash(Traits<URL::URL>::hash(url), pair_int_hash(destination_hash, modes_hash));
+}
+
+MapOfPreloadedResources::MapOfPreloadedResources() = default;
+MapOfPreloadedResources::~MapOfPreloadedResources() = default;
+
+void MapOfPreloadedResources::set(Key const& key, GC::Ref<PreloadEntry> entry)
+{
+    m_entries.set(key, entry);
+}
+
+GC::Ptr<PreloadEntry> MapOfPreloadedResources::get(Key const& key) const
+{
+    if (auto entry = m_entries.get(key); entry.has_value())
+        return *entry;
+    return nullptr;
+}
+
+void MapOfPreloadedResources::remove(Key const& key)
+{
+    m_entries.remove(key);
+}
+
+void MapOfPreloadedResources::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    for (auto& it : m_entries)
+        visitor.visit(it.value);
+}
+
+static bool is_equal_integrity_metadata(Vector<SRI::Metadata> const& a, Vector<SRI::Metadata> const& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].algorithm != b[i].algorithm || a[i].base64_value != b[i].base64_value || a[i].options != b[i].options)
+            return false;
+    }
+    return true;
+}
+
+// https://html.spec.whatwg.org/multipage/links.html#consume-a-preloaded-resource
+bool consume_a_preloaded_resource(Window& window, URL::URL const& url, Optional<Fetch::Infrastructure::Request::Destination> destination, Fetch::Infrastructure::Request::Mode mode, Fetch::Infrastructure::Request::CredentialsMode credentials_mode, StringView integrity_metadata, GC::Ref<PreloadEntry::OnResponseAvailable> on_response_available)
+{
+    // 1. Let key be a preload key whose URL is url, destination is destination, mode is mode, and credentials mode is
+    //    credentialsMode.
+    MapOfPreloadedResources::Key key { url, destination, mode, credentials_mode };
+
+    // 2. Let preloads be window's associated Document's map of preloaded resources.
+    auto& document = window.associated_document();
+    auto& preloads = document.map_of_preloaded_resources();
+
+    // 3. If key does not exist in preloads, then return false.
+    // 4. Let entry be preloads[key].
+    auto entry = preloads.get(key);
+    if (!entry)
+        return false;
+
+    // 5. Let consumerIntegrityMetadata be the result of parsing integrityMetadata.
+    auto consumer_integrity_metadata = SRI::parse_metadata(integrity_metadata);
+
+    // 6. Let preloadIntegrityMetadata be the result of parsing entry's integrity metadata.
+    auto preload_integrity_metadata = SRI::parse_metadata(entry->integrity_metadata());
+
+    if (consumer_integrity_metadata.is_error() || preload_integrity_metadata.is_error())
+        return false;
+
+    // 7. If none of the following conditions apply:
+    //    - consumerIntegrityMetadata is no metadata;
+    //    - consumerIntegrityMetadata is equal to preloadIntegrityMetadata,
+    //    then return false.
+    if (!consumer_integrity_metadata.value().is_empty() && !is_equal_integrity_metadata(consumer_integrity_metadata.value(), preload_integrity_metadata.value()))
+        return false;
+
+    // 8. Remove preloads[key].
+    preloads.remove(key);
+
+    if (entry->is_speculative())
+        ++document.speculative_fetch_statistics().fetches_used;
+
+    // 9. If entry's response is null, then set entry's on response available to onResponseAvailable.
+    if (!entry->response())
+        entry->set_on_response_available(on_response_available);
+
+    // 10. Otherwise, call onResponseAvailable with entry's response.
+    else
+        on_response_available->function()(*entry->response());
+
+    // 11. Return true.
+    return true;
+}
+
+}
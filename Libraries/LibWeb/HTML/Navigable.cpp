@@ -160,8 +160,9 @@ Navigable::~Navigable() = default;
 
 void Navigable::finalize()
 {
-    all_navigables().remove(*this);
     Base::finalize();
+    revoke_weak_ptrs();
+    all_navigables().remove(*this);
 }
 
 void Navigable::visit_edges(Cell::Visitor& visitor)
@@ -362,7 +362,7 @@ Optional<ByteString> run_bom_sniff(ByteBuffer const& input)
 }
 
 // https://html.spec.whatwg.org/multipage/parsing.html#determining-the-character-encoding
-ByteString run_encoding_sniffing_algorithm(DOM::Document& document, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type)
+Optional<ByteString> run_encoding_sniffing_algorithm_without_autodetection(DOM::Document& document, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type)
 {
     // 1. If the result of BOM sniffing is an encoding, return that encoding with confidence certain.
     // FIXME: There is no concept of decoding certainty yet.
@@ -372,10 +372,11 @@ ByteString run_encoding_sniffing_algorithm(DOM::Document& document, ByteBuffer c
     // 2. FIXME: If the user has explicitly instructed the user agent to override the document's character encoding with a specific encoding,
     //    optionally return that encoding with the confidence certain.
 
-    // 3. FIXME: The user agent may wait for more bytes of the resource to be available, either in this step or at any later step in this algorithm.
+    // 3. The user agent may wait for more bytes of the resource to be available, either in this step or at any later step in this algorithm.
     //    For instance, a user agent might wait 500ms or 1024 bytes, whichever came first. In general preparsing the source to find the encoding improves performance,
     //    as it reduces the need to throw away the data structures used when parsing upon finding the encoding information. However, if the user agent delays too long
     //    to obtain data to determine the encoding, then the cost of the delay could outweigh any performance improvements from the preparse.
+    // NOTE: When parsing a document from the network, HTMLParser waits for 1024 bytes before running this.
 
     // 4. If the transport layer specifies a character encoding, and it is supported, return that encoding with the confidence certain.
     if (maybe_mime_type.has_value()) {
@@ -393,6 +394,16 @@ ByteString run_encoding_sniffing_algorithm(DOM::Document& document, ByteBuffer c
     if (prescan.has_value())
         return prescan.value();
 
+    return {};
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#determining-the-character-encoding
+ByteString run_encoding_sniffing_algorithm(DOM::Document& document, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type)
+{
+    // Steps 1-5.
+    if (auto encoding = run_encoding_sniffing_algorithm_without_autodetection(document, input, maybe_mime_type); encoding.has_value())
+        return encoding.release_value();
+
     // 6. FIXME: If the HTML parser for which this algorithm is being run is associated with a Document d whose container document is non-null, then:
     // 1. Let parentDocument be d's container document.
     // 2. If parentDocument's origin is same origin with d's origin and parentDocument's character encoding is not UTF-16BE/LE, then return parentDocument's character
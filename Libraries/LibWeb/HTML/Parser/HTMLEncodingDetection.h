@@ -20,6 +20,8 @@ Optional<StringView> extract_character_encoding_from_meta_element(ByteString con
 GC::Ptr<DOM::Attr> prescan_get_attribute(DOM::Document&, ByteBuffer const& input, size_t& position);
 Optional<ByteString> run_prescan_byte_stream_algorithm(DOM::Document&, ByteBuffer const& input);
 Optional<ByteString> run_bom_sniff(ByteBuffer const& input);
+// Runs the steps of the encoding sniffing algorithm that don't look past the first 1024 bytes of the input.
+Optional<ByteString> run_encoding_sniffing_algorithm_without_autodetection(DOM::Document&, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type = {});
 ByteString run_encoding_sniffing_algorithm(DOM::Document&, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type = {});
 
 }
@@ -190,6 +190,8 @@ void HTMLParser::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_character_insertion_node);
 
     m_stack_of_open_elements.visit_edges(visitor);
+    if (m_active_speculative_html_parser)
+        m_active_speculative_html_parser->visit_edges(visitor);
     m_list_of_active_formatting_elements.visit_edges(visitor);
 }
 
@@ -3293,7 +3295,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    start_the_speculative_html_parser();
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -3312,7 +3315,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    stop_the_speculative_html_parser();
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -5118,6 +5122,187 @@ GC::Ref<HTMLParser> HTMLParser::create(DOM::Document& document, StringView input
     return document.realm().create<HTMLParser>(document, input, encoding);
 }
 
+GC::Ref<HTMLParser> HTMLParser::create_for_network_input(DOM::Document& document, URL::URL const& url, Optional<MimeSniff::MimeType> maybe_mime_type)
+{
+    document.set_url(url);
+
+    auto parser = document.realm().create<HTMLParser>(document);
+    parser->m_input_mime_type = move(maybe_mime_type);
+    parser->m_tokenizer.open_input_stream();
+    return parser;
+}
+
+// https://html.spec.whatwg.org/multipage/document-lifecycle.html#navigate-html
+void HTMLParser::append_to_input_byte_stream(ReadonlyBytes bytes)
+{
+    VERIFY(!m_input_byte_stream_is_complete);
+    if (m_aborted)
+        return;
+
+    // Each task that the networking task source places on the task queue while fetching runs must then fill the
+    // parser's input byte stream with the fetched bytes and cause the HTML parser to perform the appropriate
+    // processing of the input stream.
+    m_undecoded_input_bytes.append(bytes);
+    decode_input_byte_stream();
+    parse_available_input();
+}
+
+void HTMLParser::finish_input_byte_stream()
+{
+    VERIFY(!m_input_byte_stream_is_complete);
+    if (m_aborted)
+        return;
+
+    // When no more bytes are available, the user agent must queue a global task on the networking task source given
+    // document's relevant global object to have the parser to process the implied EOF character, which eventually
+    // causes a load event to be fired.
+    m_input_byte_stream_is_complete = true;
+    decode_input_byte_stream();
+    parse_available_input();
+}
+
+// Returns how many bytes at the end of the given UTF-8 data belong to a code point that hasn't been fully received.
+static size_t length_of_incomplete_utf8_sequence_at_end(ReadonlyBytes bytes)
+{
+    for (size_t length = 1; length <= min(bytes.size(), 4uz); ++length) {
+        auto byte = bytes[bytes.size() - length];
+        if ((byte & 0xC0) == 0x80)
+            continue;
+
+        size_t expected_length = 1;
+        if ((byte & 0xE0) == 0xC0)
+            expected_length = 2;
+        else if ((byte & 0xF0) == 0xE0)
+            expected_length = 3;
+        else if ((byte & 0xF8) == 0xF0)
+            expected_length = 4;
+
+        return expected_length > length ? length : 0;
+    }
+    return 0;
+}
+
+void HTMLParser::decode_input_byte_stream()
+{
+    if (!m_input_encoding.has_value()) {
+        ByteString encoding;
+        if (m_document->has_encoding()) {
+            encoding = m_document->encoding()->to_byte_string();
+        } else {
+            // NOTE: Wait until there are enough bytes to prescan, so that a <meta charset> near the top is found.
+            if (!m_input_byte_stream_is_complete && m_undecoded_input_bytes.size() < 1024)
+                return;
+
+            Optional<ByteString> sniffed_encoding;
+            if (m_input_byte_stream_is_complete)
+                sniffed_encoding = run_encoding_sniffing_algorithm(*m_document, m_undecoded_input_bytes, m_input_mime_type);
+            else
+                sniffed_encoding = run_encoding_sniffing_algorithm_without_autodetection(*m_document, m_undecoded_input_bytes, m_input_mime_type);
+
+            // NOTE: Autodetecting the encoding looks at all of the input, so we can't start decoding before it's here.
+            if (!sniffed_encoding.has_value())
+                return;
+
+            dbgln_if(HTML_PARSER_DEBUG, "The encoding sniffing algorithm returned encoding '{}'", *sniffed_encoding);
+            encoding = sniffed_encoding.release_value();
+        }
+
+        auto standardized_encoding = TextCodec::get_standardized_encoding(encoding);
+        VERIFY(standardized_encoding.has_value());
+        m_input_encoding = standardized_encoding->to_byte_string();
+        m_document->set_encoding(MUST(String::from_utf8(*standardized_encoding)));
+    }
+
+    ReadonlyBytes bytes_to_decode = m_undecoded_input_bytes;
+    String decoded_input;
+
+    if (*m_input_encoding == "UTF-8"sv) {
+        // NOTE: The last code point may be split between this chunk and the next one.
+        if (!m_input_byte_stream_is_complete)
+            bytes_to_decode = bytes_to_decode.trim(bytes_to_decode.size() - length_of_incomplete_utf8_sequence_at_end(bytes_to_decode));
+
+        auto bom_handling = m_has_decoded_input_bytes ? String::WithBOMHandling::No : String::WithBOMHandling::Yes;
+        decoded_input = String::from_utf8_with_replacement_character(bytes_to_decode, bom_handling);
+    } else {
+        // FIXME: Decode other encodings as their bytes arrive too. Our decoders don't know where a chunk may be split.
+        if (!m_input_byte_stream_is_complete)
+            return;
+
+        auto decoder = TextCodec::decoder_for(*m_input_encoding);
+        VERIFY(decoder.has_value());
+        decoded_input = MUST(decoder->to_utf8(bytes_to_decode));
+    }
+
+    if (!bytes_to_decode.is_empty())
+        m_has_decoded_input_bytes = true;
+    m_tokenizer.append_to_input_stream(decoded_input);
+    m_undecoded_input_bytes = MUST(ByteBuffer::copy(m_undecoded_input_bytes.bytes().slice(bytes_to_decode.size())));
+
+    if (m_input_byte_stream_is_complete)
+        m_tokenizer.close_input_stream();
+
+    // NOTE: While we're blocked on a script, the speculative HTML parser gets to look at the new input right away.
+    if (m_active_speculative_html_parser) {
+        m_active_speculative_html_parser->append_input(decoded_input);
+        if (m_input_byte_stream_is_complete)
+            m_active_speculative_html_parser->finish_input();
+        m_active_speculative_html_parser->scan();
+    }
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void HTMLParser::start_the_speculative_html_parser()
+{
+    // 1. Optionally, return.
+    // NOTE: Nothing is loaded for documents without a browsing context, or for fragments.
+    if (m_parsing_fragment || !m_document->browsing_context())
+        return;
+
+    // 2. If parser's active speculative HTML parser is not null, then stop the speculative HTML parser for parser.
+    // NOTE: This can happen when document.write() writes another parser-blocking script while the parser is paused.
+    stop_the_speculative_html_parser();
+
+    // 3. Optionally, return.
+
+    // 4. Let speculativeParser be a new speculative HTML parser, with the same state as parser.
+    // 5. Let speculativeDoc be a new isomorphic representation of parser's Document, where all elements are instead
+    //    speculative mock elements. Let speculativeParser parse into speculativeDoc.
+    // 6. Set parser's active speculative HTML parser to speculativeParser.
+    m_active_speculative_html_parser = make<PreloadScanner>(*m_document, m_tokenizer, m_scripting_enabled);
+
+    // 7. In parallel, run speculativeParser until it is stopped or until it reaches the end of its input stream.
+    // NOTE: We scan the input that is already here right away, and anything that arrives later as it comes in.
+    m_active_speculative_html_parser->scan();
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#stop-the-speculative-html-parser
+void HTMLParser::stop_the_speculative_html_parser()
+{
+    // 1. Let speculativeParser be parser's active speculative HTML parser.
+    // 2. If speculativeParser is null, then return.
+    // 3. Throw away any pending content in speculativeParser's input stream, and discard any future content that would
+    //    have been added to it.
+    // 4. Set parser's active speculative HTML parser to null.
+    m_active_speculative_html_parser = nullptr;
+}
+
+void HTMLParser::parse_available_input()
+{
+    // NOTE: If the parser is already busy further up the stack (because it's waiting for a script, or running one),
+    //       it will pick up the new input once it gets back to tokenizing.
+    if (m_aborted || m_tokenizer.is_blocked() || m_parser_pause_flag || m_script_nesting_level > 0)
+        return;
+
+    run();
+
+    if (!m_input_byte_stream_is_complete || m_aborted || m_has_finished_parsing_input_byte_stream)
+        return;
+
+    m_has_finished_parsing_input_byte_stream = true;
+    m_document->set_source(m_tokenizer.source());
+    the_end(*m_document, this);
+}
+
 enum class AttributeMode {
     No,
     Yes,
@@ -5650,7 +5835,8 @@ void HTMLParser::abort()
     // 1. Throw away any pending content in the input stream, and discard any future content that would have been added to it.
     m_tokenizer.abort();
 
-    // FIXME: 2. Stop the speculative HTML parser for this HTML parser.
+    // 2. Stop the speculative HTML parser for this HTML parser.
+    stop_the_speculative_html_parser();
 
     // 3. Update the current document readiness to "interactive".
     m_document->update_readiness(DocumentReadyState::Interactive);
@@ -12,6 +12,7 @@
 #include <LibWeb/Export.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 #include <LibWeb/HTML/Parser/ListOfActiveFormattingElements.h>
+#include <LibWeb/HTML/Parser/PreloadScanner.h>
 #include <LibWeb/HTML/Parser/StackOfOpenElements.h>
 #include <LibWeb/MimeSniff/MimeType.h>
 
@@ -65,6 +66,12 @@ public:
     static GC::Ref<HTMLParser> create_with_uncertain_encoding(DOM::Document&, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type = {});
     static GC::Ref<HTMLParser> create(DOM::Document&, StringView input, StringView encoding);
 
+    // Creates a parser for a document whose bytes are still arriving from the network. The parser is fed with
+    // append_to_input_byte_stream() as they arrive, and parses as much of the document as it can each time.
+    static GC::Ref<HTMLParser> create_for_network_input(DOM::Document&, URL::URL const&, Optional<MimeSniff::MimeType> maybe_mime_type = {});
+    void append_to_input_byte_stream(ReadonlyBytes);
+    void finish_input_byte_stream();
+
     void run(HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
     void run(const URL::URL&, HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
 
@@ -139,6 +146,12 @@ private:
 
     void stop_parsing() { m_stop_parsing = true; }
 
+    void decode_input_byte_stream();
+    void parse_available_input();
+
+    void start_the_speculative_html_parser();
+    void stop_the_speculative_html_parser();
+
     void generate_implied_end_tags(FlyString const& exception = {});
     void generate_all_implied_end_tags_thoroughly();
     GC::Ref<DOM::Element> create_element_for(HTMLToken const&, Optional<FlyString> const& namespace_, DOM::Node& intended_parent);
@@ -215,6 +228,14 @@ private:
     bool m_stop_parsing { false };
     size_t m_script_nesting_level { 0 };
 
+    // The bytes from the network that haven't been decoded into the tokenizer's input stream yet.
+    ByteBuffer m_undecoded_input_bytes;
+    Optional<MimeSniff::MimeType> m_input_mime_type;
+    Optional<ByteString> m_input_encoding;
+    bool m_has_decoded_input_bytes { false };
+    bool m_input_byte_stream_is_complete { false };
+    bool m_has_finished_parsing_input_byte_stream { false };
+
     JS::Realm& realm();
 
     GC::Ptr<DOM::Document> m_document;
@@ -226,6 +247,9 @@ private:
     GC::ForeignPtr<Web::SpeculativeHTMLParser> m_speculative_parser;
 #endif
 
+    // https://html.spec.whatwg.org/multipage/parsing.html#active-speculative-html-parser
+    OwnPtr<PreloadScanner> m_active_speculative_html_parser;
+
     Vector<HTMLToken> m_pending_table_character_tokens;
 
     GC::Ptr<DOM::Text> m_character_insertion_node;
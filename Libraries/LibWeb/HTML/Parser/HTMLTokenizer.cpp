@@ -9,6 +9,7 @@
 #include <AK/Debug.h>
 #include <AK/GenericShorthands.h>
 #include <AK/SourceLocation.h>
+#include <AK/Utf8View.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
@@ -34,7 +35,7 @@ namespace Web::HTML {
     do {                                                                                          \
         will_switch_to(State::new_state);                                                         \
         m_state = State::new_state;                                                               \
-        if (stop_at_insertion_point == StopAtInsertionPoint::Yes && is_insertion_point_reached()) \
+        if (should_stop_consuming_input(stop_at_insertion_point))                                 \
             return {};                                                                            \
         CONSUME_NEXT_INPUT_CHARACTER;                                                             \
         goto new_state;                                                                           \
@@ -274,7 +275,7 @@ _StartOfFunction:
         return {};
 
     for (;;) {
-        if (stop_at_insertion_point == StopAtInsertionPoint::Yes && is_insertion_point_reached())
+        if (should_stop_consuming_input(stop_at_insertion_point))
             return {};
 
         auto current_input_character = next_code_point(stop_at_insertion_point);
@@ -1696,9 +1697,11 @@ _StartOfFunction:
             // 13.2.5.73 Named character reference state, https://html.spec.whatwg.org/multipage/parsing.html#named-character-reference-state
             BEGIN_STATE(NamedCharacterReference)
             {
-                if (stop_at_insertion_point == StopAtInsertionPoint::Yes && is_insertion_point_defined()) {
+                if ((stop_at_insertion_point == StopAtInsertionPoint::Yes && is_insertion_point_defined()) || m_input_stream_is_open || !current_input_character.has_value()) {
                     // If there is an insertion point, match code-point-by-code-point to handle the possibility of
                     // document.write being used to insert a named character reference one-code-point-at-a-time.
+                    // The same goes for input that's still arriving from the network, which may have ended right
+                    // after the code points we already matched.
                     if (current_input_character.has_value()) {
                         if (m_named_character_reference_matcher.try_consume_code_point(current_input_character.value())) {
                             m_temporary_buffer.append(current_input_character.value());
@@ -2846,7 +2849,7 @@ HTMLTokenizer::ConsumeNextResult HTMLTokenizer::consume_next_if_match(StringView
     for (size_t i = 0; i < string.length(); ++i) {
         auto code_point = peek_code_point(i, stop_at_insertion_point);
         if (!code_point.has_value()) {
-            if (StopAtInsertionPoint::Yes == stop_at_insertion_point) {
+            if (StopAtInsertionPoint::Yes == stop_at_insertion_point || m_input_stream_is_open) {
                 return ConsumeNextResult::RanOutOfCharacters;
             }
             return ConsumeNextResult::NotConsumed;
@@ -2927,6 +2930,48 @@ bool HTMLTokenizer::is_eof_inserted()
     return m_explicit_eof_inserted;
 }
 
+void HTMLTokenizer::append_to_input_stream(StringView input)
+{
+    VERIFY(m_input_stream_is_open);
+    m_source_builder.append(input);
+
+    m_decoded_input.ensure_capacity(m_decoded_input.size() + input.length());
+    for (auto code_point : Utf8View { input })
+        m_decoded_input.unchecked_append(code_point);
+}
+
+void HTMLTokenizer::close_input_stream()
+{
+    m_input_stream_is_open = false;
+    m_source = m_source_builder.to_string_without_validation();
+    m_source_builder.clear();
+}
+
+bool HTMLTokenizer::is_waiting_for_more_input() const
+{
+    if (!m_input_stream_is_open)
+        return false;
+
+    // NOTE: A trailing CR may be the first half of a CRLF pair, which we have to normalize to a single LF.
+    auto remaining_code_points = m_decoded_input.size() - static_cast<size_t>(m_current_offset);
+    return remaining_code_points == 0 || (remaining_code_points == 1 && m_decoded_input.last() == '\r');
+}
+
+String HTMLTokenizer::unconsumed_input() const
+{
+    StringBuilder builder;
+    for (auto code_point : m_decoded_input.span().slice(m_current_offset))
+        builder.append_code_point(code_point);
+    return builder.to_string_without_validation();
+}
+
+bool HTMLTokenizer::should_stop_consuming_input(StopAtInsertionPoint stop_at_insertion_point)
+{
+    if (stop_at_insertion_point == StopAtInsertionPoint::Yes && is_insertion_point_reached())
+        return true;
+    return is_waiting_for_more_input();
+}
+
 void HTMLTokenizer::will_switch_to([[maybe_unused]] State new_state)
 {
     dbgln_if(TOKENIZER_TRACE_DEBUG, "[{}] Switch to {}", state_name(m_state), state_name(new_state));
@@ -135,6 +135,17 @@ public:
     void insert_eof();
     bool is_eof_inserted();
 
+    // While the input stream is being filled from the network, running out of input only means that we have to wait
+    // for more of it. Tokenization then resumes where it left off once more input has been appended.
+    void open_input_stream() { m_input_stream_is_open = true; }
+    void append_to_input_stream(StringView input);
+    void close_input_stream();
+    bool is_input_stream_open() const { return m_input_stream_is_open; }
+    bool is_waiting_for_more_input() const;
+
+    // The part of the input stream that the tokenizer hasn't consumed yet.
+    String unconsumed_input() const;
+
     bool is_insertion_point_defined() const { return m_insertion_point.defined; }
     bool is_insertion_point_reached()
     {
@@ -186,6 +197,8 @@ private:
 
     bool consumed_as_part_of_an_attribute() const;
 
+    bool should_stop_consuming_input(StopAtInsertionPoint);
+
     void restore_to(ssize_t new_iterator);
     HTMLToken::Position nth_last_position(size_t n = 0);
 
@@ -199,6 +212,9 @@ private:
     String m_source;
     Vector<u32> m_decoded_input;
 
+    bool m_input_stream_is_open { false };
+    StringBuilder m_source_builder;
+
     struct InsertionPoint {
         ssize_t position { 0 };
         bool defined { false };
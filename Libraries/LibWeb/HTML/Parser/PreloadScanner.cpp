@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/Fetch/Infrastructure/URL.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+#include <LibWeb/HTML/MapOfPreloadedResources.h>
+#include <LibWeb/HTML/Parser/PreloadScanner.h>
+#include <LibWeb/HTML/PotentialCORSRequest.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+PreloadScanner::PreloadScanner(DOM::Document& document, HTMLTokenizer const& parser_tokenizer, bool scripting_enabled)
+    : m_document(document)
+    , m_scripting_enabled(scripting_enabled)
+{
+    // NOTE: The parser has just consumed the end tag of a script, so we start out in the data state, like it does.
+    m_tokenizer.open_input_stream();
+    m_tokenizer.append_to_input_stream(parser_tokenizer.unconsumed_input());
+    if (!parser_tokenizer.is_input_stream_open())
+        m_tokenizer.close_input_stream();
+}
+
+void PreloadScanner::visit_edges(JS::Cell::Visitor& visitor)
+{
+    visitor.visit(m_document);
+}
+
+void PreloadScanner::append_input(StringView input)
+{
+    m_tokenizer.append_to_input_stream(input);
+}
+
+void PreloadScanner::finish_input()
+{
+    m_tokenizer.close_input_stream();
+}
+
+void PreloadScanner::scan()
+{
+    while (!m_has_reached_end_of_input) {
+        auto token = m_tokenizer.next_token();
+        if (!token.has_value())
+            return;
+
+        if (token->is_end_of_file())
+            m_has_reached_end_of_input = true;
+        else if (token->is_start_tag())
+            process_start_tag(*token);
+        else if (token->is_end_tag())
+            process_end_tag(*token);
+    }
+}
+
+static bool has_keyword(Optional<String> const& attribute_value, StringView keyword)
+{
+    if (!attribute_value.has_value())
+        return false;
+
+    for (auto part : attribute_value->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+        if (part.equals_ignoring_ascii_case(keyword))
+            return true;
+    }
+    return false;
+}
+
+void PreloadScanner::process_start_tag(HTMLToken const& token)
+{
+    auto const& tag_name = token.tag_name();
+
+    // https://html.spec.whatwg.org/multipage/parsing.html#parsing-main-inforeign
+    // NOTE: In foreign content, the tree builder doesn't switch the tokenizer to another state for any element.
+    if (m_foreign_content_depth > 0) {
+        if (!token.is_self_closing() && tag_name.is_one_of(TagNames::svg, TagNames::math))
+            ++m_foreign_content_depth;
+        return;
+    }
+
+    // These are the elements for which the tree builder switches the tokenizer to another state.
+    if (tag_name == TagNames::script)
+        m_tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+    else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes) || (tag_name == TagNames::noscript && m_scripting_enabled))
+        m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+    else if (tag_name.is_one_of(TagNames::textarea, TagNames::title))
+        m_tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+    else if (tag_name == TagNames::plaintext)
+        m_tokenizer.switch_to(HTMLTokenizer::State::PLAINTEXT);
+
+    if (tag_name.is_one_of(TagNames::svg, TagNames::math)) {
+        if (!token.is_self_closing())
+            ++m_foreign_content_depth;
+        return;
+    }
+
+    if (tag_name == TagNames::template_) {
+        ++m_template_depth;
+        return;
+    }
+    if (m_template_depth > 0)
+        return;
+
+    if (tag_name == TagNames::picture) {
+        ++m_picture_depth;
+        return;
+    }
+
+    // https://html.spec.whatwg.org/multipage/semantics.html#frozen-base-url
+    if (tag_name == TagNames::base) {
+        if (m_base_url.has_value())
+            return;
+        if (auto href = token.attribute(AttributeNames::href); href.has_value())
+            m_base_url = DOMURL::parse(*href, m_document->fallback_base_url(), m_document->encoding_or_default());
+        return;
+    }
+
+    auto cors_setting = cors_setting_attribute_from_keyword(token.attribute(AttributeNames::crossorigin));
+
+    GC::Ptr<Fetch::Infrastructure::Request> request;
+
+    // https://html.spec.whatwg.org/multipage/scripting.html#prepare-the-script-element
+    if (tag_name == TagNames::script) {
+        auto src = token.attribute(AttributeNames::src);
+        if (!src.has_value() || src->is_empty())
+            return;
+
+        auto type_attribute = token.attribute(AttributeNames::type).value_or({});
+        auto type = type_attribute.bytes_as_string_view().trim(Infra::ASCII_WHITESPACE);
+        bool is_classic = type.is_empty() || MimeSniff::is_javascript_mime_type_essence_match(type);
+        bool is_module = type.equals_ignoring_ascii_case("module"sv);
+
+        // NOTE: Classic scripts with a nomodule attribute are never executed, since we support module scripts.
+        if ((!is_classic && !is_module) || (is_classic && token.has_attribute(AttributeNames::nomodule)))
+            return;
+
+        auto url = parse_url(*src);
+        if (!url.has_value())
+            return;
+
+        request = create_potential_CORS_request(m_document->vm(), *url, Fetch::Infrastructure::Request::Destination::Script, cors_setting);
+
+        // NOTE: Module scripts are always fetched in CORS mode, see "fetch a single module script".
+        if (is_module) {
+            request->set_mode(Fetch::Infrastructure::Request::Mode::CORS);
+            if (cors_setting != CORSSettingAttribute::UseCredentials)
+                request->set_credentials_mode(Fetch::Infrastructure::Request::CredentialsMode::SameOrigin);
+        }
+    }
+
+    // https://html.spec.whatwg.org/multipage/links.html#link-type-stylesheet
+    else if (tag_name == TagNames::link) {
+        auto rel = token.attribute(AttributeNames::rel);
+        if (!has_keyword(rel, "stylesheet"sv) || has_keyword(rel, "alternate"sv) || token.has_attribute(AttributeNames::disabled))
+            return;
+
+        auto href = token.attribute(AttributeNames::href);
+        if (!href.has_value() || href->is_empty())
+            return;
+
+        auto url = parse_url(*href);
+        if (!url.has_value())
+            return;
+
+        request = create_potential_CORS_request(m_document->vm(), *url, Fetch::Infrastructure::Request::Destination::Style, cors_setting);
+    }
+
+    // https://html.spec.whatwg.org/multipage/images.html#update-the-image-data
+    else if (tag_name == TagNames::img) {
+        if (m_picture_depth > 0 || token.has_attribute(AttributeNames::srcset))
+            return;
+
+        auto src = token.attribute(AttributeNames::src);
+        if (!src.has_value() || src->is_empty())
+            return;
+
+        auto url = parse_url(*src);
+        if (!url.has_value())
+            return;
+
+        request = create_potential_CORS_request(m_document->vm(), *url, Fetch::Infrastructure::Request::Destination::Image, cors_setting);
+    }
+
+    if (!request)
+        return;
+
+    if (auto integrity = token.attribute(AttributeNames::integrity); integrity.has_value())
+        request->set_integrity_metadata(*integrity);
+
+    speculative_fetch(*request);
+}
+
+void PreloadScanner::process_end_tag(HTMLToken const& token)
+{
+    auto const& tag_name = token.tag_name();
+
+    if (m_foreign_content_depth > 0) {
+        if (tag_name.is_one_of(TagNames::svg, TagNames::math))
+            --m_foreign_content_depth;
+        return;
+    }
+
+    if (tag_name == TagNames::template_ && m_template_depth > 0)
+        --m_template_depth;
+    else if (tag_name == TagNames::picture && m_picture_depth > 0)
+        --m_picture_depth;
+}
+
+Optional<URL::URL> PreloadScanner::parse_url(StringView url) const
+{
+    if (m_base_url.has_value())
+        return DOMURL::parse(url, *m_base_url, m_document->encoding_or_default());
+    return m_document->encoding_parse_url(url);
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
+void PreloadScanner::speculative_fetch(GC::Ref<Fetch::Infrastructure::Request> request)
+{
+    auto const& url = request->url();
+
+    // NOTE: Only responses for HTTP(S) requests can be handed over to the real fetch, see "consume a preloaded resource".
+    if (!Fetch::Infrastructure::is_http_or_https_scheme(url.scheme()))
+        return;
+
+    // If url is already in the list of speculative fetch URLs, then do nothing.
+    auto& list_of_speculative_fetch_urls = m_document->list_of_speculative_fetch_urls();
+    if (list_of_speculative_fetch_urls.contains(url))
+        return;
+
+    MapOfPreloadedResources::Key key { url, request->destination(), request->mode(), request->credentials_mode() };
+    auto& preloads = m_document->map_of_preloaded_resources();
+    if (preloads.contains(key))
+        return;
+
+    dbgln_if(HTML_PARSER_DEBUG, "PreloadScanner: Speculatively fetching {}", url);
+
+    request->set_client(&m_document->relevant_settings_object());
+
+    auto entry = PreloadEntry::create(m_document->heap(), request->integrity_metadata(), true);
+
+    Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+    fetch_algorithms_input.process_response_consume_body = [document = m_document, entry](GC::Ref<Fetch::Infrastructure::Response> response, Fetch::Infrastructure::FetchAlgorithms::BodyBytes body_bytes) {
+        // If bodyBytes is a byte sequence, then set response's body to bodyBytes as a body.
+        if (auto* bytes = body_bytes.get_pointer<ByteBuffer>())
+            response->set_body(Fetch::Infrastructure::byte_sequence_as_body(document->realm(), bytes->bytes()));
+        // Otherwise, set response to a network error.
+        else
+            response = Fetch::Infrastructure::Response::network_error(document->vm(), "Speculative fetch failed"_string);
+
+        // If entry's on response available is null, then set entry's response to response; otherwise call entry's
+        // on response available given response.
+        if (auto on_response_available = entry->on_response_available())
+            on_response_available->function()(response);
+        else
+            entry->set_response(response);
+    };
+
+    // NOTE: The entry goes into the map once the fetch has started, so that the fetch doesn't consume its own entry.
+    MUST(Fetch::Fetching::fetch(m_document->realm(), *request, Fetch::Infrastructure::FetchAlgorithms::create(m_document->vm(), move(fetch_algorithms_input))));
+    preloads.set(key, entry);
+
+    // Append url to the list of speculative fetch URLs.
+    list_of_speculative_fetch_urls.set(url);
+
+    ++m_document->speculative_fetch_statistics().fetches_started;
+}
+
+}
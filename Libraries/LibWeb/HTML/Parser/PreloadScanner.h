@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <LibGC/Ptr.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#active-speculative-html-parser
+// While the HTML parser is blocked on a script, this looks at the input that follows it for resources that the
+// document is going to need, and starts fetching them early. Unlike the speculative HTML parser in the spec, it
+// doesn't build a tree of mock elements; a tokenizer, and a little bit of state to keep it in step with what the
+// tree builder would do, is enough to find the URLs. The fetched responses are handed over to the real fetches
+// through the document's map of preloaded resources.
+class PreloadScanner {
+    AK_MAKE_NONCOPYABLE(PreloadScanner);
+    AK_MAKE_NONMOVABLE(PreloadScanner);
+
+public:
+    PreloadScanner(DOM::Document&, HTMLTokenizer const& parser_tokenizer, bool scripting_enabled);
+
+    void append_input(StringView);
+    void finish_input();
+
+    // Scans all of the input that has arrived so far.
+    void scan();
+
+    void visit_edges(JS::Cell::Visitor&);
+
+private:
+    void process_start_tag(HTMLToken const&);
+    void process_end_tag(HTMLToken const&);
+
+    Optional<URL::URL> parse_url(StringView) const;
+    void speculative_fetch(GC::Ref<Fetch::Infrastructure::Request>);
+
+    GC::Ref<DOM::Document> m_document;
+    HTMLTokenizer m_tokenizer;
+    bool m_scripting_enabled { true };
+    bool m_has_reached_end_of_input { false };
+
+    // https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parser
+    // NOTE: The first <base href> that we come across applies to the URLs after it, like it would for the real parser.
+    Optional<URL::URL> m_base_url;
+
+    // Elements in these aren't processed normally, so there's nothing to fetch for them.
+    size_t m_template_depth { 0 };
+    size_t m_foreign_content_depth { 0 };
+
+    // The source of an <img> in a <picture> is selected from its <source> siblings, which we don't do.
+    size_t m_picture_depth { 0 };
+};
+
+}
@@ -46,8 +46,8 @@ EnvironmentSettingsObject::EnvironmentSettingsObject(NonnullOwnPtr<JS::Execution
 
 void EnvironmentSettingsObject::finalize()
 {
-    responsible_event_loop().unregister_environment_settings_object({}, *this);
     Base::finalize();
+    responsible_event_loop().unregister_environment_settings_object({}, *this);
 }
 
 void EnvironmentSettingsObject::initialize(JS::Realm& realm)
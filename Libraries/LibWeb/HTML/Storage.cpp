@@ -59,6 +59,7 @@ void Storage::initialize(JS::Realm& realm)
 
 void Storage::finalize()
 {
+    Base::finalize();
     all_storages().remove(*this);
 }
 
@@ -135,7 +135,7 @@ WebIDL::ExceptionOr<GC::Ref<IDBObjectStore>> IDBDatabase::create_object_store(St
     //    Set the created object store's name to name.
     //    If autoIncrement is true, then the created object store uses a key generator.
     //    If keyPath is not null, set the created object store's key path to keyPath.
-    auto object_store = ObjectStore::create(realm, database, name, auto_increment, key_path);
+    auto object_store = ObjectStore::create(realm, database, database->allocate_id(), name, auto_increment, key_path);
 
     // AD-HOC: Add newly created object store to this's object store set.
     add_to_object_store_set(object_store);
@@ -204,29 +204,36 @@ GC::Ref<WebIDL::Promise> IDBFactory::databases()
         //    If this cannot be determined for any reason, then reject p with an appropriate error (e.g. an "UnknownError" DOMException) and terminate these steps.
         auto databases = Database::for_key(storage_key);
 
-        // 2. Let result be a new list.
-        auto result = MUST(JS::Array::create(realm, databases.size()));
+        // NOTE: Databases from previous sessions are only read from disk once they're opened, so we list them separately.
+        auto unloaded_databases = Database::unloaded_databases_for_key(realm, storage_key);
 
-        // 3. For each db of databases:
-        for (u32 i = 0; i < databases.size(); ++i) {
-            auto& db = databases[i];
+        // 2. Let result be a new list.
+        auto result = MUST(JS::Array::create(realm, 0));
+        u32 result_size = 0;
 
+        auto append_info = [&](String const& name, u64 version) {
             // 1. If db’s version is 0, then continue.
-            if (db->version() == 0)
-                continue;
+            if (version == 0)
+                return;
 
             // 2. Let info be a new IDBDatabaseInfo dictionary.
             auto info = JS::Object::create(realm, realm.intrinsics().object_prototype());
 
             // 3. Set info’s name dictionary member to db’s name.
-            MUST(info->create_data_property("name"_utf16_fly_string, JS::PrimitiveString::create(realm.vm(), db->name())));
+            MUST(info->create_data_property("name"_utf16_fly_string, JS::PrimitiveString::create(realm.vm(), name)));
 
             // 4. Set info’s version dictionary member to db’s version.
-            MUST(info->create_data_property("version"_utf16_fly_string, JS::Value(db->version())));
+            MUST(info->create_data_property("version"_utf16_fly_string, JS::Value(version)));
 
             // 4. Append info to result.
-            MUST(result->create_data_property_or_throw(i, info));
-        }
+            MUST(result->create_data_property_or_throw(result_size++, info));
+        };
+
+        // 3. For each db of databases:
+        for (auto const& db : databases)
+            append_info(db->name(), db->version());
+        for (auto const& db : unloaded_databases)
+            append_info(db.name, db.version);
 
         // 4. Resolve p with result.
         WebIDL::resolve_promise(realm, p, result);
@@ -183,7 +183,7 @@ WebIDL::ExceptionOr<GC::Ref<IDBIndex>> IDBObjectStore::create_index(String const
 
     // 11. Let index be a new index in store.
     //     Set index’s name to name, key path to keyPath, unique flag to unique, and multiEntry flag to multiEntry.
-    auto index = Index::create(realm, store, name, key_path, unique, multi_entry);
+    auto index = Index::create(realm, store, store->database()->allocate_id(), name, key_path, unique, multi_entry);
 
     // 12. Add index to this's index set.
     this->index_set().set(name, index);
@@ -246,7 +246,7 @@ WebIDL::ExceptionOr<void> IDBObjectStore::delete_index(String const& name)
     m_indexes.remove(name);
 
     // 8. Destroy index.
-    store->index_set().remove(name);
+    store->remove_index(*index);
 
     return {};
 }
@@ -17,7 +17,9 @@ namespace Web::IndexedDB {
 // https://w3c.github.io/IndexedDB/#object-store-record
 struct ObjectStoreRecord {
     GC::Ref<Key> key;
-    HTML::SerializationRecord value;
+
+    // NOTE: This is empty for records read back from disk until the value is needed. Use ObjectStore::value_of() to read it.
+    mutable Optional<ByteBuffer> value;
 };
 
 // https://w3c.github.io/IndexedDB/#index-list-of-records
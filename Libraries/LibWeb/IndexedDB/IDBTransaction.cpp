@@ -48,6 +48,7 @@ void IDBTransaction::visit_edges(Visitor& visitor)
     visitor.visit(m_associated_request);
     visitor.visit(m_scope);
     visitor.visit(m_cleanup_event_loop);
+    m_changes.visit_edges(visitor);
 }
 
 void IDBTransaction::set_onabort(WebIDL::CallbackType* event_handler)
@@ -17,6 +17,7 @@
 #include <LibWeb/IndexedDB/IDBRequest.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
 #include <LibWeb/IndexedDB/Internal/RequestList.h>
+#include <LibWeb/IndexedDB/Internal/TransactionChanges.h>
 
 namespace Web::IndexedDB {
 
@@ -45,6 +46,7 @@ public:
     [[nodiscard]] bool aborted() const { return m_aborted; }
     [[nodiscard]] GC::Ref<HTML::DOMStringList> object_store_names();
     [[nodiscard]] RequestList& request_list() { return m_request_list; }
+    [[nodiscard]] TransactionChanges& changes() { return m_changes; }
     [[nodiscard]] ReadonlySpan<GC::Ref<ObjectStore>> scope() const { return m_scope; }
     [[nodiscard]] String uuid() const { return m_uuid; }
     [[nodiscard]] GC::Ptr<HTML::EventLoop> cleanup_event_loop() const { return m_cleanup_event_loop; }
@@ -111,6 +113,9 @@ private:
     // A transaction has a request list of pending requests which have been made against the transaction.
     RequestList m_request_list;
 
+    // AD-HOC: The changes this transaction made to the database, so they can be written to disk or reverted.
+    TransactionChanges m_changes;
+
     // A transaction optionally has a cleanup event loop which is an event loop.
     GC::Ptr<HTML::EventLoop> m_cleanup_event_loop;
 
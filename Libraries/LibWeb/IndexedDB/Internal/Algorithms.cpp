@@ -74,6 +74,8 @@ WebIDL::ExceptionOr<GC::Ref<IDBDatabase>> open_a_database_connection(JS::Realm&
     // 4. Let db be the database named name in storageKey, or null otherwise.
     GC::Ptr<Database> db;
     auto maybe_db = Database::for_key_and_name(storage_key, name);
+    if (!maybe_db.has_value())
+        maybe_db = Database::load_for_key_and_name(realm, storage_key, name);
     if (maybe_db.has_value()) {
         db = maybe_db.value();
     }
@@ -458,6 +460,8 @@ WebIDL::ExceptionOr<u64> delete_a_database(JS::Realm& realm, StorageAPI::Storage
 
     // 4. Let db be the database named name in storageKey, if one exists. Otherwise, return 0 (zero).
     auto maybe_db = Database::for_key_and_name(storage_key, name);
+    if (!maybe_db.has_value())
+        maybe_db = Database::load_for_key_and_name(realm, storage_key, name);
     if (!maybe_db.has_value())
         return 0;
 
@@ -542,9 +546,10 @@ void abort_a_transaction(GC::Ref<IDBTransaction> transaction, GC::Ptr<WebIDL::DO
     if (transaction->is_finished())
         return;
 
-    // FIXME: 2. All the changes made to the database by the transaction are reverted.
+    // 2. All the changes made to the database by the transaction are reverted.
     // For upgrade transactions this includes changes to the set of object stores and indexes, as well as the change to the version.
     // Any object stores and indexes which were created during the transaction are now considered deleted for the purposes of other algorithms.
+    transaction->changes().revert();
 
     // FIXME: 3. If transaction is an upgrade transaction, run the steps to abort an upgrade transaction with transaction.
     // if (transaction.is_upgrade_transaction())
@@ -558,7 +563,8 @@ void abort_a_transaction(GC::Ref<IDBTransaction> transaction, GC::Ptr<WebIDL::DO
 
     // 6. For each request of transaction’s request list,
     for (auto const& request : transaction->request_list()) {
-        // FIXME: abort the steps to asynchronously execute a request for request,
+        // abort the steps to asynchronously execute a request for request,
+        // NOTE: Those steps stop on their own once they see that transaction is finished.
 
         // set request’s processed flag to true
         request->set_processed(true);
@@ -770,7 +776,12 @@ void commit_a_transaction(JS::Realm& realm, GC::Ref<IDBTransaction> transaction)
         if (transaction->state() != IDBTransaction::TransactionState::Committing)
             return;
 
-        // FIXME: 3. Attempt to write any outstanding changes made by transaction to the database, considering transaction’s durability hint.
+        // 3. Attempt to write any outstanding changes made by transaction to the database, considering transaction’s durability hint.
+        // FIXME: Consider the durability hint.
+        // NOTE: Read-only transactions can't have made any changes.
+        if (transaction->mode() != Bindings::IDBTransactionMode::Readonly)
+            transaction->connection()->associated_database()->write_changes_to_disk(*transaction);
+
         // FIXME: 4. If an error occurs while writing the changes to the database, then run abort a transaction with transaction and an appropriate type for the error, for example "QuotaExceededError" or "UnknownError" DOMException, and terminate these steps.
 
         // 5. Queue a database task to run these steps:
@@ -1173,8 +1184,16 @@ GC::Ref<IDBRequest> asynchronously_execute_a_request(JS::Realm& realm, IDBReques
             return transaction->request_list().all_previous_requests_processed(request);
         }));
 
+        // AD-HOC: If transaction was aborted in the meantime, these steps were aborted with it.
+        if (transaction->is_finished())
+            return;
+
         // 2. Let result be the result of performing operation.
+        auto database = transaction->connection()->associated_database();
+        auto change_count_before_operation = transaction->changes().size();
+        database->set_transaction_executing_request(transaction);
         auto result = operation->function()();
+        database->set_transaction_executing_request(nullptr);
 
         // 3. If result is an error and transaction’s state is committing, then run abort a transaction with transaction and result, and terminate these steps.
         if (result.is_error() && transaction->state() == IDBTransaction::TransactionState::Committing) {
@@ -1182,7 +1201,9 @@ GC::Ref<IDBRequest> asynchronously_execute_a_request(JS::Realm& realm, IDBReques
             return;
         }
 
-        // FIXME: 4. If result is an error, then revert all changes made by operation.
+        // 4. If result is an error, then revert all changes made by operation.
+        if (result.is_error())
+            transaction->changes().revert_to(change_count_before_operation);
 
         // 5. Set request’s processed flag to true.
         request->set_processed(true);
@@ -1226,7 +1247,7 @@ GC::Ref<IDBRequest> asynchronously_execute_a_request(JS::Realm& realm, IDBReques
 ErrorOr<u64> generate_a_key(GC::Ref<ObjectStore> store)
 {
     // 1. Let generator be store’s key generator.
-    auto& generator = store->key_generator();
+    auto const& generator = store->key_generator();
 
     // 2. Let key be generator’s current number.
     auto key = generator.current_number();
@@ -1236,7 +1257,7 @@ ErrorOr<u64> generate_a_key(GC::Ref<ObjectStore> store)
         return Error::from_string_literal("Key is greater than 2^53 while trying to generate a key");
 
     // 4. Increase generator’s current number by 1.
-    generator.increment(1);
+    store->set_key_generator_current_number(key + 1);
 
     // 5. Return key.
     return key;
@@ -1259,11 +1280,11 @@ void possibly_update_the_key_generator(GC::Ref<ObjectStore> store, GC::Ref<Key>
     u64 value = floor(temp_value);
 
     // 5. Let generator be store’s key generator.
-    auto& generator = store->key_generator();
+    auto const& generator = store->key_generator();
 
     // 6. If value is greater than or equal to generator’s current number, then set generator’s current number to value + 1.
     if (value >= generator.current_number())
-        generator.set(value + 1);
+        store->set_key_generator_current_number(value + 1);
 }
 
 // https://w3c.github.io/IndexedDB/#inject-a-key-into-a-value-using-a-key-path
@@ -1373,9 +1394,10 @@ WebIDL::ExceptionOr<GC::Ptr<Key>> store_a_record_into_an_object_store(JS::Realm&
 
     // 4. Store a record in store containing key as its key and ! StructuredSerializeForStorage(value) as its value.
     //    The record is stored in the object store’s list of records such that the list is sorted according to the key of the records in ascending order.
+    auto serialized = MUST(HTML::structured_serialize_for_storage(realm.vm(), value));
     ObjectStoreRecord record = {
         .key = *key,
-        .value = MUST(HTML::structured_serialize_for_storage(realm.vm(), value)),
+        .value = MUST(ByteBuffer::copy(serialized.span())),
     };
     store->store_a_record(record);
 
@@ -1503,7 +1525,7 @@ WebIDL::ExceptionOr<JS::Value> retrieve_a_value_from_an_object_store(JS::Realm&
         return JS::js_undefined();
 
     // 3. Let serialized be record’s value. If an error occurs while reading the value from the underlying storage, return a newly created "NotReadableError" DOMException.
-    auto serialized = record->value;
+    auto serialized = store->value_of(*record);
 
     // 4. Return ! StructuredDeserialize(serialized, targetRealm).
     return MUST(HTML::structured_deserialize(realm.vm(), serialized, realm));
@@ -1524,13 +1546,8 @@ GC::Ptr<IDBCursor> iterate_a_cursor(JS::Realm& realm, GC::Ref<IDBCursor> cursor,
         VERIFY(source.has<GC::Ref<Index>>() && direction_is_next_or_prev);
 
     // 4. Let records be the list of records in source.
-    Variant<ReadonlySpan<ObjectStoreRecord>, ReadonlySpan<IndexRecord>> records = source.visit(
-        [](GC::Ref<ObjectStore> object_store) -> Variant<ReadonlySpan<ObjectStoreRecord>, ReadonlySpan<IndexRecord>> {
-            return object_store->records();
-        },
-        [](GC::Ref<Index> index) -> Variant<ReadonlySpan<ObjectStoreRecord>, ReadonlySpan<IndexRecord>> {
-            return index->records();
-        });
+    // NOTE: Records are ordered by key, so instead of going through all of them, the searches below start at the first
+    //       record that could satisfy the requirements, and stop at the first record outside of range.
 
     // 5. Let range be cursor’s range.
     auto range = cursor->range();
@@ -1736,6 +1753,63 @@ GC::Ptr<IDBCursor> iterate_a_cursor(JS::Realm& realm, GC::Ref<IDBCursor> cursor,
         return is_in_range;
     };
 
+    // Every set of requirements includes the record’s key being in range, and not being beyond key or position.
+    auto is_below_range = [&](GC::Ref<Key> record_key) {
+        auto lower_key = range->lower_key();
+        return lower_key && (Key::less_than(record_key, *lower_key) || (range->lower_open() && Key::equals(record_key, *lower_key)));
+    };
+
+    auto is_above_range = [&](GC::Ref<Key> record_key) {
+        auto upper_key = range->upper_key();
+        return upper_key && (Key::greater_than(record_key, *upper_key) || (range->upper_open() && Key::equals(record_key, *upper_key)));
+    };
+
+    auto lowest_possible_key = [&]() {
+        GC::Ptr<Key> lowest_key = range->lower_key();
+        for (auto candidate : { key, position }) {
+            if (candidate && (!lowest_key || Key::greater_than(*candidate, *lowest_key)))
+                lowest_key = candidate;
+        }
+        return lowest_key;
+    };
+
+    auto highest_possible_key = [&]() {
+        GC::Ptr<Key> highest_key = range->upper_key();
+        for (auto candidate : { key, position }) {
+            if (candidate && (!highest_key || Key::less_than(*candidate, *highest_key)))
+                highest_key = candidate;
+        }
+        return highest_key;
+    };
+
+    auto find_first_record = [&](auto const& requirements) {
+        return source.visit([&](auto store_or_index) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
+            auto lowest_key = lowest_possible_key();
+            for (auto it = lowest_key ? store_or_index->lower_bound(*lowest_key) : store_or_index->records().begin(); !it.is_end(); ++it) {
+                if (is_above_range(it->key))
+                    break;
+                if (requirements(*it))
+                    return *it;
+            }
+            return Empty {};
+        });
+    };
+
+    auto find_last_record = [&](auto const& requirements) {
+        return source.visit([&](auto store_or_index) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
+            auto highest_key = highest_possible_key();
+            auto it = highest_key ? store_or_index->upper_bound(*highest_key) : store_or_index->records().end();
+            while (it != store_or_index->records().begin()) {
+                --it;
+                if (is_below_range(it->key))
+                    break;
+                if (requirements(*it))
+                    return *it;
+            }
+            return Empty {};
+        });
+    };
+
     // 9. While count is greater than 0:
     Variant<Empty, ObjectStoreRecord, IndexRecord> found_record;
     while (count > 0) {
@@ -1743,47 +1817,23 @@ GC::Ptr<IDBCursor> iterate_a_cursor(JS::Realm& realm, GC::Ref<IDBCursor> cursor,
         switch (direction) {
         case Bindings::IDBCursorDirection::Next: {
             // Let found record be the first record in records which satisfy all of the following requirements:
-            found_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                auto value = content.first_matching(next_requirements);
-                if (value.has_value())
-                    return *value;
-
-                return Empty {};
-            });
+            found_record = find_first_record(next_requirements);
             break;
         }
         case Bindings::IDBCursorDirection::Nextunique: {
             // Let found record be the first record in records which satisfy all of the following requirements:
-            found_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                auto value = content.first_matching(next_unique_requirements);
-                if (value.has_value())
-                    return *value;
-
-                return Empty {};
-            });
+            found_record = find_first_record(next_unique_requirements);
             break;
         }
         case Bindings::IDBCursorDirection::Prev: {
             // Let found record be the last record in records which satisfy all of the following requirements:
-            found_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                auto value = content.last_matching(prev_requirements);
-                if (value.has_value())
-                    return *value;
-
-                return Empty {};
-            });
+            found_record = find_last_record(prev_requirements);
             break;
         }
 
         case Bindings::IDBCursorDirection::Prevunique: {
             // Let temp record be the last record in records which satisfy all of the following requirements:
-            auto temp_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                auto value = content.last_matching(prev_unique_requirements);
-                if (value.has_value())
-                    return *value;
-
-                return Empty {};
-            });
+            auto temp_record = find_last_record(prev_unique_requirements);
 
             // If temp record is defined, let found record be the first record in records whose key is equal to temp record’s key.
             if (!temp_record.has<Empty>()) {
@@ -1791,12 +1841,10 @@ GC::Ptr<IDBCursor> iterate_a_cursor(JS::Realm& realm, GC::Ref<IDBCursor> cursor,
                     [](Empty) -> GC::Ref<Key> { VERIFY_NOT_REACHED(); },
                     [](auto const& record) { return record.key; });
 
-                found_record = records.visit([&](auto content) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
-                    auto value = content.first_matching([&](auto const& content_record) {
-                        return Key::equals(content_record.key, temp_record_key);
-                    });
-                    if (value.has_value())
-                        return *value;
+                found_record = source.visit([&](auto store_or_index) -> Variant<Empty, ObjectStoreRecord, IndexRecord> {
+                    auto it = store_or_index->lower_bound(temp_record_key);
+                    if (!it.is_end() && Key::equals(it->key, temp_record_key))
+                        return *it;
 
                     return Empty {};
                 });
@@ -1853,8 +1901,8 @@ GC::Ptr<IDBCursor> iterate_a_cursor(JS::Realm& realm, GC::Ref<IDBCursor> cursor,
 
         // 1. Let serialized be found record’s value if source is an object store, or found record’s referenced value otherwise.
         auto serialized = source.visit(
-            [&](GC::Ref<ObjectStore>) {
-                return found_record.get<ObjectStoreRecord>().value;
+            [&](GC::Ref<ObjectStore> store) {
+                return store->value_of(found_record.get<ObjectStoreRecord>());
             },
             [&](GC::Ref<Index> index) {
                 return index->referenced_value(found_record.get<IndexRecord>());
@@ -1918,7 +1966,7 @@ GC::Ref<JS::Array> retrieve_multiple_values_from_an_object_store(JS::Realm& real
         auto& record = records[i];
 
         // 1. Let serialized be record’s value. If an error occurs while reading the value from the underlying storage, return a newly created "NotReadableError" DOMException.
-        auto serialized = record.value;
+        auto serialized = store->value_of(record);
 
         // 2. Let entry be ! StructuredDeserialize(serialized, targetRealm).
         auto entry = MUST(HTML::structured_deserialize(realm.vm(), serialized, realm));
@@ -1969,7 +2017,7 @@ GC::Ref<JS::Array> retrieve_multiple_items_from_an_object_store(JS::Realm& realm
         }
         case RecordKind::Value: {
             // 1. Let serialized be record’s value.
-            auto serialized = record.value;
+            auto serialized = store->value_of(record);
 
             // 2. Let value be ! StructuredDeserialize(serialized, targetRealm).
             auto entry = MUST(HTML::structured_deserialize(realm.vm(), serialized, realm));
@@ -1983,7 +2031,7 @@ GC::Ref<JS::Array> retrieve_multiple_items_from_an_object_store(JS::Realm& realm
             auto key = record.key;
 
             // 2. Let serialized be record’s value.
-            auto serialized = record.value;
+            auto serialized = store->value_of(record);
 
             // 3. Let value be ! StructuredDeserialize(serialized, targetRealm).
             auto value = MUST(HTML::structured_deserialize(realm.vm(), serialized, realm));
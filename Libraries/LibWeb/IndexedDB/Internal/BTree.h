@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+
+namespace Web::IndexedDB {
+
+// An ordered B+ tree. Entries only live in the leaves, which are linked together, so iterating in either direction never
+// has to go back up the tree. Internal nodes hold copies of entry keys, which are only used to find the right leaf.
+//
+// Traits must provide:
+// - KeyType, a cheap to copy key for the entries.
+// - static KeyType key_of(T const&)
+// - static int compare(KeyType const&, KeyType const&)
+//
+// Entries with equal keys are kept in insertion order.
+template<typename T, typename Traits>
+class BTree {
+    AK_MAKE_NONCOPYABLE(BTree);
+    AK_MAKE_NONMOVABLE(BTree);
+
+    struct LeafNode;
+
+public:
+    using KeyType = typename Traits::KeyType;
+
+    class Iterator {
+    public:
+        T const& operator*() const { return m_leaf->entries[m_index]; }
+        T const* operator->() const { return &m_leaf->entries[m_index]; }
+
+        bool is_end() const { return !m_leaf; }
+        bool operator==(Iterator const&) const = default;
+
+        Iterator& operator++()
+        {
+            VERIFY(m_leaf);
+            if (++m_index == m_leaf->entries.size()) {
+                m_leaf = m_leaf->next;
+                m_index = 0;
+            }
+            return *this;
+        }
+
+        Iterator& operator--()
+        {
+            if (!m_leaf) {
+                m_leaf = m_tree->m_last_leaf;
+                VERIFY(!m_leaf->entries.is_empty());
+                m_index = m_leaf->entries.size() - 1;
+            } else if (m_index == 0) {
+                m_leaf = m_leaf->previous;
+                VERIFY(m_leaf);
+                m_index = m_leaf->entries.size() - 1;
+            } else {
+                --m_index;
+            }
+            return *this;
+        }
+
+    private:
+        friend class BTree;
+
+        Iterator(BTree const& tree, LeafNode* leaf, size_t index)
+            : m_tree(&tree)
+            , m_leaf(leaf)
+            , m_index(index)
+        {
+            // Positions past the end of a leaf refer to the start of the next one.
+            if (m_leaf && m_index >= m_leaf->entries.size()) {
+                m_leaf = m_leaf->next;
+                m_index = 0;
+            }
+        }
+
+        BTree const* m_tree { nullptr };
+        LeafNode* m_leaf { nullptr };
+        size_t m_index { 0 };
+    };
+
+    BTree() { clear(); }
+
+    size_t size() const { return m_size; }
+    bool is_empty() const { return m_size == 0; }
+
+    Iterator begin() const { return { *this, m_first_leaf, 0 }; }
+    Iterator end() const { return { *this, nullptr, 0 }; }
+
+    // Returns the first entry whose key compares as greater than or equal to the target.
+    // The callback returns a negative number, zero or a positive number if the given key is less than, equal to or greater than the target.
+    template<typename Compare>
+    Iterator lower_bound(Compare compare) const
+    {
+        return find_position([&](KeyType const& key) { return compare(key) < 0; });
+    }
+
+    // Returns the first entry whose key compares as greater than the target.
+    template<typename Compare>
+    Iterator upper_bound(Compare compare) const
+    {
+        return find_position([&](KeyType const& key) { return compare(key) <= 0; });
+    }
+
+    Iterator find(KeyType const& key) const
+    {
+        auto it = lower_bound([&](KeyType const& other) { return Traits::compare(other, key); });
+        if (it.is_end() || Traits::compare(Traits::key_of(*it), key) != 0)
+            return end();
+        return it;
+    }
+
+    void insert(T entry)
+    {
+        auto key = Traits::key_of(entry);
+        auto is_before_entry = [&](KeyType const& other) { return Traits::compare(other, key) <= 0; };
+
+        auto* node = m_root.ptr();
+        while (!node->is_leaf)
+            node = static_cast<InternalNode&>(*node).child_for(is_before_entry);
+
+        auto& leaf = static_cast<LeafNode&>(*node);
+        leaf.entries.insert(leaf.index_for(is_before_entry), move(entry));
+        ++m_size;
+
+        if (leaf.entries.size() > max_entries_per_node)
+            split_leaf(leaf);
+    }
+
+    // Returns the position of the entry that followed the removed one.
+    Iterator remove(Iterator position)
+    {
+        VERIFY(position.m_tree == this && !position.is_end());
+        auto& leaf = *position.m_leaf;
+        leaf.entries.remove(position.m_index);
+        --m_size;
+
+        if (!leaf.entries.is_empty() || &leaf == m_root.ptr())
+            return { *this, &leaf, position.m_index };
+
+        auto* next = leaf.next;
+        remove_empty_leaf(leaf);
+        return { *this, next, 0 };
+    }
+
+    template<typename Predicate>
+    size_t remove_all_matching(Predicate predicate)
+    {
+        size_t removed_count = 0;
+        for (auto it = begin(); !it.is_end();) {
+            if (predicate(*it)) {
+                it = remove(it);
+                ++removed_count;
+            } else {
+                ++it;
+            }
+        }
+        return removed_count;
+    }
+
+    void clear()
+    {
+        auto root = make<LeafNode>();
+        m_first_leaf = root.ptr();
+        m_last_leaf = root.ptr();
+        m_root = move(root);
+        m_size = 0;
+    }
+
+    // Calls the callback for every key held by internal nodes. These may belong to entries that have since been removed.
+    template<typename Callback>
+    void for_each_separator(Callback callback) const
+    {
+        for_each_separator_in(*m_root, callback);
+    }
+
+private:
+    // Nodes are split once they have more than this many entries or children.
+    static constexpr size_t max_entries_per_node = 64;
+
+    struct InternalNode;
+
+    struct Node {
+        explicit Node(bool is_leaf)
+            : is_leaf(is_leaf)
+        {
+        }
+        virtual ~Node() = default;
+
+        bool is_leaf { false };
+        InternalNode* parent { nullptr };
+    };
+
+    struct LeafNode final : public Node {
+        LeafNode()
+            : Node(true)
+        {
+        }
+
+        // Returns the index of the first entry for which the predicate is false.
+        template<typename Predicate>
+        size_t index_for(Predicate is_before) const
+        {
+            size_t low = 0;
+            size_t high = entries.size();
+            while (low < high) {
+                auto middle = low + (high - low) / 2;
+                if (is_before(Traits::key_of(entries[middle])))
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            return low;
+        }
+
+        Vector<T> entries;
+        LeafNode* previous { nullptr };
+        LeafNode* next { nullptr };
+    };
+
+    struct InternalNode final : public Node {
+        InternalNode()
+            : Node(false)
+        {
+        }
+
+        // Returns the child after the last separator for which the predicate is true.
+        template<typename Predicate>
+        Node* child_for(Predicate is_before) const
+        {
+            size_t low = 0;
+            size_t high = separators.size();
+            while (low < high) {
+                auto middle = low + (high - low) / 2;
+                if (is_before(separators[middle]))
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            return children[low].ptr();
+        }
+
+        size_t index_of(Node const& child) const
+        {
+            for (size_t i = 0; i < children.size(); ++i) {
+                if (children[i].ptr() == &child)
+                    return i;
+            }
+            VERIFY_NOT_REACHED();
+        }
+
+        // No key in children[i] is greater than separators[i], and no key in children[i + 1] is less than it.
+        Vector<KeyType> separators;
+        Vector<NonnullOwnPtr<Node>> children;
+    };
+
+    template<typename Predicate>
+    Iterator find_position(Predicate is_before) const
+    {
+        auto* node = m_root.ptr();
+        while (!node->is_leaf)
+            node = static_cast<InternalNode&>(*node).child_for(is_before);
+
+        auto& leaf = static_cast<LeafNode&>(*node);
+        return { *this, &leaf, leaf.index_for(is_before) };
+    }
+
+    void split_leaf(LeafNode& leaf)
+    {
+        auto new_leaf = make<LeafNode>();
+        auto middle = leaf.entries.size() / 2;
+        new_leaf->entries.ensure_capacity(leaf.entries.size() - middle);
+        for (size_t i = middle; i < leaf.entries.size(); ++i)
+            new_leaf->entries.unchecked_append(move(leaf.entries[i]));
+        leaf.entries.shrink(middle, true);
+
+        new_leaf->previous = &leaf;
+        new_leaf->next = leaf.next;
+        if (leaf.next)
+            leaf.next->previous = new_leaf.ptr();
+        else
+            m_last_leaf = new_leaf.ptr();
+        leaf.next = new_leaf.ptr();
+
+        auto separator = Traits::key_of(new_leaf->entries.first());
+        insert_into_parent(leaf, move(separator), move(new_leaf));
+    }
+
+    void split_internal_node(InternalNode& node)
+    {
+        auto new_node = make<InternalNode>();
+        auto middle = node.children.size() / 2;
+
+        for (size_t i = middle; i < node.children.size(); ++i) {
+            node.children[i]->parent = new_node.ptr();
+            new_node->children.append(move(node.children[i]));
+        }
+        for (size_t i = middle; i < node.separators.size(); ++i)
+            new_node->separators.append(move(node.separators[i]));
+
+        auto separator = move(node.separators[middle - 1]);
+        node.children.shrink(middle, true);
+        node.separators.shrink(middle - 1, true);
+
+        insert_into_parent(node, move(separator), move(new_node));
+    }
+
+    void insert_into_parent(Node& left, KeyType separator, NonnullOwnPtr<Node> right)
+    {
+        if (!left.parent) {
+            VERIFY(&left == m_root.ptr());
+            auto new_root = make<InternalNode>();
+            left.parent = new_root.ptr();
+            right->parent = new_root.ptr();
+            new_root->children.append(m_root.release_nonnull());
+            new_root->children.append(move(right));
+            new_root->separators.append(move(separator));
+            m_root = move(new_root);
+            return;
+        }
+
+        auto& parent = *left.parent;
+        auto index = parent.index_of(left);
+        right->parent = &parent;
+        parent.separators.insert(index, move(separator));
+        parent.children.insert(index + 1, move(right));
+
+        if (parent.children.size() > max_entries_per_node)
+            split_internal_node(parent);
+    }
+
+    // NOTE: Nodes are only removed once they become empty, and are never merged with their siblings.
+    //       This keeps removal simple, at the cost of a tree that shrinks a lot keeping its height.
+    void remove_empty_leaf(LeafNode& leaf)
+    {
+        if (leaf.previous)
+            leaf.previous->next = leaf.next;
+        else
+            m_first_leaf = leaf.next;
+        if (leaf.next)
+            leaf.next->previous = leaf.previous;
+        else
+            m_last_leaf = leaf.previous;
+
+        remove_child(*leaf.parent, leaf);
+    }
+
+    void remove_child(InternalNode& parent, Node& child)
+    {
+        auto index = parent.index_of(child);
+
+        // Either separator around the child still bounds its neighbours once it's gone.
+        if (!parent.separators.is_empty())
+            parent.separators.remove(index > 0 ? index - 1 : 0);
+        parent.children.remove(index);
+
+        if (parent.children.is_empty()) {
+            VERIFY(parent.parent);
+            remove_child(*parent.parent, parent);
+            return;
+        }
+
+        while (!m_root->is_leaf) {
+            auto& root = static_cast<InternalNode&>(*m_root);
+            if (root.children.size() > 1)
+                break;
+            auto new_root = root.children.take_first();
+            new_root->parent = nullptr;
+            m_root = move(new_root);
+        }
+    }
+
+    template<typename Callback>
+    static void for_each_separator_in(Node const& node, Callback& callback)
+    {
+        if (node.is_leaf)
+            return;
+        auto const& internal_node = static_cast<InternalNode const&>(node);
+        for (auto const& separator : internal_node.separators)
+            callback(separator);
+        for (auto const& child : internal_node.children)
+            for_each_separator_in(*child, callback);
+    }
+
+    OwnPtr<Node> m_root;
+    LeafNode* m_first_leaf { nullptr };
+    LeafNode* m_last_leaf { nullptr };
+    size_t m_size { 0 };
+};
+
+}
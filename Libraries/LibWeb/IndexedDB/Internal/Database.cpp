@@ -4,10 +4,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/HTML/StructuredSerialize.h>
+#include <LibWeb/HTML/Window.h>
 #include <LibWeb/IndexedDB/IDBTransaction.h>
 #include <LibWeb/IndexedDB/Internal/ConnectionQueueHandler.h>
 #include <LibWeb/IndexedDB/Internal/Database.h>
+#include <LibWeb/IndexedDB/Internal/Index.h>
 #include <LibWeb/IndexedDB/Internal/RequestList.h>
+#include <LibWeb/Page/Page.h>
 
 namespace Web::IndexedDB {
 
@@ -27,9 +31,17 @@ GC_DEFINE_ALLOCATOR(Database);
 
 Database::~Database() = default;
 
-GC::Ref<Database> Database::create(JS::Realm& realm, String const& name)
+GC::Ref<Database> Database::create(JS::Realm& realm, StorageAPI::StorageKey const& storage_key, String const& name)
 {
-    return realm.create<Database>(realm, name);
+    return realm.create<Database>(realm, storage_key, name);
+}
+
+// NOTE: Databases are written to disk by the page's client. Databases used from workers are only kept in memory.
+static Page* page_for_realm(JS::Realm& realm)
+{
+    if (auto* window = as_if<HTML::Window>(realm.global_object()))
+        return &window->page();
+    return nullptr;
 }
 
 void Database::visit_edges(Visitor& visitor)
@@ -37,9 +49,36 @@ void Database::visit_edges(Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_associated_connections);
     visitor.visit(m_upgrade_transaction);
+    visitor.visit(m_transaction_executing_request);
     visitor.visit(m_object_stores);
 }
 
+void Database::set_version(u64 version)
+{
+    record_change(TransactionChanges::VersionChanged { *this, m_version });
+    m_version = version;
+}
+
+void Database::add_object_store(GC::Ref<ObjectStore> object_store)
+{
+    record_change(TransactionChanges::ObjectStoreCreated { object_store });
+    m_object_stores.append(object_store);
+}
+
+void Database::remove_object_store(GC::Ref<ObjectStore> object_store)
+{
+    record_change(TransactionChanges::ObjectStoreDeleted { object_store });
+    m_object_stores.remove_first_matching([&](auto& entry) { return entry == object_store; });
+}
+
+void Database::record_change(TransactionChanges::Change change)
+{
+    // NOTE: Nothing is recorded while a database is being read back from disk.
+    auto transaction = m_transaction_executing_request ? m_transaction_executing_request : m_upgrade_transaction;
+    if (transaction)
+        transaction->changes().append(move(change));
+}
+
 GC::Ptr<ObjectStore> Database::object_store_with_name(String const& name) const
 {
     for (auto const& object_store : m_object_stores) {
@@ -84,7 +123,7 @@ ErrorOr<GC::Root<Database>> Database::create_for_key_and_name(JS::Realm& realm,
         return HashMap<String, GC::Root<Database>>();
     }));
 
-    auto value = Database::create(realm, name);
+    auto value = Database::create(realm, key, name);
 
     database_mapping.set(name, value);
     m_databases.set(key, database_mapping);
@@ -104,6 +143,9 @@ ErrorOr<void> Database::delete_for_key_and_name(StorageAPI::StorageKey& key, Str
     if (!maybe_database.has_value())
         return {};
 
+    if (auto* page = page_for_realm(maybe_database.value()->realm()))
+        page->client().page_did_delete_indexed_db_database(key.to_string(), name);
+
     auto did_remove = database_mapping.remove(name);
     if (!did_remove)
         return {};
@@ -113,4 +155,114 @@ ErrorOr<void> Database::delete_for_key_and_name(StorageAPI::StorageKey& key, Str
     return {};
 }
 
+Optional<GC::Root<Database> const&> Database::load_for_key_and_name(JS::Realm& realm, StorageAPI::StorageKey& key, String& name)
+{
+    auto* page = page_for_realm(realm);
+    if (!page)
+        return {};
+
+    auto contents = page->client().page_did_request_indexed_db_database(key.to_string(), name);
+    if (!contents.has_value())
+        return {};
+
+    auto database = MUST(create_for_key_and_name(realm, key, name));
+    database->set_version(contents->database.version);
+
+    HashMap<u64, GC::Ref<ObjectStore>> object_stores;
+    HashMap<u64, GC::Ref<Index>> indexes;
+
+    for (auto const& persisted_object_store : contents->database.object_stores) {
+        auto auto_increment = persisted_object_store.key_generator_current_number.has_value();
+        auto object_store = ObjectStore::create(realm, *database, persisted_object_store.id, persisted_object_store.name, auto_increment, persisted_object_store.key_path);
+        if (auto_increment)
+            object_store->set_key_generator_current_number(*persisted_object_store.key_generator_current_number);
+
+        object_stores.set(object_store->id(), object_store);
+        database->m_next_id = max(database->m_next_id, object_store->id() + 1);
+
+        for (auto const& persisted_index : persisted_object_store.indexes) {
+            auto index = Index::create(realm, object_store, persisted_index.id, persisted_index.name, persisted_index.key_path, persisted_index.unique, persisted_index.multi_entry);
+
+            indexes.set(index->id(), index);
+            database->m_next_id = max(database->m_next_id, index->id() + 1);
+        }
+    }
+
+    for (auto const& record : contents->records) {
+        auto object_store = object_stores.get(record.source_id);
+        auto key = Key::decode(realm, record.key);
+        if (!object_store.has_value() || key.is_error()) {
+            dbgln("IndexedDB: Ignoring invalid record in database '{}'", name);
+            continue;
+        }
+        object_store.value()->load_record(key.release_value());
+    }
+
+    for (auto const& record : contents->index_records) {
+        auto index = indexes.get(record.source_id);
+        auto key = Key::decode(realm, record.key);
+        auto value = Key::decode(realm, record.value);
+        if (!index.has_value() || key.is_error() || value.is_error()) {
+            dbgln("IndexedDB: Ignoring invalid index record in database '{}'", name);
+            continue;
+        }
+        index.value()->load_record({ key.release_value(), value.release_value() });
+    }
+
+    return for_key_and_name(key, name);
+}
+
+Vector<PersistedDatabase> Database::unloaded_databases_for_key(JS::Realm& realm, StorageAPI::StorageKey const& key)
+{
+    auto* page = page_for_realm(realm);
+    if (!page)
+        return {};
+
+    auto databases = page->client().page_did_request_indexed_db_databases(key.to_string());
+
+    if (auto loaded_databases = m_databases.get(key); loaded_databases.has_value()) {
+        databases.remove_all_matching([&](auto const& database) {
+            return loaded_databases->contains(database.name);
+        });
+    }
+
+    return databases;
+}
+
+ByteBuffer Database::load_record_value(ObjectStore const& object_store, GC::Ref<Key> key)
+{
+    auto* page = page_for_realm(realm());
+
+    // NOTE: Records are only missing their value if they were read back from disk, which always goes through a page.
+    VERIFY(page);
+
+    auto value = page->client().page_did_request_indexed_db_record_value(m_storage_key.to_string(), m_name, object_store.id(), key->encode());
+    if (value.has_value())
+        return value.release_value();
+
+    // The record was removed from disk behind our back, e.g. by another process deleting the database.
+    dbgln("IndexedDB: Value of record {} in object store '{}' is missing from disk", key->dump(), object_store.name());
+    auto serialized = MUST(HTML::structured_serialize_for_storage(vm(), JS::js_undefined()));
+    return MUST(ByteBuffer::copy(serialized.span()));
+}
+
+PersistedDatabase Database::to_persisted() const
+{
+    PersistedDatabase database { .name = m_name, .version = m_version, .object_stores = {} };
+    for (auto const& object_store : m_object_stores)
+        database.object_stores.append(object_store->to_persisted());
+    return database;
+}
+
+// Only what the transaction changed is sent, and the page's client applies it in a single disk transaction.
+void Database::write_changes_to_disk(IDBTransaction& transaction)
+{
+    if (transaction.changes().is_empty())
+        return;
+
+    auto changes = transaction.changes().take_persisted_changes(*this);
+    if (auto* page = page_for_realm(realm()))
+        page->client().page_did_commit_indexed_db_changes(m_storage_key.to_string(), m_name, changes);
+}
+
 }
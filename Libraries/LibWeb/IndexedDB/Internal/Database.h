@@ -11,6 +11,8 @@
 #include <LibWeb/IndexedDB/IDBDatabase.h>
 #include <LibWeb/IndexedDB/IDBRequest.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
+#include <LibWeb/IndexedDB/Internal/TransactionChanges.h>
 #include <LibWeb/StorageAPI/StorageKey.h>
 
 namespace Web::IndexedDB {
@@ -21,9 +23,10 @@ class Database : public Bindings::PlatformObject {
     GC_DECLARE_ALLOCATOR(Database);
 
 public:
-    void set_version(u64 version) { m_version = version; }
+    void set_version(u64 version);
     u64 version() const { return m_version; }
     String name() const { return m_name; }
+    StorageAPI::StorageKey const& storage_key() const { return m_storage_key; }
 
     void set_upgrade_transaction(GC::Ptr<IDBTransaction> transaction) { m_upgrade_transaction = transaction; }
     [[nodiscard]] GC::Ptr<IDBTransaction> upgrade_transaction() { return m_upgrade_transaction; }
@@ -42,27 +45,41 @@ public:
 
     ReadonlySpan<GC::Ref<ObjectStore>> object_stores() { return m_object_stores; }
     GC::Ptr<ObjectStore> object_store_with_name(String const& name) const;
-    void add_object_store(GC::Ref<ObjectStore> object_store) { m_object_stores.append(object_store); }
-    void remove_object_store(GC::Ref<ObjectStore> object_store)
-    {
-        m_object_stores.remove_first_matching([&](auto& entry) { return entry == object_store; });
-    }
+    void add_object_store(GC::Ref<ObjectStore>);
+    void remove_object_store(GC::Ref<ObjectStore>);
+
+    // AD-HOC: Object stores and indexes are identified on disk by an ID that is unique within their database.
+    u64 allocate_id() { return m_next_id++; }
+
+    // AD-HOC: Changes are recorded in the transaction whose request is being executed, or otherwise in the upgrade
+    //         transaction, which is the only one that can change the database outside of a request.
+    void set_transaction_executing_request(GC::Ptr<IDBTransaction> transaction) { m_transaction_executing_request = transaction; }
+    void record_change(TransactionChanges::Change);
+
+    ByteBuffer load_record_value(ObjectStore const&, GC::Ref<Key>);
+    void write_changes_to_disk(IDBTransaction&);
+    PersistedDatabase to_persisted() const;
 
     [[nodiscard]] static Vector<GC::Root<Database>> for_key(StorageAPI::StorageKey const&);
     [[nodiscard]] static Optional<GC::Root<Database> const&> for_key_and_name(StorageAPI::StorageKey&, String&);
     [[nodiscard]] static ErrorOr<GC::Root<Database>> create_for_key_and_name(JS::Realm&, StorageAPI::StorageKey&, String&);
     [[nodiscard]] static ErrorOr<void> delete_for_key_and_name(StorageAPI::StorageKey&, String&);
 
+    // Databases from previous sessions stay on disk until they're opened.
+    [[nodiscard]] static Optional<GC::Root<Database> const&> load_for_key_and_name(JS::Realm&, StorageAPI::StorageKey&, String&);
+    [[nodiscard]] static Vector<PersistedDatabase> unloaded_databases_for_key(JS::Realm&, StorageAPI::StorageKey const&);
+
     static void for_each_database(AK::Function<void(GC::Root<Database> const&)> const& visitor);
 
-    [[nodiscard]] static GC::Ref<Database> create(JS::Realm&, String const&);
+    [[nodiscard]] static GC::Ref<Database> create(JS::Realm&, StorageAPI::StorageKey const&, String const&);
     virtual ~Database();
 
 protected:
     explicit Database(IDBDatabase& database);
 
-    explicit Database(JS::Realm& realm, String name)
+    explicit Database(JS::Realm& realm, StorageAPI::StorageKey storage_key, String name)
         : PlatformObject(realm)
+        , m_storage_key(move(storage_key))
         , m_name(move(name))
     {
     }
@@ -72,6 +89,9 @@ protected:
 private:
     Vector<GC::Ref<IDBDatabase>> m_associated_connections;
 
+    // AD-HOC: A database needs to know which storage key it belongs to, so it can be written to disk.
+    StorageAPI::StorageKey m_storage_key;
+
     // A database has a name which identifies it within a specific storage key.
     String m_name;
 
@@ -81,8 +101,12 @@ private:
     // A database has at most one associated upgrade transaction, which is either null or an upgrade transaction, and is initially null.
     GC::Ptr<IDBTransaction> m_upgrade_transaction;
 
+    GC::Ptr<IDBTransaction> m_transaction_executing_request;
+
     // A database has zero or more object stores which hold the data stored in the database.
     Vector<GC::Ref<ObjectStore>> m_object_stores;
+
+    u64 m_next_id { 1 };
 };
 
 }
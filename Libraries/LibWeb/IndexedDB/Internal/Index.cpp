@@ -4,9 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/QuickSort.h>
 #include <LibWeb/IndexedDB/Internal/Index.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
+#include <LibWeb/IndexedDB/Internal/TransactionChanges.h>
 
 namespace Web::IndexedDB {
 
@@ -14,19 +14,20 @@ GC_DEFINE_ALLOCATOR(Index);
 
 Index::~Index() = default;
 
-GC::Ref<Index> Index::create(JS::Realm& realm, GC::Ref<ObjectStore> store, String const& name, KeyPath const& key_path, bool unique, bool multi_entry)
+GC::Ref<Index> Index::create(JS::Realm& realm, GC::Ref<ObjectStore> store, u64 id, String const& name, KeyPath const& key_path, bool unique, bool multi_entry)
 {
-    return realm.create<Index>(store, name, key_path, unique, multi_entry);
+    return realm.create<Index>(store, id, name, key_path, unique, multi_entry);
 }
 
-Index::Index(GC::Ref<ObjectStore> store, String const& name, KeyPath const& key_path, bool unique, bool multi_entry)
+Index::Index(GC::Ref<ObjectStore> store, u64 id, String const& name, KeyPath const& key_path, bool unique, bool multi_entry)
     : m_object_store(store)
+    , m_id(id)
     , m_name(name)
     , m_unique(unique)
     , m_multi_entry(multi_entry)
     , m_key_path(key_path)
 {
-    store->index_set().set(name, *this);
+    store->add_index(*this);
 }
 
 void Index::visit_edges(Visitor& visitor)
@@ -34,14 +35,21 @@ void Index::visit_edges(Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_object_store);
 
-    for (auto& record : m_records) {
+    for (auto const& record : m_records) {
         visitor.visit(record.key);
         visitor.visit(record.value);
     }
+
+    m_records.for_each_separator([&](auto const& separator) {
+        visitor.visit(separator.key);
+        visitor.visit(separator.value);
+    });
 }
 
 void Index::set_name(String name)
 {
+    m_object_store->database()->record_change(TransactionChanges::IndexRenamed { *this, m_name });
+
     // NOTE: Update the key in the map so it still matches the name
     auto old_value = m_object_store->index_set().take(m_name).release_value();
     m_object_store->index_set().set(name, old_value);
@@ -49,13 +57,33 @@ void Index::set_name(String name)
     m_name = move(name);
 }
 
-bool Index::has_record_with_key(GC::Ref<Key> key)
+IndexRecords::Iterator Index::lower_bound(GC::Ref<Key> key) const
 {
-    auto index = m_records.find_if([&key](auto const& record) {
-        return Key::equals(record.key, key);
+    return m_records.lower_bound([&](IndexRecord const& other) {
+        return Key::compare_two_keys(other.key, key);
     });
+}
+
+IndexRecords::Iterator Index::upper_bound(GC::Ref<Key> key) const
+{
+    return m_records.upper_bound([&](IndexRecord const& other) {
+        return Key::compare_two_keys(other.key, key);
+    });
+}
 
-    return index != m_records.end();
+// Records are ordered by key, so the records in a range always follow this position, up to the first one that is out of range.
+IndexRecords::Iterator Index::first_position_in_range(IDBKeyRange const& range) const
+{
+    auto lower_key = range.lower_key();
+    if (!lower_key)
+        return m_records.begin();
+    return range.lower_open() ? upper_bound(*lower_key) : lower_bound(*lower_key);
+}
+
+bool Index::has_record_with_key(GC::Ref<Key> key)
+{
+    auto it = lower_bound(key);
+    return !it.is_end() && Key::equals(it->key, key);
 }
 
 // https://w3c.github.io/IndexedDB/#index-referenced-value
@@ -63,36 +91,35 @@ HTML::SerializationRecord Index::referenced_value(IndexRecord const& index_recor
 {
     // Records in an index are said to have a referenced value.
     // This is the value of the record in the index’s referenced object store which has a key equal to the index’s record’s value.
-    return m_object_store
-        ->records()
-        .first_matching([&](auto const& store_record) {
-            return Key::equals(store_record.key, index_record.value);
-        })
-        .value()
-        .value;
+    return m_object_store->value_of(m_object_store->record_with_key(index_record.value).value());
 }
 
 void Index::clear_records()
 {
+    Vector<IndexRecord> previous_records;
+    previous_records.ensure_capacity(m_records.size());
+    for (auto const& record : m_records)
+        previous_records.unchecked_append(record);
+
+    m_object_store->database()->record_change(TransactionChanges::IndexCleared { *this, move(previous_records) });
     m_records.clear();
 }
 
-Optional<IndexRecord&> Index::first_in_range(GC::Ref<IDBKeyRange> range)
+Optional<IndexRecord const&> Index::first_in_range(GC::Ref<IDBKeyRange> range)
 {
-    return m_records.first_matching([&](auto const& record) {
-        return range->is_in_range(record.key);
-    });
+    auto it = first_position_in_range(range);
+    if (it.is_end() || !range->is_in_range(it->key))
+        return {};
+    return *it;
 }
 
 GC::ConservativeVector<IndexRecord> Index::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
     GC::ConservativeVector<IndexRecord> records(range->heap());
-    for (auto const& record : m_records) {
-        if (range->is_in_range(record.key))
-            records.append(record);
-
+    for (auto it = first_position_in_range(range); !it.is_end() && range->is_in_range(it->key); ++it) {
         if (count.has_value() && records.size() >= *count)
             break;
+        records.append(*it);
     }
 
     return records;
@@ -101,12 +128,18 @@ GC::ConservativeVector<IndexRecord> Index::first_n_in_range(GC::Ref<IDBKeyRange>
 GC::ConservativeVector<IndexRecord> Index::last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
     GC::ConservativeVector<IndexRecord> records(range->heap());
-    for (auto const& record : m_records.in_reverse()) {
-        if (range->is_in_range(record.key))
-            records.append(record);
 
+    auto it = m_records.end();
+    if (auto upper_key = range->upper_key())
+        it = range->upper_open() ? lower_bound(*upper_key) : upper_bound(*upper_key);
+
+    while (it != m_records.begin()) {
+        --it;
+        if (!range->is_in_range(it->key))
+            break;
         if (count.has_value() && records.size() >= *count)
             break;
+        records.append(*it);
     }
 
     return records;
@@ -115,32 +148,59 @@ GC::ConservativeVector<IndexRecord> Index::last_n_in_range(GC::Ref<IDBKeyRange>
 u64 Index::count_records_in_range(GC::Ref<IDBKeyRange> range)
 {
     u64 count = 0;
-    for (auto const& record : m_records) {
-        if (range->is_in_range(record.key))
-            ++count;
-    }
+    for (auto it = first_position_in_range(range); !it.is_end() && range->is_in_range(it->key); ++it)
+        ++count;
     return count;
 }
 
 void Index::store_a_record(IndexRecord const& record)
 {
-    m_records.append(record);
-
     // NOTE: The record is stored in index’s list of records such that the list is sorted primarily on the records keys, and secondarily on the records values, in ascending order.
-    AK::quick_sort(m_records, [](auto const& a, auto const& b) {
-        auto key_comparison = Key::compare_two_keys(a.key, b.key);
-        if (key_comparison != 0)
-            return key_comparison < 0;
-
-        return Key::compare_two_keys(a.value, b.value) < 0;
-    });
+    m_object_store->database()->record_change(TransactionChanges::IndexRecordChanged { *this, record, true });
+    m_records.insert(record);
 }
 
 void Index::remove_records_with_value_in_range(GC::Ref<IDBKeyRange> range)
 {
     m_records.remove_all_matching([&](auto const& record) {
-        return range->is_in_range(record.value);
+        if (!range->is_in_range(record.value))
+            return false;
+        m_object_store->database()->record_change(TransactionChanges::IndexRecordChanged { *this, record, false });
+        return true;
     });
 }
 
+void Index::load_record(IndexRecord const& record)
+{
+    m_records.insert(record);
+}
+
+void Index::restore_record(IndexRecord const& record, bool was_stored)
+{
+    if (!was_stored) {
+        m_records.insert(record);
+        return;
+    }
+
+    if (auto it = m_records.find(record); !it.is_end())
+        m_records.remove(it);
+}
+
+void Index::restore_records(ReadonlySpan<IndexRecord> records)
+{
+    for (auto const& record : records)
+        m_records.insert(record);
+}
+
+PersistedIndex Index::to_persisted() const
+{
+    return PersistedIndex {
+        .id = m_id,
+        .name = m_name,
+        .key_path = m_key_path,
+        .unique = m_unique,
+        .multi_entry = m_multi_entry,
+    };
+}
+
 }
@@ -11,32 +11,53 @@
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/IndexedDB/IDBRecord.h>
+#include <LibWeb/IndexedDB/Internal/BTree.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
 
 namespace Web::IndexedDB {
 
 using KeyPath = Variant<String, Vector<String>>;
 
+// Index records are ordered by key first, and value second.
+struct IndexRecordTraits {
+    using KeyType = IndexRecord;
+    static KeyType key_of(IndexRecord const& record) { return record; }
+    static int compare(IndexRecord const& a, IndexRecord const& b)
+    {
+        if (auto key_comparison = Key::compare_two_keys(a.key, b.key); key_comparison != 0)
+            return key_comparison;
+        return Key::compare_two_keys(a.value, b.value);
+    }
+};
+
+using IndexRecords = BTree<IndexRecord, IndexRecordTraits>;
+
 // https://w3c.github.io/IndexedDB/#index-construct
 class Index : public JS::Cell {
     GC_CELL(Index, JS::Cell);
     GC_DECLARE_ALLOCATOR(Index);
 
 public:
-    [[nodiscard]] static GC::Ref<Index> create(JS::Realm&, GC::Ref<ObjectStore>, String const&, KeyPath const&, bool, bool);
+    [[nodiscard]] static GC::Ref<Index> create(JS::Realm&, GC::Ref<ObjectStore>, u64 id, String const&, KeyPath const&, bool, bool);
     virtual ~Index();
 
+    [[nodiscard]] u64 id() const { return m_id; }
     void set_name(String name);
     [[nodiscard]] String name() const { return m_name; }
     [[nodiscard]] bool unique() const { return m_unique; }
     [[nodiscard]] bool multi_entry() const { return m_multi_entry; }
     [[nodiscard]] GC::Ref<ObjectStore> object_store() const { return m_object_store; }
-    [[nodiscard]] AK::ReadonlySpan<IndexRecord> records() const { return m_records; }
+    [[nodiscard]] IndexRecords const& records() const { return m_records; }
     [[nodiscard]] KeyPath const& key_path() const { return m_key_path; }
 
+    // The first record whose key is greater than or equal to, or greater than, the given key.
+    IndexRecords::Iterator lower_bound(GC::Ref<Key>) const;
+    IndexRecords::Iterator upper_bound(GC::Ref<Key>) const;
+
     [[nodiscard]] bool has_record_with_key(GC::Ref<Key> key);
     void clear_records();
-    Optional<IndexRecord&> first_in_range(GC::Ref<IDBKeyRange> range);
+    Optional<IndexRecord const&> first_in_range(GC::Ref<IDBKeyRange> range);
     GC::ConservativeVector<IndexRecord> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
     GC::ConservativeVector<IndexRecord> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
     u64 count_records_in_range(GC::Ref<IDBKeyRange> range);
@@ -45,17 +66,30 @@ public:
 
     HTML::SerializationRecord referenced_value(IndexRecord const& index_record) const;
 
+    void load_record(IndexRecord const&);
+
+    // Used to revert the changes of a transaction.
+    void restore_record(IndexRecord const&, bool was_stored);
+    void restore_records(ReadonlySpan<IndexRecord>);
+
+    PersistedIndex to_persisted() const;
+
 protected:
     virtual void visit_edges(Visitor&) override;
 
 private:
-    Index(GC::Ref<ObjectStore>, String const&, KeyPath const&, bool, bool);
+    Index(GC::Ref<ObjectStore>, u64 id, String const&, KeyPath const&, bool, bool);
+
+    IndexRecords::Iterator first_position_in_range(IDBKeyRange const&) const;
 
     // An index [...] has a referenced object store.
     GC::Ref<ObjectStore> m_object_store;
 
+    // AD-HOC: Identifies the index on disk, since its name may change.
+    u64 m_id { 0 };
+
     // The index has a list of records which hold the data stored in the index.
-    Vector<IndexRecord> m_records;
+    IndexRecords m_records;
 
     // An index has a name, which is a name. At any one time, the name is unique within index’s referenced object store.
     String m_name;
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Endian.h>
+#include <AK/MemoryStream.h>
 #include <LibWeb/IndexedDB/Internal/Key.h>
 #include <LibWeb/Infra/ByteSequences.h>
 #include <LibWeb/Infra/Strings.h>
@@ -186,4 +188,88 @@ String Key::dump() const
         });
 }
 
+ByteBuffer Key::encode() const
+{
+    ByteBuffer buffer;
+    encode_into(buffer);
+    return buffer;
+}
+
+// NOTE: A key is encoded as its type followed by its value. Numbers and dates are stored as the bits of the double,
+//       with -0 stored as 0 since the two compare as equal. Everything else is prefixed with its length.
+void Key::encode_into(ByteBuffer& buffer) const
+{
+    VERIFY(m_type != Invalid);
+    buffer.append(static_cast<u8>(m_type));
+
+    auto append_value = [&](auto value) {
+        LittleEndian<decltype(value)> little_endian_value = value;
+        buffer.append(&little_endian_value, sizeof(little_endian_value));
+    };
+
+    m_value.visit(
+        [&](double value) {
+            if (value == 0)
+                value = 0;
+            append_value(bit_cast<u64>(value));
+        },
+        [&](AK::String const& value) {
+            append_value(static_cast<u32>(value.bytes().size()));
+            buffer.append(value.bytes());
+        },
+        [&](ByteBuffer const& value) {
+            append_value(static_cast<u32>(value.size()));
+            buffer.append(value.bytes());
+        },
+        [&](Vector<GC::Root<Key>> const& value) {
+            append_value(static_cast<u32>(value.size()));
+            for (auto const& subkey : value)
+                subkey->encode_into(buffer);
+        });
+}
+
+ErrorOr<GC::Ref<Key>> Key::decode(JS::Realm& realm, ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    auto key = TRY(decode_from(realm, stream));
+    if (!stream.is_eof())
+        return Error::from_string_literal("Trailing data after encoded key");
+    return key;
+}
+
+ErrorOr<GC::Ref<Key>> Key::decode_from(JS::Realm& realm, Stream& stream)
+{
+    auto type = TRY(stream.read_value<u8>());
+
+    switch (type) {
+    case Number:
+    case Date: {
+        auto value = bit_cast<double>(static_cast<u64>(TRY(stream.read_value<LittleEndian<u64>>())));
+        return create(realm, static_cast<KeyType>(type), value);
+    }
+    case String: {
+        auto length = TRY(stream.read_value<LittleEndian<u32>>());
+        auto bytes = TRY(ByteBuffer::create_uninitialized(length));
+        TRY(stream.read_until_filled(bytes));
+        return create_string(realm, TRY(AK::String::from_utf8(StringView { bytes })));
+    }
+    case Binary: {
+        auto length = TRY(stream.read_value<LittleEndian<u32>>());
+        auto bytes = TRY(ByteBuffer::create_uninitialized(length));
+        TRY(stream.read_until_filled(bytes));
+        return create_binary(realm, bytes);
+    }
+    case Array: {
+        auto size = TRY(stream.read_value<LittleEndian<u32>>());
+        Vector<GC::Root<Key>> subkeys;
+        TRY(subkeys.try_ensure_capacity(size));
+        for (u32 i = 0; i < size; ++i)
+            subkeys.unchecked_append(TRY(decode_from(realm, stream)));
+        return create_array(realm, subkeys);
+    }
+    default:
+        return Error::from_string_literal("Invalid key type");
+    }
+}
+
 }
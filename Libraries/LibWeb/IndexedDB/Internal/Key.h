@@ -72,6 +72,10 @@ public:
 
     AK::String dump() const;
 
+    // Encodes the key for storage. Keys that compare as equal always have the same encoding.
+    [[nodiscard]] ByteBuffer encode() const;
+    [[nodiscard]] static ErrorOr<GC::Ref<Key>> decode(JS::Realm&, ReadonlyBytes);
+
 private:
     Key(KeyType type, KeyValue value)
         : m_type(type)
@@ -79,6 +83,9 @@ private:
     {
     }
 
+    void encode_into(ByteBuffer&) const;
+    static ErrorOr<GC::Ref<Key>> decode_from(JS::Realm&, Stream&);
+
     KeyType m_type;
     KeyValue m_value;
 };
@@ -4,9 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/QuickSort.h>
 #include <LibWeb/IndexedDB/IDBKeyRange.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
+#include <LibWeb/IndexedDB/Internal/TransactionChanges.h>
 
 namespace Web::IndexedDB {
 
@@ -14,13 +14,14 @@ GC_DEFINE_ALLOCATOR(ObjectStore);
 
 ObjectStore::~ObjectStore() = default;
 
-GC::Ref<ObjectStore> ObjectStore::create(JS::Realm& realm, GC::Ref<Database> database, String name, bool auto_increment, Optional<KeyPath> const& key_path)
+GC::Ref<ObjectStore> ObjectStore::create(JS::Realm& realm, GC::Ref<Database> database, u64 id, String name, bool auto_increment, Optional<KeyPath> const& key_path)
 {
-    return realm.create<ObjectStore>(database, name, auto_increment, key_path);
+    return realm.create<ObjectStore>(database, id, name, auto_increment, key_path);
 }
 
-ObjectStore::ObjectStore(GC::Ref<Database> database, String name, bool auto_increment, Optional<KeyPath> const& key_path)
+ObjectStore::ObjectStore(GC::Ref<Database> database, u64 id, String name, bool auto_increment, Optional<KeyPath> const& key_path)
     : m_database(database)
+    , m_id(id)
     , m_name(move(name))
     , m_key_path(key_path)
 {
@@ -36,68 +37,125 @@ void ObjectStore::visit_edges(Visitor& visitor)
     visitor.visit(m_database);
     visitor.visit(m_indexes);
 
-    for (auto& record : m_records) {
+    for (auto const& record : m_records) {
         visitor.visit(record.key);
     }
+
+    m_records.for_each_separator([&](auto key) {
+        visitor.visit(key);
+    });
 }
 
-void ObjectStore::remove_records_in_range(GC::Ref<IDBKeyRange> range)
+void ObjectStore::set_name(String name)
+{
+    m_database->record_change(TransactionChanges::ObjectStoreRenamed { *this, m_name });
+    m_name = move(name);
+}
+
+void ObjectStore::set_key_generator_current_number(u64 current_number)
+{
+    m_database->record_change(TransactionChanges::KeyGeneratorChanged { *this, m_key_generator->current_number() });
+    m_key_generator->set(current_number);
+}
+
+void ObjectStore::add_index(GC::Ref<Index> index)
+{
+    m_database->record_change(TransactionChanges::IndexCreated { index });
+    m_indexes.set(index->name(), index);
+}
+
+void ObjectStore::remove_index(GC::Ref<Index> index)
+{
+    m_database->record_change(TransactionChanges::IndexDeleted { index });
+    m_indexes.remove(index->name());
+}
+
+ObjectStoreRecords::Iterator ObjectStore::lower_bound(GC::Ref<Key> key) const
 {
-    m_records.remove_all_matching([&](auto const& record) {
-        return range->is_in_range(record.key);
+    return m_records.lower_bound([&](GC::Ref<Key> other) {
+        return Key::compare_two_keys(other, key);
     });
 }
 
-bool ObjectStore::has_record_with_key(GC::Ref<Key> key)
+ObjectStoreRecords::Iterator ObjectStore::upper_bound(GC::Ref<Key> key) const
 {
-    auto index = m_records.find_if([&key](auto const& record) {
-        return Key::equals(key, record.key);
+    return m_records.upper_bound([&](GC::Ref<Key> other) {
+        return Key::compare_two_keys(other, key);
     });
+}
 
-    return index != m_records.end();
+// Records are ordered by key, so the records in a range always follow this position, up to the first one that is out of range.
+ObjectStoreRecords::Iterator ObjectStore::first_position_in_range(IDBKeyRange const& range) const
+{
+    auto lower_key = range.lower_key();
+    if (!lower_key)
+        return m_records.begin();
+    return range.lower_open() ? upper_bound(*lower_key) : lower_bound(*lower_key);
 }
 
-void ObjectStore::store_a_record(ObjectStoreRecord const& record)
+void ObjectStore::remove_records_in_range(GC::Ref<IDBKeyRange> range)
+{
+    auto it = first_position_in_range(range);
+    while (!it.is_end() && range->is_in_range(it->key)) {
+        m_database->record_change(TransactionChanges::RecordChanged { *this, it->key, *it });
+        it = m_records.remove(it);
+    }
+}
+
+bool ObjectStore::has_record_with_key(GC::Ref<Key> key)
+{
+    return !m_records.find(key).is_end();
+}
+
+Optional<ObjectStoreRecord const&> ObjectStore::record_with_key(GC::Ref<Key> key) const
 {
-    m_records.append(record);
+    auto it = m_records.find(key);
+    if (it.is_end())
+        return {};
+    return *it;
+}
 
+void ObjectStore::store_a_record(ObjectStoreRecord const& record)
+{
     // NOTE: The record is stored in the object store’s list of records such that the list is sorted according to the key of the records in ascending order.
-    AK::quick_sort(m_records, [](auto const& a, auto const& b) {
-        return Key::compare_two_keys(a.key, b.key) < 0;
-    });
+    m_database->record_change(TransactionChanges::RecordChanged { *this, record.key, record_with_key(record.key).copy() });
+    m_records.insert(record);
 }
 
 u64 ObjectStore::count_records_in_range(GC::Ref<IDBKeyRange> range)
 {
     u64 count = 0;
-    for (auto const& record : m_records) {
-        if (range->is_in_range(record.key))
-            ++count;
-    }
+    for (auto it = first_position_in_range(range); !it.is_end() && range->is_in_range(it->key); ++it)
+        ++count;
     return count;
 }
 
-Optional<ObjectStoreRecord&> ObjectStore::first_in_range(GC::Ref<IDBKeyRange> range)
+Optional<ObjectStoreRecord const&> ObjectStore::first_in_range(GC::Ref<IDBKeyRange> range)
 {
-    return m_records.first_matching([&](auto const& record) {
-        return range->is_in_range(record.key);
-    });
+    auto it = first_position_in_range(range);
+    if (it.is_end() || !range->is_in_range(it->key))
+        return {};
+    return *it;
 }
 
 void ObjectStore::clear_records()
 {
+    Vector<ObjectStoreRecord> previous_records;
+    previous_records.ensure_capacity(m_records.size());
+    for (auto const& record : m_records)
+        previous_records.unchecked_append(record);
+
+    m_database->record_change(TransactionChanges::ObjectStoreCleared { *this, move(previous_records) });
     m_records.clear();
 }
 
 GC::ConservativeVector<ObjectStoreRecord> ObjectStore::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
     GC::ConservativeVector<ObjectStoreRecord> records(range->heap());
-    for (auto const& record : m_records) {
-        if (range->is_in_range(record.key))
-            records.append(record);
-
+    for (auto it = first_position_in_range(range); !it.is_end() && range->is_in_range(it->key); ++it) {
         if (count.has_value() && records.size() >= *count)
             break;
+        records.append(*it);
     }
 
     return records;
@@ -106,15 +164,77 @@ GC::ConservativeVector<ObjectStoreRecord> ObjectStore::first_n_in_range(GC::Ref<
 GC::ConservativeVector<ObjectStoreRecord> ObjectStore::last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
     GC::ConservativeVector<ObjectStoreRecord> records(range->heap());
-    for (auto const& record : m_records.in_reverse()) {
-        if (range->is_in_range(record.key))
-            records.append(record);
 
+    auto it = m_records.end();
+    if (auto upper_key = range->upper_key())
+        it = range->upper_open() ? lower_bound(*upper_key) : upper_bound(*upper_key);
+
+    while (it != m_records.begin()) {
+        --it;
+        if (!range->is_in_range(it->key))
+            break;
         if (count.has_value() && records.size() >= *count)
             break;
+        records.append(*it);
     }
 
     return records;
 }
 
+HTML::SerializationRecord ObjectStore::value_of(ObjectStoreRecord const& record) const
+{
+    auto const& value = loaded_value(record);
+
+    HTML::SerializationRecord serialized;
+    serialized.append(value.data(), value.size());
+    return serialized;
+}
+
+ByteBuffer const& ObjectStore::loaded_value(ObjectStoreRecord const& record) const
+{
+    // NOTE: The record may be a copy, so look up the one in our list of records to keep the loaded value around.
+    auto const& stored_record = record.value.has_value() ? record : record_with_key(record.key).value();
+    if (!stored_record.value.has_value())
+        stored_record.value = m_database->load_record_value(*this, stored_record.key);
+    return *stored_record.value;
+}
+
+void ObjectStore::load_record(GC::Ref<Key> key)
+{
+    m_records.insert({ key, {} });
+}
+
+void ObjectStore::restore_record(GC::Ref<Key> key, Optional<ObjectStoreRecord> const& record)
+{
+    if (auto it = m_records.find(key); !it.is_end())
+        m_records.remove(it);
+    if (record.has_value())
+        m_records.insert(*record);
+}
+
+void ObjectStore::restore_records(ReadonlySpan<ObjectStoreRecord> records)
+{
+    for (auto const& record : records)
+        m_records.insert(record);
+}
+
+PersistedObjectStore ObjectStore::to_persisted() const
+{
+    PersistedObjectStore object_store {
+        .id = m_id,
+        .name = m_name,
+        .key_path = m_key_path,
+        .key_generator_current_number = {},
+        .indexes = {},
+    };
+
+    if (m_key_generator.has_value())
+        object_store.key_generator_current_number = m_key_generator->current_number();
+
+    for (auto const& [name, index] : m_indexes)
+        object_store.indexes.append(index->to_persisted());
+
+    return object_store;
+}
+
 }
@@ -16,53 +16,88 @@
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/IndexedDB/IDBRecord.h>
 #include <LibWeb/IndexedDB/Internal/Algorithms.h>
+#include <LibWeb/IndexedDB/Internal/BTree.h>
 #include <LibWeb/IndexedDB/Internal/Database.h>
 #include <LibWeb/IndexedDB/Internal/Index.h>
 #include <LibWeb/IndexedDB/Internal/KeyGenerator.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
 
 namespace Web::IndexedDB {
 
 using KeyPath = Variant<String, Vector<String>>;
 
+struct ObjectStoreRecordTraits {
+    using KeyType = GC::Ref<Key>;
+    static KeyType key_of(ObjectStoreRecord const& record) { return record.key; }
+    static int compare(KeyType a, KeyType b) { return Key::compare_two_keys(a, b); }
+};
+
+using ObjectStoreRecords = BTree<ObjectStoreRecord, ObjectStoreRecordTraits>;
+
 // https://w3c.github.io/IndexedDB/#object-store-construct
 class ObjectStore : public JS::Cell {
     GC_CELL(ObjectStore, JS::Cell);
     GC_DECLARE_ALLOCATOR(ObjectStore);
 
 public:
-    [[nodiscard]] static GC::Ref<ObjectStore> create(JS::Realm&, GC::Ref<Database>, String, bool, Optional<KeyPath> const&);
+    [[nodiscard]] static GC::Ref<ObjectStore> create(JS::Realm&, GC::Ref<Database>, u64 id, String, bool, Optional<KeyPath> const&);
     virtual ~ObjectStore();
 
+    u64 id() const { return m_id; }
     String name() const { return m_name; }
-    void set_name(String name) { m_name = move(name); }
+    void set_name(String name);
     Optional<KeyPath> key_path() const { return m_key_path; }
     bool uses_inline_keys() const { return m_key_path.has_value(); }
     bool uses_out_of_line_keys() const { return !m_key_path.has_value(); }
-    KeyGenerator& key_generator() { return *m_key_generator; }
+    KeyGenerator const& key_generator() const { return *m_key_generator; }
+    void set_key_generator_current_number(u64);
     bool uses_a_key_generator() const { return m_key_generator.has_value(); }
     AK::HashMap<String, GC::Ref<Index>>& index_set() { return m_indexes; }
+    void add_index(GC::Ref<Index>);
+    void remove_index(GC::Ref<Index>);
 
     GC::Ref<Database> database() const { return m_database; }
-    ReadonlySpan<ObjectStoreRecord> records() const { return m_records; }
+    ObjectStoreRecords const& records() const { return m_records; }
+
+    // The first record whose key is greater than or equal to, or greater than, the given key.
+    ObjectStoreRecords::Iterator lower_bound(GC::Ref<Key>) const;
+    ObjectStoreRecords::Iterator upper_bound(GC::Ref<Key>) const;
 
     void remove_records_in_range(GC::Ref<IDBKeyRange> range);
     bool has_record_with_key(GC::Ref<Key> key);
+    Optional<ObjectStoreRecord const&> record_with_key(GC::Ref<Key> key) const;
     void store_a_record(ObjectStoreRecord const& record);
     u64 count_records_in_range(GC::Ref<IDBKeyRange> range);
-    Optional<ObjectStoreRecord&> first_in_range(GC::Ref<IDBKeyRange> range);
+    Optional<ObjectStoreRecord const&> first_in_range(GC::Ref<IDBKeyRange> range);
     void clear_records();
     GC::ConservativeVector<ObjectStoreRecord> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
     GC::ConservativeVector<ObjectStoreRecord> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
 
+    // Records read back from disk only have their value loaded once it's needed.
+    HTML::SerializationRecord value_of(ObjectStoreRecord const&) const;
+    ByteBuffer const& loaded_value(ObjectStoreRecord const&) const;
+    void load_record(GC::Ref<Key>);
+
+    // Used to revert the changes of a transaction.
+    void restore_record(GC::Ref<Key>, Optional<ObjectStoreRecord> const&);
+    void restore_records(ReadonlySpan<ObjectStoreRecord>);
+
+    PersistedObjectStore to_persisted() const;
+
 protected:
     virtual void visit_edges(Visitor&) override;
 
 private:
-    ObjectStore(GC::Ref<Database> database, String name, bool auto_increment, Optional<KeyPath> const& key_path);
+    ObjectStore(GC::Ref<Database> database, u64 id, String name, bool auto_increment, Optional<KeyPath> const& key_path);
+
+    ObjectStoreRecords::Iterator first_position_in_range(IDBKeyRange const&) const;
 
     // AD-HOC: An ObjectStore needs to know what Database it belongs to...
     GC::Ref<Database> m_database;
 
+    // AD-HOC: Identifies the object store on disk, since its name may change.
+    u64 m_id { 0 };
+
     // AD-HOC: An Index has referenced ObjectStores, we also need the reverse mapping
     AK::HashMap<String, GC::Ref<Index>> m_indexes;
 
@@ -76,7 +111,8 @@ private:
     Optional<KeyGenerator> m_key_generator;
 
     // An object store has a list of records
-    Vector<ObjectStoreRecord> m_records;
+    // NOTE: The records are kept in a B-tree ordered by key, which is the order the spec keeps the list in.
+    ObjectStoreRecords m_records;
 };
 
 }
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedIndex const& index)
+{
+    TRY(encoder.encode(index.id));
+    TRY(encoder.encode(index.name));
+    TRY(encoder.encode(index.key_path));
+    TRY(encoder.encode(index.unique));
+    TRY(encoder.encode(index.multi_entry));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedIndex> IPC::decode(Decoder& decoder)
+{
+    auto id = TRY(decoder.decode<u64>());
+    auto name = TRY(decoder.decode<String>());
+    auto key_path = TRY(decoder.decode<Web::IndexedDB::KeyPath>());
+    auto unique = TRY(decoder.decode<bool>());
+    auto multi_entry = TRY(decoder.decode<bool>());
+
+    return Web::IndexedDB::PersistedIndex { id, move(name), move(key_path), unique, multi_entry };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedObjectStore const& object_store)
+{
+    TRY(encoder.encode(object_store.id));
+    TRY(encoder.encode(object_store.name));
+    TRY(encoder.encode(object_store.key_path));
+    TRY(encoder.encode(object_store.key_generator_current_number));
+    TRY(encoder.encode(object_store.indexes));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedObjectStore> IPC::decode(Decoder& decoder)
+{
+    auto id = TRY(decoder.decode<u64>());
+    auto name = TRY(decoder.decode<String>());
+    auto key_path = TRY(decoder.decode<Optional<Web::IndexedDB::KeyPath>>());
+    auto key_generator_current_number = TRY(decoder.decode<Optional<u64>>());
+    auto indexes = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedIndex>>());
+
+    return Web::IndexedDB::PersistedObjectStore { id, move(name), move(key_path), key_generator_current_number, move(indexes) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedDatabase const& database)
+{
+    TRY(encoder.encode(database.name));
+    TRY(encoder.encode(database.version));
+    TRY(encoder.encode(database.object_stores));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedDatabase> IPC::decode(Decoder& decoder)
+{
+    auto name = TRY(decoder.decode<String>());
+    auto version = TRY(decoder.decode<u64>());
+    auto object_stores = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedObjectStore>>());
+
+    return Web::IndexedDB::PersistedDatabase { move(name), version, move(object_stores) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedRecord const& record)
+{
+    TRY(encoder.encode(record.source_id));
+    TRY(encoder.encode(record.key));
+    TRY(encoder.encode(record.value));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedRecord> IPC::decode(Decoder& decoder)
+{
+    auto source_id = TRY(decoder.decode<u64>());
+    auto key = TRY(decoder.decode<ByteBuffer>());
+    auto value = TRY(decoder.decode<ByteBuffer>());
+
+    return Web::IndexedDB::PersistedRecord { source_id, move(key), move(value) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedKeyGenerator const& key_generator)
+{
+    TRY(encoder.encode(key_generator.object_store_id));
+    TRY(encoder.encode(key_generator.current_number));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedKeyGenerator> IPC::decode(Decoder& decoder)
+{
+    auto object_store_id = TRY(decoder.decode<u64>());
+    auto current_number = TRY(decoder.decode<u64>());
+
+    return Web::IndexedDB::PersistedKeyGenerator { object_store_id, current_number };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedDatabaseContents const& contents)
+{
+    TRY(encoder.encode(contents.database));
+    TRY(encoder.encode(contents.records));
+    TRY(encoder.encode(contents.index_records));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedDatabaseContents> IPC::decode(Decoder& decoder)
+{
+    auto database = TRY(decoder.decode<Web::IndexedDB::PersistedDatabase>());
+    auto records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedRecord>>());
+    auto index_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedRecord>>());
+
+    return Web::IndexedDB::PersistedDatabaseContents { move(database), move(records), move(index_records) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedDatabaseChanges const& changes)
+{
+    TRY(encoder.encode(changes.database));
+    TRY(encoder.encode(changes.key_generators));
+    TRY(encoder.encode(changes.cleared_object_stores));
+    TRY(encoder.encode(changes.cleared_indexes));
+    TRY(encoder.encode(changes.stored_records));
+    TRY(encoder.encode(changes.removed_records));
+    TRY(encoder.encode(changes.stored_index_records));
+    TRY(encoder.encode(changes.removed_index_records));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedDatabaseChanges> IPC::decode(Decoder& decoder)
+{
+    auto database = TRY(decoder.decode<Optional<Web::IndexedDB::PersistedDatabase>>());
+    auto key_generators = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedKeyGenerator>>());
+    auto cleared_object_stores = TRY(decoder.decode<Vector<u64>>());
+    auto cleared_indexes = TRY(decoder.decode<Vector<u64>>());
+    auto stored_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedRecord>>());
+    auto removed_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedRecord>>());
+    auto stored_index_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedRecord>>());
+    auto removed_index_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedRecord>>());
+
+    return Web::IndexedDB::PersistedDatabaseChanges {
+        move(database),
+        move(key_generators),
+        move(cleared_object_stores),
+        move(cleared_indexes),
+        move(stored_records),
+        move(removed_records),
+        move(stored_index_records),
+        move(removed_index_records),
+    };
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibIPC/Forward.h>
+#include <LibWeb/Export.h>
+
+namespace Web::IndexedDB {
+
+// These describe the parts of a database that are kept on disk between sessions. They are handed to and from the
+// process that owns the disk storage. Keys are encoded with Key::encode(), and values are serialized for storage.
+
+using KeyPath = Variant<String, Vector<String>>;
+
+struct PersistedIndex {
+    u64 id { 0 };
+    String name;
+    KeyPath key_path;
+    bool unique { false };
+    bool multi_entry { false };
+};
+
+struct PersistedObjectStore {
+    u64 id { 0 };
+    String name;
+    Optional<KeyPath> key_path;
+    Optional<u64> key_generator_current_number;
+    Vector<PersistedIndex> indexes;
+};
+
+struct PersistedDatabase {
+    String name;
+    u64 version { 0 };
+    Vector<PersistedObjectStore> object_stores;
+};
+
+// Used for both object store and index records. The source is the ID of the object store or index the record is in.
+// Index records hold the encoded primary key as their value.
+struct PersistedRecord {
+    u64 source_id { 0 };
+    ByteBuffer key;
+    ByteBuffer value;
+};
+
+// Everything needed to open a database. Object store records are listed without their value, which is only loaded
+// once it's needed.
+struct PersistedDatabaseContents {
+    PersistedDatabase database;
+    Vector<PersistedRecord> records;
+    Vector<PersistedRecord> index_records;
+};
+
+struct PersistedKeyGenerator {
+    u64 object_store_id { 0 };
+    u64 current_number { 0 };
+};
+
+// The changes a transaction made to a database. The database is only described in full if its version, object stores
+// or indexes changed, which only upgrade transactions can do. Otherwise, only the key generators that were used are.
+// Object stores and indexes that were deleted have their records cleared.
+struct PersistedDatabaseChanges {
+    Optional<PersistedDatabase> database;
+    Vector<PersistedKeyGenerator> key_generators;
+    Vector<u64> cleared_object_stores;
+    Vector<u64> cleared_indexes;
+    Vector<PersistedRecord> stored_records;
+    Vector<PersistedRecord> removed_records;
+    Vector<PersistedRecord> stored_index_records;
+    Vector<PersistedRecord> removed_index_records;
+};
+
+}
+
+namespace IPC {
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedIndex const&);
+
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedIndex> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedObjectStore const&);
+
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedObjectStore> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedDatabase const&);
+
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedDatabase> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedRecord const&);
+
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedRecord> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedKeyGenerator const&);
+
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedKeyGenerator> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedDatabaseContents const&);
+
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedDatabaseContents> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedDatabaseChanges const&);
+
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedDatabaseChanges> decode(Decoder&);
+
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
+#include <LibWeb/IndexedDB/Internal/Index.h>
+#include <LibWeb/IndexedDB/Internal/ObjectStore.h>
+#include <LibWeb/IndexedDB/Internal/TransactionChanges.h>
+
+namespace Web::IndexedDB {
+
+void TransactionChanges::revert_to(size_t size)
+{
+    VERIFY(size <= m_changes.size());
+
+    while (m_changes.size() > size) {
+        auto change = m_changes.take_last();
+        auto change_count = m_changes.size();
+
+        change.visit(
+            [](RecordChanged const& change) {
+                change.object_store->restore_record(change.key, change.previous_record);
+            },
+            [](IndexRecordChanged const& change) {
+                change.index->restore_record(change.record, change.stored);
+            },
+            [](ObjectStoreCleared const& change) {
+                change.object_store->restore_records(change.previous_records);
+            },
+            [](IndexCleared const& change) {
+                change.index->restore_records(change.previous_records);
+            },
+            [](KeyGeneratorChanged const& change) {
+                change.object_store->set_key_generator_current_number(change.previous_current_number);
+            },
+            [](ObjectStoreCreated const& change) {
+                change.object_store->database()->remove_object_store(change.object_store);
+            },
+            [](ObjectStoreDeleted const& change) {
+                change.object_store->database()->add_object_store(change.object_store);
+            },
+            [](ObjectStoreRenamed const& change) {
+                change.object_store->set_name(change.previous_name);
+            },
+            [](IndexCreated const& change) {
+                change.index->object_store()->remove_index(change.index);
+            },
+            [](IndexDeleted const& change) {
+                change.index->object_store()->add_index(change.index);
+            },
+            [](IndexRenamed const& change) {
+                change.index->set_name(change.previous_name);
+            },
+            [](VersionChanged const& change) {
+                change.database->set_version(change.previous_version);
+            });
+
+        // NOTE: Undoing a change may record another one, which is not a change of this transaction.
+        m_changes.shrink(change_count);
+    }
+}
+
+PersistedDatabaseChanges TransactionChanges::take_persisted_changes(Database& database)
+{
+    PersistedDatabaseChanges changes;
+
+    // Records of object stores and indexes that were deleted are cleared along with them, so their other changes don't matter.
+    HashTable<ObjectStore const*> object_stores;
+    for (auto const& object_store : database.object_stores())
+        object_stores.set(object_store.ptr());
+
+    auto is_in_database = [&](Index& index) {
+        auto object_store = index.object_store();
+        if (!object_stores.contains(object_store.ptr()))
+            return false;
+        auto index_with_name = object_store->index_set().get(index.name());
+        return index_with_name.has_value() && index_with_name->ptr() == &index;
+    };
+
+    bool database_changed = false;
+    HashTable<ObjectStore*> used_key_generators;
+    HashMap<u64, HashTable<ByteBuffer>> changed_keys;
+
+    for (auto const& change : m_changes) {
+        change.visit(
+            [&](RecordChanged const& change) {
+                auto object_store = change.object_store;
+                if (!object_stores.contains(object_store.ptr()))
+                    return;
+
+                // NOTE: A key may have changed several times, so only its final state is written.
+                PersistedRecord persisted_record { object_store->id(), change.key->encode(), {} };
+                auto& keys = changed_keys.ensure(object_store->id());
+                if (keys.set(persisted_record.key) == HashSetResult::KeptExistingEntry)
+                    return;
+
+                if (auto record = object_store->record_with_key(change.key); record.has_value()) {
+                    persisted_record.value = object_store->loaded_value(*record);
+                    changes.stored_records.append(move(persisted_record));
+                } else {
+                    changes.removed_records.append(move(persisted_record));
+                }
+            },
+            [&](IndexRecordChanged const& change) {
+                if (!is_in_database(*change.index))
+                    return;
+
+                PersistedRecord persisted_record { change.index->id(), change.record.key->encode(), change.record.value->encode() };
+                if (change.index->records().find(change.record).is_end())
+                    changes.removed_index_records.append(move(persisted_record));
+                else
+                    changes.stored_index_records.append(move(persisted_record));
+            },
+            [&](ObjectStoreCleared const& change) {
+                if (object_stores.contains(change.object_store.ptr()))
+                    changes.cleared_object_stores.append(change.object_store->id());
+            },
+            [&](IndexCleared const& change) {
+                if (is_in_database(*change.index))
+                    changes.cleared_indexes.append(change.index->id());
+            },
+            [&](KeyGeneratorChanged const& change) {
+                if (object_stores.contains(change.object_store.ptr()))
+                    used_key_generators.set(change.object_store.ptr());
+            },
+            [&](ObjectStoreDeleted const& change) {
+                database_changed = true;
+                changes.cleared_object_stores.append(change.object_store->id());
+                for (auto const& [name, index] : change.object_store->index_set())
+                    changes.cleared_indexes.append(index->id());
+            },
+            [&](IndexDeleted const& change) {
+                database_changed = true;
+                changes.cleared_indexes.append(change.index->id());
+            },
+            [&](auto const&) {
+                database_changed = true;
+            });
+    }
+
+    // NOTE: The full description of the database includes the current number of every key generator.
+    if (database_changed) {
+        changes.database = database.to_persisted();
+    } else {
+        for (auto* object_store : used_key_generators)
+            changes.key_generators.append({ object_store->id(), object_store->key_generator().current_number() });
+    }
+
+    m_changes.clear();
+    return changes;
+}
+
+void TransactionChanges::visit_edges(GC::Cell::Visitor& visitor)
+{
+    for (auto const& change : m_changes) {
+        change.visit(
+            [&](RecordChanged const& change) {
+                visitor.visit(change.object_store);
+                visitor.visit(change.key);
+            },
+            [&](IndexRecordChanged const& change) {
+                visitor.visit(change.index);
+                visitor.visit(change.record.key);
+                visitor.visit(change.record.value);
+            },
+            [&](ObjectStoreCleared const& change) {
+                visitor.visit(change.object_store);
+                for (auto const& record : change.previous_records)
+                    visitor.visit(record.key);
+            },
+            [&](IndexCleared const& change) {
+                visitor.visit(change.index);
+                for (auto const& record : change.previous_records) {
+                    visitor.visit(record.key);
+                    visitor.visit(record.value);
+                }
+            },
+            [&](KeyGeneratorChanged const& change) {
+                visitor.visit(change.object_store);
+            },
+            [&](ObjectStoreCreated const& change) {
+                visitor.visit(change.object_store);
+            },
+            [&](ObjectStoreDeleted const& change) {
+                visitor.visit(change.object_store);
+            },
+            [&](ObjectStoreRenamed const& change) {
+                visitor.visit(change.object_store);
+            },
+            [&](IndexCreated const& change) {
+                visitor.visit(change.index);
+            },
+            [&](IndexDeleted const& change) {
+                visitor.visit(change.index);
+            },
+            [&](IndexRenamed const& change) {
+                visitor.visit(change.index);
+            },
+            [&](VersionChanged const& change) {
+                visitor.visit(change.database);
+            });
+    }
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibGC/Cell.h>
+#include <LibGC/Ptr.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/IndexedDB/IDBRecord.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
+
+namespace Web::IndexedDB {
+
+// AD-HOC: The changes a transaction made to its database, along with what they replaced. They are written to disk
+//         when the transaction commits, and reverted when it is aborted or one of its requests fails.
+class TransactionChanges {
+public:
+    struct RecordChanged {
+        GC::Ref<ObjectStore> object_store;
+        GC::Ref<Key> key;
+        Optional<ObjectStoreRecord> previous_record;
+    };
+
+    struct IndexRecordChanged {
+        GC::Ref<Index> index;
+        IndexRecord record;
+        bool stored { false };
+    };
+
+    struct ObjectStoreCleared {
+        GC::Ref<ObjectStore> object_store;
+        Vector<ObjectStoreRecord> previous_records;
+    };
+
+    struct IndexCleared {
+        GC::Ref<Index> index;
+        Vector<IndexRecord> previous_records;
+    };
+
+    struct KeyGeneratorChanged {
+        GC::Ref<ObjectStore> object_store;
+        u64 previous_current_number { 0 };
+    };
+
+    struct ObjectStoreCreated {
+        GC::Ref<ObjectStore> object_store;
+    };
+
+    struct ObjectStoreDeleted {
+        GC::Ref<ObjectStore> object_store;
+    };
+
+    struct ObjectStoreRenamed {
+        GC::Ref<ObjectStore> object_store;
+        String previous_name;
+    };
+
+    struct IndexCreated {
+        GC::Ref<Index> index;
+    };
+
+    struct IndexDeleted {
+        GC::Ref<Index> index;
+    };
+
+    struct IndexRenamed {
+        GC::Ref<Index> index;
+        String previous_name;
+    };
+
+    struct VersionChanged {
+        GC::Ref<Database> database;
+        u64 previous_version { 0 };
+    };
+
+    using Change = Variant<
+        RecordChanged,
+        IndexRecordChanged,
+        ObjectStoreCleared,
+        IndexCleared,
+        KeyGeneratorChanged,
+        ObjectStoreCreated,
+        ObjectStoreDeleted,
+        ObjectStoreRenamed,
+        IndexCreated,
+        IndexDeleted,
+        IndexRenamed,
+        VersionChanged>;
+
+    [[nodiscard]] bool is_empty() const { return m_changes.is_empty(); }
+    [[nodiscard]] size_t size() const { return m_changes.size(); }
+
+    void append(Change change) { m_changes.append(move(change)); }
+
+    // Reverts the changes made after the first `size` ones, most recent first.
+    void revert_to(size_t size);
+    void revert() { revert_to(0); }
+
+    // Describes the final state of everything that was changed, and forgets the changes.
+    [[nodiscard]] PersistedDatabaseChanges take_persisted_changes(Database&);
+
+    void visit_edges(GC::Cell::Visitor&);
+
+private:
+    Vector<Change> m_changes;
+};
+
+}
@@ -11,6 +11,7 @@
 #include <LibUnicode/TimeZone.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
@@ -325,6 +326,48 @@ String Internals::dump_display_list()
     return window().associated_document().dump_display_list();
 }
 
+JS::Object* Internals::get_layout_statistics()
+{
+    auto const& statistics = window().associated_document().last_layout_statistics();
+
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("boxesLaidOut"_utf16_fly_string, JS::Value(statistics.boxes_laid_out), JS::default_attributes);
+    result->define_direct_property("boxesReused"_utf16_fly_string, JS::Value(statistics.boxes_reused), JS::default_attributes);
+    return result;
+}
+
+JS::Object* Internals::get_style_sharing_statistics()
+{
+    auto const& statistics = window().associated_document().style_computer().style_sharing_statistics();
+
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("hits"_utf16_fly_string, JS::Value(statistics.hits), JS::default_attributes);
+    result->define_direct_property("misses"_utf16_fly_string, JS::Value(statistics.misses), JS::default_attributes);
+    return result;
+}
+
+JS::Object* Internals::get_style_memory_statistics()
+{
+    auto statistics = window().associated_document().style_memory_statistics();
+
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("computedStyles"_utf16_fly_string, JS::Value(statistics.computed_style_count), JS::default_attributes);
+    result->define_direct_property("propertyGroups"_utf16_fly_string, JS::Value(statistics.property_group_count), JS::default_attributes);
+    result->define_direct_property("bytes"_utf16_fly_string, JS::Value(statistics.bytes), JS::default_attributes);
+    result->define_direct_property("bytesWithoutSharing"_utf16_fly_string, JS::Value(statistics.bytes_without_sharing), JS::default_attributes);
+    return result;
+}
+
+JS::Object* Internals::get_speculative_fetch_statistics()
+{
+    auto const& statistics = window().associated_document().speculative_fetch_statistics();
+
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("fetchesStarted"_utf16_fly_string, JS::Value(statistics.fetches_started), JS::default_attributes);
+    result->define_direct_property("fetchesUsed"_utf16_fly_string, JS::Value(statistics.fetches_used), JS::default_attributes);
+    return result;
+}
+
 GC::Ptr<DOM::ShadowRoot> Internals::get_shadow_root(GC::Ref<DOM::Element> element)
 {
     return element->shadow_root();
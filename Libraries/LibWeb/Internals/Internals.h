@@ -66,6 +66,10 @@ public:
     bool headless();
 
     String dump_display_list();
+    JS::Object* get_layout_statistics();
+    JS::Object* get_style_sharing_statistics();
+    JS::Object* get_style_memory_statistics();
+    JS::Object* get_speculative_fetch_statistics();
 
     GC::Ptr<DOM::ShadowRoot> get_shadow_root(GC::Ref<DOM::Element>);
 
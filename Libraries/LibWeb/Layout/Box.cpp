@@ -10,6 +10,7 @@
 #include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/FormattingContext.h>
+#include <LibWeb/Layout/LayoutState.h>
 #include <LibWeb/Layout/TableWrapper.h>
 #include <LibWeb/Painting/PaintableBox.h>
 
@@ -61,6 +62,18 @@ void Box::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_contained_abspos_children);
+    if (m_retained_layout)
+        m_retained_layout->visit_edges(visitor);
+}
+
+void Box::set_retained_layout(NonnullOwnPtr<RetainedLayout> retained_layout) const
+{
+    m_retained_layout = move(retained_layout);
+}
+
+void Box::clear_retained_layout() const
+{
+    m_retained_layout.clear();
 }
 
 GC::Ptr<Painting::Paintable> Box::create_paintable() const
@@ -18,6 +18,8 @@ struct LineBoxFragmentCoordinate {
     size_t fragment_index { 0 };
 };
 
+struct RetainedLayout;
+
 struct IntrinsicSizes {
     Optional<CSSPixels> min_content_width;
     Optional<CSSPixels> max_content_width;
@@ -69,6 +71,11 @@ public:
     }
     void reset_cached_intrinsic_sizes() const { m_cached_intrinsic_sizes.clear(); }
 
+    // The results of this box's inside layout, if it's a relayout boundary and nothing inside it has changed since.
+    RetainedLayout const* retained_layout() const { return m_retained_layout.ptr(); }
+    void set_retained_layout(NonnullOwnPtr<RetainedLayout>) const;
+    void clear_retained_layout() const;
+
 protected:
     Box(DOM::Document&, DOM::Node*, GC::Ref<CSS::ComputedProperties>);
     Box(DOM::Document&, DOM::Node*, NonnullOwnPtr<CSS::ComputedValues>);
@@ -83,6 +90,7 @@ private:
     Vector<GC::Ref<Node>> m_contained_abspos_children;
 
     OwnPtr<IntrinsicSizes> mutable m_cached_intrinsic_sizes;
+    OwnPtr<RetainedLayout> mutable m_retained_layout;
 };
 
 template<>
@@ -196,6 +196,40 @@ struct DummyFormattingContext : public FormattingContext {
     virtual void run(AvailableSpace const&) override { }
 };
 
+// Stands in for the formatting context of a relayout boundary whose inside layout was reused from an earlier pass.
+class ReusedFormattingContext final : public FormattingContext {
+public:
+    ReusedFormattingContext(LayoutState& state, LayoutMode layout_mode, Box const& box, RetainedLayout const& retained_layout)
+        : FormattingContext(Type::InternalDummy, layout_mode, state, box)
+        , m_automatic_content_width(retained_layout.automatic_content_width)
+        , m_automatic_content_height(retained_layout.automatic_content_height)
+    {
+    }
+    virtual CSSPixels automatic_content_width() const override { return m_automatic_content_width; }
+    virtual CSSPixels automatic_content_height() const override { return m_automatic_content_height; }
+    virtual void run(AvailableSpace const&) override { }
+
+private:
+    CSSPixels m_automatic_content_width;
+    CSSPixels m_automatic_content_height;
+};
+
+// A relayout boundary is a box whose inside layout only depends on its own size and the space available to it, so
+// that the results can be reused for as long as those and everything inside the box stay the same.
+static bool is_relayout_boundary(Box const& box, LayoutState::UsedValues const& used_values)
+{
+    auto type = FormattingContext::formatting_context_type_created_by_box(box);
+    if (type != FormattingContext::Type::Block && type != FormattingContext::Type::Flex && type != FormattingContext::Type::Grid)
+        return false;
+
+    // NOTE: We don't use has_layout_containment() here, as the insides of boxes with content-visibility: auto come
+    //       and go depending on whether they're relevant to the user.
+    if (box.computed_values().contain().layout_containment)
+        return true;
+
+    return used_values.has_definite_width() && used_values.has_definite_height();
+}
+
 OwnPtr<FormattingContext> FormattingContext::create_independent_formatting_context_if_needed(LayoutState& state, LayoutMode layout_mode, Box const& child_box)
 {
     auto type = formatting_context_type_created_by_box(child_box);
@@ -245,12 +279,46 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     if (!child_box.can_have_children())
         return {};
 
+    Optional<RelayoutBoundaryInputs> relayout_boundary_inputs;
+    if (layout_mode == LayoutMode::Normal && m_state.retains_results_for_relayout_boundaries) {
+        auto const& used_values = m_state.get(child_box);
+        if (is_relayout_boundary(child_box, used_values)) {
+            relayout_boundary_inputs = RelayoutBoundaryInputs {
+                .available_space = available_space,
+                .content_width = used_values.content_width(),
+                .content_height = used_values.content_height(),
+                .has_definite_width = used_values.has_definite_width(),
+                .has_definite_height = used_values.has_definite_height(),
+                .padding_left = used_values.padding_left,
+                .padding_right = used_values.padding_right,
+                .padding_top = used_values.padding_top,
+                .padding_bottom = used_values.padding_bottom,
+            };
+
+            // OPTIMIZATION: If neither the box nor anything inside it has changed since the last layout pass, the
+            //               results of that pass are still good.
+            if (auto const* retained_layout = m_state.reusable_layout_for_relayout_boundary(child_box, *relayout_boundary_inputs)) {
+                m_state.restore_layout_of_relayout_boundary(child_box, *retained_layout);
+                return make<ReusedFormattingContext>(m_state, layout_mode, child_box, *retained_layout);
+            }
+        }
+        child_box.clear_retained_layout();
+    }
+
     auto independent_formatting_context = create_independent_formatting_context_if_needed(m_state, layout_mode, child_box);
     if (independent_formatting_context)
         independent_formatting_context->run(available_space);
     else
         run(available_space);
 
+    if (relayout_boundary_inputs.has_value() && independent_formatting_context) {
+        m_state.did_lay_out_relayout_boundary(
+            child_box,
+            *relayout_boundary_inputs,
+            independent_formatting_context->automatic_content_width(),
+            independent_formatting_context->automatic_content_height());
+    }
+
     return independent_formatting_context;
 }
 
@@ -50,6 +50,127 @@ LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
     return *new_used_values_ptr;
 }
 
+// Calls the callback for every node inside the relayout boundary in tree order, except for the insides of nested
+// relayout boundaries that retain results of their own.
+template<typename Callback>
+static void for_each_node_inside_relayout_boundary(Box const& box, Callback callback)
+{
+    box.for_each_in_subtree([&](Node const& node) {
+        if (callback(node) == IterationDecision::Break)
+            return TraversalDecision::Break;
+        if (auto const* nested_box = as_if<Box>(node); nested_box && nested_box->retained_layout())
+            return TraversalDecision::SkipChildrenAndContinue;
+        return TraversalDecision::Continue;
+    });
+}
+
+static bool layout_tree_matches_retained_layout(Box const& box, RetainedLayout const& retained_layout)
+{
+    size_t index = 0;
+    bool matches = true;
+
+    for_each_node_inside_relayout_boundary(box, [&](Node const& node) {
+        if (index >= retained_layout.nodes.size() || retained_layout.nodes[index].ptr() != &node) {
+            matches = false;
+            return IterationDecision::Break;
+        }
+        ++index;
+
+        if (auto const* nested_box = as_if<Box>(node); nested_box && nested_box->retained_layout()) {
+            if (!layout_tree_matches_retained_layout(*nested_box, *nested_box->retained_layout())) {
+                matches = false;
+                return IterationDecision::Break;
+            }
+        }
+        return IterationDecision::Continue;
+    });
+
+    return matches && index == retained_layout.nodes.size();
+}
+
+RetainedLayout const* LayoutState::reusable_layout_for_relayout_boundary(Box const& box, RelayoutBoundaryInputs const& inputs) const
+{
+    auto const* retained_layout = box.retained_layout();
+    if (!retained_layout || box.needs_layout_update() || retained_layout->inputs != inputs)
+        return nullptr;
+
+    // NOTE: Anything that changes inside the box marks it as needing layout, which drops the retained results. This
+    //       guards against changes to the layout tree that go unnoticed by that.
+    if (!layout_tree_matches_retained_layout(box, *retained_layout))
+        return nullptr;
+
+    return retained_layout;
+}
+
+void LayoutState::restore_layout_of_relayout_boundary(Box const& box, RetainedLayout const& retained_layout)
+{
+    get_mutable(box).restore_inside_layout_results_from(retained_layout.box_used_values);
+
+    size_t index = 0;
+    for_each_node_inside_relayout_boundary(box, [&](Node const& node) {
+        if (index < retained_layout.used_values.size() && &retained_layout.used_values[index].node() == &node) {
+            get_mutable(static_cast<NodeWithStyle const&>(node)).restore_from(retained_layout.used_values[index]);
+            if (node.is_box())
+                ++m_reused_box_count;
+            ++index;
+        }
+
+        if (auto const* nested_box = as_if<Box>(node); nested_box && nested_box->retained_layout())
+            restore_layout_of_relayout_boundary(*nested_box, *nested_box->retained_layout());
+        return IterationDecision::Continue;
+    });
+
+    VERIFY(index == retained_layout.used_values.size());
+}
+
+void LayoutState::did_lay_out_relayout_boundary(Box const& box, RelayoutBoundaryInputs const& inputs, CSSPixels automatic_content_width, CSSPixels automatic_content_height)
+{
+    m_laid_out_relayout_boundaries.set(box, adopt_own(*new RetainedLayout {
+                                                .inputs = inputs,
+                                                .automatic_content_width = automatic_content_width,
+                                                .automatic_content_height = automatic_content_height,
+                                                .box_used_values = {},
+                                                .nodes = {},
+                                                .used_values = {},
+                                            }));
+}
+
+void LayoutState::retain_results_for_relayout_boundaries()
+{
+    // NOTE: Relayout boundaries are recorded once their inside layout is done, so nested ones come before the ones
+    //       they are nested in. This lets the latter leave out the insides of the former.
+    for (auto& it : m_laid_out_relayout_boundaries) {
+        auto const& box = *it.key;
+        auto& retained_layout = *it.value;
+        bool can_retain = true;
+
+        for_each_node_inside_relayout_boundary(box, [&](Node const& node) {
+            // Absolutely positioned boxes are laid out by the formatting context of their containing block. If that's
+            // outside this box, the results of its inside layout don't include them.
+            if (node.is_absolutely_positioned()) {
+                auto containing_block = node.containing_block();
+                if (!containing_block || !box.is_inclusive_ancestor_of(*containing_block)) {
+                    can_retain = false;
+                    return IterationDecision::Break;
+                }
+            }
+
+            retained_layout.nodes.append(node);
+            if (auto used_values = used_values_per_layout_node.get(node); used_values.has_value())
+                retained_layout.used_values.append(*used_values.value());
+            return IterationDecision::Continue;
+        });
+
+        if (!can_retain)
+            continue;
+
+        retained_layout.box_used_values = get(box);
+        box.set_retained_layout(move(it.value));
+    }
+
+    m_laid_out_relayout_boundaries.clear();
+}
+
 // https://drafts.csswg.org/css-overflow-3/#scrollable-overflow-region
 static CSSPixelRect measure_scrollable_overflow(Box const& box)
 {
@@ -682,6 +803,21 @@ AvailableSpace LayoutState::UsedValues::available_inner_space_or_constraints_fro
     return AvailableSpace(inner_width, inner_height);
 }
 
+void LayoutState::UsedValues::restore_from(UsedValues const& retained)
+{
+    auto const* containing_block_used_values = m_containing_block_used_values;
+    *this = retained;
+    m_containing_block_used_values = containing_block_used_values;
+}
+
+void LayoutState::UsedValues::restore_inside_layout_results_from(UsedValues const& retained)
+{
+    line_boxes = retained.line_boxes;
+    m_floating_descendants = retained.m_floating_descendants;
+    m_grid_template_columns = retained.m_grid_template_columns;
+    m_grid_template_rows = retained.m_grid_template_rows;
+}
+
 void LayoutState::UsedValues::set_indefinite_content_width()
 {
     m_has_definite_width = false;
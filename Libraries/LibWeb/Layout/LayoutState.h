@@ -9,6 +9,7 @@
 #include <AK/HashMap.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Point.h>
+#include <LibWeb/Layout/AvailableSpace.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/LineBox.h>
 #include <LibWeb/Painting/PaintableBox.h>
@@ -22,8 +23,23 @@ enum class SizeConstraint {
     MaxContent,
 };
 
-class AvailableSize;
-class AvailableSpace;
+// The inputs to the inside layout of a relayout boundary. As long as they stay the same, and nothing inside the box
+// changes, laying out its inside again would produce the same results.
+struct RelayoutBoundaryInputs {
+    AvailableSpace available_space;
+    CSSPixels content_width;
+    CSSPixels content_height;
+    bool has_definite_width { false };
+    bool has_definite_height { false };
+
+    // NOTE: Absolutely positioned descendants are positioned relative to the padding box.
+    CSSPixels padding_left;
+    CSSPixels padding_right;
+    CSSPixels padding_top;
+    CSSPixels padding_bottom;
+
+    bool operator==(RelayoutBoundaryInputs const&) const = default;
+};
 
 // https://www.w3.org/TR/css-position-3/#static-position-rectangle
 struct StaticPositionRect {
@@ -154,6 +170,12 @@ struct LayoutState {
         void set_grid_template_rows(RefPtr<CSS::GridTrackSizeListStyleValue const> used_values_for_grid_template_rows) { m_grid_template_rows = move(used_values_for_grid_template_rows); }
         auto const& grid_template_rows() const { return m_grid_template_rows; }
 
+        // Takes over the used values from an earlier layout pass, while keeping this node's place in the current one.
+        void restore_from(UsedValues const&);
+
+        // Takes over what an earlier inside layout of this box produced, leaving what the parent decided alone.
+        void restore_inside_layout_results_from(UsedValues const&);
+
         void set_static_position_rect(StaticPositionRect const& static_position_rect) { m_static_position_rect = static_position_rect; }
         CSSPixelPoint static_position() const
         {
@@ -206,8 +228,45 @@ struct LayoutState {
 
     OrderedHashMap<GC::Ref<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
 
+    // Set for the layout pass that produces a document's paintables. The results of such passes are retained for
+    // relayout boundaries, and reused by later passes where possible.
+    bool retains_results_for_relayout_boundaries { false };
+
+    // Returns the retained results for the box if they may be used in place of laying out its inside again.
+    RetainedLayout const* reusable_layout_for_relayout_boundary(Box const&, RelayoutBoundaryInputs const&) const;
+    void restore_layout_of_relayout_boundary(Box const&, RetainedLayout const&);
+
+    void did_lay_out_relayout_boundary(Box const&, RelayoutBoundaryInputs const&, CSSPixels automatic_content_width, CSSPixels automatic_content_height);
+
+    // Hands the results of this pass to the relayout boundaries that were laid out in it. Must be called before
+    // commit(), which modifies some of the used values.
+    void retain_results_for_relayout_boundaries();
+
+    // The number of boxes whose used values were reused from an earlier pass rather than laid out in this one.
+    size_t reused_box_count() const { return m_reused_box_count; }
+
 private:
     void resolve_relative_positions();
+
+    OrderedHashMap<GC::Ref<Box const>, NonnullOwnPtr<RetainedLayout>> m_laid_out_relayout_boundaries;
+    size_t m_reused_box_count { 0 };
+};
+
+// The results of laying out the inside of a relayout boundary, kept on the box so that later passes can reuse them.
+struct RetainedLayout {
+    RelayoutBoundaryInputs inputs;
+    CSSPixels automatic_content_width;
+    CSSPixels automatic_content_height;
+
+    // The box's own used values, as its inside layout left them.
+    LayoutState::UsedValues box_used_values;
+
+    // Every node inside the box in tree order, and the used values of those that have any. The insides of nested
+    // relayout boundaries are left out, as those retain their own results.
+    Vector<GC::Ref<Node const>> nodes;
+    Vector<LayoutState::UsedValues> used_values;
+
+    void visit_edges(GC::Cell::Visitor& visitor) const { visitor.visit(nodes); }
 };
 
 inline CSSPixels clamp_to_max_dimension_value(CSSPixels value)
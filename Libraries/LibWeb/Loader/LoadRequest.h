@@ -10,6 +10,7 @@
 #include <AK/HashMap.h>
 #include <AK/Time.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibRequests/CachePartition.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Forward.h>
@@ -47,6 +48,9 @@ public:
     GC::Ptr<Page> page() const { return m_page.ptr(); }
     void set_page(Page& page) { m_page = page; }
 
+    Optional<Requests::CachePartition> const& cache_partition() const { return m_cache_partition; }
+    void set_cache_partition(Optional<Requests::CachePartition> cache_partition) { m_cache_partition = move(cache_partition); }
+
     unsigned hash() const
     {
         auto body_hash = string_hash((char const*)m_body.data(), m_body.size());
@@ -83,6 +87,7 @@ private:
     ByteBuffer m_body;
     Core::ElapsedTimer m_load_timer;
     GC::Root<Page> m_page;
+    Optional<Requests::CachePartition> m_cache_partition;
     bool m_main_resource { false };
 };
 
@@ -552,7 +552,7 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
         return nullptr;
     }
 
-    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy);
+    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy, request.cache_partition());
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
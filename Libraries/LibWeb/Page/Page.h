@@ -34,6 +34,7 @@
 #include <LibWeb/HTML/SelectItem.h>
 #include <LibWeb/HTML/TokenizedFeatures.h>
 #include <LibWeb/HTML/WebViewHints.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
 #include <LibWeb/Loader/FileRequest.h>
 #include <LibWeb/Page/EventResult.h>
 #include <LibWeb/Page/InputEvent.h>
@@ -365,6 +366,11 @@ public:
     virtual void page_did_remove_storage_item([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& bottle_key) { }
     virtual Vector<String> page_did_request_storage_keys([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key) { return {}; }
     virtual void page_did_clear_storage([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key) { }
+    virtual Optional<IndexedDB::PersistedDatabaseContents> page_did_request_indexed_db_database([[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& name) { return {}; }
+    virtual Vector<IndexedDB::PersistedDatabase> page_did_request_indexed_db_databases([[maybe_unused]] String const& storage_key) { return {}; }
+    virtual Optional<ByteBuffer> page_did_request_indexed_db_record_value([[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& name, [[maybe_unused]] u64 object_store_id, [[maybe_unused]] ByteBuffer const& key) { return {}; }
+    virtual void page_did_commit_indexed_db_changes([[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& name, [[maybe_unused]] IndexedDB::PersistedDatabaseChanges const& changes) { }
+    virtual void page_did_delete_indexed_db_database([[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& name) { }
     virtual void page_did_update_resource_count(i32) { }
     struct NewWebViewResult {
         GC::Ptr<Page> page;
@@ -19,6 +19,7 @@
 #include <LibWebView/Database.h>
 #include <LibWebView/HeadlessWebView.h>
 #include <LibWebView/HelperProcess.h>
+#include <LibWebView/IndexedDBStorage.h>
 #include <LibWebView/URL.h>
 #include <LibWebView/UserAgent.h>
 #include <LibWebView/Utilities.h>
@@ -101,6 +102,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     bool allow_popups = false;
     bool disable_scripting = false;
     bool disable_sql_database = false;
+    bool disable_http_disk_cache = false;
     Optional<u16> devtools_port;
     Optional<StringView> debug_process;
     Optional<StringView> profile_process;
@@ -115,6 +117,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     bool disable_site_isolation = false;
     bool enable_idl_tracing = false;
     bool enable_http_cache = false;
+    bool enable_bytecode_cache = false;
     bool enable_autoplay = false;
     bool expose_internals_object = false;
     bool force_cpu_painting = false;
@@ -154,6 +157,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     args_parser.add_option(allow_popups, "Disable popup blocking by default", "allow-popups");
     args_parser.add_option(disable_scripting, "Disable scripting by default", "disable-scripting");
     args_parser.add_option(disable_sql_database, "Disable SQL database", "disable-sql-database");
+    args_parser.add_option(disable_http_disk_cache, "Disable the on-disk HTTP cache", "disable-http-disk-cache");
     args_parser.add_option(debug_process, "Wait for a debugger to attach to the given process name (WebContent, RequestServer, etc.)", "debug-process", 0, "process-name");
     args_parser.add_option(profile_process, "Enable callgrind profiling of the given process name (WebContent, RequestServer, etc.)", "profile-process", 0, "process-name");
     args_parser.add_option(webdriver_content_ipc_path, "Path to WebDriver IPC for WebContent", "webdriver-content-path", 0, "path", Core::ArgsParser::OptionHideMode::CommandLineAndMarkdown);
@@ -162,6 +166,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     args_parser.add_option(disable_site_isolation, "Disable site isolation", "disable-site-isolation");
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
     args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
+    args_parser.add_option(enable_bytecode_cache, "Reuse compiled JavaScript bytecode across page loads (experimental)", "enable-bytecode-cache");
     args_parser.add_option(enable_autoplay, "Enable multimedia autoplay", "enable-autoplay");
     args_parser.add_option(expose_internals_object, "Expose internals object", "expose-internals-object");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
@@ -203,9 +208,11 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     args_parser.parse(m_arguments);
 
     // Our persisted SQL storage assumes it runs in a singleton process. If we have multiple UI processes accessing
-    // the same underlying database, one of them is likely to fail.
-    if (force_new_process)
+    // the same underlying database, one of them is likely to fail. The same goes for the HTTP disk cache's index.
+    if (force_new_process) {
         disable_sql_database = true;
+        disable_http_disk_cache = true;
+    }
 
     if (!dns_server_port.has_value())
         dns_server_port = use_dns_over_tls ? 853 : 53;
@@ -232,6 +239,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         .allow_popups = allow_popups ? AllowPopups::Yes : AllowPopups::No,
         .disable_scripting = disable_scripting ? DisableScripting::Yes : DisableScripting::No,
         .disable_sql_database = disable_sql_database ? DisableSQLDatabase::Yes : DisableSQLDatabase::No,
+        .disable_http_disk_cache = disable_http_disk_cache ? DisableHTTPDiskCache::Yes : DisableHTTPDiskCache::No,
         .debug_helper_process = move(debug_process_type),
         .profile_helper_process = move(profile_process_type),
         .dns_settings = (dns_server_address.has_value()
@@ -259,6 +267,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         .disable_site_isolation = disable_site_isolation ? DisableSiteIsolation::Yes : DisableSiteIsolation::No,
         .enable_idl_tracing = enable_idl_tracing ? EnableIDLTracing::Yes : EnableIDLTracing::No,
         .enable_http_cache = enable_http_cache ? EnableHTTPCache::Yes : EnableHTTPCache::No,
+        .enable_bytecode_cache = enable_bytecode_cache ? EnableBytecodeCache::Yes : EnableBytecodeCache::No,
         .expose_internals_object = expose_internals_object ? ExposeInternalsObject::Yes : ExposeInternalsObject::No,
         .force_cpu_painting = force_cpu_painting ? ForceCPUPainting::Yes : ForceCPUPainting::No,
         .force_fontconfig = force_fontconfig ? ForceFontconfig::Yes : ForceFontconfig::No,
@@ -341,9 +350,11 @@ ErrorOr<void> Application::launch_services()
         m_database = Database::create().release_value_but_fixme_should_propagate_errors();
         m_cookie_jar = CookieJar::create(*m_database).release_value_but_fixme_should_propagate_errors();
         m_storage_jar = StorageJar::create(*m_database).release_value_but_fixme_should_propagate_errors();
+        m_indexed_db_storage = IndexedDBStorage::create(*m_database).release_value_but_fixme_should_propagate_errors();
     } else {
         m_cookie_jar = CookieJar::create();
         m_storage_jar = StorageJar::create();
+        m_indexed_db_storage = IndexedDBStorage::create();
     }
 
     // No need to monitor the system time zone if the TZ environment variable is set, as it overrides system preferences.
@@ -49,6 +49,7 @@ public:
 
     static CookieJar& cookie_jar() { return *the().m_cookie_jar; }
     static StorageJar& storage_jar() { return *the().m_storage_jar; }
+    static IndexedDBStorage& indexed_db_storage() { return *the().m_indexed_db_storage; }
 
     static ProcessManager& process_manager() { return *the().m_process_manager; }
 
@@ -142,6 +143,7 @@ private:
     RefPtr<Database> m_database;
     OwnPtr<CookieJar> m_cookie_jar;
     OwnPtr<StorageJar> m_storage_jar;
+    OwnPtr<IndexedDBStorage> m_indexed_db_storage;
 
     OwnPtr<Core::TimeZoneWatcher> m_time_zone_watcher;
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
 #include <AK/String.h>
 #include <AK/Time.h>
@@ -45,8 +46,11 @@ ErrorOr<NonnullRefPtr<Database>> Database::create()
     auto database_path = ByteString::formatted("{}/Ladybird", Core::StandardPaths::user_data_directory());
     TRY(Core::Directory::create(database_path, Core::Directory::CreateDirectories::Yes));
 
-    auto database_file = ByteString::formatted("{}/Ladybird.db", database_path);
+    return create(ByteString::formatted("{}/Ladybird.db", database_path));
+}
 
+ErrorOr<NonnullRefPtr<Database>> Database::create(ByteString const& database_file)
+{
     sqlite3* m_database { nullptr };
     SQL_TRY(sqlite3_open(database_file.characters(), &m_database));
 
@@ -114,15 +118,25 @@ void Database::apply_placeholder(StatementID statement_id, int index, ValueType
         SQL_MUST(sqlite3_bind_int64(statement, index, value.offset_to_epoch().to_milliseconds()));
     } else if constexpr (IsSame<ValueType, int>) {
         SQL_MUST(sqlite3_bind_int(statement, index, value));
+    } else if constexpr (IsSame<ValueType, u64>) {
+        SQL_MUST(sqlite3_bind_int64(statement, index, static_cast<sqlite3_int64>(value)));
     } else if constexpr (IsSame<ValueType, bool>) {
         SQL_MUST(sqlite3_bind_int(statement, index, static_cast<int>(value)));
+    } else if constexpr (IsSame<ValueType, ByteBuffer>) {
+        // NOTE: SQLite binds a null pointer as NULL rather than as an empty blob.
+        if (value.is_empty())
+            SQL_MUST(sqlite3_bind_zeroblob(statement, index, 0));
+        else
+            SQL_MUST(sqlite3_bind_blob(statement, index, value.data(), static_cast<int>(value.size()), SQLITE_TRANSIENT));
     }
 }
 
 template void Database::apply_placeholder(StatementID, int, String const&);
 template void Database::apply_placeholder(StatementID, int, UnixDateTime const&);
 template void Database::apply_placeholder(StatementID, int, int const&);
+template void Database::apply_placeholder(StatementID, int, u64 const&);
 template void Database::apply_placeholder(StatementID, int, bool const&);
+template void Database::apply_placeholder(StatementID, int, ByteBuffer const&);
 
 template<typename ValueType>
 ValueType Database::result_column(StatementID statement_id, int column)
@@ -137,8 +151,14 @@ ValueType Database::result_column(StatementID statement_id, int column)
         return UnixDateTime::from_milliseconds_since_epoch(milliseconds);
     } else if constexpr (IsSame<ValueType, int>) {
         return sqlite3_column_int(statement, column);
+    } else if constexpr (IsSame<ValueType, u64>) {
+        return static_cast<u64>(sqlite3_column_int64(statement, column));
     } else if constexpr (IsSame<ValueType, bool>) {
         return static_cast<bool>(sqlite3_column_int(statement, column));
+    } else if constexpr (IsSame<ValueType, ByteBuffer>) {
+        auto const* blob = static_cast<u8 const*>(sqlite3_column_blob(statement, column));
+        auto size = static_cast<size_t>(sqlite3_column_bytes(statement, column));
+        return MUST(ByteBuffer::copy(blob, size));
     }
 
     VERIFY_NOT_REACHED();
@@ -147,6 +167,8 @@ ValueType Database::result_column(StatementID statement_id, int column)
 template String Database::result_column(StatementID, int);
 template UnixDateTime Database::result_column(StatementID, int);
 template int Database::result_column(StatementID, int);
+template u64 Database::result_column(StatementID, int);
 template bool Database::result_column(StatementID, int);
+template ByteBuffer Database::result_column(StatementID, int);
 
 }
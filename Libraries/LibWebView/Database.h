@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/ByteString.h>
 #include <AK/Error.h>
 #include <AK/Function.h>
 #include <AK/NonnullRefPtr.h>
@@ -23,6 +24,7 @@ namespace WebView {
 class WEBVIEW_API Database : public RefCounted<Database> {
 public:
     static ErrorOr<NonnullRefPtr<Database>> create();
+    static ErrorOr<NonnullRefPtr<Database>> create(ByteString const& database_file);
     ~Database();
 
     using StatementID = size_t;
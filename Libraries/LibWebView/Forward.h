@@ -16,6 +16,7 @@ class Application;
 class Autocomplete;
 class CookieJar;
 class Database;
+class IndexedDBStorage;
 class OutOfProcessWebView;
 class ProcessManager;
 class Settings;
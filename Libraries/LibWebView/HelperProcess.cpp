@@ -58,6 +58,11 @@ static ErrorOr<NonnullRefPtr<ClientType>> launch_server_process(
                 client->transport().set_peer_pid(response->peer_pid());
             }
 
+            // NOTE: The WebWorker transport is cloned for the WebContent process that owns the worker, so both of them
+            //       would have to read from a ring that only one of them can see.
+            if constexpr (!IsSame<ClientType, Web::HTML::WebWorkerClient>)
+                client->transport().offer_shared_memory_ring();
+
             WebView::Application::the().add_child_process(move(process));
 
             if (browser_options.profile_helper_process == process_type) {
@@ -112,6 +117,8 @@ static ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_proc
         arguments.append("--enable-idl-tracing"sv);
     if (web_content_options.enable_http_cache == WebView::EnableHTTPCache::Yes)
         arguments.append("--enable-http-cache"sv);
+    if (web_content_options.enable_bytecode_cache == WebView::EnableBytecodeCache::Yes)
+        arguments.append("--enable-bytecode-cache"sv);
     if (web_content_options.expose_internals_object == WebView::ExposeInternalsObject::Yes)
         arguments.append("--expose-internals-object"sv);
     if (web_content_options.force_cpu_painting == WebView::ForceCPUPainting::Yes)
@@ -206,6 +213,12 @@ ErrorOr<NonnullRefPtr<Requests::RequestClient>> launch_request_server_process()
     for (auto const& certificate : WebView::Application::browser_options().certificates)
         arguments.append(ByteString::formatted("--certificate={}", certificate));
 
+    // Layout tests must not be affected by responses stored in earlier runs.
+    if (WebView::Application::browser_options().disable_http_disk_cache == WebView::DisableHTTPDiskCache::Yes
+        || WebView::Application::web_content_options().is_layout_test_mode == WebView::IsLayoutTestMode::Yes) {
+        arguments.append("--disable-http-disk-cache"sv);
+    }
+
     if (auto server = mach_server_name(); server.has_value()) {
         arguments.append("--mach-server-name"sv);
         arguments.append(server.value());
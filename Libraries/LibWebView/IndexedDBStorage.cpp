@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibWebView/IndexedDBStorage.h>
+
+namespace WebView {
+
+using Web::IndexedDB::KeyPath;
+using Web::IndexedDB::PersistedDatabase;
+using Web::IndexedDB::PersistedDatabaseChanges;
+using Web::IndexedDB::PersistedDatabaseContents;
+using Web::IndexedDB::PersistedIndex;
+using Web::IndexedDB::PersistedObjectStore;
+using Web::IndexedDB::PersistedRecord;
+
+ErrorOr<NonnullOwnPtr<IndexedDBStorage>> IndexedDBStorage::create(Database& database)
+{
+    Statements statements {};
+
+    // NOTE: Object stores and indexes are small, so each database keeps them in a single JSON column.
+    auto create_databases_table = TRY(database.prepare_statement(R"#(
+        CREATE TABLE IF NOT EXISTS IndexedDBDatabases (
+            storage_key TEXT,
+            name TEXT,
+            version INTEGER,
+            object_stores TEXT,
+            PRIMARY KEY(storage_key, name)
+        );)#"sv));
+    database.execute_statement(create_databases_table, {});
+
+    auto create_records_table = TRY(database.prepare_statement(R"#(
+        CREATE TABLE IF NOT EXISTS IndexedDBRecords (
+            storage_key TEXT,
+            database_name TEXT,
+            object_store_id INTEGER,
+            key BLOB,
+            value BLOB,
+            PRIMARY KEY(storage_key, database_name, object_store_id, key)
+        );)#"sv));
+    database.execute_statement(create_records_table, {});
+
+    auto create_index_records_table = TRY(database.prepare_statement(R"#(
+        CREATE TABLE IF NOT EXISTS IndexedDBIndexRecords (
+            storage_key TEXT,
+            database_name TEXT,
+            index_id INTEGER,
+            key BLOB,
+            value BLOB,
+            PRIMARY KEY(storage_key, database_name, index_id, key, value)
+        );)#"sv));
+    database.execute_statement(create_index_records_table, {});
+
+    statements.begin_transaction = TRY(database.prepare_statement("BEGIN TRANSACTION;"sv));
+    statements.commit_transaction = TRY(database.prepare_statement("COMMIT;"sv));
+
+    statements.get_database = TRY(database.prepare_statement("SELECT version, object_stores FROM IndexedDBDatabases WHERE storage_key = ? AND name = ?;"sv));
+    statements.get_databases = TRY(database.prepare_statement("SELECT name, version, object_stores FROM IndexedDBDatabases WHERE storage_key = ?;"sv));
+    statements.set_database = TRY(database.prepare_statement("INSERT OR REPLACE INTO IndexedDBDatabases VALUES (?, ?, ?, ?);"sv));
+    statements.delete_database = TRY(database.prepare_statement("DELETE FROM IndexedDBDatabases WHERE storage_key = ? AND name = ?;"sv));
+
+    statements.get_record_keys = TRY(database.prepare_statement("SELECT object_store_id, key FROM IndexedDBRecords WHERE storage_key = ? AND database_name = ?;"sv));
+    statements.get_record_value = TRY(database.prepare_statement("SELECT value FROM IndexedDBRecords WHERE storage_key = ? AND database_name = ? AND object_store_id = ? AND key = ?;"sv));
+    statements.set_record = TRY(database.prepare_statement("INSERT OR REPLACE INTO IndexedDBRecords VALUES (?, ?, ?, ?, ?);"sv));
+    statements.delete_record = TRY(database.prepare_statement("DELETE FROM IndexedDBRecords WHERE storage_key = ? AND database_name = ? AND object_store_id = ? AND key = ?;"sv));
+    statements.delete_object_store_records = TRY(database.prepare_statement("DELETE FROM IndexedDBRecords WHERE storage_key = ? AND database_name = ? AND object_store_id = ?;"sv));
+    statements.delete_database_records = TRY(database.prepare_statement("DELETE FROM IndexedDBRecords WHERE storage_key = ? AND database_name = ?;"sv));
+
+    statements.get_index_records = TRY(database.prepare_statement("SELECT index_id, key, value FROM IndexedDBIndexRecords WHERE storage_key = ? AND database_name = ?;"sv));
+    statements.set_index_record = TRY(database.prepare_statement("INSERT OR REPLACE INTO IndexedDBIndexRecords VALUES (?, ?, ?, ?, ?);"sv));
+    statements.delete_index_record = TRY(database.prepare_statement("DELETE FROM IndexedDBIndexRecords WHERE storage_key = ? AND database_name = ? AND index_id = ? AND key = ? AND value = ?;"sv));
+    statements.delete_index_records = TRY(database.prepare_statement("DELETE FROM IndexedDBIndexRecords WHERE storage_key = ? AND database_name = ? AND index_id = ?;"sv));
+    statements.delete_database_index_records = TRY(database.prepare_statement("DELETE FROM IndexedDBIndexRecords WHERE storage_key = ? AND database_name = ?;"sv));
+
+    return adopt_own(*new IndexedDBStorage { PersistedStorage { database, statements } });
+}
+
+NonnullOwnPtr<IndexedDBStorage> IndexedDBStorage::create()
+{
+    return adopt_own(*new IndexedDBStorage { OptionalNone {} });
+}
+
+IndexedDBStorage::IndexedDBStorage(Optional<PersistedStorage> persisted_storage)
+    : m_persisted_storage(move(persisted_storage))
+{
+}
+
+IndexedDBStorage::~IndexedDBStorage() = default;
+
+static JsonValue key_path_to_json(KeyPath const& key_path)
+{
+    return key_path.visit(
+        [](String const& path) -> JsonValue { return path; },
+        [](Vector<String> const& paths) -> JsonValue {
+            JsonArray array;
+            for (auto const& path : paths)
+                array.must_append(path);
+            return array;
+        });
+}
+
+static Optional<KeyPath> key_path_from_json(JsonValue const& value)
+{
+    if (value.is_string())
+        return KeyPath { value.as_string() };
+
+    if (value.is_array()) {
+        Vector<String> paths;
+        for (auto const& path : value.as_array().values()) {
+            if (!path.is_string())
+                return {};
+            paths.append(path.as_string());
+        }
+        return KeyPath { move(paths) };
+    }
+
+    return {};
+}
+
+static String object_stores_to_json(Vector<PersistedObjectStore> const& object_stores)
+{
+    JsonArray array;
+
+    for (auto const& object_store : object_stores) {
+        JsonObject object;
+        object.set("id"sv, object_store.id);
+        object.set("name"sv, object_store.name);
+        if (object_store.key_path.has_value())
+            object.set("keyPath"sv, key_path_to_json(*object_store.key_path));
+        if (object_store.key_generator_current_number.has_value())
+            object.set("keyGeneratorCurrentNumber"sv, *object_store.key_generator_current_number);
+
+        JsonArray indexes;
+        for (auto const& index : object_store.indexes) {
+            JsonObject index_object;
+            index_object.set("id"sv, index.id);
+            index_object.set("name"sv, index.name);
+            index_object.set("keyPath"sv, key_path_to_json(index.key_path));
+            index_object.set("unique"sv, index.unique);
+            index_object.set("multiEntry"sv, index.multi_entry);
+            indexes.must_append(move(index_object));
+        }
+        object.set("indexes"sv, move(indexes));
+
+        array.must_append(move(object));
+    }
+
+    return array.serialized();
+}
+
+static Optional<Vector<PersistedObjectStore>> object_stores_from_json(StringView json)
+{
+    auto value = JsonValue::from_string(json);
+    if (value.is_error() || !value.value().is_array())
+        return {};
+
+    Vector<PersistedObjectStore> object_stores;
+
+    for (auto const& object_store_value : value.value().as_array().values()) {
+        if (!object_store_value.is_object())
+            return {};
+        auto const& object = object_store_value.as_object();
+
+        auto id = object.get_u64("id"sv);
+        auto name = object.get_string("name"sv);
+        auto indexes = object.get_array("indexes"sv);
+        if (!id.has_value() || !name.has_value() || !indexes.has_value())
+            return {};
+
+        PersistedObjectStore object_store { .id = *id, .name = *name, .key_path = {}, .key_generator_current_number = object.get_u64("keyGeneratorCurrentNumber"sv), .indexes = {} };
+
+        if (auto key_path = object.get("keyPath"sv); key_path.has_value()) {
+            object_store.key_path = key_path_from_json(*key_path);
+            if (!object_store.key_path.has_value())
+                return {};
+        }
+
+        for (auto const& index_value : indexes->values()) {
+            if (!index_value.is_object())
+                return {};
+            auto const& index_object = index_value.as_object();
+
+            auto index_id = index_object.get_u64("id"sv);
+            auto index_name = index_object.get_string("name"sv);
+            auto key_path = index_object.get("keyPath"sv).map([](auto const& key_path) { return key_path_from_json(key_path); }).value_or({});
+            auto unique = index_object.get_bool("unique"sv);
+            auto multi_entry = index_object.get_bool("multiEntry"sv);
+            if (!index_id.has_value() || !index_name.has_value() || !key_path.has_value() || !unique.has_value() || !multi_entry.has_value())
+                return {};
+
+            object_store.indexes.append({ *index_id, *index_name, key_path.release_value(), *unique, *multi_entry });
+        }
+
+        object_stores.append(move(object_store));
+    }
+
+    return object_stores;
+}
+
+Optional<PersistedDatabase> IndexedDBStorage::get_database(PersistedStorage& storage, String const& storage_key, String const& name)
+{
+    Optional<PersistedDatabase> result;
+
+    storage.database.execute_statement(
+        storage.statements.get_database,
+        [&](auto statement_id) {
+            auto version = storage.database.result_column<u64>(statement_id, 0);
+            auto object_stores = object_stores_from_json(storage.database.result_column<String>(statement_id, 1));
+
+            if (!object_stores.has_value()) {
+                dbgln("IndexedDBStorage: Ignoring database '{}' with invalid object stores", name);
+                return;
+            }
+
+            result = PersistedDatabase { name, version, object_stores.release_value() };
+        },
+        storage_key,
+        name);
+
+    return result;
+}
+
+Optional<PersistedDatabaseContents> IndexedDBStorage::load_database(String const& storage_key, String const& name)
+{
+    if (!m_persisted_storage.has_value())
+        return {};
+    auto& storage = *m_persisted_storage;
+
+    auto database = get_database(storage, storage_key, name);
+    if (!database.has_value())
+        return {};
+
+    PersistedDatabaseContents contents { database.release_value(), {}, {} };
+
+    // NOTE: Values are left out, since WebContent only asks for those once it needs them.
+    storage.database.execute_statement(
+        storage.statements.get_record_keys,
+        [&](auto statement_id) {
+            contents.records.append({
+                storage.database.result_column<u64>(statement_id, 0),
+                storage.database.result_column<ByteBuffer>(statement_id, 1),
+                {},
+            });
+        },
+        storage_key,
+        name);
+
+    storage.database.execute_statement(
+        storage.statements.get_index_records,
+        [&](auto statement_id) {
+            contents.index_records.append({
+                storage.database.result_column<u64>(statement_id, 0),
+                storage.database.result_column<ByteBuffer>(statement_id, 1),
+                storage.database.result_column<ByteBuffer>(statement_id, 2),
+            });
+        },
+        storage_key,
+        name);
+
+    return contents;
+}
+
+Vector<PersistedDatabase> IndexedDBStorage::databases(String const& storage_key)
+{
+    if (!m_persisted_storage.has_value())
+        return {};
+    auto& storage = *m_persisted_storage;
+
+    Vector<PersistedDatabase> databases;
+
+    storage.database.execute_statement(
+        storage.statements.get_databases,
+        [&](auto statement_id) {
+            auto name = storage.database.result_column<String>(statement_id, 0);
+            auto version = storage.database.result_column<u64>(statement_id, 1);
+            auto object_stores = object_stores_from_json(storage.database.result_column<String>(statement_id, 2));
+
+            if (object_stores.has_value())
+                databases.append({ move(name), version, object_stores.release_value() });
+        },
+        storage_key);
+
+    return databases;
+}
+
+Optional<ByteBuffer> IndexedDBStorage::load_record_value(String const& storage_key, String const& name, u64 object_store_id, ByteBuffer const& key)
+{
+    if (!m_persisted_storage.has_value())
+        return {};
+    auto& storage = *m_persisted_storage;
+
+    Optional<ByteBuffer> value;
+
+    storage.database.execute_statement(
+        storage.statements.get_record_value,
+        [&](auto statement_id) {
+            value = storage.database.result_column<ByteBuffer>(statement_id, 0);
+        },
+        storage_key,
+        name,
+        object_store_id,
+        key);
+
+    return value;
+}
+
+void IndexedDBStorage::commit_changes(String const& storage_key, String const& name, PersistedDatabaseChanges const& changes)
+{
+    if (!m_persisted_storage.has_value())
+        return;
+    auto& storage = *m_persisted_storage;
+
+    auto delete_object_store_records = [&](u64 object_store_id) {
+        storage.database.execute_statement(storage.statements.delete_object_store_records, {}, storage_key, name, object_store_id);
+    };
+    auto delete_index_records = [&](u64 index_id) {
+        storage.database.execute_statement(storage.statements.delete_index_records, {}, storage_key, name, index_id);
+    };
+
+    // NOTE: All changes of a transaction are written at once, so they either all make it to disk, or none of them do.
+    storage.database.execute_statement(storage.statements.begin_transaction, {});
+
+    auto set_database = [&](PersistedDatabase const& database) {
+        storage.database.execute_statement(
+            storage.statements.set_database,
+            {},
+            storage_key,
+            name,
+            database.version,
+            object_stores_to_json(database.object_stores));
+    };
+
+    if (changes.database.has_value()) {
+        set_database(*changes.database);
+    } else if (!changes.key_generators.is_empty()) {
+        if (auto database = get_database(storage, storage_key, name); database.has_value()) {
+            for (auto const& key_generator : changes.key_generators) {
+                for (auto& object_store : database->object_stores) {
+                    if (object_store.id == key_generator.object_store_id)
+                        object_store.key_generator_current_number = key_generator.current_number;
+                }
+            }
+            set_database(*database);
+        }
+    }
+
+    for (auto object_store_id : changes.cleared_object_stores)
+        delete_object_store_records(object_store_id);
+
+    for (auto index_id : changes.cleared_indexes)
+        delete_index_records(index_id);
+
+    for (auto const& record : changes.removed_records)
+        storage.database.execute_statement(storage.statements.delete_record, {}, storage_key, name, record.source_id, record.key);
+
+    for (auto const& record : changes.removed_index_records)
+        storage.database.execute_statement(storage.statements.delete_index_record, {}, storage_key, name, record.source_id, record.key, record.value);
+
+    for (auto const& record : changes.stored_records)
+        storage.database.execute_statement(storage.statements.set_record, {}, storage_key, name, record.source_id, record.key, record.value);
+
+    for (auto const& record : changes.stored_index_records)
+        storage.database.execute_statement(storage.statements.set_index_record, {}, storage_key, name, record.source_id, record.key, record.value);
+
+    storage.database.execute_statement(storage.statements.commit_transaction, {});
+}
+
+void IndexedDBStorage::delete_database(String const& storage_key, String const& name)
+{
+    if (!m_persisted_storage.has_value())
+        return;
+    auto& storage = *m_persisted_storage;
+
+    storage.database.execute_statement(storage.statements.begin_transaction, {});
+    storage.database.execute_statement(storage.statements.delete_database, {}, storage_key, name);
+    storage.database.execute_statement(storage.statements.delete_database_records, {}, storage_key, name);
+    storage.database.execute_statement(storage.statements.delete_database_index_records, {}, storage_key, name);
+    storage.database.execute_statement(storage.statements.commit_transaction, {});
+}
+
+}
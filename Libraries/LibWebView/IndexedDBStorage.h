@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
+#include <LibWebView/Database.h>
+#include <LibWebView/Forward.h>
+
+namespace WebView {
+
+// Keeps IndexedDB databases on disk for every WebContent process. Without a SQL database, nothing is persisted, and
+// WebContent keeps its databases in memory only.
+class WEBVIEW_API IndexedDBStorage {
+    AK_MAKE_NONCOPYABLE(IndexedDBStorage);
+    AK_MAKE_NONMOVABLE(IndexedDBStorage);
+
+public:
+    static ErrorOr<NonnullOwnPtr<IndexedDBStorage>> create(Database&);
+    static NonnullOwnPtr<IndexedDBStorage> create();
+
+    ~IndexedDBStorage();
+
+    Optional<Web::IndexedDB::PersistedDatabaseContents> load_database(String const& storage_key, String const& name);
+    Vector<Web::IndexedDB::PersistedDatabase> databases(String const& storage_key);
+    Optional<ByteBuffer> load_record_value(String const& storage_key, String const& name, u64 object_store_id, ByteBuffer const& key);
+
+    void commit_changes(String const& storage_key, String const& name, Web::IndexedDB::PersistedDatabaseChanges const&);
+    void delete_database(String const& storage_key, String const& name);
+
+private:
+    struct Statements {
+        Database::StatementID begin_transaction { 0 };
+        Database::StatementID commit_transaction { 0 };
+
+        Database::StatementID get_database { 0 };
+        Database::StatementID get_databases { 0 };
+        Database::StatementID set_database { 0 };
+        Database::StatementID delete_database { 0 };
+
+        Database::StatementID get_record_keys { 0 };
+        Database::StatementID get_record_value { 0 };
+        Database::StatementID set_record { 0 };
+        Database::StatementID delete_record { 0 };
+        Database::StatementID delete_object_store_records { 0 };
+        Database::StatementID delete_database_records { 0 };
+
+        Database::StatementID get_index_records { 0 };
+        Database::StatementID set_index_record { 0 };
+        Database::StatementID delete_index_record { 0 };
+        Database::StatementID delete_index_records { 0 };
+        Database::StatementID delete_database_index_records { 0 };
+    };
+
+    struct PersistedStorage {
+        Database& database;
+        Statements statements;
+    };
+
+    explicit IndexedDBStorage(Optional<PersistedStorage>);
+
+    Optional<Web::IndexedDB::PersistedDatabase> get_database(PersistedStorage&, String const& storage_key, String const& name);
+
+    Optional<PersistedStorage> m_persisted_storage;
+};
+
+}
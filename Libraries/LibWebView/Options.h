@@ -52,6 +52,11 @@ enum class EnableAutoplay {
     Yes,
 };
 
+enum class DisableHTTPDiskCache {
+    No,
+    Yes,
+};
+
 struct SystemDNS { };
 struct DNSOverTLS {
     ByteString server_address;
@@ -80,6 +85,7 @@ struct BrowserOptions {
     AllowPopups allow_popups { AllowPopups::No };
     DisableScripting disable_scripting { DisableScripting::No };
     DisableSQLDatabase disable_sql_database { DisableSQLDatabase::No };
+    DisableHTTPDiskCache disable_http_disk_cache { DisableHTTPDiskCache::No };
     Optional<ProcessType> debug_helper_process {};
     Optional<ProcessType> profile_helper_process {};
     Optional<ByteString> webdriver_content_ipc_path {};
@@ -107,6 +113,11 @@ enum class EnableHTTPCache {
     Yes,
 };
 
+enum class EnableBytecodeCache {
+    No,
+    Yes,
+};
+
 enum class DisableSiteIsolation {
     No,
     Yes,
@@ -147,6 +158,7 @@ struct WebContentOptions {
     DisableSiteIsolation disable_site_isolation { DisableSiteIsolation::No };
     EnableIDLTracing enable_idl_tracing { EnableIDLTracing::No };
     EnableHTTPCache enable_http_cache { EnableHTTPCache::No };
+    EnableBytecodeCache enable_bytecode_cache { EnableBytecodeCache::No };
     ExposeInternalsObject expose_internals_object { ExposeInternalsObject::No };
     ForceCPUPainting force_cpu_painting { ForceCPUPainting::No };
     ForceFontconfig force_fontconfig { ForceFontconfig::No };
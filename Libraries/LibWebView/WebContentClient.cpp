@@ -8,6 +8,7 @@
 #include <LibWebView/Application.h>
 #include <LibWebView/CookieJar.h>
 #include <LibWebView/HelperProcess.h>
+#include <LibWebView/IndexedDBStorage.h>
 #include <LibWebView/ViewImplementation.h>
 #include <LibWebView/WebContentClient.h>
 #include <LibWebView/WebUI.h>
@@ -545,6 +546,31 @@ void WebContentClient::did_clear_storage(Web::StorageAPI::StorageEndpointType st
     Application::storage_jar().clear_storage_key(storage_endpoint, storage_key);
 }
 
+Messages::WebContentClient::DidRequestIndexedDbDatabaseResponse WebContentClient::did_request_indexed_db_database(String storage_key, String name)
+{
+    return Application::indexed_db_storage().load_database(storage_key, name);
+}
+
+Messages::WebContentClient::DidRequestIndexedDbDatabasesResponse WebContentClient::did_request_indexed_db_databases(String storage_key)
+{
+    return Application::indexed_db_storage().databases(storage_key);
+}
+
+Messages::WebContentClient::DidRequestIndexedDbRecordValueResponse WebContentClient::did_request_indexed_db_record_value(String storage_key, String name, u64 object_store_id, ByteBuffer key)
+{
+    return Application::indexed_db_storage().load_record_value(storage_key, name, object_store_id, key);
+}
+
+void WebContentClient::did_commit_indexed_db_changes(String storage_key, String name, Web::IndexedDB::PersistedDatabaseChanges changes)
+{
+    Application::indexed_db_storage().commit_changes(storage_key, name, changes);
+}
+
+void WebContentClient::did_delete_indexed_db_database(String storage_key, String name)
+{
+    Application::indexed_db_storage().delete_database(storage_key, name);
+}
+
 Messages::WebContentClient::DidRequestNewWebViewResponse WebContentClient::did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab activate_tab, Web::HTML::WebViewHints hints, Optional<u64> page_index)
 {
     if (auto view = view_for_page_id(page_id); view.has_value()) {
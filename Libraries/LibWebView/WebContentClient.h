@@ -113,6 +113,11 @@ private:
     virtual void did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key) override;
     virtual Messages::WebContentClient::DidRequestStorageKeysResponse did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
     virtual void did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
+    virtual Messages::WebContentClient::DidRequestIndexedDbDatabaseResponse did_request_indexed_db_database(String storage_key, String name) override;
+    virtual Messages::WebContentClient::DidRequestIndexedDbDatabasesResponse did_request_indexed_db_databases(String storage_key) override;
+    virtual Messages::WebContentClient::DidRequestIndexedDbRecordValueResponse did_request_indexed_db_record_value(String storage_key, String name, u64 object_store_id, ByteBuffer key) override;
+    virtual void did_commit_indexed_db_changes(String storage_key, String name, Web::IndexedDB::PersistedDatabaseChanges changes) override;
+    virtual void did_delete_indexed_db_database(String storage_key, String name) override;
     virtual Messages::WebContentClient::DidRequestNewWebViewResponse did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab, Web::HTML::WebViewHints, Optional<u64> page_index) override;
     virtual void did_request_activate_tab(u64 page_id) override;
     virtual void did_close_browsing_context(u64 page_id) override;
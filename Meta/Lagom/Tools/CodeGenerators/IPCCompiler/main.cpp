@@ -459,7 +459,7 @@ public:)~~~");
     message_generator.append(R"~~~()
     {
         IPC::MessageBuffer buffer;
-        IPC::Encoder stream(buffer);
+        IPC::Encoder stream(buffer, IPC::Encoder::UseSharedMemory::Yes);
         TRY(stream.encode(ENDPOINT_MAGIC));
         TRY(stream.encode((int)MessageID::@message.pascal_name@));)~~~");
 
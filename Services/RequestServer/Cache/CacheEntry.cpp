@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/System.h>
+#include <LibThreading/BackgroundAction.h>
+#include <RequestServer/Cache/CacheEntry.h>
+#include <RequestServer/Cache/DiskCache.h>
+#include <RequestServer/Cache/Utilities.h>
+
+namespace RequestServer {
+
+static constexpr u32 CACHE_ENTRY_MAGIC = 0x4C424843; // "CHBL"
+static constexpr u32 CACHE_ENTRY_VERSION = 2;
+
+// The body size (u64), the metadata size (u32), the version (u32) and the magic number (u32).
+static constexpr size_t CACHE_ENTRY_TRAILER_SIZE = sizeof(u64) + 3 * sizeof(u32);
+
+static constexpr size_t PIPE_BUFFER_SIZE = 64 * KiB;
+static constexpr size_t COPY_BUFFER_SIZE = 64 * KiB;
+
+// How much of a response body we collect before handing it to the background thread.
+static constexpr size_t WRITE_BUFFER_SIZE = 256 * KiB;
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<ByteString> read_string(FixedMemoryStream& stream)
+{
+    auto length = TRY(stream.read_value<LittleEndian<u32>>());
+    if (length > stream.remaining())
+        return Error::from_string_literal("Cache entry string is out of bounds");
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+    TRY(stream.read_until_filled(buffer));
+    return ByteString { buffer.bytes() };
+}
+
+static ErrorOr<void> write_headers(Stream& stream, HTTP::HeaderMap const& headers)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(headers.headers().size()));
+    for (auto const& header : headers.headers()) {
+        TRY(write_string(stream, header.name));
+        TRY(write_string(stream, header.value));
+    }
+    return {};
+}
+
+static ErrorOr<HTTP::HeaderMap> read_headers(FixedMemoryStream& stream)
+{
+    HTTP::HeaderMap headers;
+
+    auto count = TRY(stream.read_value<LittleEndian<u32>>());
+    for (u32 i = 0; i < count; ++i) {
+        auto name = TRY(read_string(stream));
+        auto value = TRY(read_string(stream));
+        headers.set(move(name), move(value));
+    }
+
+    return headers;
+}
+
+static ErrorOr<ByteBuffer> encode_metadata(CacheEntryMetadata const& metadata)
+{
+    AllocatingMemoryStream stream;
+
+    TRY(write_string(stream, metadata.partition.top_level_site));
+    TRY(write_string(stream, metadata.partition.frame_site));
+    TRY(write_string(stream, metadata.url));
+    TRY(write_string(stream, metadata.method));
+    TRY(stream.write_value<LittleEndian<u32>>(metadata.status_code));
+
+    TRY(stream.write_value<u8>(metadata.reason_phrase.has_value()));
+    if (metadata.reason_phrase.has_value())
+        TRY(write_string(stream, *metadata.reason_phrase));
+
+    TRY(write_headers(stream, metadata.response_headers));
+    TRY(write_headers(stream, metadata.varying_request_headers));
+
+    TRY(stream.write_value<LittleEndian<i64>>(metadata.request_time.milliseconds_since_epoch()));
+    TRY(stream.write_value<LittleEndian<i64>>(metadata.response_time.milliseconds_since_epoch()));
+
+    return stream.read_until_eof();
+}
+
+static ErrorOr<CacheEntryMetadata> decode_metadata(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    CacheEntryMetadata metadata;
+
+    metadata.partition.top_level_site = TRY(read_string(stream));
+    metadata.partition.frame_site = TRY(read_string(stream));
+    metadata.url = TRY(read_string(stream));
+    metadata.method = TRY(read_string(stream));
+    metadata.status_code = TRY(stream.read_value<LittleEndian<u32>>());
+
+    if (TRY(stream.read_value<u8>()) != 0)
+        metadata.reason_phrase = TRY(String::from_byte_string(TRY(read_string(stream))));
+
+    metadata.response_headers = TRY(read_headers(stream));
+    metadata.varying_request_headers = TRY(read_headers(stream));
+
+    metadata.request_time = UnixDateTime::from_milliseconds_since_epoch(TRY(stream.read_value<LittleEndian<i64>>()));
+    metadata.response_time = UnixDateTime::from_milliseconds_since_epoch(TRY(stream.read_value<LittleEndian<i64>>()));
+
+    return metadata;
+}
+
+// Entries only appear under their real name once they're complete, so that readers never see a partially written one.
+static ErrorOr<NonnullOwnPtr<Core::File>> create_temporary_file(DiskCache::Storage const& storage, ByteString& temporary_path)
+{
+    auto pattern = ByteString::formatted("{}/.tmp-XXXXXX", storage.directory);
+    Vector<char> path;
+    path.append(pattern.characters(), pattern.length() + 1);
+
+    auto fd = TRY(Core::System::mkstemp(path));
+    temporary_path = ByteString { path.data(), pattern.length() };
+
+    return Core::File::adopt_fd(fd, Core::File::OpenMode::Write);
+}
+
+// Writes the metadata and trailer that follow the body, and returns the size of the entry.
+static ErrorOr<u64> write_metadata_and_trailer(Core::File& file, u64 body_size, ReadonlyBytes metadata)
+{
+    TRY(file.write_until_depleted(metadata));
+
+    TRY(file.write_value<LittleEndian<u64>>(body_size));
+    TRY(file.write_value<LittleEndian<u32>>(metadata.size()));
+    TRY(file.write_value<LittleEndian<u32>>(CACHE_ENTRY_VERSION));
+    TRY(file.write_value<LittleEndian<u32>>(CACHE_ENTRY_MAGIC));
+
+    return body_size + metadata.size() + CACHE_ENTRY_TRAILER_SIZE;
+}
+
+// Writes a copy of the entry with new metadata, and returns its size. Returns nothing if the entry was replaced or
+// evicted since the given file was opened.
+static ErrorOr<Optional<u64>> rewrite_entry(DiskCache::Storage const& storage, u64 key, dev_t device, ino_t inode, u64 body_size, ReadonlyBytes metadata)
+{
+    auto path = storage.path_for_key(key);
+
+    auto file_or_error = Core::File::open(path, Core::File::OpenMode::Read);
+    if (file_or_error.is_error()) {
+        if (file_or_error.error().code() == ENOENT)
+            return OptionalNone {};
+        return file_or_error.release_error();
+    }
+
+    auto file = file_or_error.release_value();
+    auto stat = TRY(Core::System::fstat(file->fd()));
+    if (stat.st_dev != device || stat.st_ino != inode)
+        return OptionalNone {};
+
+    ByteString temporary_path;
+
+    auto result = [&]() -> ErrorOr<u64> {
+        auto temporary_file = TRY(create_temporary_file(storage, temporary_path));
+        auto buffer = TRY(ByteBuffer::create_uninitialized(min(body_size, COPY_BUFFER_SIZE)));
+
+        for (u64 bytes_copied = 0; bytes_copied < body_size;) {
+            auto bytes = TRY(file->read_some(buffer.bytes().trim(min(buffer.size(), body_size - bytes_copied))));
+            if (bytes.is_empty())
+                return Error::from_string_literal("Cache entry ended unexpectedly");
+
+            TRY(temporary_file->write_until_depleted(bytes));
+            bytes_copied += bytes.size();
+        }
+
+        auto size = TRY(write_metadata_and_trailer(*temporary_file, body_size, metadata));
+        TRY(Core::System::rename(temporary_path, path));
+        return size;
+    }();
+
+    if (result.is_error()) {
+        if (!temporary_path.is_empty())
+            (void)Core::System::unlink(temporary_path);
+        return result.release_error();
+    }
+
+    return Optional<u64> { result.release_value() };
+}
+
+CacheEntry::CacheEntry(DiskCache& disk_cache, u64 key, CacheEntryMetadata metadata)
+    : m_disk_cache(disk_cache)
+    , m_key(key)
+    , m_metadata(move(metadata))
+{
+}
+
+ErrorOr<NonnullOwnPtr<CacheEntryWriter>> CacheEntryWriter::create(DiskCache& disk_cache, u64 key, CacheEntryMetadata metadata)
+{
+    auto pending_file = TRY(try_make_ref_counted<PendingFile>());
+    return adopt_nonnull_own_or_enomem(new (nothrow) CacheEntryWriter(disk_cache, key, move(metadata), move(pending_file)));
+}
+
+CacheEntryWriter::CacheEntryWriter(DiskCache& disk_cache, u64 key, CacheEntryMetadata metadata, NonnullRefPtr<PendingFile> pending_file)
+    : CacheEntry(disk_cache, key, move(metadata))
+    , m_pending_file(move(pending_file))
+{
+}
+
+CacheEntryWriter::~CacheEntryWriter()
+{
+    if (m_flushed)
+        return;
+
+    // NOTE: This runs after the data that's still queued up for the background thread has been written.
+    Threading::BackgroundAction<Empty>::construct(
+        [pending_file = m_pending_file](auto&) -> ErrorOr<Empty> {
+            pending_file->file = nullptr;
+            if (!pending_file->temporary_path.is_empty())
+                (void)Core::System::unlink(pending_file->temporary_path);
+            return Empty {};
+        },
+        nullptr);
+}
+
+ErrorOr<void> CacheEntryWriter::write_data(ReadonlyBytes bytes)
+{
+    VERIFY(!m_flushed);
+
+    if (m_body_size + bytes.size() > m_disk_cache.maximum_entry_size())
+        return Error::from_string_literal("Response is too large to be stored");
+
+    TRY(m_buffered_data.try_append(bytes));
+    m_body_size += bytes.size();
+
+    if (m_buffered_data.size() >= WRITE_BUFFER_SIZE)
+        write_buffered_data();
+    return {};
+}
+
+void CacheEntryWriter::write_buffered_data()
+{
+    Threading::BackgroundAction<Empty>::construct(
+        [storage = m_disk_cache.storage(), pending_file = m_pending_file, bytes = move(m_buffered_data)](auto&) -> ErrorOr<Empty> {
+            if (pending_file->error.has_value())
+                return Empty {};
+
+            auto result = [&]() -> ErrorOr<void> {
+                if (!pending_file->file)
+                    pending_file->file = TRY(create_temporary_file(*storage, pending_file->temporary_path));
+                TRY(pending_file->file->write_until_depleted(bytes));
+                return {};
+            }();
+
+            // The error is reported once the entry is flushed.
+            if (result.is_error())
+                pending_file->error = result.release_error();
+            return Empty {};
+        },
+        nullptr);
+
+    m_buffered_data.clear();
+}
+
+ErrorOr<void> CacheEntryWriter::flush()
+{
+    VERIFY(!m_flushed);
+
+    auto metadata = TRY(encode_metadata(m_metadata));
+
+    write_buffered_data();
+    m_flushed = true;
+
+    Threading::BackgroundAction<u64>::construct(
+        [storage = m_disk_cache.storage(), pending_file = m_pending_file, key = m_key, body_size = m_body_size, metadata = move(metadata)](auto&) -> ErrorOr<u64> {
+            auto result = [&]() -> ErrorOr<u64> {
+                if (pending_file->error.has_value())
+                    return pending_file->error.release_value();
+
+                auto size = TRY(write_metadata_and_trailer(*pending_file->file, body_size, metadata));
+                pending_file->file = nullptr;
+
+                TRY(Core::System::rename(pending_file->temporary_path, storage->path_for_key(key)));
+                return size;
+            }();
+
+            if (result.is_error() && !pending_file->temporary_path.is_empty())
+                (void)Core::System::unlink(pending_file->temporary_path);
+            return result;
+        },
+        [weak_disk_cache = m_disk_cache.make_weak_ptr(), key = m_key](u64 size) -> ErrorOr<void> {
+            if (weak_disk_cache)
+                weak_disk_cache->did_store_entry({}, key, size);
+            return {};
+        },
+        [key = m_key](Error error) {
+            dbgln("CacheEntryWriter: Unable to store entry {:016x}: {}", key, error);
+        });
+
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<CacheEntryReader>> CacheEntryReader::open(DiskCache& disk_cache, u64 key)
+{
+    auto file = TRY(Core::File::open(disk_cache.path_for_key(key), Core::File::OpenMode::Read));
+    auto stat = TRY(Core::System::fstat(file->fd()));
+
+    auto file_size = static_cast<u64>(stat.st_size);
+    if (file_size < CACHE_ENTRY_TRAILER_SIZE)
+        return Error::from_string_literal("Cache entry is truncated");
+
+    TRY(file->seek(file_size - CACHE_ENTRY_TRAILER_SIZE, SeekMode::SetPosition));
+    auto body_size = TRY(file->read_value<LittleEndian<u64>>());
+    auto metadata_size = TRY(file->read_value<LittleEndian<u32>>());
+    auto version = TRY(file->read_value<LittleEndian<u32>>());
+    auto magic = TRY(file->read_value<LittleEndian<u32>>());
+
+    if (magic != CACHE_ENTRY_MAGIC || version != CACHE_ENTRY_VERSION)
+        return Error::from_string_literal("Cache entry has an unknown format");
+    if (body_size + metadata_size + CACHE_ENTRY_TRAILER_SIZE != file_size)
+        return Error::from_string_literal("Cache entry is truncated");
+
+    auto metadata_bytes = TRY(ByteBuffer::create_uninitialized(metadata_size));
+    TRY(file->seek(body_size, SeekMode::SetPosition));
+    TRY(file->read_until_filled(metadata_bytes));
+
+    auto metadata = TRY(decode_metadata(metadata_bytes));
+    FileID file_id { stat.st_dev, stat.st_ino };
+    return adopt_nonnull_own_or_enomem(new (nothrow) CacheEntryReader(disk_cache, key, move(metadata), move(file), file_id, body_size));
+}
+
+CacheEntryReader::CacheEntryReader(DiskCache& disk_cache, u64 key, CacheEntryMetadata metadata, NonnullOwnPtr<Core::File> file, FileID file_id, u64 body_size)
+    : CacheEntry(disk_cache, key, move(metadata))
+    , m_file(move(file))
+    , m_file_id(file_id)
+{
+    m_body_size = body_size;
+}
+
+CacheEntryReader::~CacheEntryReader()
+{
+    if (m_pipe_notifier)
+        m_pipe_notifier->set_enabled(false);
+}
+
+ErrorOr<void> CacheEntryReader::update_metadata(HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time)
+{
+    m_metadata.response_headers = update_stored_headers(m_metadata.response_headers, response_headers);
+    m_metadata.request_time = request_time;
+    m_metadata.response_time = response_time;
+
+    auto metadata = TRY(encode_metadata(m_metadata));
+
+    // NOTE: We keep reading the body from the file we opened, even once the entry has been replaced by its copy.
+    Threading::BackgroundAction<Optional<u64>>::construct(
+        [storage = m_disk_cache.storage(), key = m_key, file_id = m_file_id, body_size = m_body_size, metadata = move(metadata)](auto&) -> ErrorOr<Optional<u64>> {
+            return rewrite_entry(*storage, key, file_id.device, file_id.inode, body_size, metadata);
+        },
+        [weak_disk_cache = m_disk_cache.make_weak_ptr(), key = m_key](Optional<u64> size) -> ErrorOr<void> {
+            if (size.has_value() && weak_disk_cache)
+                weak_disk_cache->did_update_entry({}, key, *size);
+            return {};
+        },
+        [key = m_key](Error error) {
+            dbgln("CacheEntryReader: Unable to update entry {:016x}: {}", key, error);
+        });
+
+    return {};
+}
+
+void CacheEntryReader::pipe_to(int fd, BodyCallback on_complete, BodyCallback on_error)
+{
+    VERIFY(m_pipe_fd == -1);
+
+    m_pipe_fd = fd;
+    m_on_pipe_complete = move(on_complete);
+    m_on_pipe_error = move(on_error);
+
+    auto result = [&]() -> ErrorOr<void> {
+        m_pipe_buffer = TRY(ByteBuffer::create_uninitialized(min(m_body_size, PIPE_BUFFER_SIZE)));
+        TRY(m_file->seek(0, SeekMode::SetPosition));
+        return {};
+    }();
+
+    if (result.is_error()) {
+        dbgln("CacheEntryReader: Unable to read cache entry: {}", result.error());
+        m_on_pipe_error(0);
+        return;
+    }
+
+    m_pipe_notifier = Core::Notifier::construct(fd, Core::NotificationType::Write);
+    m_pipe_notifier->set_enabled(false);
+    m_pipe_notifier->on_activation = [this] {
+        pipe_more_data();
+    };
+
+    pipe_more_data();
+}
+
+void CacheEntryReader::pipe_more_data()
+{
+    // Returns whether the whole body has been written.
+    auto result = [&]() -> ErrorOr<bool> {
+        while (true) {
+            if (m_pending_bytes.is_empty()) {
+                if (m_bytes_read == m_body_size)
+                    return true;
+
+                auto bytes_to_read = min(m_pipe_buffer.size(), m_body_size - m_bytes_read);
+                auto bytes = TRY(m_file->read_some(m_pipe_buffer.bytes().trim(bytes_to_read)));
+                if (bytes.is_empty())
+                    return Error::from_string_literal("Cache entry ended unexpectedly");
+
+                m_bytes_read += bytes.size();
+                m_pending_bytes = bytes;
+            }
+
+            auto bytes_written = Core::System::write(m_pipe_fd, m_pending_bytes);
+            if (bytes_written.is_error()) {
+                if (bytes_written.error().code() != EAGAIN)
+                    return bytes_written.release_error();
+
+                m_pipe_notifier->set_enabled(true);
+                return false;
+            }
+
+            m_bytes_sent += bytes_written.value();
+            m_pending_bytes = m_pending_bytes.slice(bytes_written.value());
+        }
+    }();
+
+    if (!result.is_error() && !result.value())
+        return;
+
+    m_pipe_notifier->set_enabled(false);
+
+    if (result.is_error()) {
+        dbgln("CacheEntryReader: Unable to send cached response body (it's likely the client disappeared): {}", result.error());
+        auto on_error = move(m_on_pipe_error);
+        on_error(m_bytes_sent);
+        return;
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Sent {} bytes of cached response body for {}", m_bytes_sent, m_metadata.url);
+
+    auto on_complete = move(m_on_pipe_complete);
+    on_complete(m_bytes_sent);
+}
+
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <LibCore/File.h>
+#include <LibCore/Notifier.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibRequests/CachePartition.h>
+#include <sys/types.h>
+
+namespace RequestServer {
+
+class DiskCache;
+
+// Everything we know about a stored response, apart from its body.
+struct CacheEntryMetadata {
+    Requests::CachePartition partition;
+    ByteString url;
+    ByteString method;
+    u32 status_code { 0 };
+    Optional<String> reason_phrase;
+    HTTP::HeaderMap response_headers;
+
+    // The request header fields nominated by the response's Vary header field, as they were sent in the request.
+    HTTP::HeaderMap varying_request_headers;
+
+    UnixDateTime request_time;
+    UnixDateTime response_time;
+};
+
+// Each entry is stored in a file of its own. The body comes first, so that it can be written while it is being
+// downloaded. The metadata follows, and a fixed-size trailer at the very end tells us where the two are.
+//
+// Entries are only ever written on the background thread, to a temporary file that is renamed into place once it is
+// complete. Readers on the main thread therefore always see either the old or the new version of an entry.
+class CacheEntry {
+    AK_MAKE_NONCOPYABLE(CacheEntry);
+    AK_MAKE_NONMOVABLE(CacheEntry);
+
+public:
+    virtual ~CacheEntry() = default;
+
+    u64 key() const { return m_key; }
+    CacheEntryMetadata const& metadata() const { return m_metadata; }
+
+protected:
+    CacheEntry(DiskCache&, u64 key, CacheEntryMetadata);
+
+    DiskCache& m_disk_cache;
+    u64 m_key { 0 };
+    CacheEntryMetadata m_metadata;
+    u64 m_body_size { 0 };
+};
+
+class CacheEntryWriter final : public CacheEntry {
+public:
+    static ErrorOr<NonnullOwnPtr<CacheEntryWriter>> create(DiskCache&, u64 key, CacheEntryMetadata);
+    virtual ~CacheEntryWriter() override;
+
+    ErrorOr<void> write_data(ReadonlyBytes);
+
+    // Makes the entry visible to later lookups once it has been written. An entry that is never flushed is discarded.
+    ErrorOr<void> flush();
+
+private:
+    // The file the entry is written to. Only used on the background thread.
+    struct PendingFile : public AtomicRefCounted<PendingFile> {
+        OwnPtr<Core::File> file;
+        ByteString temporary_path;
+        Optional<Error> error;
+    };
+
+    CacheEntryWriter(DiskCache&, u64 key, CacheEntryMetadata, NonnullRefPtr<PendingFile>);
+
+    void write_buffered_data();
+
+    NonnullRefPtr<PendingFile> m_pending_file;
+    ByteBuffer m_buffered_data;
+    bool m_flushed { false };
+};
+
+class CacheEntryReader final : public CacheEntry {
+public:
+    static ErrorOr<NonnullOwnPtr<CacheEntryReader>> open(DiskCache&, u64 key);
+    virtual ~CacheEntryReader() override;
+
+    u64 body_size() const { return m_body_size; }
+
+    // Whether the stored response may only be used after the server has confirmed that it's still current.
+    bool must_revalidate() const { return m_must_revalidate; }
+    void set_must_revalidate(bool must_revalidate) { m_must_revalidate = must_revalidate; }
+
+    // Freshens the stored response with the header fields of a 304 (Not Modified) response. The entry on disk is
+    // rewritten in the background, unless it has been replaced in the meantime.
+    ErrorOr<void> update_metadata(HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time);
+
+    // Streams the body to the given non-blocking file descriptor, waiting for it to become writable as needed. The
+    // callbacks are given the number of body bytes that were written.
+    using BodyCallback = Function<void(u64 bytes_sent)>;
+    void pipe_to(int fd, BodyCallback on_complete, BodyCallback on_error);
+
+private:
+    struct FileID {
+        dev_t device { 0 };
+        ino_t inode { 0 };
+    };
+
+    CacheEntryReader(DiskCache&, u64 key, CacheEntryMetadata, NonnullOwnPtr<Core::File>, FileID, u64 body_size);
+
+    void pipe_more_data();
+
+    NonnullOwnPtr<Core::File> m_file;
+    FileID m_file_id;
+    bool m_must_revalidate { false };
+
+    int m_pipe_fd { -1 };
+    RefPtr<Core::Notifier> m_pipe_notifier;
+    BodyCallback m_on_pipe_complete;
+    BodyCallback m_on_pipe_error;
+    ByteBuffer m_pipe_buffer;
+    ReadonlyBytes m_pending_bytes;
+    u64 m_bytes_read { 0 };
+    u64 m_bytes_sent { 0 };
+};
+
+}
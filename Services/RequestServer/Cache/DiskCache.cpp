@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <AK/StringConversions.h>
+#include <LibCore/Directory.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibThreading/BackgroundAction.h>
+#include <RequestServer/Cache/DiskCache.h>
+#include <RequestServer/Cache/Utilities.h>
+
+namespace RequestServer {
+
+// Runs disk work whose outcome the main thread doesn't need to hear about.
+static void run_in_background(ESCAPING Function<void()> work)
+{
+    Threading::BackgroundAction<Empty>::construct(
+        [work = move(work)](auto&) -> ErrorOr<Empty> {
+            work();
+            return Empty {};
+        },
+        nullptr);
+}
+
+ErrorOr<NonnullOwnPtr<DiskCache>> DiskCache::create()
+{
+    return create(ByteString::formatted("{}/Ladybird/HTTPCache", Core::StandardPaths::user_data_directory()));
+}
+
+ErrorOr<NonnullOwnPtr<DiskCache>> DiskCache::create(ByteString directory, u64 maximum_size)
+{
+    TRY(Core::Directory::create(LexicalPath { directory }, Core::Directory::CreateDirectories::Yes));
+
+    auto storage = TRY(try_make_ref_counted<Storage>(move(directory)));
+    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(move(storage), maximum_size)));
+    disk_cache->load_index();
+    return disk_cache;
+}
+
+DiskCache::DiskCache(NonnullRefPtr<Storage> storage, u64 maximum_size)
+    : m_storage(move(storage))
+    , m_maximum_size(maximum_size)
+{
+}
+
+ByteString DiskCache::Storage::path_for_key(u64 key) const
+{
+    return ByteString::formatted("{}/{:016x}", directory, key);
+}
+
+void DiskCache::load_index()
+{
+    Threading::BackgroundAction<HashMap<u64, IndexEntry>>::construct(
+        [storage = m_storage](auto&) -> ErrorOr<HashMap<u64, IndexEntry>> {
+            HashMap<u64, IndexEntry> index;
+
+            TRY(Core::Directory::for_each_entry(storage->directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const& directory) -> ErrorOr<IterationDecision> {
+                auto path = ByteString::formatted("{}/{}", directory.path(), entry.name);
+
+                // Leftovers from responses that were still being written when we last exited.
+                if (entry.name.starts_with(".tmp-"sv)) {
+                    (void)Core::System::unlink(path);
+                    return IterationDecision::Continue;
+                }
+
+                auto key = AK::parse_hexadecimal_number<u64>(entry.name, TrimWhitespace::No);
+                if (entry.name.length() != 16 || !key.has_value())
+                    return IterationDecision::Continue;
+
+                auto stat = Core::System::stat(path);
+                if (stat.is_error())
+                    return IterationDecision::Continue;
+
+                // NOTE: We touch entries whenever they're used, so their modification time tells us how recently that was.
+#if defined(AK_OS_MACOS) || defined(AK_OS_IOS)
+                auto last_access_time = UnixDateTime::from_unix_timespec(stat.value().st_mtimespec);
+#else
+                auto last_access_time = UnixDateTime::from_unix_timespec(stat.value().st_mtim);
+#endif
+
+                TRY(index.try_set(*key, { static_cast<u64>(stat.value().st_size), last_access_time }));
+                return IterationDecision::Continue;
+            }));
+
+            return index;
+        },
+        [weak_this = make_weak_ptr()](HashMap<u64, IndexEntry> index) -> ErrorOr<void> {
+            if (weak_this)
+                weak_this->did_load_index(move(index));
+            return {};
+        },
+        [storage = m_storage](Error error) {
+            dbgln("DiskCache: Unable to read cache directory {}: {}", storage->directory, error);
+        });
+}
+
+void DiskCache::did_load_index(HashMap<u64, IndexEntry> index)
+{
+    // Entries that were stored while the directory was being read are newer than what was found in it.
+    for (auto const& [key, index_entry] : index) {
+        if (m_index.set(key, index_entry, AK::HashSetExistingEntryBehavior::Keep) == AK::HashSetResult::InsertedNewEntry)
+            m_total_size += index_entry.size;
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Loaded {} entries ({} bytes) from {}", m_index.size(), m_total_size, m_storage->directory);
+    evict_entries_if_needed();
+}
+
+// https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
+OwnPtr<CacheEntryReader> DiskCache::open_entry(Requests::CachePartition const& partition, URL::URL const& url, StringView method, HTTP::HeaderMap const& request_headers)
+{
+    if (!is_cacheable(method, request_headers))
+        return {};
+
+    // Conditional requests come from a cache of their own (i.e. the one in WebContent), which wants to hear from the
+    // server directly.
+    for (auto header : { "If-Match"sv, "If-None-Match"sv, "If-Modified-Since"sv, "If-Unmodified-Since"sv, "If-Range"sv }) {
+        if (request_headers.contains(header))
+            return {};
+    }
+
+    auto serialized_url = url.serialize(URL::ExcludeFragment::Yes).to_byte_string();
+    auto key = create_cache_key(partition, serialized_url, method);
+
+    auto miss = [&](StringView reason) -> OwnPtr<CacheEntryReader> {
+        dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Miss ({}) for {}", reason, serialized_url);
+        ++m_statistics.misses;
+        return {};
+    };
+
+    if (!m_index.contains(key))
+        return miss("not stored"sv);
+
+    auto entry_or_error = CacheEntryReader::open(*this, key);
+    if (entry_or_error.is_error()) {
+        dbgln("DiskCache: Unable to open entry for {}: {}", serialized_url, entry_or_error.error());
+        remove_entry(key);
+        return miss("unreadable"sv);
+    }
+
+    auto entry = entry_or_error.release_value();
+    auto const& metadata = entry->metadata();
+
+    // When presented with a request, a cache MUST NOT reuse a stored response unless:
+
+    // - the presented target URI (Section 7.1 of [HTTP]) and that of the stored response match, and
+    // - the request method associated with the stored response allows it to be used for the presented request, and
+    if (metadata.partition != partition || metadata.url != serialized_url || metadata.method != method)
+        return miss("key collision"sv);
+
+    // - request header fields nominated by the stored response (if any) match those presented (see Section 4.1), and
+    if (auto vary = metadata.response_headers.get("Vary"sv); vary.has_value()) {
+        for (auto name : vary->split_view(',')) {
+            name = name.trim_whitespace();
+            if (request_headers.get(name) != metadata.varying_request_headers.get(name))
+                return miss("varying request header"sv);
+        }
+    }
+
+    // - the stored response does not contain the no-cache directive (Section 5.2.2.4), unless it is successfully
+    //   validated (Section 4.3), and
+    auto must_revalidate = has_cache_control_directive(metadata.response_headers, "no-cache"sv);
+
+    // - the stored response is one of the following:
+    //   + fresh (see Section 4.2), or
+    //   + successfully validated (see Section 4.3).
+    auto freshness_lifetime = calculate_freshness_lifetime(metadata.status_code, metadata.response_headers, metadata.response_time);
+    auto current_age = calculate_age(metadata.response_headers, metadata.request_time, metadata.response_time);
+    if (current_age >= freshness_lifetime)
+        must_revalidate = true;
+
+    // The no-cache request directive indicates that the client prefers a stored response not be used to satisfy the
+    // request without successful validation on the origin server. The same goes for a max-age the response is older
+    // than, and for Pragma: no-cache if there's no Cache-Control header field.
+    if (has_cache_control_directive(request_headers, "no-cache"sv))
+        must_revalidate = true;
+    if (auto max_age = cache_control_duration(request_headers, "max-age"sv); max_age.has_value() && current_age > *max_age)
+        must_revalidate = true;
+    if (auto pragma = request_headers.get("Pragma"sv); pragma.has_value() && !request_headers.contains("Cache-Control"sv) && pragma->contains("no-cache"sv))
+        must_revalidate = true;
+
+    if (must_revalidate && !metadata.response_headers.contains("ETag"sv) && !metadata.response_headers.contains("Last-Modified"sv))
+        return miss("stale without validators"sv);
+
+    entry->set_must_revalidate(must_revalidate);
+
+    if (must_revalidate) {
+        dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Revalidating {} (age {}s, freshness lifetime {}s)", serialized_url, current_age.to_seconds(), freshness_lifetime.to_seconds());
+    } else {
+        dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Hit for {} (age {}s, freshness lifetime {}s)", serialized_url, current_age.to_seconds(), freshness_lifetime.to_seconds());
+        ++m_statistics.hits;
+    }
+
+    if (auto index_entry = m_index.get(key); index_entry.has_value()) {
+        index_entry->last_access_time = UnixDateTime::now();
+        run_in_background([path = path_for_key(key)] {
+            (void)Core::System::utimensat(AT_FDCWD, path, nullptr, 0);
+        });
+    }
+
+    return entry;
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+OwnPtr<CacheEntryWriter> DiskCache::create_entry(Requests::CachePartition const& partition, URL::URL const& url, StringView method, HTTP::HeaderMap const& request_headers, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time)
+{
+    if (!is_cacheable(method, request_headers) || !is_cacheable(status_code, response_headers))
+        return {};
+
+    // NOTE: A response that is never fresh and can't be validated is of no use to us.
+    if (calculate_freshness_lifetime(status_code, response_headers, response_time) == AK::Duration {}
+        && !response_headers.contains("ETag"sv)
+        && !response_headers.contains("Last-Modified"sv)) {
+        return {};
+    }
+
+    CacheEntryMetadata metadata {
+        .partition = partition,
+        .url = url.serialize(URL::ExcludeFragment::Yes).to_byte_string(),
+        .method = method,
+        .status_code = status_code,
+        .reason_phrase = move(reason_phrase),
+        .response_headers = headers_for_storage(response_headers),
+        .varying_request_headers = {},
+        .request_time = request_time,
+        .response_time = response_time,
+    };
+
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value()) {
+        for (auto name : vary->split_view(',')) {
+            name = name.trim_whitespace();
+            if (auto value = request_headers.get(name); value.has_value())
+                metadata.varying_request_headers.set(name, *value);
+        }
+    }
+
+    auto key = create_cache_key(partition, metadata.url, method);
+
+    auto writer = CacheEntryWriter::create(*this, key, move(metadata));
+    if (writer.is_error()) {
+        dbgln("DiskCache: Unable to create entry for {}: {}", url, writer.error());
+        return {};
+    }
+
+    return writer.release_value();
+}
+
+// https://httpwg.org/specs/rfc9111.html#freshening.responses
+void DiskCache::freshen_entry(CacheEntryReader& entry, HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time)
+{
+    ++m_statistics.validated;
+
+    if (auto result = entry.update_metadata(response_headers, request_time, response_time); result.is_error()) {
+        dbgln("DiskCache: Unable to update entry for {}: {}", entry.metadata().url, result.error());
+        remove_entry(entry.key());
+    }
+}
+
+void DiskCache::did_store_entry(Badge<CacheEntryWriter>, u64 key, u64 size)
+{
+    ++m_statistics.stored;
+
+    if (auto previous_entry = m_index.get(key); previous_entry.has_value())
+        m_total_size -= previous_entry->size;
+
+    m_index.set(key, { size, UnixDateTime::now() });
+    m_total_size += size;
+
+    evict_entries_if_needed();
+}
+
+void DiskCache::did_update_entry(Badge<CacheEntryReader>, u64 key, u64 size)
+{
+    auto index_entry = m_index.get(key);
+    if (!index_entry.has_value())
+        return;
+
+    m_total_size -= index_entry->size;
+    index_entry->size = size;
+    m_total_size += size;
+}
+
+void DiskCache::remove_entry(u64 key)
+{
+    auto index_entry = m_index.take(key);
+    if (!index_entry.has_value())
+        return;
+
+    m_total_size -= index_entry->size;
+    run_in_background([path = path_for_key(key)] {
+        (void)Core::System::unlink(path);
+    });
+}
+
+void DiskCache::evict_entries_if_needed()
+{
+    if (m_total_size <= m_maximum_size)
+        return;
+
+    // Evicting a bit more than we need to means we don't have to evict again on every store.
+    auto size_after_eviction = m_maximum_size / 10 * 9;
+
+    Vector<u64> keys;
+    keys.ensure_capacity(m_index.size());
+    for (auto const& it : m_index)
+        keys.unchecked_append(it.key);
+
+    quick_sort(keys, [&](u64 a, u64 b) {
+        return m_index.get(a)->last_access_time < m_index.get(b)->last_access_time;
+    });
+
+    for (auto key : keys) {
+        if (m_total_size <= size_after_eviction)
+            break;
+
+        remove_entry(key);
+        ++m_statistics.evicted;
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Evicted entries down to {} bytes", m_total_size);
+}
+
+void DiskCache::dump_statistics() const
+{
+    dbgln("DiskCache: {} hits, {} misses, {} validated, {} stored, {} evicted; {} entries ({} bytes)",
+        m_statistics.hits,
+        m_statistics.misses,
+        m_statistics.validated,
+        m_statistics.stored,
+        m_statistics.evicted,
+        m_index.size(),
+        m_total_size);
+}
+
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/Badge.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Time.h>
+#include <AK/Weakable.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibRequests/CachePartition.h>
+#include <LibURL/URL.h>
+#include <RequestServer/Cache/CacheEntry.h>
+
+namespace RequestServer {
+
+// An HTTP cache (RFC 9111) that keeps responses in the user's data directory. There is a single RequestServer, so
+// every WebContent process shares it, and it survives restarts. Entries are partitioned by the top-level site and
+// frame site of the request. The cache is bounded in size, and evicts the least recently used entries first.
+//
+// Lookups read from disk directly, but everything that writes to disk happens on a background thread.
+class DiskCache : public Weakable<DiskCache> {
+    AK_MAKE_NONCOPYABLE(DiskCache);
+    AK_MAKE_NONMOVABLE(DiskCache);
+
+public:
+    static constexpr u64 default_maximum_size = 256 * MiB;
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 validated { 0 };
+        u64 stored { 0 };
+        u64 evicted { 0 };
+    };
+
+    // Only used on the background thread, apart from the directory, which never changes.
+    struct Storage : public AtomicRefCounted<Storage> {
+        explicit Storage(ByteString directory)
+            : directory(move(directory))
+        {
+        }
+
+        ByteString path_for_key(u64 key) const;
+
+        ByteString directory;
+    };
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> create();
+    static ErrorOr<NonnullOwnPtr<DiskCache>> create(ByteString directory, u64 maximum_size = default_maximum_size);
+
+    // Returns a stored response that may be used for the given request. If the entry must be revalidated first, the
+    // returned reader says so.
+    OwnPtr<CacheEntryReader> open_entry(Requests::CachePartition const&, URL::URL const&, StringView method, HTTP::HeaderMap const& request_headers);
+
+    // Returns a writer for the given response if it may be stored.
+    OwnPtr<CacheEntryWriter> create_entry(Requests::CachePartition const&, URL::URL const&, StringView method, HTTP::HeaderMap const& request_headers, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time);
+
+    // Updates a stored response after the server responded to its revalidation with 304 (Not Modified).
+    void freshen_entry(CacheEntryReader&, HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time);
+
+    NonnullRefPtr<Storage> const& storage() const { return m_storage; }
+    ByteString path_for_key(u64 key) const { return m_storage->path_for_key(key); }
+
+    u64 maximum_size() const { return m_maximum_size; }
+    u64 maximum_entry_size() const { return m_maximum_size / 8; }
+
+    void did_store_entry(Badge<CacheEntryWriter>, u64 key, u64 size);
+    void did_update_entry(Badge<CacheEntryReader>, u64 key, u64 size);
+
+    Statistics const& statistics() const { return m_statistics; }
+    void dump_statistics() const;
+
+private:
+    DiskCache(NonnullRefPtr<Storage>, u64 maximum_size);
+
+    struct IndexEntry {
+        u64 size { 0 };
+        UnixDateTime last_access_time;
+    };
+
+    void load_index();
+    void did_load_index(HashMap<u64, IndexEntry>);
+    void remove_entry(u64 key);
+    void evict_entries_if_needed();
+
+    NonnullRefPtr<Storage> m_storage;
+    u64 m_maximum_size { 0 };
+
+    HashMap<u64, IndexEntry> m_index;
+    u64 m_total_size { 0 };
+    Statistics m_statistics;
+};
+
+}
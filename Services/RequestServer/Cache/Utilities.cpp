@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteReader.h>
+#include <AK/DateConstants.h>
+#include <AK/StringBuilder.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/Cache/Utilities.h>
+
+namespace RequestServer {
+
+u64 create_cache_key(Requests::CachePartition const& partition, StringView url, StringView method)
+{
+    StringBuilder builder;
+    builder.append(partition.top_level_site);
+    builder.append(' ');
+    builder.append(partition.frame_site);
+    builder.append(' ');
+    builder.append(method);
+    builder.append(' ');
+    builder.append(url);
+
+    auto digest = Crypto::Hash::SHA256::hash(builder.string_view().bytes());
+    return ByteReader::load64(digest.bytes().data());
+}
+
+// https://httpwg.org/specs/rfc9110.html#http.date
+Optional<UnixDateTime> parse_http_date(StringView date)
+{
+    // FIXME: Recipients should also accept the obsolete RFC 850 and asctime() formats.
+    // IMF-fixdate, e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+    auto parts = date.split_view(' ');
+    if (parts.size() != 6 || !parts[0].ends_with(',') || parts[5] != "GMT"sv)
+        return {};
+
+    auto day = parts[1].to_number<u8>();
+    auto year = parts[3].to_number<i32>();
+    if (!day.has_value() || !year.has_value())
+        return {};
+
+    Optional<u8> month;
+    for (size_t i = 0; i < short_month_names.size(); ++i) {
+        if (parts[2] == short_month_names[i]) {
+            month = i + 1;
+            break;
+        }
+    }
+
+    auto time = parts[4].split_view(':');
+    if (!month.has_value() || time.size() != 3)
+        return {};
+
+    auto hour = time[0].to_number<u8>();
+    auto minute = time[1].to_number<u8>();
+    auto second = time[2].to_number<u8>();
+    if (!hour.has_value() || !minute.has_value() || !second.has_value())
+        return {};
+
+    if (*day < 1 || *day > 31 || *hour > 23 || *minute > 59 || *second > 60)
+        return {};
+
+    return UnixDateTime::from_unix_time_parts(*year, *month, *day, *hour, *minute, *second, 0);
+}
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+template<typename Callback>
+static void for_each_cache_control_directive(HTTP::HeaderMap const& headers, Callback callback)
+{
+    for (auto const& header : headers.headers()) {
+        if (!header.name.equals_ignoring_ascii_case("Cache-Control"sv))
+            continue;
+
+        for (auto directive : header.value.split_view(',')) {
+            directive = directive.trim_whitespace();
+
+            auto name = directive;
+            StringView value;
+
+            if (auto equals = directive.find('='); equals.has_value()) {
+                name = directive.substring_view(0, *equals).trim_whitespace();
+                value = directive.substring_view(*equals + 1).trim_whitespace();
+
+                if (value.length() >= 2 && value.starts_with('"') && value.ends_with('"'))
+                    value = value.substring_view(1, value.length() - 2);
+            }
+
+            if (callback(name, value) == IterationDecision::Break)
+                return;
+        }
+    }
+}
+
+bool has_cache_control_directive(HTTP::HeaderMap const& headers, StringView directive)
+{
+    bool found = false;
+
+    for_each_cache_control_directive(headers, [&](StringView name, StringView) {
+        if (!name.equals_ignoring_ascii_case(directive))
+            return IterationDecision::Continue;
+
+        found = true;
+        return IterationDecision::Break;
+    });
+
+    return found;
+}
+
+Optional<AK::Duration> cache_control_duration(HTTP::HeaderMap const& headers, StringView directive)
+{
+    Optional<AK::Duration> duration;
+
+    for_each_cache_control_directive(headers, [&](StringView name, StringView value) {
+        if (!name.equals_ignoring_ascii_case(directive))
+            return IterationDecision::Continue;
+
+        // A cache that can't parse the value should consider the response stale.
+        auto seconds = value.to_number<i64>();
+        duration = AK::Duration::from_seconds(max(seconds.value_or(0), 0));
+        return IterationDecision::Break;
+    });
+
+    return duration;
+}
+
+// https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+static bool is_heuristically_cacheable(u32 status_code)
+{
+    switch (status_code) {
+    case 200:
+    case 203:
+    case 204:
+    case 206:
+    case 300:
+    case 301:
+    case 308:
+    case 404:
+    case 405:
+    case 410:
+    case 414:
+    case 501:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool is_cacheable(StringView method, HTTP::HeaderMap const& request_headers)
+{
+    // NOTE: HEAD responses have no content to store, and we don't store partial content.
+    if (method != "GET"sv)
+        return false;
+    if (request_headers.contains("Range"sv))
+        return false;
+
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive.no-store
+    return !has_cache_control_directive(request_headers, "no-store"sv);
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+bool is_cacheable(u32 status_code, HTTP::HeaderMap const& response_headers)
+{
+    // A cache MUST NOT store a response to a request unless:
+
+    // - the response status code is final (see Section 15 of [HTTP]);
+    if (status_code < 200)
+        return false;
+
+    // - if the response status code is 206 or 304, or the must-understand cache directive (see Section 5.2.2.3) is
+    //   present: the cache understands the response status code;
+    // NOTE: We don't combine partial content, and 304s are only used to freshen stored responses.
+    if (status_code == 206 || status_code == 304)
+        return false;
+    if (has_cache_control_directive(response_headers, "must-understand"sv) && !is_heuristically_cacheable(status_code))
+        return false;
+
+    // - the no-store cache directive is not present in the response (see Section 5.2.2.5);
+    if (has_cache_control_directive(response_headers, "no-store"sv))
+        return false;
+
+    // NOTE: A Vary value of "*" always fails to match (Section 4.1), so there's no point in storing the response.
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value() && vary->contains('*'))
+        return false;
+
+    // - the response contains at least one of the following:
+    //   + a public response directive (see Section 5.2.2.9);
+    //   + a private response directive, if the cache is not shared (see Section 5.2.2.7);
+    //   + an Expires header field (see Section 5.3);
+    //   + a max-age response directive (see Section 5.2.2.1);
+    //   + a status code that is defined as heuristically cacheable (see Section 4.2.2).
+    return has_cache_control_directive(response_headers, "public"sv)
+        || has_cache_control_directive(response_headers, "private"sv)
+        || response_headers.contains("Expires"sv)
+        || has_cache_control_directive(response_headers, "max-age"sv)
+        || is_heuristically_cacheable(status_code);
+}
+
+// https://httpwg.org/specs/rfc9111.html#storing.fields
+bool is_header_exempted_from_storage(StringView name)
+{
+    // Connection-specific fields, and fields that only make sense to a proxy, are removed before forwarding the
+    // message. We also leave out Set-Cookie, so that a stored response never replays cookies.
+    return name.is_one_of_ignoring_ascii_case(
+        "Connection"sv,
+        "Keep-Alive"sv,
+        "Proxy-Authenticate"sv,
+        "Proxy-Authentication-Info"sv,
+        "Proxy-Authorization"sv,
+        "Proxy-Connection"sv,
+        "Set-Cookie"sv,
+        "TE"sv,
+        "Transfer-Encoding"sv,
+        "Upgrade"sv);
+}
+
+HTTP::HeaderMap headers_for_storage(HTTP::HeaderMap const& headers)
+{
+    HTTP::HeaderMap stored_headers;
+
+    for (auto const& header : headers.headers()) {
+        if (!is_header_exempted_from_storage(header.name))
+            stored_headers.set(header.name, header.value);
+    }
+
+    return stored_headers;
+}
+
+// https://httpwg.org/specs/rfc9111.html#update
+HTTP::HeaderMap update_stored_headers(HTTP::HeaderMap const& stored_headers, HTTP::HeaderMap const& new_headers)
+{
+    // The cache MUST add each header field in the provided response to the stored response, replacing field values
+    // that are already present, with the exception of fields excepted from storage and the Content-Length field.
+    auto is_exempted_from_updating = [](StringView name) {
+        return is_header_exempted_from_storage(name) || name.equals_ignoring_ascii_case("Content-Length"sv);
+    };
+
+    HTTP::HeaderMap updated_headers;
+
+    for (auto const& header : stored_headers.headers()) {
+        if (is_exempted_from_updating(header.name) || !new_headers.contains(header.name))
+            updated_headers.set(header.name, header.value);
+    }
+
+    for (auto const& header : new_headers.headers()) {
+        if (!is_exempted_from_updating(header.name))
+            updated_headers.set(header.name, header.value);
+    }
+
+    return updated_headers;
+}
+
+static UnixDateTime date_value(HTTP::HeaderMap const& headers, UnixDateTime response_time)
+{
+    // A recipient with a clock that receives a response without a Date header field uses the time it was received.
+    if (auto date = headers.get("Date"sv); date.has_value()) {
+        if (auto value = parse_http_date(*date); value.has_value())
+            return *value;
+    }
+    return response_time;
+}
+
+// https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+AK::Duration calculate_freshness_lifetime(u32 status_code, HTTP::HeaderMap const& headers, UnixDateTime response_time)
+{
+    // A cache can calculate the freshness lifetime (denoted as freshness_lifetime) of a response by evaluating the
+    // following rules and using the first match:
+
+    // - If the cache is shared and the s-maxage response directive (Section 5.2.2.10) is present, use its value, or
+    // NOTE: Our cache is not shared.
+
+    // - If the max-age response directive (Section 5.2.2.1) is present, use its value, or
+    if (auto max_age = cache_control_duration(headers, "max-age"sv); max_age.has_value())
+        return *max_age;
+
+    // - If the Expires response header field (Section 5.3) is present, use its value minus the value of the Date
+    //   response header field (using the time the message was received if it is not present, as per Section 6.6.1
+    //   of [HTTP]), or
+    if (auto expires = headers.get("Expires"sv); expires.has_value()) {
+        // A cache recipient MUST interpret invalid date formats, especially the value "0", as representing a time in
+        // the past (i.e., "already expired").
+        auto expires_value = parse_http_date(*expires);
+        if (!expires_value.has_value())
+            return {};
+
+        return max(*expires_value - date_value(headers, response_time), AK::Duration {});
+    }
+
+    // - Otherwise, no explicit expiration time is present in the response. A heuristic freshness lifetime might be
+    //   applicable; see Section 4.2.2.
+    if (!is_heuristically_cacheable(status_code) && !has_cache_control_directive(headers, "public"sv))
+        return {};
+
+    // If the response has a Last-Modified header field (Section 8.8.2 of [HTTP]), caches are encouraged to use a
+    // heuristic expiration value that is no more than some fraction of the interval since that time. A typical
+    // setting of this fraction might be 10%.
+    if (auto last_modified = headers.get("Last-Modified"sv); last_modified.has_value()) {
+        if (auto last_modified_value = parse_http_date(*last_modified); last_modified_value.has_value()) {
+            auto interval = date_value(headers, response_time) - *last_modified_value;
+            return max(AK::Duration::from_seconds(interval.to_seconds() / 10), AK::Duration {});
+        }
+    }
+
+    return {};
+}
+
+// https://httpwg.org/specs/rfc9111.html#age.calculations
+AK::Duration calculate_age(HTTP::HeaderMap const& headers, UnixDateTime request_time, UnixDateTime response_time)
+{
+    // The term "age_value" denotes the value of the Age header field (Section 5.1), in a form appropriate for
+    // arithmetic operation; or 0, if not available.
+    AK::Duration age_value;
+    if (auto age = headers.get("Age"sv); age.has_value()) {
+        if (auto seconds = age->to_number<i64>(); seconds.has_value() && *seconds > 0)
+            age_value = AK::Duration::from_seconds(*seconds);
+    }
+
+    // The term "now" means the current value of this implementation's clock (Section 5.6.7 of [HTTP]).
+    auto now = UnixDateTime::now();
+
+    auto apparent_age = max(response_time - date_value(headers, response_time), AK::Duration {});
+
+    auto response_delay = response_time - request_time;
+    auto corrected_age_value = age_value + response_delay;
+
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+
+    auto resident_time = now - response_time;
+    return corrected_initial_age + resident_time;
+}
+
+}
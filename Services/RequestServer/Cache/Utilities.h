@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibRequests/CachePartition.h>
+
+namespace RequestServer {
+
+// Helpers for the HTTP caching rules of RFC 9111. Our cache belongs to a single user agent, so it is a private cache.
+
+u64 create_cache_key(Requests::CachePartition const&, StringView url, StringView method);
+
+Optional<UnixDateTime> parse_http_date(StringView);
+
+bool has_cache_control_directive(HTTP::HeaderMap const&, StringView directive);
+Optional<AK::Duration> cache_control_duration(HTTP::HeaderMap const&, StringView directive);
+
+bool is_cacheable(StringView method, HTTP::HeaderMap const& request_headers);
+bool is_cacheable(u32 status_code, HTTP::HeaderMap const& response_headers);
+bool is_header_exempted_from_storage(StringView name);
+
+HTTP::HeaderMap headers_for_storage(HTTP::HeaderMap const&);
+HTTP::HeaderMap update_stored_headers(HTTP::HeaderMap const& stored_headers, HTTP::HeaderMap const& new_headers);
+
+AK::Duration calculate_freshness_lifetime(u32 status_code, HTTP::HeaderMap const&, UnixDateTime response_time);
+AK::Duration calculate_age(HTTP::HeaderMap const&, UnixDateTime request_time, UnixDateTime response_time);
+
+}
@@ -20,6 +20,8 @@
 #include <LibTextCodec/Decoder.h>
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Message.h>
+#include <RequestServer/Cache/DiskCache.h>
+#include <RequestServer/Cache/Utilities.h>
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #ifdef AK_OS_WINDOWS
@@ -31,6 +33,7 @@
 namespace RequestServer {
 
 ByteString g_default_certificate_path;
+OwnPtr<DiskCache> g_disk_cache;
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 static IDAllocator s_client_ids;
 static long s_connect_timeout_seconds = 90L;
@@ -123,6 +126,17 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
     NonnullRefPtr<Core::Notifier> write_notifier;
     bool done_fetching { false };
 
+    // The request as it was made, so that the response can be stored in the disk cache.
+    Optional<URL::URL> cacheable_url;
+    Requests::CachePartition cache_partition;
+    ByteString method;
+    HTTP::HeaderMap request_headers;
+    UnixDateTime request_start_time;
+
+    // A stored response that is being revalidated, or served from the disk cache.
+    OwnPtr<CacheEntryReader> cache_entry_reader;
+    OwnPtr<CacheEntryWriter> cache_entry_writer;
+
     ActiveRequest(ConnectionFromClient& client, CURLM* multi, CURL* easy, i32 request_id, int writer_fd)
         : multi(multi)
         , easy(easy)
@@ -184,12 +198,18 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
             dbgln("Warning: Request destroyed with buffered data (it's likely that the client disappeared or the request was cancelled)");
         }
 
+        // NOTE: The reader may still be waiting for the pipe to become writable.
+        cache_entry_reader = nullptr;
+
         if (writer_fd > 0)
             MUST(Core::System::close(writer_fd));
 
-        auto result = curl_multi_remove_handle(multi, easy);
-        VERIFY(result == CURLM_OK);
-        curl_easy_cleanup(easy);
+        // Responses served from the disk cache don't have a curl handle.
+        if (easy) {
+            auto result = curl_multi_remove_handle(multi, easy);
+            VERIFY(result == CURLM_OK);
+            curl_easy_cleanup(easy);
+        }
 
         for (auto* string_list : curl_string_lists)
             curl_slist_free_all(string_list);
@@ -203,8 +223,41 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
         long http_status_code = 0;
         auto result = curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_status_code);
         VERIFY(result == CURLE_OK);
+
+        if (cache_entry_reader) {
+            // The server confirmed that our stored response is still current, so that's what the client gets.
+            if (http_status_code == 304) {
+                g_disk_cache->freshen_entry(*cache_entry_reader, headers, request_start_time, UnixDateTime::now());
+
+                auto const& metadata = cache_entry_reader->metadata();
+                client->async_headers_became_available(request_id, metadata.response_headers, metadata.status_code, metadata.reason_phrase);
+                return;
+            }
+
+            cache_entry_reader = nullptr;
+        }
+
+        if (g_disk_cache && cacheable_url.has_value())
+            cache_entry_writer = g_disk_cache->create_entry(cache_partition, *cacheable_url, method, request_headers, http_status_code, reason_phrase, headers, request_start_time, UnixDateTime::now());
+
         client->async_headers_became_available(request_id, headers, http_status_code, reason_phrase);
     }
+
+    void send_cached_response_body(Requests::RequestTimingInfo timing_info)
+    {
+        VERIFY(cache_entry_reader);
+
+        auto on_finish = [this, timing_info](u64 bytes_sent, Optional<Requests::NetworkError> network_error) {
+            if (client)
+                client->async_request_finished(request_id, bytes_sent, timing_info, network_error);
+            notify_about_fetching_completion();
+        };
+
+        cache_entry_reader->pipe_to(
+            writer_fd,
+            [on_finish](u64 bytes_sent) { on_finish(bytes_sent, {}); },
+            [on_finish](u64 bytes_sent) { on_finish(bytes_sent, Requests::NetworkError::Unknown); });
+    }
 };
 
 size_t ConnectionFromClient::on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data)
@@ -257,6 +310,13 @@ size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t
         return CURL_WRITEFUNC_ERROR;
     }
 
+    if (request->cache_entry_writer) {
+        if (auto result = request->cache_entry_writer->write_data(bytes); result.is_error()) {
+            dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Not storing response for {} in the disk cache: {}", request->url, result.error());
+            request->cache_entry_writer = nullptr;
+        }
+    }
+
     request->downloaded_so_far += total_size;
     return total_size;
 }
@@ -353,8 +413,13 @@ void ConnectionFromClient::die()
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
 
-    if (s_connections.is_empty())
+    if (s_connections.is_empty()) {
+        if constexpr (REQUESTSERVER_DEBUG) {
+            if (g_disk_cache)
+                g_disk_cache->dump_statistics();
+        }
         Core::EventLoop::current().quit(0);
+    }
 }
 
 Messages::RequestServer::InitTransportResponse ConnectionFromClient::init_transport([[maybe_unused]] int peer_pid)
@@ -411,6 +476,7 @@ ErrorOr<IPC::File> ConnectionFromClient::create_client_socket()
 
     // Note: A ref is stored in the static s_connections map
     auto client = adopt_ref(*new ConnectionFromClient(make<IPC::Transport>(client_socket.release_value())));
+    client->transport().offer_shared_memory_ring();
 
     return IPC::File::adopt_fd(socket_fds[1]);
 }
@@ -456,14 +522,35 @@ void ConnectionFromClient::set_use_system_dns()
 }
 
 #ifdef AK_OS_WINDOWS
-void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData)
+void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<Requests::CachePartition>)
 {
     VERIFY(0 && "RequestServer::ConnectionFromClient::start_request is not implemented");
 }
 #else
-void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data)
+void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, Optional<Requests::CachePartition> cache_partition)
 {
     dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: start_request({}, {})", request_id, url);
+
+    OwnPtr<CacheEntryReader> cache_entry_reader;
+    if (g_disk_cache && cache_partition.has_value()) {
+        cache_entry_reader = g_disk_cache->open_entry(*cache_partition, url, method, request_headers);
+
+        if (cache_entry_reader && !cache_entry_reader->must_revalidate()) {
+            send_cached_response(request_id, cache_entry_reader.release_nonnull());
+            return;
+        }
+
+        // https://httpwg.org/specs/rfc9111.html#validation.sent
+        if (cache_entry_reader) {
+            auto const& response_headers = cache_entry_reader->metadata().response_headers;
+
+            if (auto etag = response_headers.get("ETag"sv); etag.has_value())
+                request_headers.set("If-None-Match"sv, *etag);
+            if (auto last_modified = response_headers.get("Last-Modified"sv); last_modified.has_value())
+                request_headers.set("If-Modified-Since"sv, *last_modified);
+        }
+    }
+
     auto host = url.serialized_host().to_byte_string();
 
     m_resolver->dns.lookup(host, DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA }, { .validate_dnssec_locally = g_dns_info.validate_dnssec_locally })
@@ -472,7 +559,7 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             // FIXME: Implement timing info for DNS lookup failure.
             async_request_finished(request_id, 0, {}, Requests::NetworkError::UnableToResolveHost);
         })
-        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data](auto const& dns_result) mutable {
+        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data, cache_partition = move(cache_partition), cache_entry_reader = move(cache_entry_reader)](auto const& dns_result) mutable {
             if (dns_result->is_empty() || !dns_result->has_cached_addresses()) {
                 dbgln("StartRequest: DNS lookup failed for '{}'", host);
                 // FIXME: Implement timing info for DNS lookup failure.
@@ -501,6 +588,15 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
 
             auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, writer_fd);
             request->url = url.to_string();
+            request->request_start_time = UnixDateTime::now();
+            request->cache_entry_reader = move(cache_entry_reader);
+
+            if (g_disk_cache && cache_partition.has_value() && is_cacheable(method, request_headers)) {
+                request->cacheable_url = url;
+                request->cache_partition = cache_partition.release_value();
+                request->method = method;
+                request->request_headers = request_headers;
+            }
 
             auto set_option = [easy](auto option, auto value) {
                 auto result = curl_easy_setopt(easy, option, value);
@@ -585,6 +681,33 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             m_active_requests.set(request_id, move(request));
         });
 }
+
+void ConnectionFromClient::send_cached_response(i32 request_id, NonnullOwnPtr<CacheEntryReader> cache_entry_reader)
+{
+    auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
+    if (fds_or_error.is_error()) {
+        dbgln("StartRequest: Failed to create pipe: {}", fds_or_error.error());
+        return;
+    }
+
+    auto fds = fds_or_error.release_value();
+    auto writer_fd = fds[1];
+    auto reader_fd = fds[0];
+    async_request_started(request_id, IPC::File::adopt_fd(reader_fd));
+
+    auto request = make<ActiveRequest>(*this, m_curl_multi, nullptr, request_id, writer_fd);
+    request->url = MUST(String::from_byte_string(cache_entry_reader->metadata().url));
+    request->got_all_headers = true;
+
+    auto const& metadata = cache_entry_reader->metadata();
+    async_headers_became_available(request_id, metadata.response_headers, metadata.status_code, metadata.reason_phrase);
+
+    request->cache_entry_reader = move(cache_entry_reader);
+
+    auto& request_ref = *request;
+    m_active_requests.set(request_id, move(request));
+    request_ref.send_cached_response_body({});
+}
 #endif
 
 static Requests::NetworkError map_curl_code_to_network_error(CURLcode const& code)
@@ -732,6 +855,21 @@ void ConnectionFromClient::check_active_requests()
                 }
             }
 
+            if (request->cache_entry_writer) {
+                if (request_was_successful) {
+                    if (auto maybe_error = request->cache_entry_writer->flush(); maybe_error.is_error())
+                        dbgln("ConnectionFromClient: Unable to store response for {} in the disk cache: {}", request->url, maybe_error.error());
+                }
+                request->cache_entry_writer = nullptr;
+            }
+
+            // The server confirmed that our stored response is still current, so its body goes in place of the
+            // server's empty one. The request is finished once it has been sent.
+            if (request->cache_entry_reader && request_was_successful) {
+                request->send_cached_response_body(timing_info);
+                continue;
+            }
+
             async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
         }
 
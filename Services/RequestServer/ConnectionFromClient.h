@@ -15,6 +15,8 @@
 
 namespace RequestServer {
 
+class CacheEntryReader;
+
 struct Resolver : public RefCounted<Resolver>
     , Weakable<Resolver> {
     Resolver(Function<ErrorOr<DNS::Resolver::SocketResult>()> create_socket)
@@ -44,7 +46,7 @@ private:
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString) override;
     virtual void set_dns_server(ByteString host_or_address, u16 port, bool use_tls, bool validate_dnssec_locally) override;
     virtual void set_use_system_dns() override;
-    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData) override;
+    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<Requests::CachePartition>) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString, ByteString) override;
     virtual void ensure_connection(URL::URL url, ::RequestServer::CacheLevel cache_level) override;
@@ -61,6 +63,8 @@ private:
 
     static ErrorOr<IPC::File> create_client_socket();
 
+    void send_cached_response(i32 request_id, NonnullOwnPtr<CacheEntryReader>);
+
     static int on_socket_callback(void*, int sockfd, int what, void* user_data, void*);
     static int on_timeout_callback(void*, long timeout_ms, void* user_data);
     static size_t on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data);
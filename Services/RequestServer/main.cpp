@@ -14,6 +14,7 @@
 #include <LibCore/Process.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
+#include <RequestServer/Cache/DiskCache.h>
 #include <RequestServer/ConnectionFromClient.h>
 
 #if defined(AK_OS_MACOS)
@@ -23,6 +24,7 @@
 namespace RequestServer {
 
 extern ByteString g_default_certificate_path;
+extern OwnPtr<DiskCache> g_disk_cache;
 
 }
 
@@ -33,11 +35,13 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     Vector<ByteString> certificates;
     StringView mach_server_name;
     bool wait_for_debugger = false;
+    bool disable_http_disk_cache = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
+    args_parser.add_option(disable_http_disk_cache, "Disable the on-disk HTTP cache", "disable-http-disk-cache");
     args_parser.parse(arguments);
 
     if (wait_for_debugger)
@@ -49,12 +53,20 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
 
     Core::EventLoop event_loop;
 
+    if (!disable_http_disk_cache) {
+        if (auto disk_cache = RequestServer::DiskCache::create(); disk_cache.is_error())
+            warnln("Unable to create the HTTP disk cache: {}", disk_cache.error());
+        else
+            RequestServer::g_disk_cache = disk_cache.release_value();
+    }
+
 #if defined(AK_OS_MACOS)
     if (!mach_server_name.is_empty())
         Core::Platform::register_with_mach_server(mach_server_name);
 #endif
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<RequestServer::ConnectionFromClient>());
+    client->transport().offer_shared_memory_ring();
 
     return event_loop.exec();
 }
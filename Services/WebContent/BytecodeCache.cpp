@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibThreading/BackgroundAction.h>
+#include <WebContent/BytecodeCache.h>
+
+namespace WebContent {
+
+static constexpr u64 maximum_size_on_disk = 64 * MiB;
+
+// Evicting a bit more than we need to means we don't have to scan the whole cache again on the next store.
+static constexpr u64 size_on_disk_after_eviction = 48 * MiB;
+
+// Entries that were read but not loaded yet belong to functions that haven't been called (and may never be).
+static constexpr size_t maximum_size_in_memory = 8 * MiB;
+
+// Scripts we've read stay around even when they had no entries, so that their other functions don't hit the disk again.
+static constexpr size_t maximum_scripts_in_memory = 1024;
+
+struct EntryPath {
+    StringView source_hash;
+    StringView name;
+};
+
+static Optional<EntryPath> entry_path_for_key(StringView key)
+{
+    auto separator = key.find('-');
+    if (!separator.has_value() || *separator == 0 || *separator == key.length() - 1)
+        return {};
+    return EntryPath { key.substring_view(0, *separator), key.substring_view(*separator + 1) };
+}
+
+ErrorOr<NonnullOwnPtr<BytecodeCache>> BytecodeCache::create()
+{
+    return create(ByteString::formatted("{}/Ladybird/BytecodeCache", Core::StandardPaths::user_data_directory()));
+}
+
+ErrorOr<NonnullOwnPtr<BytecodeCache>> BytecodeCache::create(ByteString directory)
+{
+    TRY(Core::Directory::create(LexicalPath { directory }, Core::Directory::CreateDirectories::Yes));
+    auto storage = TRY(try_make_ref_counted<Storage>(move(directory)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) BytecodeCache(move(storage)));
+}
+
+BytecodeCache::BytecodeCache(NonnullRefPtr<Storage> storage)
+    : m_storage(move(storage))
+{
+}
+
+static ErrorOr<HashMap<String, ByteBuffer>> read_entries(ByteString const& directory, String const& source_hash)
+{
+    HashMap<String, ByteBuffer> entries;
+    auto script_directory = ByteString::formatted("{}/{}", directory, source_hash);
+
+    auto result = Core::Directory::for_each_entry(script_directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        // Entries that are still being written have a leading dot.
+        if (entry.name.starts_with('.'))
+            return IterationDecision::Continue;
+
+        // Another process may have evicted the script in the meantime.
+        auto file = Core::File::open(ByteString::formatted("{}/{}", script_directory, entry.name), Core::File::OpenMode::Read);
+        if (file.is_error())
+            return IterationDecision::Continue;
+
+        auto key = TRY(String::formatted("{}-{}", source_hash, entry.name));
+        TRY(entries.try_set(move(key), TRY(file.value()->read_until_eof())));
+        return IterationDecision::Continue;
+    });
+    if (result.is_error() && result.error().code() != ENOENT)
+        return result.release_error();
+
+    // Eviction goes by the modification time of the script's directory, so mark it as recently used.
+    if (!entries.is_empty())
+        (void)Core::System::utimensat(AT_FDCWD, script_directory, nullptr, 0);
+
+    return entries;
+}
+
+struct CachedScript {
+    ByteString directory;
+    UnixDateTime last_used;
+    u64 size { 0 };
+};
+
+static ErrorOr<Vector<CachedScript>> list_cached_scripts(ByteString const& directory)
+{
+    Vector<CachedScript> scripts;
+
+    TRY(Core::Directory::for_each_entry(directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        if (entry.type != Core::DirectoryEntry::Type::Directory)
+            return IterationDecision::Continue;
+
+        CachedScript script { .directory = ByteString::formatted("{}/{}", directory, entry.name) };
+        auto script_stat = Core::System::stat(script.directory);
+        if (script_stat.is_error())
+            return IterationDecision::Continue;
+#if defined(AK_OS_MACOS) || defined(AK_OS_IOS)
+        script.last_used = UnixDateTime::from_unix_timespec(script_stat.value().st_mtimespec);
+#else
+        script.last_used = UnixDateTime::from_unix_timespec(script_stat.value().st_mtim);
+#endif
+
+        (void)Core::Directory::for_each_entry(script.directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& file, auto const&) -> ErrorOr<IterationDecision> {
+            if (auto file_stat = Core::System::stat(ByteString::formatted("{}/{}", script.directory, file.name)); !file_stat.is_error())
+                script.size += file_stat.value().st_size;
+            return IterationDecision::Continue;
+        });
+
+        TRY(scripts.try_append(move(script)));
+        return IterationDecision::Continue;
+    }));
+
+    return scripts;
+}
+
+static ErrorOr<void> evict_least_recently_used_scripts(ByteString const& directory, u64& size_on_disk)
+{
+    auto scripts = TRY(list_cached_scripts(directory));
+
+    size_on_disk = 0;
+    for (auto const& script : scripts)
+        size_on_disk += script.size;
+    if (size_on_disk <= maximum_size_on_disk)
+        return {};
+
+    quick_sort(scripts, [](auto const& a, auto const& b) { return a.last_used < b.last_used; });
+
+    for (auto const& script : scripts) {
+        if (size_on_disk <= size_on_disk_after_eviction)
+            break;
+        if (auto result = FileSystem::remove(script.directory, FileSystem::RecursionMode::Allowed); result.is_error()) {
+            dbgln("BytecodeCache: Unable to evict {}: {}", script.directory, result.error());
+            continue;
+        }
+        size_on_disk -= script.size;
+    }
+
+    return {};
+}
+
+static ErrorOr<void> write_entry(ByteString const& directory, StringView source_hash, StringView name, ReadonlyBytes bytes)
+{
+    auto script_directory = ByteString::formatted("{}/{}", directory, source_hash);
+    auto path = ByteString::formatted("{}/{}", script_directory, name);
+
+    // Another process may have stored the same entry first.
+    if (!Core::System::access(path, F_OK).is_error())
+        return {};
+
+    TRY(Core::Directory::create(LexicalPath { script_directory }, Core::Directory::CreateDirectories::Yes));
+
+    // Other WebContent processes may be reading the same entry, so it only appears under its real name once complete.
+    auto pattern = ByteString::formatted("{}/.tmp-XXXXXX", script_directory);
+    Vector<char> temporary_path;
+    temporary_path.append(pattern.characters(), pattern.length() + 1);
+
+    auto result = [&]() -> ErrorOr<void> {
+        auto fd = TRY(Core::System::mkstemp(temporary_path));
+        auto file = TRY(Core::File::adopt_fd(fd, Core::File::OpenMode::Write));
+        TRY(file->write_until_depleted(bytes));
+        TRY(Core::System::rename({ temporary_path.data(), pattern.length() }, path));
+        return {};
+    }();
+
+    if (result.is_error())
+        (void)Core::System::unlink({ temporary_path.data(), pattern.length() });
+    return result;
+}
+
+Optional<ByteBuffer> BytecodeCache::load(StringView key)
+{
+    auto entry_path = entry_path_for_key(key);
+    if (!entry_path.has_value())
+        return {};
+
+    auto source_hash = MUST(String::from_utf8(entry_path->source_hash));
+    auto script = m_scripts_read.find(source_hash);
+    if (script == m_scripts_read.end())
+        script = read_script(source_hash);
+
+    auto bytes = script->value.entries.take(MUST(String::from_utf8(key)));
+    if (bytes.has_value()) {
+        script->value.size -= bytes->size();
+        m_size_in_memory -= bytes->size();
+    }
+    return bytes;
+}
+
+// The rest of the script's functions will likely be compiled soon, so we read all of them at once. That's a single small
+// directory, which is still a lot cheaper than generating the bytecode of the function we're looking up.
+OrderedHashMap<String, BytecodeCache::ScriptEntries>::IteratorType BytecodeCache::read_script(String const& source_hash)
+{
+    ScriptEntries script;
+    if (auto entries = read_entries(m_storage->directory, source_hash); !entries.is_error())
+        script.entries = entries.release_value();
+    else
+        dbgln("BytecodeCache: Unable to read entries for {}: {}", source_hash, entries.error());
+
+    for (auto const& entry : script.entries)
+        script.size += entry.value.size();
+
+    evict_scripts(script.size);
+
+    m_size_in_memory += script.size;
+    m_scripts_read.set(source_hash, move(script));
+    return m_scripts_read.find(source_hash);
+}
+
+void BytecodeCache::evict_scripts(size_t size_needed)
+{
+    while (!m_scripts_read.is_empty() && (m_size_in_memory + size_needed > maximum_size_in_memory || m_scripts_read.size() >= maximum_scripts_in_memory)) {
+        auto oldest = m_scripts_read.begin();
+        m_size_in_memory -= oldest->value.size;
+        m_scripts_read.remove(oldest);
+    }
+}
+
+void BytecodeCache::store(StringView key, ReadonlyBytes bytes)
+{
+    auto entry_path = entry_path_for_key(key);
+    if (!entry_path.has_value())
+        return;
+
+    auto buffer = ByteBuffer::copy(bytes);
+    if (buffer.is_error())
+        return;
+
+    Threading::BackgroundAction<Empty>::construct(
+        [storage = m_storage, source_hash = ByteString { entry_path->source_hash }, name = ByteString { entry_path->name }, bytes = buffer.release_value()](auto&) -> ErrorOr<Empty> {
+            TRY(write_entry(storage->directory, source_hash, name, bytes));
+
+            if (storage->size_on_disk.has_value())
+                *storage->size_on_disk += bytes.size();
+
+            // The first store in this process has to find out how much the other processes have left behind.
+            if (!storage->size_on_disk.has_value() || *storage->size_on_disk > maximum_size_on_disk) {
+                u64 size_on_disk = 0;
+                TRY(evict_least_recently_used_scripts(storage->directory, size_on_disk));
+                storage->size_on_disk = size_on_disk;
+            }
+            return Empty {};
+        },
+        nullptr,
+        [key = ByteString { key }](Error error) {
+            dbgln("BytecodeCache: Unable to store {}: {}", key, error);
+        });
+}
+
+}
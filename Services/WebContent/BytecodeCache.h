@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+
+namespace WebContent {
+
+// Keeps serialized bytecode in the user's data directory, so it's shared by every WebContent process and survives restarts.
+// Entries are grouped in a directory per script, and the least recently used scripts are evicted once we're over the limit.
+// The first lookup for a script reads all of its entries at once, so its other functions don't have to go to the disk, and
+// stores are written behind on a background thread.
+// FIXME: Entries aren't partitioned by top-level site, so a page could tell which scripts another site has run by timing
+//        its own compiles, and a compromised WebContent process could plant bytecode for other sites. Until the cache
+//        is partitioned and brokered by the browser process, it's only enabled with --enable-bytecode-cache.
+class BytecodeCache final : public JS::Bytecode::ExecutableCache {
+public:
+    static ErrorOr<NonnullOwnPtr<BytecodeCache>> create();
+    static ErrorOr<NonnullOwnPtr<BytecodeCache>> create(ByteString directory);
+
+    virtual Optional<ByteBuffer> load(StringView key) override;
+    virtual void store(StringView key, ReadonlyBytes) override;
+
+private:
+    // Only used on the background thread.
+    struct Storage : public AtomicRefCounted<Storage> {
+        explicit Storage(ByteString directory)
+            : directory(move(directory))
+        {
+        }
+
+        ByteString directory;
+        Optional<u64> size_on_disk;
+    };
+
+    explicit BytecodeCache(NonnullRefPtr<Storage>);
+
+    struct ScriptEntries {
+        HashMap<String, ByteBuffer> entries;
+        size_t size { 0 };
+    };
+
+    OrderedHashMap<String, ScriptEntries>::IteratorType read_script(String const& source_hash);
+    void evict_scripts(size_t size_needed);
+
+    NonnullRefPtr<Storage> m_storage;
+
+    // Entries are dropped once they've been loaded, and whole scripts are dropped in the order they were read once we're
+    // holding on to too much.
+    OrderedHashMap<String, ScriptEntries> m_scripts_read;
+    size_t m_size_in_memory { 0 };
+};
+
+}
@@ -16,6 +16,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/SystemTheme.h>
+#include <LibGfx/TextShapingCache.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/Date.h>
 #include <LibUnicode/TimeZone.h>
@@ -364,6 +365,13 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
         return;
     }
 
+    if (request == "dump-text-shaping-cache-statistics") {
+        auto const& cache = Gfx::TextShapingCache::the();
+        auto const& statistics = cache.statistics();
+        dbgln("Text shaping cache (main thread): {} entries, {} hits, {} misses, {} evictions", cache.size(), statistics.hits, statistics.misses, statistics.evictions);
+        return;
+    }
+
     if (request == "collect-garbage") {
         // NOTE: We use deferred_invoke here to ensure that GC runs with as little on the stack as possible.
         Core::deferred_invoke([] {
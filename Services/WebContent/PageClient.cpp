@@ -574,6 +574,46 @@ void PageClient::page_did_clear_storage(Web::StorageAPI::StorageEndpointType sto
     }
 }
 
+Optional<Web::IndexedDB::PersistedDatabaseContents> PageClient::page_did_request_indexed_db_database(String const& storage_key, String const& name)
+{
+    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestIndexedDbDatabase>(storage_key, name);
+    if (!response) {
+        dbgln("WebContent client disconnected during DidRequestIndexedDbDatabase. Exiting peacefully.");
+        exit(0);
+    }
+    return response->take_contents();
+}
+
+Vector<Web::IndexedDB::PersistedDatabase> PageClient::page_did_request_indexed_db_databases(String const& storage_key)
+{
+    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestIndexedDbDatabases>(storage_key);
+    if (!response) {
+        dbgln("WebContent client disconnected during DidRequestIndexedDbDatabases. Exiting peacefully.");
+        exit(0);
+    }
+    return response->take_databases();
+}
+
+Optional<ByteBuffer> PageClient::page_did_request_indexed_db_record_value(String const& storage_key, String const& name, u64 object_store_id, ByteBuffer const& key)
+{
+    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestIndexedDbRecordValue>(storage_key, name, object_store_id, key);
+    if (!response) {
+        dbgln("WebContent client disconnected during DidRequestIndexedDbRecordValue. Exiting peacefully.");
+        exit(0);
+    }
+    return response->take_value();
+}
+
+void PageClient::page_did_commit_indexed_db_changes(String const& storage_key, String const& name, Web::IndexedDB::PersistedDatabaseChanges const& changes)
+{
+    client().async_did_commit_indexed_db_changes(storage_key, name, changes);
+}
+
+void PageClient::page_did_delete_indexed_db_database(String const& storage_key, String const& name)
+{
+    client().async_did_delete_indexed_db_database(storage_key, name);
+}
+
 void PageClient::page_did_update_resource_count(i32 count_waiting)
 {
     client().async_did_update_resource_count(m_id, count_waiting);
@@ -155,6 +155,11 @@ private:
     virtual void page_did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key) override;
     virtual Vector<String> page_did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key) override;
     virtual void page_did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key) override;
+    virtual Optional<Web::IndexedDB::PersistedDatabaseContents> page_did_request_indexed_db_database(String const& storage_key, String const& name) override;
+    virtual Vector<Web::IndexedDB::PersistedDatabase> page_did_request_indexed_db_databases(String const& storage_key) override;
+    virtual Optional<ByteBuffer> page_did_request_indexed_db_record_value(String const& storage_key, String const& name, u64 object_store_id, ByteBuffer const& key) override;
+    virtual void page_did_commit_indexed_db_changes(String const& storage_key, String const& name, Web::IndexedDB::PersistedDatabaseChanges const&) override;
+    virtual void page_did_delete_indexed_db_database(String const& storage_key, String const& name) override;
     virtual void page_did_update_resource_count(i32) override;
     virtual NewWebViewResult page_did_request_new_web_view(Web::HTML::ActivateTab, Web::HTML::WebViewHints, Web::HTML::TokenizedFeature::NoOpener) override;
     virtual void page_did_request_activate_tab() override;
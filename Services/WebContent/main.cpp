@@ -10,6 +10,7 @@
 #include <LibCore/LocalServer.h>
 #include <LibCore/Process.h>
 #include <LibCore/Resource.h>
+#include <LibCore/System.h>
 #include <LibCore/SystemServerTakeover.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/PathFontProvider.h>
@@ -19,6 +20,7 @@
 #include <LibMedia/Audio/Loader.h>
 #include <LibRequests/RequestClient.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/Internals.h>
@@ -34,6 +36,7 @@
 #include <LibWebView/Plugins/ImageCodecPlugin.h>
 #include <LibWebView/SiteIsolation.h>
 #include <LibWebView/Utilities.h>
+#include <WebContent/BytecodeCache.h>
 #include <WebContent/ConnectionFromClient.h>
 #include <WebContent/PageClient.h>
 #include <WebContent/WebDriverConnection.h>
@@ -96,8 +99,15 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
+    u32 gc_max_pause_ms = 0;
+    bool gc_lazy_sweeping = false;
+    bool gc_precise_stack = false;
+    Optional<size_t> gc_collector_threads;
+    bool enable_js_jit = false;
+    bool enable_bytecode_cache = false;
     bool is_headless = false;
     bool disable_scrollbar_painting = false;
+    bool disable_parallel_style = false;
     StringView echo_server_port_string_view {};
 
     Core::ArgsParser args_parser;
@@ -118,7 +128,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
+    args_parser.add_option(gc_max_pause_ms, "Mark the JS heap incrementally, in steps of at most this many milliseconds", "gc-max-pause-ms", 0, "ms");
+    args_parser.add_option(gc_lazy_sweeping, "Sweep the JS heap lazily instead of at the end of every collection", "gc-lazy-sweeping");
+    args_parser.add_option(gc_precise_stack, "Don't scan JS interpreter call frames conservatively for GC roots", "gc-precise-stack");
+    args_parser.add_option(gc_collector_threads, "Number of threads that mark and sweep the JS heap (1 to collect on the main thread only)", "gc-collector-threads", 0, "count");
+    args_parser.add_option(enable_js_jit, "Compile frequently run JavaScript to native code (experimental, x86-64 only)", "enable-js-jit");
+    args_parser.add_option(enable_bytecode_cache, "Reuse compiled JavaScript bytecode across page loads (experimental)", "enable-bytecode-cache");
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical viewport scrollbars", "disable-scrollbar-painting");
+    args_parser.add_option(disable_parallel_style, "Match CSS rules on the main thread only", "disable-parallel-style");
     args_parser.add_option(echo_server_port_string_view, "Echo server port used in test internals", "echo-server-port", 0, "echo_server_port");
     args_parser.add_option(is_headless, "Report that the browser is running in headless mode", "headless");
 
@@ -158,6 +175,9 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
 
     Web::Painting::set_paint_viewport_scrollbars(!disable_scrollbar_painting);
 
+    if (disable_parallel_style)
+        Web::CSS::StyleComputer::set_parallel_rule_matching_enabled(false);
+
     if (!echo_server_port_string_view.is_empty()) {
         if (auto maybe_echo_server_port = echo_server_port_string_view.to_number<u16>(); maybe_echo_server_port.has_value())
             Web::Internals::Internals::set_echo_server_port(maybe_echo_server_port.value());
@@ -181,6 +201,9 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
 
     Web::HTML::Window::set_internals_object_exposed(expose_internals_object);
 
+    if (enable_js_jit)
+        JS::Bytecode::g_jit_enabled = true;
+
     Web::Platform::FontPlugin::install(*new WebView::FontPlugin(is_layout_test_mode, &font_provider));
 
     Web::Bindings::initialize_main_thread_vm(Web::Bindings::AgentType::SimilarOriginWindow);
@@ -188,6 +211,26 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     if (collect_garbage_on_every_allocation)
         Web::Bindings::main_thread_vm().heap().set_should_collect_on_every_allocation(true);
 
+    if (gc_max_pause_ms > 0)
+        Web::Bindings::main_thread_vm().heap().set_incremental_marking_time_budget(AK::Duration::from_milliseconds(gc_max_pause_ms));
+    if (gc_lazy_sweeping)
+        Web::Bindings::main_thread_vm().heap().set_lazy_sweeping_enabled(true);
+    if (gc_precise_stack)
+        Web::Bindings::main_thread_vm().heap().set_precise_stack_scanning_enabled(true);
+
+    // NOTE: The main thread collects as well.
+    static constexpr size_t default_gc_collector_thread_count = 4;
+    auto gc_collector_thread_count = gc_collector_threads.value_or(min<size_t>(max(Core::System::hardware_concurrency(), 1u), default_gc_collector_thread_count));
+    Web::Bindings::main_thread_vm().heap().set_collector_thread_count(gc_collector_thread_count);
+
+    // Layout tests shouldn't depend on what earlier runs left behind.
+    if (enable_bytecode_cache && !is_layout_test_mode) {
+        if (auto cache = WebContent::BytecodeCache::create(); !cache.is_error())
+            Web::Bindings::main_thread_vm().set_executable_cache(cache.release_value());
+        else
+            dbgln("Unable to create bytecode cache: {}", cache.error());
+    }
+
     TRY(initialize_resource_loader(Web::Bindings::main_thread_vm().heap(), request_server_socket));
 
     if (log_all_js_exceptions) {
@@ -206,6 +249,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
 
     auto webcontent_socket = TRY(Core::take_over_socket_from_system_server("WebContent"sv));
     auto webcontent_client = WebContent::ConnectionFromClient::construct(make<IPC::Transport>(move(webcontent_socket)));
+    webcontent_client->transport().offer_shared_memory_ring();
 
     webcontent_client->on_request_server_connection = [&](auto const& socket_file) {
         if (auto result = reinitialize_resource_loader(socket_file); result.is_error())
@@ -250,6 +294,7 @@ ErrorOr<void> initialize_resource_loader(GC::Heap& heap, int request_server_sock
     TRY(socket->set_blocking(true));
 
     auto request_client = TRY(try_make_ref_counted<Requests::RequestClient>(make<IPC::Transport>(move(socket))));
+    request_client->transport().offer_shared_memory_ring();
 #ifdef AK_OS_WINDOWS
     auto response = request_client->send_sync<Messages::RequestServer::InitTransport>(Core::System::getpid());
     request_client->transport().set_peer_pid(response->peer_pid());
@@ -266,6 +311,7 @@ ErrorOr<void> reinitialize_resource_loader(IPC::File const& request_server_socke
     TRY(socket->set_blocking(true));
 
     auto request_client = TRY(try_make_ref_counted<Requests::RequestClient>(make<IPC::Transport>(move(socket))));
+    request_client->transport().offer_shared_memory_ring();
     Web::ResourceLoader::the().set_client(move(request_client));
 
     return {};
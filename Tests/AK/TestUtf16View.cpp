@@ -835,6 +835,33 @@ TEST_CASE(find_code_unit_offset)
     EXPECT(!view.find_code_unit_offset(u"baz"sv).has_value());
 }
 
+TEST_CASE(find_code_unit_offset_in_long_strings)
+{
+    // These are long enough to be searched many code units at a time, with ASCII and UTF-16 storage on either side.
+    auto ascii = Utf16String::from_utf8(MUST(String::formatted("{}needle{}needle", String::repeated('x', 100).release_value(), String::repeated('x', 7).release_value())));
+    auto utf16 = Utf16String::from_utf8(MUST(String::formatted("😀{}needle{}needle", String::repeated('x', 98).release_value(), String::repeated('x', 7).release_value())));
+    EXPECT(ascii.has_ascii_storage());
+    EXPECT(!utf16.has_ascii_storage());
+
+    for (auto const& haystack : { ascii, utf16 }) {
+        auto view = haystack.utf16_view();
+        auto ascii_needle = Utf16String::from_utf8("needle"sv);
+        for (auto needle : { ascii_needle.utf16_view(), u"needle"sv }) {
+            EXPECT_EQ(view.find_code_unit_offset(needle), 100u);
+            EXPECT_EQ(view.find_code_unit_offset(needle, 100), 100u);
+            EXPECT_EQ(view.find_code_unit_offset(needle, 101), 113u);
+            EXPECT(!view.find_code_unit_offset(needle, 114).has_value());
+        }
+
+        EXPECT_EQ(view.find_code_unit_offset(u"xn"sv), 99u);
+        EXPECT(!view.find_code_unit_offset(u"nx"sv).has_value());
+        EXPECT(!view.find_code_unit_offset(u"needlf"sv).has_value());
+    }
+
+    EXPECT_EQ(utf16.utf16_view().find_code_unit_offset(u"\xde00x"sv), 1u);
+    EXPECT(!ascii.utf16_view().find_code_unit_offset(u"x😀"sv).has_value());
+}
+
 TEST_CASE(find_code_unit_offset_ignoring_case)
 {
     auto conversion_result = Utf16String::from_utf8("😀Foo😀Bar"sv);
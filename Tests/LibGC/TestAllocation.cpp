@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGC/CellAllocator.h>
+#include <LibGC/Heap.h>
+
+namespace {
+
+// Small cells without a TypeIsolatingCellAllocator, roughly the mix of objects, strings and numbers that something
+// like JSON.parse() produces.
+template<size_t payload_size>
+class SmallCell final : public GC::Cell {
+    GC_CELL(SmallCell, GC::Cell);
+
+private:
+    u8 m_payload[payload_size] {};
+};
+
+// Type-isolated cells, like documents and windows, can be larger than the largest size class, as long as one of them
+// fits into a block.
+class LargeIsolatedCell final : public GC::Cell {
+    GC_CELL(LargeIsolatedCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(LargeIsolatedCell);
+
+private:
+    u8 m_payload[3200] {};
+};
+
+GC_DEFINE_ALLOCATOR(LargeIsolatedCell);
+
+}
+
+TEST_CASE(small_cells_use_smallest_fitting_size_class)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    auto small = heap.allocate<SmallCell<8>>();
+    auto medium = heap.allocate<SmallCell<80>>();
+    auto large = heap.allocate<SmallCell<900>>();
+
+    EXPECT_EQ(GC::HeapBlock::from_cell(small.ptr())->cell_size(), 64u);
+    EXPECT_EQ(GC::HeapBlock::from_cell(medium.ptr())->cell_size(), 96u);
+    EXPECT_EQ(GC::HeapBlock::from_cell(large.ptr())->cell_size(), 1024u);
+}
+
+TEST_CASE(type_isolated_cells_are_not_limited_by_size_classes)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    auto cell = heap.allocate<LargeIsolatedCell>();
+
+    EXPECT_EQ(GC::HeapBlock::from_cell(cell.ptr())->cell_size(), sizeof(LargeIsolatedCell));
+}
+
+BENCHMARK_CASE(small_cell_allocation_throughput)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+
+    for (size_t i = 0; i < 1'000'000; ++i) {
+        (void)heap.allocate<SmallCell<16>>();
+        (void)heap.allocate<SmallCell<48>>();
+        (void)heap.allocate<SmallCell<100>>();
+    }
+}
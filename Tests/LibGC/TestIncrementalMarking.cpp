@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/HashTable.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+
+namespace {
+
+class Node final : public GC::Cell {
+    GC_CELL(Node, GC::Cell);
+
+public:
+    static inline HashTable<size_t> s_finalized_ids;
+
+    explicit Node(size_t id)
+        : m_id(id)
+    {
+    }
+
+    size_t id() const { return m_id; }
+
+    GC::Ptr<Node> first;
+    GC::Ptr<Node> second;
+
+private:
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(first);
+        visitor.visit(second);
+    }
+
+    virtual void finalize() override
+    {
+        Base::finalize();
+        s_finalized_ids.set(m_id);
+    }
+
+    size_t m_id { 0 };
+};
+
+}
+
+static constexpr size_t garbage_id = NumericLimits<size_t>::max();
+
+// Returns the last node of the chain.
+static NEVER_INLINE Node& append_chain(GC::Heap& heap, Node& head, size_t length, size_t first_id)
+{
+    auto* node = &head;
+    for (size_t i = 0; i < length; ++i) {
+        auto next = heap.allocate<Node>(first_id + i);
+        node->first = next;
+        node = next.ptr();
+    }
+    return *node;
+}
+
+static NEVER_INLINE void start_incremental_marking(GC::Heap& heap)
+{
+    for (size_t i = 0; i < 10'000'000 && !heap.is_incremental_marking_in_progress(); ++i)
+        (void)heap.allocate<Node>(garbage_id);
+    VERIFY(heap.is_incremental_marking_in_progress());
+}
+
+TEST_CASE(incremental_marking_steps_stay_within_budget)
+{
+    static constexpr auto budget = AK::Duration::from_milliseconds(1);
+    // Marking a step's last batch of cells may run past the deadline, and the machine may be busy.
+    static constexpr auto tolerance = AK::Duration::from_milliseconds(2);
+
+    GC::Heap heap(nullptr, [](auto&) { });
+    auto root = GC::make_root(heap.allocate<Node>(0));
+    (void)append_chain(heap, *root, 500'000, 1);
+
+    heap.set_incremental_marking_time_budget(budget);
+    start_incremental_marking(heap);
+
+    size_t step_count = 0;
+    while (heap.is_incremental_marking_in_progress()) {
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        heap.perform_incremental_marking_step();
+        auto elapsed = timer.elapsed_time();
+
+        // The step that finishes marking also runs the final pause, which isn't bounded by the budget.
+        if (heap.is_incremental_marking_in_progress()) {
+            EXPECT(elapsed <= budget + tolerance);
+            ++step_count;
+        }
+    }
+
+    EXPECT(step_count > 1);
+    EXPECT(!Node::s_finalized_ids.contains(500'000));
+}
+
+// Detaches the rest of the chain after the given depth and hands it over to the new parent.
+static NEVER_INLINE void move_chain_after_depth(Node& head, size_t depth, Node& new_parent)
+{
+    auto* node = &head;
+    for (size_t i = 0; i < depth; ++i)
+        node = node->first.ptr();
+    new_parent.first = node->first;
+    node->first = nullptr;
+}
+
+TEST_CASE(cells_stored_during_incremental_marking_survive)
+{
+    static constexpr size_t chain_length = 100'000;
+    static constexpr size_t first_chain_id = 1'000'000;
+
+    GC::Heap heap(nullptr, [](auto&) { });
+    auto root = GC::make_root(heap.allocate<Node>(0));
+    root->second = heap.allocate<Node>(1);
+    (void)append_chain(heap, *root, chain_length, first_chain_id);
+
+    heap.set_incremental_marking_time_budget(AK::Duration::from_microseconds(1));
+    start_incremental_marking(heap);
+    heap.perform_incremental_marking_step();
+    EXPECT(heap.is_incremental_marking_in_progress());
+    EXPECT(root->second->is_marked());
+
+    // The second half of the chain now hangs off a cell that was already traced, so only the write barrier can mark it.
+    move_chain_after_depth(*root, chain_length / 2, *root->second);
+    EXPECT(root->second->first->is_marked());
+
+    while (heap.is_incremental_marking_in_progress())
+        heap.perform_incremental_marking_step();
+
+    size_t collected_count = 0;
+    for (size_t id = first_chain_id + chain_length / 2; id < first_chain_id + chain_length; ++id) {
+        if (Node::s_finalized_ids.contains(id))
+            ++collected_count;
+    }
+    EXPECT_EQ(collected_count, 0u);
+}
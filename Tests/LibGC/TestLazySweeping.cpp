@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+
+namespace {
+
+class CountedCell final : public GC::Cell {
+    GC_CELL(CountedCell, GC::Cell);
+
+public:
+    static inline size_t s_finalized_count { 0 };
+    static inline size_t s_destroyed_count { 0 };
+
+    virtual ~CountedCell() override { ++s_destroyed_count; }
+
+private:
+    virtual void finalize() override
+    {
+        Base::finalize();
+        ++s_finalized_count;
+    }
+};
+
+}
+
+static NEVER_INLINE void allocate_garbage(GC::Heap& heap, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        (void)heap.allocate<CountedCell>();
+}
+
+TEST_CASE(lazy_sweeping_defers_destruction_until_allocation)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_lazy_sweeping_enabled(true);
+
+    auto root = GC::make_root(heap.allocate<CountedCell>());
+    allocate_garbage(heap, 1000);
+
+    CountedCell::s_finalized_count = 0;
+    CountedCell::s_destroyed_count = 0;
+    heap.collect_garbage();
+
+    // Conservative stack scanning may keep a few of the garbage cells alive.
+    auto finalized_count = CountedCell::s_finalized_count;
+    EXPECT(finalized_count > 500);
+    EXPECT_EQ(CountedCell::s_destroyed_count, 0u);
+    EXPECT(heap.has_unswept_blocks());
+    EXPECT(root->state() == GC::Cell::State::Live);
+
+    // Every block was left unswept, so the next allocation has to sweep one.
+    (void)heap.allocate<CountedCell>();
+    EXPECT(CountedCell::s_destroyed_count > 0);
+
+    // The next collection finishes sweeping before it starts marking.
+    heap.collect_garbage();
+    EXPECT(CountedCell::s_destroyed_count >= finalized_count);
+    EXPECT(root->state() == GC::Cell::State::Live);
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Atomic.h>
+#include <AK/Vector.h>
+#include <LibCore/System.h>
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+
+namespace {
+
+class TreeNode final : public GC::Cell {
+    GC_CELL(TreeNode, GC::Cell);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(TreeNode);
+
+public:
+    static inline size_t s_destroyed_count { 0 };
+
+    virtual ~TreeNode() override { ++s_destroyed_count; }
+
+    void append_child(TreeNode& child) { m_children.append(child); }
+    Vector<GC::Ref<TreeNode>> const& children() const { return m_children; }
+
+private:
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(m_children);
+    }
+
+    Vector<GC::Ref<TreeNode>> m_children;
+};
+
+class ThreadSafeBase : public GC::Cell {
+    GC_CELL(ThreadSafeBase, GC::Cell);
+    GC_DECLARE_THREAD_SAFE_VISIT_EDGES(ThreadSafeBase);
+};
+
+class DerivedFromThreadSafeBase final : public ThreadSafeBase {
+    GC_CELL(DerivedFromThreadSafeBase, ThreadSafeBase);
+};
+
+// Doesn't opt in to being traced on a helper thread, so it must only ever be traced on the main thread.
+class MainThreadNode final : public GC::Cell {
+    GC_CELL(MainThreadNode, GC::Cell);
+
+public:
+    static inline pthread_t s_main_thread;
+    static inline Atomic<size_t> s_visits_on_other_threads { 0 };
+
+    explicit MainThreadNode(GC::Ref<TreeNode> subtree)
+        : m_subtree(subtree)
+    {
+    }
+
+    TreeNode const& subtree() const { return m_subtree; }
+
+private:
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        if (!pthread_equal(pthread_self(), s_main_thread))
+            ++s_visits_on_other_threads;
+        visitor.visit(m_subtree);
+    }
+
+    GC::Ref<TreeNode> m_subtree;
+};
+
+}
+
+static GC::Ref<TreeNode> build_tree(GC::Heap& heap, size_t depth, size_t fan_out)
+{
+    auto node = heap.allocate<TreeNode>();
+    if (depth > 0) {
+        for (size_t i = 0; i < fan_out; ++i)
+            node->append_child(build_tree(heap, depth - 1, fan_out));
+    }
+    return node;
+}
+
+static size_t count_nodes(TreeNode const& node)
+{
+    size_t count = 1;
+    for (auto const& child : node.children())
+        count += count_nodes(child);
+    return count;
+}
+
+static bool every_node_is_unmarked(TreeNode const& node)
+{
+    if (node.is_marked())
+        return false;
+    for (auto const& child : node.children()) {
+        if (!every_node_is_unmarked(child))
+            return false;
+    }
+    return true;
+}
+
+// Many small trees, so that a stale pointer found by conservative stack scanning only keeps one of them alive.
+static NEVER_INLINE void build_garbage(GC::Heap& heap, size_t tree_count, size_t depth, size_t fan_out)
+{
+    for (size_t i = 0; i < tree_count; ++i)
+        (void)build_tree(heap, depth, fan_out);
+}
+
+TEST_CASE(parallel_collection_keeps_reachable_cells)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_collector_thread_count(4);
+
+    auto root = GC::make_root(build_tree(heap, 6, 4));
+    auto node_count = count_nodes(*root);
+
+    TreeNode::s_destroyed_count = 0;
+    build_garbage(heap, 16, 5, 4);
+
+    heap.collect_garbage();
+
+    EXPECT_EQ(count_nodes(*root), node_count);
+    EXPECT(every_node_is_unmarked(*root));
+
+    // Conservative stack scanning may keep a few of the garbage cells alive.
+    EXPECT(TreeNode::s_destroyed_count > node_count / 2);
+}
+
+TEST_CASE(cells_without_thread_safe_visit_edges_are_traced_on_the_main_thread)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_collector_thread_count(4);
+
+    MainThreadNode::s_main_thread = pthread_self();
+    MainThreadNode::s_visits_on_other_threads = 0;
+
+    // With enough roots, the main thread shares some of them with the helper threads.
+    Vector<GC::Root<MainThreadNode>> roots;
+    for (size_t i = 0; i < 256; ++i)
+        roots.append(GC::make_root(heap.allocate<MainThreadNode>(build_tree(heap, 2, 4))));
+
+    heap.collect_garbage();
+
+    EXPECT_EQ(MainThreadNode::s_visits_on_other_threads.load(), 0u);
+    for (auto const& root : roots)
+        EXPECT_EQ(count_nodes(root->subtree()), 21u);
+}
+
+TEST_CASE(thread_safe_visit_edges_is_not_inherited)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+
+    EXPECT(heap.allocate<TreeNode>()->has_thread_safe_visit_edges());
+    EXPECT(heap.allocate<ThreadSafeBase>()->has_thread_safe_visit_edges());
+    EXPECT(!heap.allocate<DerivedFromThreadSafeBase>()->has_thread_safe_visit_edges());
+    EXPECT(!heap.allocate<MainThreadNode>(heap.allocate<TreeNode>())->has_thread_safe_visit_edges());
+}
+
+TEST_CASE(parallel_collection_keeps_cells_of_wide_nodes)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_collector_thread_count(4);
+
+    // Far more children than fit in a mark stack to begin with, so the stack has to grow while others steal from it.
+    auto root = GC::make_root(heap.allocate<TreeNode>());
+    for (size_t i = 0; i < 20'000; ++i)
+        root->append_child(build_tree(heap, 1, 2));
+
+    for (size_t i = 0; i < 3; ++i)
+        heap.collect_garbage();
+
+    EXPECT_EQ(count_nodes(*root), 60'001u);
+    EXPECT(every_node_is_unmarked(*root));
+}
+
+TEST_CASE(collector_threads_are_reused)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_collector_thread_count(4);
+    EXPECT_EQ(heap.collector_thread_count(), 4u);
+
+    auto root = GC::make_root(build_tree(heap, 4, 4));
+    for (size_t i = 0; i < 100; ++i)
+        heap.collect_garbage();
+    EXPECT_EQ(count_nodes(*root), 341u);
+
+    heap.set_collector_thread_count(1);
+    EXPECT_EQ(heap.collector_thread_count(), 1u);
+    heap.collect_garbage();
+    EXPECT_EQ(count_nodes(*root), 341u);
+}
+
+// One benchmark per thread count, so that the pause times can be compared.
+static void benchmark_collection_with_thread_count(size_t thread_count)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+    heap.set_collector_thread_count(min<size_t>(thread_count, Core::System::hardware_concurrency()));
+    auto root = GC::make_root(build_tree(heap, 9, 4));
+
+    for (size_t i = 0; i < 10; ++i)
+        heap.collect_garbage();
+
+    EXPECT(root);
+}
+
+BENCHMARK_CASE(collection_with_1_thread)
+{
+    benchmark_collection_with_thread_count(1);
+}
+
+BENCHMARK_CASE(collection_with_2_threads)
+{
+    benchmark_collection_with_thread_count(2);
+}
+
+BENCHMARK_CASE(collection_with_4_threads)
+{
+    benchmark_collection_with_thread_count(4);
+}
+
+BENCHMARK_CASE(collection_with_8_threads)
+{
+    benchmark_collection_with_thread_count(8);
+}
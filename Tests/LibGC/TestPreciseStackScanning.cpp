@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <LibGC/Heap.h>
+
+static NEVER_INLINE void collect_with_precise_range(GC::Heap& heap, size_t& skipped_words)
+{
+    AK::Array<FlatPtr, 256> frame {};
+    heap.set_gather_precise_stack_ranges([&](auto& ranges) {
+        ranges.append({ .base = bit_cast<FlatPtr>(frame.data()), .end = bit_cast<FlatPtr>(frame.data() + frame.size()) });
+    });
+    heap.collect_garbage();
+    skipped_words = heap.last_conservative_scan_statistics().skipped_words;
+    heap.set_gather_precise_stack_ranges(nullptr);
+}
+
+TEST_CASE(precise_stack_ranges_are_skipped)
+{
+    GC::Heap heap(nullptr, [](auto&) { });
+
+    size_t skipped_words = 0;
+    collect_with_precise_range(heap, skipped_words);
+    EXPECT_EQ(skipped_words, 0u);
+    EXPECT(heap.last_conservative_scan_statistics().scanned_words > 0);
+
+    heap.set_precise_stack_scanning_enabled(true);
+    collect_with_precise_range(heap, skipped_words);
+    EXPECT_EQ(skipped_words, 256u);
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Utf16String.h>
+#include <AK/Utf8View.h>
+#include <LibCore/MappedFile.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Font/PathFontProvider.h>
+#include <LibGfx/Font/Typeface.h>
+#include <LibGfx/Font/WOFF2/Loader.h>
+#include <LibGfx/TextLayout.h>
+#include <LibGfx/TextShapingCache.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+
+#define TEST_INPUT(x) ("test-inputs/" x)
+
+namespace {
+
+struct Global {
+    Global()
+    {
+        Gfx::FontDatabase::the().install_system_font_provider(make<Gfx::PathFontProvider>());
+    }
+} global;
+
+}
+
+static NonnullRefPtr<Gfx::Typeface> load_test_typeface()
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("woff2/incorrect_sfnt_size.woff2"sv)));
+    return MUST(WOFF2::try_load_from_bytes(file->bytes()));
+}
+
+static void expect_equal_glyph_runs(Gfx::GlyphRun const& a, Gfx::GlyphRun const& b)
+{
+    EXPECT_EQ(a.width(), b.width());
+    EXPECT_EQ(a.glyphs().size(), b.glyphs().size());
+
+    for (size_t i = 0; i < min(a.glyphs().size(), b.glyphs().size()); ++i) {
+        EXPECT_EQ(a.glyphs()[i].position, b.glyphs()[i].position);
+        EXPECT_EQ(a.glyphs()[i].length_in_code_units, b.glyphs()[i].length_in_code_units);
+        EXPECT_EQ(a.glyphs()[i].glyph_width, b.glyphs()[i].glyph_width);
+        EXPECT_EQ(a.glyphs()[i].glyph_id, b.glyphs()[i].glyph_id);
+    }
+}
+
+TEST_CASE(repeated_text_is_shaped_once)
+{
+    auto& cache = Gfx::TextShapingCache::the();
+    cache.clear();
+
+    auto font = load_test_typeface()->font(12);
+    auto text = Utf8View { "hello"sv };
+
+    auto before = cache.statistics();
+    auto uncached_run = Gfx::shape_text({ 10, 20 }, 2, text, font, Gfx::GlyphRun::TextType::Ltr, {});
+    auto cached_run = Gfx::shape_text({ 10, 20 }, 2, text, font, Gfx::GlyphRun::TextType::Ltr, {});
+    auto after = cache.statistics();
+
+    EXPECT_EQ(after.misses - before.misses, 1u);
+    EXPECT_EQ(after.hits - before.hits, 1u);
+    expect_equal_glyph_runs(uncached_run, cached_run);
+
+    // The baseline and the letter spacing are applied after shaping, so they don't need entries of their own.
+    cache.clear();
+    auto uncached_moved_run = Gfx::shape_text({ 30, 5 }, 0, text, font, Gfx::GlyphRun::TextType::Ltr, {});
+    auto cached_moved_run = Gfx::shape_text({ 30, 5 }, 0, text, font, Gfx::GlyphRun::TextType::Ltr, {});
+    expect_equal_glyph_runs(uncached_moved_run, cached_moved_run);
+    EXPECT_EQ(cache.size(), 1u);
+
+    // Measuring text shares the entries of shaping it.
+    auto hits = cache.statistics().hits;
+    (void)font->width(text);
+    EXPECT_EQ(cache.statistics().hits, hits + 1);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_CASE(shaping_inputs_are_part_of_the_key)
+{
+    auto& cache = Gfx::TextShapingCache::the();
+    cache.clear();
+
+    auto typeface = load_test_typeface();
+    auto font = typeface->font(12);
+    auto larger_font = typeface->font(24);
+
+    Gfx::ShapeFeatures features;
+    features.append({ { 'k', 'e', 'r', 'n' }, 0 });
+
+    (void)Gfx::shape_text({}, 0, Utf8View { "hello"sv }, font, Gfx::GlyphRun::TextType::Ltr, {});
+    (void)Gfx::shape_text({}, 0, Utf8View { "hello"sv }, larger_font, Gfx::GlyphRun::TextType::Ltr, {});
+    (void)Gfx::shape_text({}, 0, Utf8View { "hello"sv }, font, Gfx::GlyphRun::TextType::Ltr, features);
+    (void)Gfx::shape_text({}, 0, Utf8View { "world"sv }, font, Gfx::GlyphRun::TextType::Ltr, {});
+    EXPECT_EQ(cache.size(), 4u);
+
+    // ASCII text is shaped the same way, no matter which kind of view it comes from.
+    auto ascii = "hello"_utf16;
+    (void)Gfx::shape_text({}, 0, ascii.utf16_view(), font, Gfx::GlyphRun::TextType::Ltr, {});
+    EXPECT_EQ(cache.size(), 4u);
+
+    // Clusters of UTF-16 text are counted in code units rather than bytes, so it can't share entries with UTF-8 text.
+    auto non_ascii = u"héllo"_utf16;
+    (void)Gfx::shape_text({}, 0, Utf8View { "héllo"sv }, font, Gfx::GlyphRun::TextType::Ltr, {});
+    (void)Gfx::shape_text({}, 0, non_ascii.utf16_view(), font, Gfx::GlyphRun::TextType::Ltr, {});
+    EXPECT_EQ(cache.size(), 6u);
+}
+
+TEST_CASE(least_recently_used_text_is_evicted)
+{
+    auto& cache = Gfx::TextShapingCache::the();
+    cache.clear();
+
+    auto font = load_test_typeface()->font(12);
+    auto shape = [&](size_t index) {
+        auto text = ByteString::number(index);
+        (void)Gfx::shape_text({}, 0, Utf8View { text }, font, Gfx::GlyphRun::TextType::Ltr, {});
+    };
+
+    for (size_t i = 0; i < Gfx::TextShapingCache::CAPACITY; ++i)
+        shape(i);
+    EXPECT_EQ(cache.size(), Gfx::TextShapingCache::CAPACITY);
+
+    // Using the oldest entry again makes the second oldest one the next to go.
+    shape(0);
+    auto before = cache.statistics();
+    shape(Gfx::TextShapingCache::CAPACITY);
+    shape(0);
+    shape(1);
+    auto after = cache.statistics();
+
+    EXPECT_EQ(cache.size(), Gfx::TextShapingCache::CAPACITY);
+    EXPECT_EQ(after.evictions - before.evictions, 2u);
+    EXPECT_EQ(after.hits - before.hits, 1u);
+    EXPECT_EQ(after.misses - before.misses, 2u);
+}
+
+TEST_CASE(long_text_is_not_cached)
+{
+    auto& cache = Gfx::TextShapingCache::the();
+    cache.clear();
+
+    auto font = load_test_typeface()->font(12);
+    auto text = ByteString::repeated('a', Gfx::TextShapingCache::MAX_TEXT_SIZE_IN_BYTES + 1);
+
+    auto before = cache.statistics();
+    (void)Gfx::shape_text({}, 0, Utf8View { text }, font, Gfx::GlyphRun::TextType::Ltr, {});
+    (void)Gfx::shape_text({}, 0, Utf8View { text }, font, Gfx::GlyphRun::TextType::Ltr, {});
+    auto after = cache.statistics();
+
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(after.hits, before.hits);
+    EXPECT_EQ(after.misses, before.misses);
+}
+
+TEST_CASE(each_thread_has_its_own_cache)
+{
+    auto& cache = Gfx::TextShapingCache::the();
+    cache.clear();
+
+    auto font = load_test_typeface()->font(12);
+    (void)font->width(Utf8View { "hello"sv });
+    EXPECT_EQ(cache.size(), 1u);
+
+    Gfx::TextShapingCache::Statistics other_thread_statistics;
+    size_t other_thread_cache_size = 0;
+    auto thread = Threading::Thread::construct([&] {
+        auto& other_thread_cache = Gfx::TextShapingCache::the();
+        (void)font->width(Utf8View { "hello"sv });
+        (void)font->width(Utf8View { "world"sv });
+        other_thread_statistics = other_thread_cache.statistics();
+        other_thread_cache_size = other_thread_cache.size();
+        return 0;
+    });
+    thread->start();
+    (void)thread->join();
+
+    // Text that was measured on the main thread has to be shaped again on another thread, and doesn't show up here.
+    EXPECT_EQ(other_thread_statistics.hits, 0u);
+    EXPECT_EQ(other_thread_statistics.misses, 2u);
+    EXPECT_EQ(other_thread_cache_size, 2u);
+    EXPECT_EQ(cache.size(), 1u);
+}
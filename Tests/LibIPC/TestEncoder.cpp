@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/MemoryStream.h>
+#include <AK/String.h>
+#include <AK/Utf16String.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibCore/System.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibIPC/Message.h>
+#include <LibTest/TestCase.h>
+
+template<typename T>
+static T round_trip(T const& value, IPC::Encoder::UseSharedMemory use_shared_memory, size_t expected_fd_count)
+{
+    IPC::MessageBuffer buffer;
+    IPC::Encoder encoder(buffer, use_shared_memory);
+    MUST(encoder.encode(value));
+    EXPECT_EQ(buffer.fds().size(), expected_fd_count);
+
+    Queue<IPC::File> files;
+    for (auto const& fd : buffer.fds())
+        files.enqueue(MUST(IPC::File::clone_fd(fd->value())));
+
+    FixedMemoryStream stream { buffer.data().span() };
+    IPC::Decoder decoder { stream, files };
+    auto decoded = MUST(decoder.decode<T>());
+
+    EXPECT(stream.is_eof());
+    EXPECT(files.is_empty());
+    return decoded;
+}
+
+static ByteBuffer create_buffer(size_t size)
+{
+    auto buffer = MUST(ByteBuffer::create_uninitialized(size));
+    for (size_t i = 0; i < size; ++i)
+        buffer[i] = static_cast<u8>(i * 7);
+    return buffer;
+}
+
+TEST_CASE(small_payloads_are_sent_inline)
+{
+    using enum IPC::Encoder::UseSharedMemory;
+
+    auto before = IPC::Encoder::statistics();
+
+    EXPECT_EQ(round_trip(ByteBuffer {}, Yes, 0), ByteBuffer {});
+    EXPECT_EQ(round_trip(create_buffer(1024), Yes, 0), create_buffer(1024));
+    EXPECT_EQ(round_trip(ByteString {}, Yes, 0), ByteString {});
+    EXPECT_EQ(round_trip("well hello friends"_string, Yes, 0), "well hello friends"_string);
+    EXPECT_EQ(round_trip(u"héllo 😀"_utf16, Yes, 0), u"héllo 😀"_utf16);
+
+    auto after = IPC::Encoder::statistics();
+    EXPECT_EQ(after.bytes_sent_inline - before.bytes_sent_inline, 1024u + 18u + 8u * sizeof(char16_t));
+    EXPECT_EQ(after.shared_memory_buffers_sent, before.shared_memory_buffers_sent);
+}
+
+TEST_CASE(large_payloads_are_sent_through_shared_memory)
+{
+    using enum IPC::Encoder::UseSharedMemory;
+    static constexpr auto size = IPC::Encoder::SHARED_MEMORY_THRESHOLD + 3;
+
+    auto before = IPC::Encoder::statistics();
+
+    auto buffer = create_buffer(size);
+    EXPECT_EQ(round_trip(buffer, Yes, 1), buffer);
+
+    auto byte_string = ByteString::repeated('a', size);
+    EXPECT_EQ(round_trip(byte_string, Yes, 1), byte_string);
+
+    auto string = MUST(String::repeated('b', size));
+    EXPECT_EQ(round_trip(string, Yes, 1), string);
+
+    auto ascii_utf16_string = Utf16String::repeated('c', size);
+    EXPECT_EQ(round_trip(ascii_utf16_string, Yes, 1), ascii_utf16_string);
+
+    auto utf16_string = Utf16String::repeated(0x1F600, size / 2);
+    EXPECT_EQ(round_trip(utf16_string, Yes, 1), utf16_string);
+
+    auto after = IPC::Encoder::statistics();
+    EXPECT_EQ(after.bytes_sent_through_shared_memory - before.bytes_sent_through_shared_memory, 4 * size + utf16_string.length_in_code_units() * sizeof(char16_t));
+    EXPECT_EQ(after.shared_memory_buffers_sent - before.shared_memory_buffers_sent, 5u);
+    EXPECT_EQ(after.bytes_sent_inline, before.bytes_sent_inline);
+}
+
+TEST_CASE(large_payloads_stay_inline_without_shared_memory)
+{
+    using enum IPC::Encoder::UseSharedMemory;
+
+    auto before = IPC::Encoder::statistics();
+
+    auto buffer = create_buffer(IPC::Encoder::SHARED_MEMORY_THRESHOLD * 2);
+    EXPECT_EQ(round_trip(buffer, No, 0), buffer);
+
+    auto after = IPC::Encoder::statistics();
+    EXPECT_EQ(after.bytes_sent_inline, before.bytes_sent_inline);
+    EXPECT_EQ(after.bytes_sent_through_shared_memory, before.bytes_sent_through_shared_memory);
+}
+
+static ErrorOr<ByteBuffer> decode_from_shared_memory(IPC::File file, size_t size)
+{
+    IPC::MessageBuffer buffer;
+    IPC::Encoder encoder(buffer);
+    MUST(encoder.encode_size(size));
+    MUST(encoder.encode(IPC::PayloadStorage::SharedMemory));
+
+    Queue<IPC::File> files;
+    files.enqueue(move(file));
+
+    FixedMemoryStream stream { buffer.data().span() };
+    IPC::Decoder decoder { stream, files };
+    return decoder.decode<ByteBuffer>();
+}
+
+TEST_CASE(shared_memory_smaller_than_payload_is_rejected)
+{
+    auto shared_memory = MUST(Core::AnonymousBuffer::create_with_size(4096));
+    auto file = MUST(IPC::File::clone_fd(shared_memory.fd()));
+    shared_memory = {};
+    MUST(Core::System::seal_anon_fd_against_writes(file.fd()));
+
+    EXPECT(decode_from_shared_memory(move(file), 2 * MiB).is_error());
+}
+
+#if defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
+TEST_CASE(shared_memory_that_is_still_writable_is_rejected)
+{
+    auto shared_memory = MUST(Core::AnonymousBuffer::create_with_size(4096));
+    EXPECT(decode_from_shared_memory(MUST(IPC::File::clone_fd(shared_memory.fd())), 4096).is_error());
+}
+#endif
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/File.h>
+#include <LibIPC/SharedMemoryRing.h>
+#include <LibIPC/Transport.h>
+#include <LibTest/TestCase.h>
+
+#if defined(AK_OS_LINUX)
+#    include <sys/mman.h>
+#endif
+
+struct TransportPair {
+    NonnullOwnPtr<IPC::Transport> sender;
+    NonnullOwnPtr<IPC::Transport> receiver;
+};
+
+static TransportPair create_transport_pair()
+{
+    int fds[2] {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto sender_socket = MUST(Core::LocalSocket::adopt_fd(fds[0]));
+    MUST(sender_socket->set_blocking(true));
+    auto receiver_socket = MUST(Core::LocalSocket::adopt_fd(fds[1]));
+    MUST(receiver_socket->set_blocking(true));
+
+    return { make<IPC::Transport>(move(sender_socket)), make<IPC::Transport>(move(receiver_socket)) };
+}
+
+struct ReceivedMessage {
+    Vector<u8> bytes;
+    size_t fd_count { 0 };
+};
+
+static void receive_messages(IPC::Transport& transport, Vector<ReceivedMessage>& messages, size_t count)
+{
+    while (messages.size() < count) {
+        transport.wait_until_readable();
+        auto should_shutdown = transport.read_as_many_messages_as_possible_without_blocking([&](auto&& message) {
+            messages.append({ move(message.bytes), message.fds.size() });
+        });
+        VERIFY(should_shutdown == IPC::Transport::ShouldShutdown::No);
+    }
+}
+
+static void negotiate_shared_memory_ring(IPC::Transport& sender, IPC::Transport& receiver, Vector<ReceivedMessage>& received_messages)
+{
+    sender.offer_shared_memory_ring();
+
+    // The receiver accepts the offer while reading, and the sender learns about it the next time it reads.
+    receiver.wait_until_readable();
+    (void)receiver.read_as_many_messages_as_possible_without_blocking([&](auto&& message) {
+        received_messages.append({ move(message.bytes), message.fds.size() });
+    });
+
+    while (!sender.is_sending_through_shared_memory_ring()) {
+        sender.wait_until_readable();
+        (void)sender.read_as_many_messages_as_possible_without_blocking([](auto&&) { VERIFY_NOT_REACHED(); });
+    }
+}
+
+static Vector<u8> create_payload(size_t index, size_t size)
+{
+    Vector<u8> payload;
+    payload.resize(size);
+    for (size_t i = 0; i < size; ++i)
+        payload[i] = static_cast<u8>(index + i);
+    return payload;
+}
+
+TEST_CASE(shared_memory_ring_negotiation)
+{
+    Core::EventLoop loop;
+    auto [sender, receiver] = create_transport_pair();
+
+    Vector<ReceivedMessage> messages;
+    EXPECT(!sender->is_sending_through_shared_memory_ring());
+    negotiate_shared_memory_ring(*sender, *receiver, messages);
+    EXPECT(sender->is_sending_through_shared_memory_ring());
+    EXPECT(messages.is_empty());
+
+    // Each direction has to be offered separately.
+    EXPECT(!receiver->is_sending_through_shared_memory_ring());
+}
+
+TEST_CASE(messages_keep_their_order_across_socket_and_shared_memory_ring)
+{
+    Core::EventLoop loop;
+    auto [sender, receiver] = create_transport_pair();
+
+    // Messages posted before the ring was accepted went through the socket, and must still come first.
+    Vector<ReceivedMessage> messages;
+    sender->post_message(create_payload(0, 16), {});
+    negotiate_shared_memory_ring(*sender, *receiver, messages);
+
+    static constexpr size_t message_count = 2000;
+
+    for (size_t i = 1; i < message_count; ++i) {
+        // File descriptors and messages that are larger than the ring have to go through the socket.
+        Vector<NonnullRefPtr<IPC::AutoCloseFileDescriptor>> fds;
+        if (i % 17 == 0)
+            fds.append(adopt_ref(*new IPC::AutoCloseFileDescriptor(MUST(Core::System::dup(STDERR_FILENO)))));
+
+        auto size = i % 101 == 0 ? IPC::SharedMemoryRing::CAPACITY + 1 : (i * 37) % 3000;
+        sender->post_message(create_payload(i, size), fds);
+
+        // Read in batches, so that the ring both fills up and wraps around.
+        if (i % 250 == 0)
+            receive_messages(*receiver, messages, i + 1);
+    }
+
+    receive_messages(*receiver, messages, message_count);
+    EXPECT_EQ(messages.size(), message_count);
+
+    EXPECT_EQ(messages[0].bytes, create_payload(0, 16));
+    for (size_t i = 1; i < message_count; ++i) {
+        auto size = i % 101 == 0 ? IPC::SharedMemoryRing::CAPACITY + 1 : (i * 37) % 3000;
+        EXPECT_EQ(messages[i].bytes, create_payload(i, size));
+        EXPECT_EQ(messages[i].fd_count, i % 17 == 0 ? 1u : 0u);
+    }
+}
+
+// Mirrors the header that TransportSocket puts in front of everything it sends, so that we can impersonate a peer that
+// doesn't follow the protocol.
+struct RawMessageHeader {
+    u8 type { 0 };
+    u32 payload_size { 0 };
+    u32 fd_count { 0 };
+    u32 sequence_number { 0 };
+};
+
+static IPC::Transport::ShouldShutdown receive_raw_header(RawMessageHeader header)
+{
+    int fds[2] {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto receiver_socket = MUST(Core::LocalSocket::adopt_fd(fds[1]));
+    MUST(receiver_socket->set_blocking(true));
+    IPC::Transport receiver { move(receiver_socket) };
+
+    MUST(Core::System::write(fds[0], { &header, sizeof(header) }));
+    receiver.wait_until_readable();
+    auto should_shutdown = receiver.read_as_many_messages_as_possible_without_blocking([](auto&&) { VERIFY_NOT_REACHED(); });
+
+    MUST(Core::System::close(fds[0]));
+    return should_shutdown;
+}
+
+TEST_CASE(malformed_shared_memory_ring_messages_are_protocol_errors)
+{
+    Core::EventLoop loop;
+
+    // An offer has to come with the shared memory and the doorbell.
+    EXPECT_EQ(receive_raw_header({ .type = 2, .fd_count = 0 }), IPC::Transport::ShouldShutdown::Yes);
+
+    // We never offered a ring, so there is nothing to accept.
+    EXPECT_EQ(receive_raw_header({ .type = 3 }), IPC::Transport::ShouldShutdown::Yes);
+}
+
+#if defined(AK_OS_LINUX)
+TEST_CASE(shared_memory_ring_rejects_resizable_buffers)
+{
+    auto doorbell_fds = MUST(Core::System::pipe2(O_CLOEXEC));
+    MUST(Core::System::close(doorbell_fds[1]));
+
+    // A peer that can shrink the buffer after we've mapped it could make us fault on any access.
+    auto buffer_fd = ::memfd_create("", MFD_CLOEXEC);
+    VERIFY(buffer_fd >= 0);
+    MUST(Core::System::ftruncate(buffer_fd, 2 * IPC::SharedMemoryRing::CAPACITY));
+
+    auto ring = IPC::SharedMemoryRing::attach(IPC::File::adopt_fd(buffer_fd), IPC::File::adopt_fd(doorbell_fds[0]));
+    EXPECT(ring.is_error());
+}
+
+TEST_CASE(shared_memory_ring_buffers_are_sealed)
+{
+    auto ring = MUST(IPC::SharedMemoryRing::create());
+    auto fds = MUST(ring->clone_fds_for_peer());
+    EXPECT(!Core::System::verify_anon_fd_is_sealed(fds[0]).is_error());
+    EXPECT(Core::System::ftruncate(fds[0], 0).is_error());
+
+    for (auto fd : fds)
+        MUST(Core::System::close(fd));
+}
+#endif
+
+static void ping_pong(bool use_shared_memory_ring)
+{
+    Core::EventLoop loop;
+    auto [client, server] = create_transport_pair();
+
+    Vector<ReceivedMessage> messages;
+    if (use_shared_memory_ring) {
+        negotiate_shared_memory_ring(*client, *server, messages);
+        negotiate_shared_memory_ring(*server, *client, messages);
+    }
+
+    auto payload = create_payload(0, 64);
+
+    for (size_t i = 0; i < 20'000; ++i) {
+        client->post_message(payload, {});
+        receive_messages(*server, messages, 1);
+        server->post_message(messages.take_last().bytes, {});
+        receive_messages(*client, messages, 1);
+        VERIFY(messages.take_last().bytes == payload);
+    }
+}
+
+BENCHMARK_CASE(ping_pong_latency_through_socket)
+{
+    ping_pong(false);
+}
+
+BENCHMARK_CASE(ping_pong_latency_through_shared_memory_ring)
+{
+    ping_pong(true);
+}
+
+static void stream_messages(bool use_shared_memory_ring)
+{
+    Core::EventLoop loop;
+    auto [sender, receiver] = create_transport_pair();
+
+    Vector<ReceivedMessage> messages;
+    if (use_shared_memory_ring) {
+        negotiate_shared_memory_ring(*sender, *receiver, messages);
+        negotiate_shared_memory_ring(*receiver, *sender, messages);
+    }
+
+    // The receiver acknowledges every batch, so that the sender can't run arbitrarily far ahead of it.
+    static constexpr size_t batch_count = 1000;
+    static constexpr size_t messages_per_batch = 256;
+    auto payload = create_payload(0, 256);
+    auto acknowledgement = create_payload(0, 8);
+
+    size_t received_bytes = 0;
+    for (size_t batch = 0; batch < batch_count; ++batch) {
+        for (size_t i = 0; i < messages_per_batch; ++i)
+            sender->post_message(payload, {});
+
+        receive_messages(*receiver, messages, messages_per_batch);
+        for (auto const& message : messages)
+            received_bytes += message.bytes.size();
+        messages.clear();
+
+        receiver->post_message(acknowledgement, {});
+        receive_messages(*sender, messages, 1);
+        messages.clear();
+    }
+
+    EXPECT_EQ(received_bytes, batch_count * messages_per_batch * payload.size());
+}
+
+BENCHMARK_CASE(throughput_through_socket)
+{
+    stream_messages(false);
+}
+
+BENCHMARK_CASE(throughput_through_shared_memory_ring)
+{
+    stream_messages(true);
+}
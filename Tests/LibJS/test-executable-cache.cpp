@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/StringBuilder.h>
+#include <AK/TypeCasts.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/AbstractOperations.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// Long enough to be worth caching, and refers to a global so the bytecode depends on how it was parsed.
+static String function_source(size_t statement_count = 40)
+{
+    StringBuilder builder;
+    builder.append("function f(a) {\n"sv);
+    for (size_t i = 0; i < statement_count; ++i)
+        builder.appendff("    a = a + {} * x;\n", i);
+    builder.append("    return a;\n}\n"sv);
+    return MUST(builder.to_string());
+}
+
+static JS::ECMAScriptFunctionObject& evaluate_to_function(JS::VM& vm, StringView source)
+{
+    auto script = MUST(JS::Script::parse(source, *vm.current_realm()));
+    auto value = MUST(vm.bytecode_interpreter().run(*script));
+    return as<JS::ECMAScriptFunctionObject>(value.as_object());
+}
+
+TEST_CASE(functions_of_scripts_are_cached)
+{
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+
+    auto& function = evaluate_to_function(*vm, MUST(String::formatted("{}f", function_source())));
+    EXPECT(JS::Bytecode::executable_cache_key(function).has_value());
+}
+
+TEST_CASE(functions_of_eval_code_are_not_cached)
+{
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+
+    auto& direct = evaluate_to_function(*vm, MUST(String::formatted("(function() {{ var x; return eval(`{}f`); }})()", function_source())));
+    EXPECT(!JS::Bytecode::executable_cache_key(direct).has_value());
+
+    auto& indirect = evaluate_to_function(*vm, MUST(String::formatted("(0, eval)(`{}f`)", function_source())));
+    EXPECT(!JS::Bytecode::executable_cache_key(indirect).has_value());
+}
+
+TEST_CASE(dynamic_functions_are_not_cached)
+{
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+
+    auto& function = evaluate_to_function(*vm, MUST(String::formatted("new Function(`return ({}f)(1);`)", function_source())));
+    EXPECT(!JS::Bytecode::executable_cache_key(function).has_value());
+}
+
+// Stands in for the host's storage, which outlives the VMs using it.
+struct CacheContents {
+    HashMap<String, ByteBuffer> entries;
+    size_t loads { 0 };
+    size_t stores { 0 };
+};
+
+class MemoryExecutableCache final : public JS::Bytecode::ExecutableCache {
+public:
+    explicit MemoryExecutableCache(CacheContents& contents)
+        : m_contents(contents)
+    {
+    }
+
+    virtual Optional<ByteBuffer> load(StringView key) override
+    {
+        auto it = m_contents.entries.find(MUST(String::from_utf8(key)));
+        if (it == m_contents.entries.end())
+            return {};
+        ++m_contents.loads;
+        return MUST(ByteBuffer::copy(it->value));
+    }
+
+    virtual void store(StringView key, ReadonlyBytes bytes) override
+    {
+        ++m_contents.stores;
+        m_contents.entries.set(MUST(String::from_utf8(key)), MUST(ByteBuffer::copy(bytes)));
+    }
+
+private:
+    CacheContents& m_contents;
+};
+
+static String script_source(size_t statement_count = 40)
+{
+    return MUST(String::formatted("var x = 2;\n{}f", function_source(statement_count)));
+}
+
+static ByteBuffer serialized_function(size_t statement_count = 40)
+{
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+
+    auto& function = evaluate_to_function(*vm, script_source(statement_count));
+    auto executable = MUST(JS::Bytecode::compile(*vm, function));
+    return MUST(JS::Bytecode::serialize_executable(*executable));
+}
+
+TEST_CASE(cached_bytecode_is_reused_by_other_vms)
+{
+    CacheContents contents;
+
+    for (size_t i = 0; i < 2; ++i) {
+        auto vm = JS::VM::create();
+        auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+        vm->set_executable_cache(make<MemoryExecutableCache>(contents));
+
+        auto& function = evaluate_to_function(*vm, script_source());
+        auto result = MUST(JS::call(*vm, function, JS::js_undefined(), JS::Value(1)));
+        EXPECT_EQ(result.as_double(), 1561.0);
+    }
+
+    // The second VM must have run the bytecode stored by the first one, instead of generating (and storing) its own.
+    EXPECT_EQ(contents.entries.size(), 1u);
+    EXPECT_EQ(contents.stores, 1u);
+    EXPECT_EQ(contents.loads, 1u);
+}
+
+TEST_CASE(truncated_bytecode_is_rejected)
+{
+    auto bytes = serialized_function();
+
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& function = evaluate_to_function(*vm, script_source());
+
+    EXPECT(!JS::Bytecode::deserialize_executable(*vm, bytes, function).is_error());
+    for (size_t length = 0; length < bytes.size(); ++length)
+        EXPECT(JS::Bytecode::deserialize_executable(*vm, bytes.bytes().trim(length), function).is_error());
+}
+
+TEST_CASE(corrupted_bytecode_is_rejected_or_contained)
+{
+    auto bytes = serialized_function();
+
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& function = evaluate_to_function(*vm, script_source());
+
+    auto corrupted = MUST(ByteBuffer::copy(bytes));
+    corrupted[0] ^= 0xff;
+    EXPECT(JS::Bytecode::deserialize_executable(*vm, corrupted, function).is_error());
+
+    auto with_trailing_data = MUST(ByteBuffer::copy(bytes));
+    with_trailing_data.append(0);
+    EXPECT(JS::Bytecode::deserialize_executable(*vm, with_trailing_data, function).is_error());
+
+    // Not every corruption can be detected (e.g. in a constant), but none of them may get past validation with an
+    // executable that refers to anything outside of itself. Running these under ASan is what makes this test useful.
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        for (u8 flip : { 0x01, 0x80, 0xff }) {
+            corrupted = MUST(ByteBuffer::copy(bytes));
+            corrupted[i] ^= flip;
+            (void)JS::Bytecode::deserialize_executable(*vm, corrupted, function);
+        }
+    }
+}
+
+static constexpr size_t benchmark_statement_count = 2000;
+static constexpr size_t benchmark_iterations = 100;
+
+BENCHMARK_CASE(generate_bytecode_of_large_function)
+{
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& function = evaluate_to_function(*vm, script_source(benchmark_statement_count));
+
+    for (size_t i = 0; i < benchmark_iterations; ++i)
+        (void)MUST(JS::Bytecode::compile(*vm, function));
+}
+
+BENCHMARK_CASE(load_bytecode_of_large_function_from_cache)
+{
+    CacheContents contents;
+
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    vm->set_executable_cache(make<MemoryExecutableCache>(contents));
+    auto& function = evaluate_to_function(*vm, script_source(benchmark_statement_count));
+
+    // The first compile fills the cache.
+    (void)MUST(JS::Bytecode::compile(*vm, function));
+    for (size_t i = 0; i < benchmark_iterations; ++i)
+        (void)MUST(JS::Bytecode::compile(*vm, function));
+
+    EXPECT_EQ(contents.stores, 1u);
+    EXPECT_EQ(contents.loads, benchmark_iterations);
+}
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Enumerate.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/Date.h>
 #include <LibJS/Runtime/TypedArray.h>
@@ -131,8 +132,22 @@ TESTJS_GLOBAL_FUNCTION(to_utf8_bytes, toUTF8Bytes)
     return typed_array;
 }
 
+// Test files can turn on features that are off by default with a directive on their first line, e.g.:
+// // test-js: enable-jit
+static Vector<StringView> test_js_directives(ReadonlyBytes contents)
+{
+    auto first_line = StringView { contents }.find_first_split_view('\n');
+    if (!first_line.starts_with("// test-js:"sv))
+        return {};
+    return first_line.substring_view("// test-js:"sv.length()).split_view(' ');
+}
+
 TESTJS_RUN_FILE_FUNCTION(ByteString const& test_file, JS::Realm& realm, JS::ExecutionContext&)
 {
+    auto contents = Test::JS::load_entire_file(test_file);
+    auto directives = test_js_directives(contents);
+    JS::Bytecode::g_jit_enabled = directives.contains_slow("enable-jit"sv);
+
     if (!test262_parser_tests)
         return Test::JS::RunFileHookResult::RunAsNormal;
 
@@ -6,6 +6,7 @@
 
 #include <LibTest/TestCase.h> // import first, to prevent warning of VERIFY* redefinition
 
+#include <AK/Array.h>
 #include <AK/Debug.h>
 #include <AK/StringBuilder.h>
 #include <AK/Tuple.h>
@@ -1379,3 +1380,171 @@ TEST_CASE(account_for_opcode_size_calculating_incoming_jump_edges)
         EXPECT_EQ(result.matches.first().view.to_byte_string(), "aa"sv);
     }
 }
+
+TEST_CASE(pike_vm_eligibility)
+{
+    // Every pattern with an unbounded loop that could give back what it matched is matched by the Pike VM.
+    Array<StringView, 8> pike_vm_patterns { "^(?:x+x+)+y$"sv, "(a+)+b"sv, "(a*)*b"sv, "x+x+y"sv, "^(\\w+\\s?)*$"sv, "^(a|aa)*$"sv, ".*a.*a.*a"sv, "a.*b"sv };
+    for (auto pattern : pike_vm_patterns) {
+        Regex<ECMA262> re(pattern);
+        EXPECT(re.parser_result.optimization_data.can_use_pike_vm);
+        EXPECT(re.parser_result.optimization_data.use_pike_vm);
+    }
+
+    // Loops that were made atomic, or that nothing after them can make give back what they matched, are unambiguous.
+    Array<StringView, 5> backtracking_patterns { "(a|ab)(c|bcd)(d*)"sv, "([a-z]+) ([a-z]+)"sv, "a+b"sv, "x(ab)+y"sv, "\\s+"sv };
+    for (auto pattern : backtracking_patterns) {
+        Regex<ECMA262> re(pattern);
+        EXPECT(re.parser_result.optimization_data.can_use_pike_vm);
+        EXPECT(!re.parser_result.optimization_data.use_pike_vm);
+    }
+
+    Array<StringView, 4> ineligible_patterns { "(a)\\1"sv, "a(?=b)"sv, "a(?!b)"sv, "(?<=a)b"sv };
+    for (auto pattern : ineligible_patterns) {
+        Regex<ECMA262> re(pattern);
+        EXPECT(!re.parser_result.optimization_data.can_use_pike_vm);
+        EXPECT(!re.parser_result.optimization_data.use_pike_vm);
+    }
+}
+
+TEST_CASE(pike_vm_matches)
+{
+    {
+        // Alternatives are preferred in order, like they are when backtracking.
+        Regex<ECMA262> re("(a|ab)(c|bcd)(d*)");
+        re.set_engine_for_testing(Regex<ECMA262>::Engine::PikeVM);
+        auto result = re.match("abcd"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "abcd"sv);
+        EXPECT_EQ(result.capture_group_matches.first()[0].view.to_byte_string(), "a"sv);
+        EXPECT_EQ(result.capture_group_matches.first()[1].view.to_byte_string(), "bcd"sv);
+        EXPECT_EQ(result.capture_group_matches.first()[2].view.to_byte_string(), ""sv);
+    }
+    {
+        Regex<ECMA262> re("((b*)[ab])", ECMAScriptFlags::Insensitive);
+        re.set_engine_for_testing(Regex<ECMA262>::Engine::PikeVM);
+        auto result = re.match("bbbb"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "bbbb"sv);
+        EXPECT_EQ(result.capture_group_matches.first()[1].view.to_byte_string(), "bbb"sv);
+    }
+    {
+        // Captures from an earlier attempt at matching don't leak into a later one.
+        Regex<ECMA262> re("((a|ab|))*?a");
+        re.set_engine_for_testing(Regex<ECMA262>::Engine::PikeVM);
+        auto result = re.search("caca"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "a"sv);
+        EXPECT_EQ(result.matches.first().global_offset, 1u);
+        EXPECT(result.capture_group_matches.first()[0].view.is_null());
+    }
+    {
+        Regex<ECMA262> re("((?:b|(a)*[ab])){1,2}?", ECMAScriptFlags::Global);
+        re.set_engine_for_testing(Regex<ECMA262>::Engine::PikeVM);
+        auto result = re.match("abbbcbcaac"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 5u);
+        EXPECT_EQ(result.matches.last().view.to_byte_string(), "aa"sv);
+        EXPECT_EQ(result.matches.last().global_offset, 7u);
+    }
+}
+
+TEST_CASE(ambiguous_loops_are_matched_in_linear_time)
+{
+    // Each of these would take at least quadratic time to backtrack through.
+    auto lots_of_a_s = g_lots_of_a_s.bytes_as_string_view().substring_view(0, 50'000);
+    auto lots_of_a_s_and_a_b = ByteString::formatted("{}b", lots_of_a_s);
+    auto lots_of_b_s = ByteString::repeated('b', 50'000);
+    auto lots_of_b_s_and_three_a_s = ByteString::formatted("{}aaa", lots_of_b_s);
+    {
+        Regex<ECMA262> re("^(a|aa)*$");
+        EXPECT_EQ(re.match(lots_of_a_s).success, true);
+        EXPECT_EQ(re.match(lots_of_a_s_and_a_b.view()).success, false);
+    }
+    {
+        Regex<ECMA262> re(".*a.*a.*a");
+        EXPECT_EQ(re.search(lots_of_b_s.view()).success, false);
+        EXPECT_EQ(re.search(lots_of_b_s_and_three_a_s.view()).success, true);
+    }
+    {
+        Regex<ECMA262> re("a.*b");
+        EXPECT_EQ(re.search(lots_of_a_s).success, false);
+        auto result = re.search(lots_of_a_s_and_a_b.view());
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.length(), lots_of_a_s_and_a_b.length());
+    }
+}
+
+// The same real-world patterns and inputs for both engines, so that their benchmarks can be compared directly.
+static void match_real_world_patterns(Regex<ECMA262>::Engine engine)
+{
+    struct Case {
+        StringView pattern;
+        StringView input;
+        bool matches;
+    };
+
+    StringBuilder builder;
+    for (size_t i = 0; i < 200; ++i)
+        builder.append("Lorem ipsum dolor sit amet, consectetur adipiscing elit. "sv);
+    builder.append("foo@example.com https://example.com/index.html 2025-01-01 info: loaded"sv);
+    auto text = builder.to_byte_string();
+
+    Array<Case, 8> cases {
+        Case { "[a-z0-9._%+-]+@[a-z0-9.-]+\\.[a-z]{2,}"sv, text, true },
+        Case { "https?://[^ /]+[^ ]*"sv, text, true },
+        Case { "(\\d{4})-(\\d{2})-(\\d{2}) ([a-z]+): (.*)$"sv, text, true },
+        Case { "([a-z]+) ([a-z]+)"sv, text, true },
+        Case { "a.*b"sv, text, false },
+        // These can blow up when backtracking, so their inputs are kept short enough for the backtracker to finish.
+        Case { "^([a-z]+ ?)*$"sv, "lorem ipsum dolor sit amet consectetur adipiscing!"sv, false },
+        Case { "(a+a+)+b"sv, g_lots_of_a_s.bytes_as_string_view().substring_view(0, 20), false },
+        Case { "a+a+b"sv, g_lots_of_a_s.bytes_as_string_view().substring_view(0, 200), false },
+    };
+
+    for (auto const& test_case : cases) {
+        Regex<ECMA262> re(test_case.pattern);
+        re.set_engine_for_testing(engine);
+        EXPECT_EQ(re.search(test_case.input).success, test_case.matches);
+    }
+}
+
+BENCHMARK_CASE(backtracking_performance)
+{
+    match_real_world_patterns(Regex<ECMA262>::Engine::Backtracking);
+}
+
+BENCHMARK_CASE(pike_vm_performance)
+{
+    match_real_world_patterns(Regex<ECMA262>::Engine::PikeVM);
+}
+
+BENCHMARK_CASE(prefilter_performance)
+{
+    // A few megabytes of text that is mostly not what we're looking for, with a match right at the end.
+    StringBuilder builder(StringBuilder::Mode::UTF16);
+    for (size_t i = 0; i < 100'000; ++i)
+        builder.append(u"Lorem ipsum dolor sit amet, consectetur—"sv);
+    builder.append(u"contact: foo@example.com on 2025-01-01"sv);
+    auto input = builder.to_utf16_string();
+
+    {
+        Regex<ECMA262> re("foo@[a-z]+\\.com");
+        EXPECT_EQ(re.parser_result.optimization_data.starting_literal, "foo@"sv);
+        auto result = re.search(input.utf16_view());
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "foo@example.com"sv);
+    }
+    {
+        Regex<ECMA262> re("[0-9]{4}-[0-9]{2}-[0-9]{2}");
+        EXPECT(re.parser_result.optimization_data.starting_characters.is_empty());
+        auto result = re.search(input.utf16_view());
+        EXPECT_EQ(result.success, true);
+    }
+    {
+        Regex<ECMA262> re("[xyz]+q");
+        EXPECT_EQ(re.parser_result.optimization_data.starting_characters.size(), 3u);
+        auto result = re.search(input.utf16_view());
+        EXPECT_EQ(result.success, false);
+    }
+}
@@ -86,6 +86,32 @@ static Vector<Token> run_tokenizer(StringView input)
     return tokens;
 }
 
+// Appends the input to the tokenizer in chunks of the given size, tokenizing as much as possible after each one.
+static Vector<Token> run_tokenizer_in_chunks(StringView input, size_t chunk_size)
+{
+    Vector<Token> tokens;
+    Tokenizer tokenizer;
+    tokenizer.open_input_stream();
+
+    auto tokenize_available_input = [&] {
+        while (true) {
+            auto maybe_token = tokenizer.next_token();
+            if (!maybe_token.has_value())
+                break;
+            tokens.append(maybe_token.release_value());
+        }
+    };
+
+    for (size_t offset = 0; offset < input.length(); offset += chunk_size) {
+        tokenizer.append_to_input_stream(input.substring_view(offset, min(chunk_size, input.length() - offset)));
+        tokenize_available_input();
+    }
+
+    tokenizer.close_input_stream();
+    tokenize_available_input();
+    return tokens;
+}
+
 // FIXME: It's not very nice to rely on the format of HTMLToken::to_string() to stay the same.
 static u32 hash_tokens(Vector<Token> const& tokens)
 {
@@ -251,6 +277,32 @@ TEST_CASE(doctype)
     EXPECT_END_TAG_TOKEN(html, 23u, 27u);
 }
 
+TEST_CASE(input_arriving_in_chunks)
+{
+    // Leaves out the source position, which comes last.
+    auto describe_tokens = [](Vector<Token> const& tokens) {
+        Vector<String> descriptions;
+        for (auto const& token : tokens) {
+            auto description = token.to_string();
+            auto position = description.bytes_as_string_view().find_last('@');
+            descriptions.append(MUST(description.substring_from_byte_offset(0, position.value())));
+        }
+        return descriptions;
+    };
+
+    auto inputs = {
+        "<!DOCTYPE html><html lang=en><head><title>A &amp; B</title></head>"sv,
+        "<p class=\"foo\" data-x='1'>Some text&notit; and &#x26;&#38;</p>\r\n<!-- A comment -->\r\r\n"sv,
+        "<script>if (a < b && c) document.write(\"</p>\");</script><textarea>x</textarea>"sv,
+    };
+
+    for (auto input : inputs) {
+        auto expected_tokens = describe_tokens(run_tokenizer(input));
+        for (size_t chunk_size = 1; chunk_size <= input.length(); ++chunk_size)
+            EXPECT_EQ(describe_tokens(run_tokenizer_in_chunks(input, chunk_size)), expected_tokens);
+    }
+}
+
 // NOTE: This relies on the format of HTMLToken::to_string() staying the same.
 //       If that changes, or something is added to the test HTML, the hash needs to be adjusted.
 TEST_CASE(regression)
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/IndexedDB/Internal/BTree.h>
+
+struct Entry {
+    int key { 0 };
+    int value { 0 };
+
+    bool operator==(Entry const&) const = default;
+};
+
+struct EntryTraits {
+    using KeyType = int;
+    static int key_of(Entry const& entry) { return entry.key; }
+    static int compare(int a, int b) { return a < b ? -1 : (a > b ? 1 : 0); }
+};
+
+using Tree = Web::IndexedDB::BTree<Entry, EntryTraits>;
+
+static auto compare_to(int target)
+{
+    return [target](int key) { return EntryTraits::compare(key, target); };
+}
+
+static Vector<Entry> collect(Tree const& tree)
+{
+    Vector<Entry> entries;
+    for (auto it = tree.begin(); !it.is_end(); ++it)
+        entries.append(*it);
+    return entries;
+}
+
+TEST_CASE(empty_tree)
+{
+    Tree tree;
+    EXPECT(tree.is_empty());
+    EXPECT(tree.begin() == tree.end());
+    EXPECT(tree.find(1).is_end());
+    EXPECT(tree.lower_bound(compare_to(1)).is_end());
+}
+
+TEST_CASE(entries_are_kept_in_order)
+{
+    Tree tree;
+    // Enough entries to split leaves and internal nodes a few times.
+    for (int i = 0; i < 10000; ++i)
+        tree.insert({ (i * 7919) % 10000, i });
+
+    EXPECT_EQ(tree.size(), 10000u);
+
+    int expected_key = 0;
+    for (auto it = tree.begin(); !it.is_end(); ++it)
+        EXPECT_EQ(it->key, expected_key++);
+    EXPECT_EQ(expected_key, 10000);
+
+    auto it = tree.end();
+    for (int key = 9999; key >= 0; --key) {
+        --it;
+        EXPECT_EQ(it->key, key);
+    }
+    EXPECT(it == tree.begin());
+}
+
+TEST_CASE(equal_keys_keep_insertion_order)
+{
+    Tree tree;
+    for (int i = 0; i < 200; ++i)
+        tree.insert({ i % 2, i });
+
+    auto entries = collect(tree);
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i - 1].key == entries[i].key)
+            EXPECT(entries[i - 1].value < entries[i].value);
+    }
+    EXPECT_EQ(tree.find(1)->value, 1);
+}
+
+TEST_CASE(bounds)
+{
+    Tree tree;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert({ i * 2, i });
+
+    EXPECT_EQ(tree.lower_bound(compare_to(500))->key, 500);
+    EXPECT_EQ(tree.lower_bound(compare_to(501))->key, 502);
+    EXPECT_EQ(tree.upper_bound(compare_to(500))->key, 502);
+    EXPECT_EQ(tree.lower_bound(compare_to(-1))->key, 0);
+    EXPECT(tree.lower_bound(compare_to(1999)).is_end());
+    EXPECT(tree.upper_bound(compare_to(1998)).is_end());
+
+    EXPECT_EQ(tree.find(1998)->value, 999);
+    EXPECT(tree.find(1997).is_end());
+}
+
+TEST_CASE(remove_returns_the_next_entry)
+{
+    Tree tree;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert({ i, i });
+
+    auto it = tree.find(100);
+    while (!it.is_end() && it->key < 900)
+        it = tree.remove(it);
+
+    EXPECT_EQ(it->key, 900);
+    EXPECT_EQ(tree.size(), 200u);
+    EXPECT_EQ(tree.upper_bound(compare_to(99))->key, 900);
+
+    auto entries = collect(tree);
+    EXPECT_EQ(entries.size(), 200u);
+    EXPECT_EQ(entries[99].key, 99);
+    EXPECT_EQ(entries[100].key, 900);
+
+    while (!tree.is_empty())
+        tree.remove(tree.begin());
+    EXPECT(tree.begin() == tree.end());
+
+    tree.insert({ 1, 1 });
+    EXPECT_EQ(collect(tree), (Vector<Entry> { { 1, 1 } }));
+}
+
+TEST_CASE(remove_all_matching)
+{
+    Tree tree;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert({ i, i });
+
+    EXPECT_EQ(tree.remove_all_matching([](Entry const& entry) { return entry.key % 3 != 0; }), 666u);
+    EXPECT_EQ(tree.size(), 334u);
+
+    int expected_key = 0;
+    for (auto it = tree.begin(); !it.is_end(); ++it, expected_key += 3)
+        EXPECT_EQ(it->key, expected_key);
+    EXPECT_EQ(tree.lower_bound(compare_to(4))->key, 6);
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <LibWebView/Database.h>
+#include <LibWebView/IndexedDBStorage.h>
+
+using Web::IndexedDB::PersistedDatabase;
+using Web::IndexedDB::PersistedDatabaseChanges;
+using Web::IndexedDB::PersistedDatabaseContents;
+using Web::IndexedDB::PersistedIndex;
+using Web::IndexedDB::PersistedObjectStore;
+using Web::IndexedDB::PersistedRecord;
+
+static constexpr u64 object_store_id = 1;
+static constexpr u64 index_id = 2;
+
+static String const storage_key = "https://example.com"_string;
+static String const database_name = "test"_string;
+
+static ByteString database_file(StringView test_name)
+{
+    auto path = ByteString::formatted("{}/indexeddb-storage-{}.db", Core::StandardPaths::tempfile_directory(), test_name);
+    (void)Core::System::unlink(path);
+    return path;
+}
+
+static ByteBuffer bytes(StringView string)
+{
+    return MUST(ByteBuffer::copy(string.bytes()));
+}
+
+// Opens the database file anew, as the browser does when it starts.
+static Optional<PersistedDatabaseContents> reload(ByteString const& path)
+{
+    auto database = MUST(WebView::Database::create(path));
+    auto storage = MUST(WebView::IndexedDBStorage::create(*database));
+    return storage->load_database(storage_key, database_name);
+}
+
+static PersistedDatabase database_with_object_store(u64 version, Vector<PersistedIndex> indexes)
+{
+    PersistedObjectStore object_store {
+        .id = object_store_id,
+        .name = "items"_string,
+        .key_path = {},
+        .key_generator_current_number = 1,
+        .indexes = move(indexes),
+    };
+    return { database_name, version, { move(object_store) } };
+}
+
+static PersistedIndex by_value_index()
+{
+    return { index_id, "by_value"_string, "value"_string, false, false };
+}
+
+static void create_database(WebView::IndexedDBStorage& storage)
+{
+    PersistedDatabaseChanges changes;
+    changes.database = database_with_object_store(1, { by_value_index() });
+    changes.stored_records.append({ object_store_id, bytes("a"sv), bytes("value a"sv) });
+    changes.stored_records.append({ object_store_id, bytes("b"sv), bytes("value b"sv) });
+    changes.stored_index_records.append({ index_id, bytes("value a"sv), bytes("a"sv) });
+    changes.stored_index_records.append({ index_id, bytes("value b"sv), bytes("b"sv) });
+    storage.commit_changes(storage_key, database_name, changes);
+}
+
+static Optional<ByteString> load_value(WebView::IndexedDBStorage& storage, StringView key)
+{
+    return storage.load_record_value(storage_key, database_name, object_store_id, bytes(key)).map([](auto const& value) {
+        return ByteString { value.bytes() };
+    });
+}
+
+static bool has_record(Vector<PersistedRecord> const& records, u64 source_id, StringView key)
+{
+    return records.first_matching([&](auto const& record) {
+        return record.source_id == source_id && record.key.bytes() == key.bytes();
+    }).has_value();
+}
+
+TEST_CASE(persist_and_reload)
+{
+    auto path = database_file("persist"sv);
+    {
+        auto database = MUST(WebView::Database::create(path));
+        auto storage = MUST(WebView::IndexedDBStorage::create(*database));
+        create_database(*storage);
+    }
+
+    auto contents = reload(path);
+    VERIFY(contents.has_value());
+
+    EXPECT_EQ(contents->database.version, 1u);
+    EXPECT_EQ(contents->database.object_stores.size(), 1u);
+    EXPECT_EQ(contents->database.object_stores[0].name, "items"sv);
+    EXPECT_EQ(contents->database.object_stores[0].indexes.size(), 1u);
+    EXPECT_EQ(contents->database.object_stores[0].indexes[0].name, "by_value"sv);
+
+    EXPECT_EQ(contents->records.size(), 2u);
+    EXPECT(has_record(contents->records, object_store_id, "a"sv));
+    EXPECT(has_record(contents->records, object_store_id, "b"sv));
+    EXPECT_EQ(contents->index_records.size(), 2u);
+
+    // Values are only loaded once they're asked for.
+    EXPECT(contents->records[0].value.is_empty());
+
+    auto database = MUST(WebView::Database::create(path));
+    auto storage = MUST(WebView::IndexedDBStorage::create(*database));
+    EXPECT_EQ(load_value(*storage, "a"sv), "value a"sv);
+    EXPECT(!load_value(*storage, "c"sv).has_value());
+}
+
+TEST_CASE(changes_without_database_description)
+{
+    auto path = database_file("delta"sv);
+    {
+        auto database = MUST(WebView::Database::create(path));
+        auto storage = MUST(WebView::IndexedDBStorage::create(*database));
+        create_database(*storage);
+
+        // A transaction that isn't an upgrade transaction only sends what it changed.
+        PersistedDatabaseChanges changes;
+        changes.key_generators.append({ object_store_id, 5 });
+        changes.removed_records.append({ object_store_id, bytes("a"sv), {} });
+        changes.removed_index_records.append({ index_id, bytes("value a"sv), bytes("a"sv) });
+        changes.stored_records.append({ object_store_id, bytes("b"sv), bytes("new value b"sv) });
+        changes.stored_records.append({ object_store_id, bytes("c"sv), bytes("value c"sv) });
+        storage->commit_changes(storage_key, database_name, changes);
+    }
+
+    auto contents = reload(path);
+    VERIFY(contents.has_value());
+
+    EXPECT_EQ(contents->database.version, 1u);
+    EXPECT_EQ(contents->database.object_stores[0].key_generator_current_number, 5u);
+    EXPECT_EQ(contents->database.object_stores[0].indexes.size(), 1u);
+
+    EXPECT_EQ(contents->records.size(), 2u);
+    EXPECT(!has_record(contents->records, object_store_id, "a"sv));
+    EXPECT(has_record(contents->records, object_store_id, "b"sv));
+    EXPECT(has_record(contents->records, object_store_id, "c"sv));
+    EXPECT_EQ(contents->index_records.size(), 1u);
+
+    auto database = MUST(WebView::Database::create(path));
+    auto storage = MUST(WebView::IndexedDBStorage::create(*database));
+    EXPECT_EQ(load_value(*storage, "b"sv), "new value b"sv);
+}
+
+TEST_CASE(cleared_object_stores_and_deleted_indexes)
+{
+    auto path = database_file("clear"sv);
+    {
+        auto database = MUST(WebView::Database::create(path));
+        auto storage = MUST(WebView::IndexedDBStorage::create(*database));
+        create_database(*storage);
+
+        // An upgrade transaction that deleted the index, and cleared the object store before storing a new record.
+        PersistedDatabaseChanges changes;
+        changes.database = database_with_object_store(2, {});
+        changes.cleared_object_stores.append(object_store_id);
+        changes.cleared_indexes.append(index_id);
+        changes.stored_records.append({ object_store_id, bytes("d"sv), bytes("value d"sv) });
+        storage->commit_changes(storage_key, database_name, changes);
+    }
+
+    auto contents = reload(path);
+    VERIFY(contents.has_value());
+
+    EXPECT_EQ(contents->database.version, 2u);
+    EXPECT(contents->database.object_stores[0].indexes.is_empty());
+    EXPECT_EQ(contents->records.size(), 1u);
+    EXPECT(has_record(contents->records, object_store_id, "d"sv));
+    EXPECT(contents->index_records.is_empty());
+}
+
+TEST_CASE(delete_database)
+{
+    auto path = database_file("delete"sv);
+    {
+        auto database = MUST(WebView::Database::create(path));
+        auto storage = MUST(WebView::IndexedDBStorage::create(*database));
+        create_database(*storage);
+        storage->delete_database(storage_key, database_name);
+    }
+
+    EXPECT(!reload(path).has_value());
+}
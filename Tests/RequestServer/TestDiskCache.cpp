@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/Directory.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/BackgroundAction.h>
+#include <LibURL/Parser.h>
+#include <RequestServer/Cache/DiskCache.h>
+#include <fcntl.h>
+
+using RequestServer::CacheEntryReader;
+using RequestServer::DiskCache;
+
+static Requests::CachePartition const partition { "https://example.com", "https://example.com" };
+
+static ByteString cache_directory(StringView test_name)
+{
+    auto path = ByteString::formatted("{}/disk-cache-{}", Core::StandardPaths::tempfile_directory(), test_name);
+    (void)FileSystem::remove(path, FileSystem::RecursionMode::Allowed);
+    return path;
+}
+
+static URL::URL url(StringView path)
+{
+    return URL::Parser::basic_parse(ByteString::formatted("https://example.com/{}", path)).release_value();
+}
+
+// Background actions complete in the order they were started, so once this one has, all earlier disk work is done.
+static void wait_for_disk_writes()
+{
+    bool done = false;
+    Threading::BackgroundAction<Empty>::construct(
+        [](auto&) -> ErrorOr<Empty> { return Empty {}; },
+        [&](Empty) -> ErrorOr<void> {
+            done = true;
+            return {};
+        });
+    Core::EventLoop::current().spin_until([&] { return done; });
+}
+
+static void store(DiskCache& disk_cache, Requests::CachePartition const& partition, StringView path, HTTP::HeaderMap const& response_headers, StringView body)
+{
+    auto now = UnixDateTime::now();
+    auto writer = disk_cache.create_entry(partition, url(path), "GET"sv, {}, 200, "OK"_string, response_headers, now, now);
+    VERIFY(writer);
+    MUST(writer->write_data(body.bytes()));
+    MUST(writer->flush());
+    wait_for_disk_writes();
+}
+
+static ByteString read_body(CacheEntryReader& entry)
+{
+    auto fds = MUST(Core::System::pipe2(O_NONBLOCK));
+
+    bool done = false;
+    entry.pipe_to(
+        fds[1], [&](u64) { done = true; }, [&](u64) { VERIFY_NOT_REACHED(); });
+    VERIFY(done);
+    MUST(Core::System::close(fds[1]));
+
+    char buffer[1024];
+    auto size = MUST(Core::System::read(fds[0], { buffer, sizeof(buffer) }));
+    MUST(Core::System::close(fds[0]));
+    return ByteString { buffer, size };
+}
+
+static HTTP::HeaderMap headers(std::initializer_list<HTTP::Header> headers)
+{
+    HTTP::HeaderMap map;
+    for (auto const& header : headers)
+        map.set(header.name, header.value);
+    return map;
+}
+
+TEST_CASE(store_and_reload)
+{
+    Core::EventLoop event_loop;
+    auto directory = cache_directory("store"sv);
+
+    {
+        auto disk_cache = MUST(DiskCache::create(directory));
+        wait_for_disk_writes();
+
+        store(*disk_cache, partition, "style.css"sv, headers({ { "Cache-Control", "max-age=3600" } }), "body { }"sv);
+        EXPECT_EQ(disk_cache->statistics().stored, 1u);
+
+        auto entry = disk_cache->open_entry(partition, url("style.css"sv), "GET"sv, {});
+        VERIFY(entry);
+        EXPECT(!entry->must_revalidate());
+        EXPECT_EQ(read_body(*entry), "body { }"sv);
+
+        EXPECT(!disk_cache->open_entry(partition, url("other.css"sv), "GET"sv, {}));
+    }
+
+    // The index is rebuilt from the directory when the cache is opened again.
+    auto disk_cache = MUST(DiskCache::create(directory));
+    wait_for_disk_writes();
+
+    auto entry = disk_cache->open_entry(partition, url("style.css"sv), "GET"sv, {});
+    VERIFY(entry);
+    EXPECT_EQ(entry->metadata().status_code, 200u);
+    EXPECT_EQ(read_body(*entry), "body { }"sv);
+}
+
+TEST_CASE(entries_are_partitioned)
+{
+    Core::EventLoop event_loop;
+    auto disk_cache = MUST(DiskCache::create(cache_directory("partition"sv)));
+    wait_for_disk_writes();
+
+    store(*disk_cache, partition, "script.js"sv, headers({ { "Cache-Control", "max-age=3600" } }), "alert(1)"sv);
+
+    Requests::CachePartition other_top_level_site { "https://other.com", "https://example.com" };
+    Requests::CachePartition other_frame_site { "https://example.com", "https://other.com" };
+
+    EXPECT(disk_cache->open_entry(partition, url("script.js"sv), "GET"sv, {}));
+    EXPECT(!disk_cache->open_entry(other_top_level_site, url("script.js"sv), "GET"sv, {}));
+    EXPECT(!disk_cache->open_entry(other_frame_site, url("script.js"sv), "GET"sv, {}));
+}
+
+TEST_CASE(revalidate)
+{
+    Core::EventLoop event_loop;
+    auto disk_cache = MUST(DiskCache::create(cache_directory("revalidate"sv)));
+    wait_for_disk_writes();
+
+    store(*disk_cache, partition, "image.png"sv, headers({ { "Cache-Control", "no-cache" }, { "ETag", "\"1\"" } }), "image data"sv);
+
+    {
+        auto entry = disk_cache->open_entry(partition, url("image.png"sv), "GET"sv, {});
+        VERIFY(entry);
+        EXPECT(entry->must_revalidate());
+
+        // The server confirmed that the stored response is still current, and may now be used for an hour.
+        auto now = UnixDateTime::now();
+        disk_cache->freshen_entry(*entry, headers({ { "Cache-Control", "max-age=3600" }, { "ETag", "\"1\"" } }), now, now);
+        EXPECT_EQ(*entry->metadata().response_headers.get("Cache-Control"sv), "max-age=3600"sv);
+
+        // The body is still read from the file that was opened, even though the entry has been rewritten by now.
+        wait_for_disk_writes();
+        EXPECT_EQ(read_body(*entry), "image data"sv);
+    }
+
+    EXPECT_EQ(disk_cache->statistics().validated, 1u);
+
+    auto entry = disk_cache->open_entry(partition, url("image.png"sv), "GET"sv, {});
+    VERIFY(entry);
+    EXPECT(!entry->must_revalidate());
+    EXPECT_EQ(read_body(*entry), "image data"sv);
+
+    // A stale response without validators can't be revalidated, so it isn't stored at all.
+    auto now = UnixDateTime::now();
+    EXPECT(!disk_cache->create_entry(partition, url("stale.png"sv), "GET"sv, {}, 200, "OK"_string, headers({ { "Cache-Control", "max-age=0" } }), now, now));
+}
+
+TEST_CASE(evict_least_recently_used_entries)
+{
+    Core::EventLoop event_loop;
+    auto directory = cache_directory("evict"sv);
+    auto disk_cache = MUST(DiskCache::create(directory, 64 * KiB));
+    wait_for_disk_writes();
+
+    auto response_headers = headers({ { "Cache-Control", "max-age=3600" } });
+    auto body = ByteString::repeated('a', 7 * KiB);
+
+    // A single entry may be at most an eighth of the cache.
+    {
+        auto now = UnixDateTime::now();
+        auto writer = disk_cache->create_entry(partition, url("large"sv), "GET"sv, {}, 200, "OK"_string, response_headers, now, now);
+        VERIFY(writer);
+
+        auto large_body = ByteString::repeated('a', 9 * KiB);
+        EXPECT(writer->write_data(large_body.bytes()).is_error());
+    }
+
+    for (size_t i = 0; i < 8; ++i)
+        store(*disk_cache, partition, ByteString::number(i), response_headers, body);
+
+    // Using the first entry makes the second one the least recently used.
+    EXPECT(disk_cache->open_entry(partition, url("0"sv), "GET"sv, {}));
+    wait_for_disk_writes();
+
+    for (size_t i = 8; i < 10; ++i)
+        store(*disk_cache, partition, ByteString::number(i), response_headers, body);
+
+    EXPECT(disk_cache->statistics().evicted > 0);
+    EXPECT(disk_cache->open_entry(partition, url("0"sv), "GET"sv, {}));
+    EXPECT(!disk_cache->open_entry(partition, url("1"sv), "GET"sv, {}));
+    EXPECT(disk_cache->open_entry(partition, url("9"sv), "GET"sv, {}));
+
+    // Evicted entries are removed from disk.
+    wait_for_disk_writes();
+    size_t files_on_disk = 0;
+    MUST(Core::Directory::for_each_entry(directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const&, auto const&) -> ErrorOr<IterationDecision> {
+        ++files_on_disk;
+        return IterationDecision::Continue;
+    }));
+    EXPECT_EQ(files_on_disk, 10 - disk_cache->statistics().evicted);
+}
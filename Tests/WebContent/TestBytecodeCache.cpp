@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/BackgroundAction.h>
+#include <WebContent/BytecodeCache.h>
+
+using WebContent::BytecodeCache;
+
+static ByteString cache_directory(StringView test_name)
+{
+    auto path = ByteString::formatted("{}/bytecode-cache-{}", Core::StandardPaths::tempfile_directory(), test_name);
+    (void)FileSystem::remove(path, FileSystem::RecursionMode::Allowed);
+    return path;
+}
+
+// Background actions complete in the order they were started, so once this one has, all earlier disk work is done.
+static void wait_for_disk_writes()
+{
+    bool done = false;
+    Threading::BackgroundAction<Empty>::construct(
+        [](auto&) -> ErrorOr<Empty> { return Empty {}; },
+        [&](Empty) -> ErrorOr<void> {
+            done = true;
+            return {};
+        });
+    Core::EventLoop::current().spin_until([&] { return done; });
+}
+
+TEST_CASE(entries_are_loaded_by_other_processes)
+{
+    Core::EventLoop event_loop;
+    auto directory = cache_directory("round-trip"sv);
+
+    {
+        auto cache = MUST(BytecodeCache::create(directory));
+        EXPECT(!cache->load("1234-a"sv).has_value());
+        cache->store("1234-a"sv, "first"sv.bytes());
+        cache->store("1234-b"sv, "second"sv.bytes());
+        wait_for_disk_writes();
+    }
+
+    // The very first lookup for a script has to hit, as most functions are only ever compiled once per process.
+    auto cache = MUST(BytecodeCache::create(directory));
+    auto first = cache->load("1234-a"sv);
+    EXPECT(first.has_value());
+    EXPECT_EQ(StringView { first->bytes() }, "first"sv);
+
+    auto second = cache->load("1234-b"sv);
+    EXPECT(second.has_value());
+    EXPECT_EQ(StringView { second->bytes() }, "second"sv);
+
+    EXPECT(!cache->load("1234-c"sv).has_value());
+    EXPECT(!cache->load("5678-a"sv).has_value());
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
+
+TEST_CASE(loaded_entries_are_not_kept_in_memory)
+{
+    Core::EventLoop event_loop;
+    auto directory = cache_directory("loaded-entries"sv);
+
+    {
+        auto cache = MUST(BytecodeCache::create(directory));
+        cache->store("1234-a"sv, "first"sv.bytes());
+        wait_for_disk_writes();
+    }
+
+    auto cache = MUST(BytecodeCache::create(directory));
+    EXPECT(cache->load("1234-a"sv).has_value());
+    EXPECT(!cache->load("1234-a"sv).has_value());
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
+
+TEST_CASE(unloaded_entries_are_evicted_from_memory)
+{
+    Core::EventLoop event_loop;
+    auto directory = cache_directory("memory-eviction"sv);
+
+    // Each script holds an entry that no function ever asks for, which is more than we keep in memory in total.
+    auto entry = MUST(ByteBuffer::create_zeroed(3 * MiB));
+    {
+        auto cache = MUST(BytecodeCache::create(directory));
+        for (auto source_hash : { "1"sv, "2"sv, "3"sv, "4"sv }) {
+            cache->store(ByteString::formatted("{}-unused", source_hash), entry);
+            cache->store(ByteString::formatted("{}-used", source_hash), entry);
+        }
+        wait_for_disk_writes();
+    }
+
+    auto cache = MUST(BytecodeCache::create(directory));
+    for (auto source_hash : { "1"sv, "2"sv, "3"sv, "4"sv })
+        EXPECT(cache->load(ByteString::formatted("{}-used", source_hash)).has_value());
+
+    // The first script was evicted from memory, so its remaining entry has to be read from the disk again.
+    MUST(FileSystem::remove(ByteString::formatted("{}/1", directory), FileSystem::RecursionMode::Allowed));
+    EXPECT(!cache->load("1-unused"sv).has_value());
+
+    // The last script is still in memory.
+    MUST(FileSystem::remove(ByteString::formatted("{}/4", directory), FileSystem::RecursionMode::Allowed));
+    EXPECT(cache->load("4-unused"sv).has_value());
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
+
+TEST_CASE(entries_being_written_are_ignored)
+{
+    Core::EventLoop event_loop;
+    auto directory = cache_directory("partial-entries"sv);
+
+    {
+        auto cache = MUST(BytecodeCache::create(directory));
+        cache->store("1234-a"sv, "first"sv.bytes());
+        wait_for_disk_writes();
+    }
+
+    auto file = MUST(Core::File::open(ByteString::formatted("{}/1234/.tmp-123456", directory), Core::File::OpenMode::Write));
+    MUST(file->write_until_depleted("partial"sv.bytes()));
+    file->close();
+
+    auto cache = MUST(BytecodeCache::create(directory));
+    EXPECT(cache->load("1234-a"sv).has_value());
+    EXPECT(!cache->load("1234-.tmp-123456"sv).has_value());
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
@@ -813,6 +813,9 @@ static ErrorOr<int> run_repl(bool gc_on_every_allocation, bool syntax_highlight)
 ErrorOr<int> ladybird_main(Main::Arguments arguments)
 {
     bool gc_on_every_allocation = false;
+    bool gc_precise_stack = false;
+    bool enable_jit = false;
+    bool disable_bytecode_optimizations = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
@@ -823,11 +826,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(enable_jit, "Enable the baseline JIT compiler (experimental, x86-64 only)", "enable-jit", {});
+    args_parser.add_option(disable_bytecode_optimizations, "Disable the bytecode optimization passes", "disable-bytecode-optimizations", {});
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(gc_precise_stack, "Don't scan interpreter call frames conservatively for GC roots", "gc-precise-stack", {});
     args_parser.add_option(s_raw_strings, "Display strings without quotes or escape sequences", "raw-strings", 'r');
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
@@ -839,11 +845,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     [[maybe_unused]] bool syntax_highlight = !disable_syntax_highlight;
 
     AK::set_debug_enabled(!disable_debug_printing);
+    JS::Bytecode::g_jit_enabled = enable_jit;
+    JS::Bytecode::g_optimize_bytecode = !disable_bytecode_optimizations;
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
     g_vm_storage.get() = JS::VM::create();
     g_vm = g_vm_storage->ptr();
     g_vm->set_dynamic_imports_allowed(true);
+    g_vm->heap().set_precise_stack_scanning_enabled(gc_precise_stack);
 
     if (!disable_debug_printing) {
         // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -